@@ -0,0 +1,121 @@
+'''
+Helper functions to build the aggregates reduced by :meth:`aerospike.Scan.aggregate`,
+:meth:`aerospike.Query.aggregate` and :meth:`aerospike.Client.aggregate_many`.
+
+The aggregates are passed as a dict of name to aggregate, and the methods return a dict
+of the same names to the reduced values. Records are reduced in C, on the client's threads,
+so only the reduced values are converted to Python objects.
+
+Only integer and float values are reduced by :func:`sum`, :func:`min` and :func:`max`,
+and only integer values by :func:`histogram`. Records without such a value in the bin are skipped.
+
+Example::
+
+    from __future__ import print_function
+    import aerospike
+    from aerospike_helpers import aggregates
+
+    client = aerospike.client({"hosts": [("127.0.0.1", 3000)]}).connect()
+
+    scan = client.scan("test", "demo")
+    scan.select("views", "age")
+    result = scan.aggregate({
+        "records": aggregates.count(),
+        "views": aggregates.sum("views"),
+        "oldest": aggregates.max("age"),
+        "ages": aggregates.histogram("age", 10),
+    })
+    # {'records': 120, 'views': 45310, 'oldest': 71, 'ages': {10: 12, 20: 54, ...}}
+    print(result)
+    client.close()
+'''
+import aerospike
+
+AGGREGATE_KEY = "aggregate"
+BIN_KEY = "bin"
+BUCKET_WIDTH_KEY = "bucket_width"
+
+
+def count(bin_name=None):
+    """Count the records, or the records with a value in bin_name.
+
+    Args:
+        bin_name (str, optional): The bin to count the values of. default: None, count the records.
+
+    Returns:
+        An aggregate dictionary. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    aggregate = {AGGREGATE_KEY: aerospike.AGGREGATE_COUNT}
+
+    if bin_name is not None:
+        aggregate[BIN_KEY] = bin_name
+
+    return aggregate
+
+
+def sum(bin_name):
+    """Sum the values of bin_name. The sum is a float if any value is a float, and 0 if there are no values.
+
+    Args:
+        bin_name (str): The bin to sum the values of.
+
+    Returns:
+        An aggregate dictionary. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return {
+        AGGREGATE_KEY: aerospike.AGGREGATE_SUM,
+        BIN_KEY: bin_name
+    }
+
+
+def min(bin_name):
+    """The smallest value of bin_name, or None if there are no values.
+
+    Args:
+        bin_name (str): The bin to reduce.
+
+    Returns:
+        An aggregate dictionary. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return {
+        AGGREGATE_KEY: aerospike.AGGREGATE_MIN,
+        BIN_KEY: bin_name
+    }
+
+
+def max(bin_name):
+    """The largest value of bin_name, or None if there are no values.
+
+    Args:
+        bin_name (str): The bin to reduce.
+
+    Returns:
+        An aggregate dictionary. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return {
+        AGGREGATE_KEY: aerospike.AGGREGATE_MAX,
+        BIN_KEY: bin_name
+    }
+
+
+def histogram(bin_name, bucket_width):
+    """Count the integer values of bin_name per bucket of bucket_width values. The result is a dict
+    of bucket start to count, with a key for each non empty bucket. Bucket starts are multiples of bucket_width.
+
+    Args:
+        bin_name (str): The bin to reduce.
+        bucket_width (int): The positive width of the buckets.
+
+    Returns:
+        An aggregate dictionary. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return {
+        AGGREGATE_KEY: aerospike.AGGREGATE_HISTOGRAM,
+        BIN_KEY: bin_name,
+        BUCKET_WIDTH_KEY: bucket_width
+    }
@@ -1,6 +1,10 @@
 '''
 Helper functions to generate complex data type context (cdt_ctx) objects for use with operations on nested CDTs (list, map, etc).
 
+A list of cdt_ctx objects used by many operations may be converted once with
+:meth:`aerospike.Client.compile_ctx`, and the returned :class:`aerospike.CDTContext`
+passed as the ctx argument in place of the list.
+
 Example::
 
     from __future__ import print_function
@@ -194,13 +194,13 @@ def bit_resize(bin_name, byte_size, policy=None, resize_flags=aerospike.BIT_RESI
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_RESIZE,
         BIN_KEY: bin_name,
         POLICY_KEY: policy,
         RESIZE_FLAGS_KEY: resize_flags,
         BYTE_SIZE_KEY: byte_size
-    }
+    })
 
 
 def bit_remove(bin_name, byte_offset, byte_size, policy=None):
@@ -218,13 +218,13 @@ def bit_remove(bin_name, byte_offset, byte_size, policy=None):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_REMOVE,
         BIN_KEY: bin_name,
         POLICY_KEY: policy,
         BYTE_OFFSET_KEY: byte_offset,
         BYTE_SIZE_KEY: byte_size
-    }
+    })
 
 
 def bit_set(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None):
@@ -244,7 +244,7 @@ def bit_set(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None)
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_SET,
         BIN_KEY: bin_name,
         POLICY_KEY: policy,
@@ -252,7 +252,7 @@ def bit_set(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None)
         BIT_SIZE_KEY: bit_size,
         VALUE_BYTE_SIZE_KEY: value_byte_size,
         VALUE_KEY: value
-    }
+    })
 
 
 def bit_count(bin_name, bit_offset, bit_size):
@@ -269,12 +269,12 @@ def bit_count(bin_name, bit_offset, bit_size):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_COUNT,
         BIN_KEY: bin_name,
         BIT_OFFSET_KEY: bit_offset,
         BIT_SIZE_KEY: bit_size
-    }
+    })
 
 
 def bit_add(bin_name, bit_offset, bit_size, value, sign, action, policy=None):
@@ -297,7 +297,7 @@ def bit_add(bin_name, bit_offset, bit_size, value, sign, action, policy=None):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_ADD,
         BIN_KEY: bin_name,
         POLICY_KEY: policy,
@@ -306,7 +306,7 @@ def bit_add(bin_name, bit_offset, bit_size, value, sign, action, policy=None):
         VALUE_KEY: value,
         SIGN_KEY: sign,
         ACTION_KEY: action
-    }
+    })
 
 
 def bit_and(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None):
@@ -327,7 +327,7 @@ def bit_and(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None)
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_AND,
         BIN_KEY: bin_name,
         POLICY_KEY: policy,
@@ -335,7 +335,7 @@ def bit_and(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None)
         BIT_SIZE_KEY: bit_size,
         VALUE_BYTE_SIZE_KEY: value_byte_size,
         VALUE_KEY: value
-    }
+    })
 
 
 def bit_get(bin_name, bit_offset, bit_size):
@@ -352,12 +352,12 @@ def bit_get(bin_name, bit_offset, bit_size):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_GET,
         BIN_KEY: bin_name,
         BIT_OFFSET_KEY: bit_offset,
         BIT_SIZE_KEY: bit_size
-    }
+    })
 
 
 def bit_get_int(bin_name, bit_offset, bit_size, sign):
@@ -376,13 +376,13 @@ def bit_get_int(bin_name, bit_offset, bit_size, sign):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_GET_INT,
         BIN_KEY: bin_name,
         BIT_OFFSET_KEY: bit_offset,
         BIT_SIZE_KEY: bit_size,
         SIGN_KEY: sign
-    }
+    })
 
 
 def bit_insert(bin_name, byte_offset, value_byte_size, value, policy=None):
@@ -403,14 +403,14 @@ def bit_insert(bin_name, byte_offset, value_byte_size, value, policy=None):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_INSERT,
         BIN_KEY: bin_name,
         BYTE_OFFSET_KEY: byte_offset,
         VALUE_BYTE_SIZE_KEY: value_byte_size,
         VALUE_KEY: value,
         POLICY_KEY: policy
-    }
+    })
 
 
 def bit_lscan(bin_name, bit_offset, bit_size, value):
@@ -430,13 +430,13 @@ def bit_lscan(bin_name, bit_offset, bit_size, value):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_LSCAN,
         BIN_KEY: bin_name,
         BIT_OFFSET_KEY: bit_offset,
         BIT_SIZE_KEY: bit_size,
         VALUE_KEY: value
-    }
+    })
 
 
 def bit_lshift(bin_name, bit_offset, bit_size, shift, policy=None):
@@ -456,14 +456,14 @@ def bit_lshift(bin_name, bit_offset, bit_size, shift, policy=None):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_LSHIFT,
         BIN_KEY: bin_name,
         BIT_OFFSET_KEY: bit_offset,
         BIT_SIZE_KEY: bit_size,
         VALUE_KEY: shift,
         POLICY_KEY: policy
-    }
+    })
 
 
 def bit_not(bin_name, bit_offset, bit_size, policy=None):
@@ -482,13 +482,13 @@ def bit_not(bin_name, bit_offset, bit_size, policy=None):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_NOT,
         BIN_KEY: bin_name,
         BIT_OFFSET_KEY: bit_offset,
         BIT_SIZE_KEY: bit_size,
         POLICY_KEY: policy
-    }
+    })
 
 
 def bit_or(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None):
@@ -509,7 +509,7 @@ def bit_or(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_OR,
         BIN_KEY: bin_name,
         POLICY_KEY: policy,
@@ -517,7 +517,7 @@ def bit_or(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None):
         BIT_SIZE_KEY: bit_size,
         VALUE_BYTE_SIZE_KEY: value_byte_size,
         VALUE_KEY: value
-    }
+    })
 
 
 def bit_rscan(bin_name, bit_offset, bit_size, value):
@@ -537,13 +537,13 @@ def bit_rscan(bin_name, bit_offset, bit_size, value):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_RSCAN,
         BIN_KEY: bin_name,
         BIT_OFFSET_KEY: bit_offset,
         BIT_SIZE_KEY: bit_size,
         VALUE_KEY: value
-    }
+    })
 
 
 def bit_rshift(bin_name, bit_offset, bit_size, shift, policy=None):
@@ -563,14 +563,14 @@ def bit_rshift(bin_name, bit_offset, bit_size, shift, policy=None):
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_RSHIFT,
         BIN_KEY: bin_name,
         BIT_OFFSET_KEY: bit_offset,
         BIT_SIZE_KEY: bit_size,
         VALUE_KEY: shift,
         POLICY_KEY: policy
-    }
+    })
 
 
 def bit_subtract(bin_name, bit_offset, bit_size, value, sign, action, policy=None):
@@ -593,7 +593,7 @@ def bit_subtract(bin_name, bit_offset, bit_size, value, sign, action, policy=Non
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_SUBTRACT,
         BIN_KEY: bin_name,
         POLICY_KEY: policy,
@@ -602,7 +602,7 @@ def bit_subtract(bin_name, bit_offset, bit_size, value, sign, action, policy=Non
         VALUE_KEY: value,
         SIGN_KEY: sign,
         ACTION_KEY: action
-    }
+    })
 
 
 def bit_xor(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None):
@@ -623,7 +623,7 @@ def bit_xor(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None)
         A dictionary usable in operate or operate_ordered. The format of the dictionary
         should be considered an internal detail, and subject to change.
     """
-    return {
+    return aerospike.Operation({
         OP_KEY: aerospike.OP_BIT_XOR,
         BIN_KEY: bin_name,
         POLICY_KEY: policy,
@@ -631,4 +631,4 @@ def bit_xor(bin_name, bit_offset, bit_size, value_byte_size, value, policy=None)
         BIT_SIZE_KEY: bit_size,
         VALUE_BYTE_SIZE_KEY: value_byte_size,
         VALUE_KEY: value
-    }
\ No newline at end of file
+    })
\ No newline at end of file
@@ -0,0 +1,287 @@
+'''
+Helper functions to create HyperLogLog operation dictionary arguments for
+the :mod:`aerospike.Client.operate` and :mod:`aerospike.Client.operate_ordered` methods of the aerospike client.
+
+An HLL bin estimates the number of distinct values added to it in a fixed amount of space,
+set by its index bit count, and can be merged with other HLL bins on the server.
+The value of an HLL bin is read as an :class:`aerospike.HyperLogLog`, which may be passed
+to the operations taking a list of HLL values.
+
+    .. note:: HyperLogLog operations require server version >= 4.9.0
+
+Example::
+
+    from __future__ import print_function
+    import aerospike
+    from aerospike import exception as ex
+    from aerospike_helpers.operations import hll_operations
+    import sys
+
+    # Configure the client.
+    config = {"hosts": [("127.0.0.1", 3000)]}
+
+    # Create a client and connect it to the cluster.
+    try:
+        client = aerospike.client(config).connect()
+    except ex.ClientError as e:
+        print("Error: {0} [{1}]".format(e.msg, e.code))
+        sys.exit(1)
+
+    # EXAMPLE 1: count the distinct visitors of two campaigns, and of both.
+    try:
+        for campaign, visitors in [("spring", ["ann", "bob", "cid"]), ("summer", ["bob", "dan"])]:
+            client.operate(("test", "demo", campaign), [
+                hll_operations.hll_add("visitors", visitors, index_bit_count=12)
+            ])
+
+        _, _, bins = client.operate(("test", "demo", "spring"), [
+            hll_operations.hll_get_count("visitors")
+        ])
+        print("EXAMPLE 1, spring visitors:", bins["visitors"])
+
+        _, _, summer = client.get(("test", "demo", "summer"))
+        _, _, bins = client.operate(("test", "demo", "spring"), [
+            hll_operations.hll_get_union_count("visitors", [summer["visitors"]])
+        ])
+        print("EXAMPLE 1, visitors of either campaign:", bins["visitors"])
+    except ex.ClientError as e:
+        print("Error: {0} [{1}]".format(e.msg, e.code))
+        sys.exit(1)
+
+    # Cleanup and close the connection to the Aerospike cluster.
+    client.remove(("test", "demo", "spring"))
+    client.remove(("test", "demo", "summer"))
+    client.close()
+
+    """
+    EXPECTED OUTPUT:
+    EXAMPLE 1, spring visitors: 3
+    EXAMPLE 1, visitors of either campaign: 4
+    """
+
+.. seealso:: `HyperLogLog (Data Types) <https://www.aerospike.com/docs/guide/hyperloglog.html>`_.
+'''
+import aerospike
+
+OP_KEY = "op"
+BIN_KEY = "bin"
+POLICY_KEY = "policy"
+VALUE_LIST_KEY = "value_list"
+INDEX_BIT_COUNT_KEY = "index_bit_count"
+MH_BIT_COUNT_KEY = "mh_bit_count"
+CTX_KEY = "ctx"
+
+
+def _hll_op(op, bin_name, policy=None, ctx=None, **fields):
+    op_dict = {
+        OP_KEY: op,
+        BIN_KEY: bin_name
+    }
+
+    for key, value in fields.items():
+        if value is not None:
+            op_dict[key] = value
+
+    if policy:
+        op_dict[POLICY_KEY] = policy
+
+    if ctx:
+        op_dict[CTX_KEY] = ctx
+
+    return aerospike.Operation(op_dict)
+
+
+def hll_init(bin_name, index_bit_count=None, mh_bit_count=None, policy=None, ctx=None):
+    """Creates an hll_init operation to be used with operate or operate_ordered.
+
+    Create an empty HLL bin, or reset an existing one.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        index_bit_count (int, optional): Number of index bits, between 4 and 16. Sets the
+            size of the HLL and the precision of its counts. default: the server default
+        mh_bit_count (int, optional): Number of min hash bits, between 4 and 51, for more precise
+            intersect counts and similarities. default: None, no min hash bits
+        policy (dict, optional): The HLL policy dictionary. See :ref:`aerospike_hll_policies`. default: None
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_INIT, bin_name, policy, ctx,
+                   index_bit_count=index_bit_count, mh_bit_count=mh_bit_count)
+
+
+def hll_add(bin_name, values, index_bit_count=None, mh_bit_count=None, policy=None, ctx=None):
+    """Creates an hll_add operation to be used with operate or operate_ordered.
+
+    Add values to an HLL bin, creating it with index_bit_count and mh_bit_count if it does not exist.
+    Returns the number of entries of the HLL that changed.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        values (list): The values to be added to the HLL.
+        index_bit_count (int, optional): Number of index bits of the HLL, if it is created. default: None
+        mh_bit_count (int, optional): Number of min hash bits of the HLL, if it is created. default: None
+        policy (dict, optional): The HLL policy dictionary. See :ref:`aerospike_hll_policies`. default: None
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_ADD, bin_name, policy, ctx, value_list=values,
+                   index_bit_count=index_bit_count, mh_bit_count=mh_bit_count)
+
+
+def hll_set_union(bin_name, values, policy=None, ctx=None):
+    """Creates an hll_set_union operation to be used with operate or operate_ordered.
+
+    Set an HLL bin to the union of itself and the given HLLs. The HLLs must have the same
+    index bit count as the bin, unless the policy flags include :data:`aerospike.HLL_WRITE_ALLOW_FOLD`.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        values (list): A list of :class:`aerospike.HyperLogLog` values.
+        policy (dict, optional): The HLL policy dictionary. See :ref:`aerospike_hll_policies`. default: None
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_SET_UNION, bin_name, policy, ctx, value_list=values)
+
+
+def hll_fold(bin_name, index_bit_count, ctx=None):
+    """Creates an hll_fold operation to be used with operate or operate_ordered.
+
+    Fold an HLL bin to a smaller index bit count. The bin must not have min hash bits.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        index_bit_count (int): The new number of index bits, no more than the current one.
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_FOLD, bin_name, None, ctx, index_bit_count=index_bit_count)
+
+
+def hll_refresh_count(bin_name, ctx=None):
+    """Creates an hll_refresh_count operation to be used with operate or operate_ordered.
+
+    Update the cached count of an HLL bin, if it is stale, and return it.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_REFRESH_COUNT, bin_name, None, ctx)
+
+
+def hll_get_count(bin_name, ctx=None):
+    """Creates an hll_get_count operation to be used with operate or operate_ordered.
+
+    Return the estimated number of distinct values added to an HLL bin.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_GET_COUNT, bin_name, None, ctx)
+
+
+def hll_get_union(bin_name, values, ctx=None):
+    """Creates an hll_get_union operation to be used with operate or operate_ordered.
+
+    Return the union of an HLL bin and the given HLLs, as an :class:`aerospike.HyperLogLog`.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        values (list): A list of :class:`aerospike.HyperLogLog` values.
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_GET_UNION, bin_name, None, ctx, value_list=values)
+
+
+def hll_get_union_count(bin_name, values, ctx=None):
+    """Creates an hll_get_union_count operation to be used with operate or operate_ordered.
+
+    Return the estimated number of distinct values in the union of an HLL bin and the given HLLs.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        values (list): A list of :class:`aerospike.HyperLogLog` values.
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_GET_UNION_COUNT, bin_name, None, ctx, value_list=values)
+
+
+def hll_get_intersect_count(bin_name, values, ctx=None):
+    """Creates an hll_get_intersect_count operation to be used with operate or operate_ordered.
+
+    Return the estimated number of distinct values in the intersection of an HLL bin and the given HLLs.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        values (list): A list of up to two :class:`aerospike.HyperLogLog` values.
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_GET_INTERSECT_COUNT, bin_name, None, ctx, value_list=values)
+
+
+def hll_get_similarity(bin_name, values, ctx=None):
+    """Creates an hll_get_similarity operation to be used with operate or operate_ordered.
+
+    Return the estimated Jaccard similarity, a float between 0 and 1, of an HLL bin and the given HLLs.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        values (list): A list of up to two :class:`aerospike.HyperLogLog` values.
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_GET_SIMILARITY, bin_name, None, ctx, value_list=values)
+
+
+def hll_describe(bin_name, ctx=None):
+    """Creates an hll_describe operation to be used with operate or operate_ordered.
+
+    Return the index bit count and the min hash bit count of an HLL bin, as a list.
+
+    Args:
+        bin_name (str): The name of the bin to be operated on.
+        ctx (list, optional): An optional list of nested CDT context objects (cdt_ctx) for use on nested CDTs.
+
+    Returns:
+        A dictionary usable in operate or operate_ordered. The format of the dictionary
+        should be considered an internal detail, and subject to change.
+    """
+    return _hll_op(aerospike.OP_HLL_DESCRIBE, bin_name, None, ctx)
@@ -55,7 +55,7 @@ def list_append(bin_name, value, policy=None, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_append_items(bin_name, values, policy=None, ctx=None):
@@ -85,7 +85,7 @@ def list_append_items(bin_name, values, policy=None, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 def list_insert(bin_name, index, value, policy=None, ctx=None):
     """Creates a list insert operation to be used with operate, or operate_ordered
@@ -117,7 +117,7 @@ def list_insert(bin_name, index, value, policy=None, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 def list_insert_items(bin_name, index, values, policy=None, ctx=None):
     """Creates a list insert items operation to be used with operate, or operate_ordered
@@ -149,7 +149,7 @@ def list_insert_items(bin_name, index, values, policy=None, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 def list_increment(bin_name, index, value, policy=None, ctx=None):
     """Creates a list increment operation to be used with operate, or operate_ordered
@@ -180,7 +180,7 @@ def list_increment(bin_name, index, value, policy=None, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_pop(bin_name, index, ctx=None):
@@ -206,7 +206,7 @@ def list_pop(bin_name, index, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_pop_range(bin_name, index, count, ctx=None):
@@ -235,7 +235,7 @@ def list_pop_range(bin_name, index, count, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove(bin_name, index, ctx=None):
@@ -260,7 +260,7 @@ def list_remove(bin_name, index, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_range(bin_name, index, count, ctx=None):
@@ -288,7 +288,7 @@ def list_remove_range(bin_name, index, count, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_clear(bin_name, ctx=None):
@@ -312,7 +312,7 @@ def list_clear(bin_name, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_set(bin_name, index, value, policy=None, ctx=None):
@@ -343,7 +343,7 @@ def list_set(bin_name, index, value, policy=None, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get(bin_name, index, ctx=None):
@@ -369,7 +369,7 @@ def list_get(bin_name, index, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get_range(bin_name, index, count, ctx=None):
@@ -397,7 +397,7 @@ def list_get_range(bin_name, index, count, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_trim(bin_name, index, count, ctx=None):
@@ -425,7 +425,7 @@ def list_trim(bin_name, index, count, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_size(bin_name, ctx=None):
@@ -449,7 +449,7 @@ def list_size(bin_name, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 # Post 3.4.0 Operations. Require Server >= 3.16.0.1
@@ -481,7 +481,7 @@ def list_get_by_index(bin_name, index, return_type, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get_by_index_range(bin_name, index, return_type, count=None, inverted=False, ctx=None):
@@ -519,7 +519,7 @@ def list_get_by_index_range(bin_name, index, return_type, count=None, inverted=F
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get_by_rank(bin_name, rank, return_type, ctx=None):
@@ -549,7 +549,7 @@ def list_get_by_rank(bin_name, rank, return_type, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get_by_rank_range(bin_name, rank, return_type, count=None, inverted=False, ctx=None):
@@ -587,7 +587,7 @@ def list_get_by_rank_range(bin_name, rank, return_type, count=None, inverted=Fal
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get_by_value(bin_name, value, return_type, inverted=False, ctx=None):
@@ -619,7 +619,7 @@ def list_get_by_value(bin_name, value, return_type, inverted=False, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get_by_value_list(bin_name, value_list, return_type, inverted=False, ctx=None):
@@ -652,7 +652,7 @@ def list_get_by_value_list(bin_name, value_list, return_type, inverted=False, ct
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get_by_value_range(bin_name, return_type, value_begin, value_end, inverted=False, ctx=None):
@@ -691,7 +691,7 @@ def list_get_by_value_range(bin_name, return_type, value_begin, value_end, inver
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_by_index(bin_name, index, return_type, ctx=None):
@@ -721,7 +721,7 @@ def list_remove_by_index(bin_name, index, return_type, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_by_index_range(bin_name, index, return_type, count=None, inverted=False, ctx=None):
@@ -759,7 +759,7 @@ def list_remove_by_index_range(bin_name, index, return_type, count=None, inverte
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_by_rank(bin_name, rank, return_type, ctx=None):
@@ -789,7 +789,7 @@ def list_remove_by_rank(bin_name, rank, return_type, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_by_rank_range(bin_name, rank, return_type, count=None, inverted=False, ctx=None):
@@ -827,7 +827,7 @@ def list_remove_by_rank_range(bin_name, rank, return_type, count=None, inverted=
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_by_value(bin_name, value, return_type, inverted=False, ctx=None):
@@ -860,7 +860,7 @@ def list_remove_by_value(bin_name, value, return_type, inverted=False, ctx=None)
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_by_value_list(bin_name, value_list, return_type, inverted=False, ctx=None):
@@ -894,7 +894,7 @@ def list_remove_by_value_list(bin_name, value_list, return_type, inverted=False,
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_by_value_range(bin_name, return_type, value_begin=None,
@@ -934,7 +934,7 @@ def list_remove_by_value_range(bin_name, return_type, value_begin=None,
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_set_order(bin_name, list_order, ctx=None):
@@ -960,7 +960,7 @@ def list_set_order(bin_name, list_order, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_sort(bin_name, sort_flags=aerospike.LIST_SORT_DEFAULT, ctx=None):
@@ -986,7 +986,7 @@ def list_sort(bin_name, sort_flags=aerospike.LIST_SORT_DEFAULT, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_get_by_value_rank_range_relative(bin_name, value, offset, return_type, count=None,
@@ -1045,7 +1045,7 @@ def list_get_by_value_rank_range_relative(bin_name, value, offset, return_type,
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def list_remove_by_value_rank_range_relative(bin_name, value, offset, return_type, count=None,
@@ -1102,4 +1102,4 @@ def list_remove_by_value_rank_range_relative(bin_name, value, offset, return_typ
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
@@ -46,7 +46,7 @@ def map_set_policy(bin_name, policy, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 def map_put(bin_name, key, value, map_policy=None, ctx=None):
     """Creates a map_put operation to be used with operate or operate_ordered
@@ -78,7 +78,7 @@ def map_put(bin_name, key, value, map_policy=None, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_put_items(bin_name, item_dict, map_policy=None, ctx=None):
@@ -108,7 +108,7 @@ def map_put_items(bin_name, item_dict, map_policy=None, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
     
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 def map_increment(bin_name, key, amount, map_policy=None, ctx=None):
     """Creates a map_increment operation to be used with operate or operate_ordered
@@ -139,7 +139,7 @@ def map_increment(bin_name, key, amount, map_policy=None, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_decrement(bin_name, key, amount, map_policy=None, ctx=None):
@@ -171,7 +171,7 @@ def map_decrement(bin_name, key, amount, map_policy=None, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 def map_size(bin_name, ctx=None):
     """Creates a map_size operation to be used with operate or operate_ordered
@@ -193,7 +193,7 @@ def map_size(bin_name, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_clear(bin_name, ctx=None):
@@ -216,7 +216,7 @@ def map_clear(bin_name, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_key(bin_name, key, return_type, ctx=None):
@@ -244,7 +244,7 @@ def map_remove_by_key(bin_name, key, return_type, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_key_list(bin_name, key_list, return_type, inverted=False, ctx=None):
@@ -275,7 +275,7 @@ def map_remove_by_key_list(bin_name, key_list, return_type, inverted=False, ctx=
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_key_range(bin_name, key_range_start,
@@ -310,7 +310,7 @@ def map_remove_by_key_range(bin_name, key_range_start,
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_value(bin_name, value, return_type, inverted=False, ctx=None):
@@ -341,7 +341,7 @@ def map_remove_by_value(bin_name, value, return_type, inverted=False, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_value_list(bin_name, value_list, return_type, inverted=False, ctx=None):
@@ -372,7 +372,7 @@ def map_remove_by_value_list(bin_name, value_list, return_type, inverted=False,
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_value_range(bin_name, value_start, value_end, return_type, inverted=False, ctx=None):
@@ -406,7 +406,7 @@ def map_remove_by_value_range(bin_name, value_start, value_end, return_type, inv
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_index(bin_name, index, return_type, ctx=None):
@@ -434,7 +434,7 @@ def map_remove_by_index(bin_name, index, return_type, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_index_range(bin_name, index_start, remove_amt, return_type, inverted=False, ctx=None):
@@ -467,7 +467,7 @@ def map_remove_by_index_range(bin_name, index_start, remove_amt, return_type, in
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_rank(bin_name, rank, return_type, ctx=None):
@@ -495,7 +495,7 @@ def map_remove_by_rank(bin_name, rank, return_type, ctx=None):
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_rank_range(bin_name, rank_start, remove_amt, return_type, inverted=False, ctx=None):
@@ -528,7 +528,7 @@ def map_remove_by_rank_range(bin_name, rank_start, remove_amt, return_type, inve
     if ctx is not None:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_key(bin_name, key, return_type, ctx=None):
@@ -556,7 +556,7 @@ def map_get_by_key(bin_name, key, return_type, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_key_range(bin_name, key_range_start,
@@ -591,7 +591,7 @@ def map_get_by_key_range(bin_name, key_range_start,
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_key_list(bin_name, key_list, return_type, inverted=False, ctx=None):
@@ -622,7 +622,7 @@ def map_get_by_key_list(bin_name, key_list, return_type, inverted=False, ctx=Non
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 def map_get_by_value(bin_name, value, return_type, inverted=False, ctx=None):
     """Creates a map_get_by_value operation to be used with operate or operate_ordered
@@ -652,7 +652,7 @@ def map_get_by_value(bin_name, value, return_type, inverted=False, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_value_range(bin_name, value_start, value_end, return_type, inverted=False, ctx=None):
@@ -686,7 +686,7 @@ def map_get_by_value_range(bin_name, value_start, value_end, return_type, invert
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_value_list(bin_name, key_list, return_type, inverted=False, ctx=None):
@@ -717,7 +717,7 @@ def map_get_by_value_list(bin_name, key_list, return_type, inverted=False, ctx=N
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_index(bin_name, index, return_type, ctx=None):
@@ -745,7 +745,7 @@ def map_get_by_index(bin_name, index, return_type, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_index_range(bin_name, index_start, get_amt, return_type, inverted=False, ctx=None):
@@ -778,7 +778,7 @@ def map_get_by_index_range(bin_name, index_start, get_amt, return_type, inverted
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_rank(bin_name, rank, return_type, ctx=None):
@@ -806,7 +806,7 @@ def map_get_by_rank(bin_name, rank, return_type, ctx=None):
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_rank_range(bin_name, rank_start, get_amt, return_type, inverted=False, ctx=None):
@@ -839,7 +839,7 @@ def map_get_by_rank_range(bin_name, rank_start, get_amt, return_type, inverted=F
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 def map_remove_by_value_rank_range_relative(
         bin_name, value, offset, return_type, count=None, inverted=False, ctx=None):
@@ -897,7 +897,7 @@ def map_remove_by_value_rank_range_relative(
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_value_rank_range_relative(
@@ -954,7 +954,7 @@ def map_get_by_value_rank_range_relative(
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_remove_by_key_index_range_relative(
@@ -1014,7 +1014,7 @@ def map_remove_by_key_index_range_relative(
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
 
 
 def map_get_by_key_index_range_relative(
@@ -1074,4 +1074,4 @@ def map_get_by_key_index_range_relative(
     if ctx:
         op_dict[CTX_KEY] = ctx
 
-    return op_dict
+    return aerospike.Operation(op_dict)
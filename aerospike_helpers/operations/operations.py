@@ -19,10 +19,10 @@ def read(bin_name):
         A dictionary to be passed to operate or operate_ordered
     """
 
-    return {
+    return aerospike.Operation({
         "op": aerospike.OPERATOR_READ,
         "bin": bin_name,
-    }
+    })
 
 
 def write(bin_name, write_item):
@@ -36,11 +36,11 @@ def write(bin_name, write_item):
     Returns:
         A dictionary to be passed to operate or operate_ordered
     """
-    return {
+    return aerospike.Operation({
         "op": aerospike.OPERATOR_WRITE,
         "bin": bin_name,
         "val": write_item
-    }
+    })
 
 
 def append(bin_name, append_item):
@@ -54,11 +54,11 @@ def append(bin_name, append_item):
     Returns:
         A dictionary to be passed to operate or operate_ordered
     """
-    return {
+    return aerospike.Operation({
         "op": aerospike.OPERATOR_APPEND,
         "bin": bin_name,
         "val": append_item
-    }
+    })
 
 
 def prepend(bin_name, prepend_item):
@@ -72,11 +72,11 @@ def prepend(bin_name, prepend_item):
     Returns:
         A dictionary to be passed to operate or operate_ordered
     """
-    return {
+    return aerospike.Operation({
         "op": aerospike.OPERATOR_PREPEND,
         "bin": bin_name,
         "val": prepend_item
-    }
+    })
 
 
 def increment(bin_name, amount):
@@ -91,11 +91,11 @@ def increment(bin_name, amount):
     Returns:
         A dictionary to be passed to operate or operate_ordered
     """
-    return {
+    return aerospike.Operation({
         "op": aerospike.OPERATOR_INCR,
         "bin": bin_name,
         "val": amount
-    }
+    })
 
 
 def touch(ttl=None):
@@ -115,4 +115,4 @@ def touch(ttl=None):
         warnings.warn(
             "TTL should be specified in the meta dictionary for operate", DeprecationWarning)
         op_dict["val"] = ttl
-    return op_dict
+    return aerospike.Operation(op_dict)
@@ -0,0 +1,154 @@
+# -*- coding: utf-8 -*-
+##########################################################################
+# Copyright 2013-2020 Aerospike, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+
+from __future__ import print_function
+
+import aerospike
+import sys
+import time
+
+from optparse import OptionParser
+
+##########################################################################
+# Options Parsing
+##########################################################################
+
+usage = "usage: %prog [options]"
+
+optparser = OptionParser(usage=usage, add_help_option=False)
+
+optparser.add_option(
+    "--help", dest="help", action="store_true",
+    help="Displays this message.")
+
+optparser.add_option(
+    "-U", "--username", dest="username", type="string", metavar="<USERNAME>",
+    help="Username to connect to database.")
+
+optparser.add_option(
+    "-P", "--password", dest="password", type="string", metavar="<PASSWORD>",
+    help="Password to connect to database.")
+
+optparser.add_option(
+    "-h", "--host", dest="host", type="string", default="127.0.0.1", metavar="<ADDRESS>",
+    help="Address of Aerospike server.")
+
+optparser.add_option(
+    "-p", "--port", dest="port", type="int", default=3000, metavar="<PORT>",
+    help="Port of the Aerospike server.")
+
+optparser.add_option(
+    "-n", "--namespace", dest="namespace", type="string", default="test", metavar="<NS>",
+    help="Namespace that records will be stored and retrieved from.")
+
+optparser.add_option(
+    "-s", "--set", dest="set", type="string", default="demo", metavar="<SET>",
+    help="Set that records will be stored in.")
+
+optparser.add_option(
+    "-k", "--keys", dest="keys", type="int", default=1000, metavar="<KEYS>",
+    help="Number of distinct keys the records are spread over.")
+
+optparser.add_option(
+    "-o", "--ops", dest="ops", type="int", default=40000, metavar="<OPS>",
+    help="Number of put calls per method.")
+
+
+(options, args) = optparser.parse_args()
+
+if options.help:
+    optparser.print_help()
+    print()
+    sys.exit(1)
+
+##########################################################################
+# Client Configuration
+##########################################################################
+
+config = {
+    'hosts': [(options.host, options.port)]
+}
+
+##########################################################################
+# Benchmarks
+##########################################################################
+
+POLICY_FIELDS = {
+    'key': aerospike.POLICY_KEY_SEND,
+    'exists': aerospike.POLICY_EXISTS_IGNORE,
+    'gen': aerospike.POLICY_GEN_IGNORE,
+    'commit_level': aerospike.POLICY_COMMIT_LEVEL_ALL,
+    'total_timeout': 1000,
+    'socket_timeout': 500,
+    'max_retries': 2
+}
+
+
+def put_no_policy(client, keys):
+    for i in range(options.ops):
+        client.put(keys[i % len(keys)], {'i': i})
+
+
+def put_dict_policy(client, keys):
+    policy = dict(POLICY_FIELDS)
+    for i in range(options.ops):
+        client.put(keys[i % len(keys)], {'i': i}, policy=policy)
+
+
+def put_compiled_policy(client, keys):
+    policy = client.write_policy(**POLICY_FIELDS)
+    for i in range(options.ops):
+        client.put(keys[i % len(keys)], {'i': i}, policy=policy)
+
+
+def run(name, func, client, keys):
+    start = time.time()
+    func(client, keys)
+    elapse = time.time() - start
+
+    print("{0:<24} {1:>10} operations {2:>8.3f} seconds {3:>12.0f} operations/second".format(
+        name, options.ops, elapse, options.ops / elapse if elapse else 0))
+
+##########################################################################
+# Application
+##########################################################################
+
+try:
+    client = aerospike.client(config).connect(
+        options.username, options.password)
+
+    keys = [(options.namespace, options.set, i) for i in range(options.keys)]
+
+    print()
+    run("put (no policy)", put_no_policy, client, keys)
+    run("put (dict policy)", put_dict_policy, client, keys)
+    run("put (compiled policy)", put_compiled_policy, client, keys)
+    print()
+
+    for key in keys:
+        client.remove(key)
+    client.close()
+
+except Exception as eargs:
+    print("error: {0}".format(eargs), file=sys.stderr)
+    sys.exit(2)
+
+##########################################################################
+# Exit
+##########################################################################
+
+sys.exit(0)
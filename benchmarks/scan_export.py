@@ -0,0 +1,193 @@
+# -*- coding: utf-8 -*-
+##########################################################################
+# Copyright 2013-2020 Aerospike, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+
+from __future__ import print_function
+
+import aerospike
+import binascii
+import json
+import os
+import sys
+import tempfile
+import time
+
+from optparse import OptionParser
+
+# pyarrow is optional, the arrow comparison is skipped if it is missing
+try:
+    import pyarrow
+    HAVE_PYARROW = True
+except ImportError:
+    HAVE_PYARROW = False
+
+##########################################################################
+# Options Parsing
+##########################################################################
+
+usage = "usage: %prog [options]"
+
+optparser = OptionParser(usage=usage, add_help_option=False)
+
+optparser.add_option(
+    "--help", dest="help", action="store_true",
+    help="Displays this message.")
+
+optparser.add_option(
+    "-U", "--username", dest="username", type="string", metavar="<USERNAME>",
+    help="Username to connect to database.")
+
+optparser.add_option(
+    "-P", "--password", dest="password", type="string", metavar="<PASSWORD>",
+    help="Password to connect to database.")
+
+optparser.add_option(
+    "-h", "--host", dest="host", type="string", default="127.0.0.1", metavar="<ADDRESS>",
+    help="Address of Aerospike server.")
+
+optparser.add_option(
+    "-p", "--port", dest="port", type="int", default=3000, metavar="<PORT>",
+    help="Port of the Aerospike server.")
+
+optparser.add_option(
+    "-n", "--namespace", dest="namespace", type="string", default="test", metavar="<NS>",
+    help="Namespace that records will be stored and retrieved from.")
+
+optparser.add_option(
+    "-s", "--set", dest="set", type="string", default="demo", metavar="<SET>",
+    help="Set that records will be scanned from.")
+
+optparser.add_option(
+    "-k", "--keys", dest="keys", type="int", default=0, metavar="<KEYS>",
+    help="Number of records to write before scanning. 0 scans the existing set.")
+
+
+(options, args) = optparser.parse_args()
+
+if options.help:
+    optparser.print_help()
+    print()
+    sys.exit(1)
+
+##########################################################################
+# Client Configuration
+##########################################################################
+
+config = {
+    'hosts': [(options.host, options.port)]
+}
+
+##########################################################################
+# Benchmarks
+##########################################################################
+
+
+def export_native(client, path):
+    scan = client.scan(options.namespace, options.set)
+    return scan.export(path)
+
+
+def export_native_arrow(client, path):
+    scan = client.scan(options.namespace, options.set)
+    return scan.export(path, format='arrow_ipc')
+
+
+def export_foreach_json(client, path):
+    count = [0]
+    with open(path, 'w') as out:
+        def write_record(record):
+            key, meta, bins = record
+            out.write(json.dumps({
+                'key': key[2],
+                'digest': binascii.hexlify(bytes(key[3])).decode(),
+                'gen': meta['gen'],
+                'ttl': meta['ttl'],
+                'bins': bins}, default=str))
+            out.write('\n')
+            count[0] += 1
+
+        scan = client.scan(options.namespace, options.set)
+        scan.foreach(write_record)
+    return count[0]
+
+
+def export_foreach_pyarrow(client, path):
+    rows = []
+
+    def add_record(record):
+        rows.append(record[2])
+
+    scan = client.scan(options.namespace, options.set)
+    scan.foreach(add_record)
+
+    names = sorted(set(name for row in rows for name in row))
+    table = pyarrow.Table.from_arrays(
+        [pyarrow.array([row.get(name) for row in rows]) for name in names], names=names)
+    with pyarrow.OSFile(path, 'wb') as sink:
+        writer = pyarrow.RecordBatchFileWriter(sink, table.schema)
+        writer.write_table(table)
+        writer.close()
+    return len(rows)
+
+
+def run(name, func, client):
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        start = time.time()
+        count = func(client, path)
+        elapse = time.time() - start
+        size = os.path.getsize(path)
+    finally:
+        os.remove(path)
+
+    print("{0:<24} {1:>10} records {2:>8.3f} seconds {3:>12.0f} records/second {4:>12} bytes".format(
+        name, count, elapse, count / elapse if elapse else 0, size))
+
+##########################################################################
+# Application
+##########################################################################
+
+try:
+    client = aerospike.client(config).connect(
+        options.username, options.password)
+
+    for i in range(options.keys):
+        client.put((options.namespace, options.set, i),
+                   {'id': i, 'name': 'name%d' % i, 'score': i / 3.0, 'tags': ['a', 'b', i]},
+                   policy={'key': aerospike.POLICY_KEY_SEND})
+
+    print()
+    run("scan.export (ndjson)", export_native, client)
+    run("scan.export (arrow_ipc)", export_native_arrow, client)
+    run("foreach + json", export_foreach_json, client)
+    if HAVE_PYARROW:
+        run("foreach + pyarrow", export_foreach_pyarrow, client)
+    else:
+        print("pyarrow is not installed, skipping the pyarrow comparison")
+    print()
+
+    client.close()
+
+except Exception as eargs:
+    print("error: {0}".format(eargs), file=sys.stderr)
+    sys.exit(2)
+
+##########################################################################
+# Exit
+##########################################################################
+
+sys.exit(0)
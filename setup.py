@@ -30,7 +30,7 @@ os.putenv('ARCHFLAGS', '-arch x86_64')
 os.environ['ARCHFLAGS'] = '-arch x86_64'
 AEROSPIKE_C_VERSION = os.getenv('AEROSPIKE_C_VERSION')
 if not AEROSPIKE_C_VERSION:
-    AEROSPIKE_C_VERSION = '4.6.8'
+    AEROSPIKE_C_VERSION = '4.6.10'
 DOWNLOAD_C_CLIENT = os.getenv('DOWNLOAD_C_CLIENT')
 AEROSPIKE_C_HOME = os.getenv('AEROSPIKE_C_HOME')
 PREFIX = None
@@ -238,22 +238,34 @@ setup(
                 'src/main/client/type.c',
                 'src/main/client/apply.c',
                 'src/main/client/bit_operate.c',
+                'src/main/client/hll_operate.c',
                 'src/main/client/cdt_list_operate.c',
                 'src/main/client/cdt_map_operate.c',
                 'src/main/client/cdt_operation_utils.c',
                 'src/main/client/close.c',
                 'src/main/client/connect.c',
+                'src/main/client/fork.c',
+                'src/main/client/warmup.c',
+                'src/main/client/stats.c',
+                'src/main/client/near_cache.c',
+                'src/main/client/read_routing.c',
+                'src/main/client/hedge.c',
+                'src/main/client/background.c',
                 'src/main/client/exists.c',
                 'src/main/client/exists_many.c',
                 'src/main/client/get.c',
                 'src/main/client/get_many.c',
+                'src/main/client/aggregate_many.c',
                 'src/main/client/select_many.c',
                 'src/main/client/info_node.c',
                 'src/main/client/info.c',
                 'src/main/client/put.c',
+                'src/main/client/update.c',
                 'src/main/client/operate_list.c',
                 'src/main/client/operate_map.c',
                 'src/main/client/operate.c',
+                'src/main/client/counter_buffer.c',
+                'src/main/client/write_queue.c',
                 'src/main/client/query.c',
                 'src/main/client/remove.c',
                 'src/main/client/scan.c',
@@ -263,6 +275,7 @@ setup(
                 'src/main/client/admin.c',
                 'src/main/client/udf.c',
                 'src/main/client/sec_index.c',
+                'src/main/client/compile_policy.c',
                 'src/main/serializer.c',
                 'src/main/client/remove_bin.c',
                 'src/main/client/get_key_digest.c',
@@ -271,13 +284,18 @@ setup(
                 'src/main/query/foreach.c',
                 'src/main/query/predexp.c',
                 'src/main/query/results.c',
+                'src/main/query/page.c',
                 'src/main/query/select.c',
                 'src/main/query/where.c',
                 'src/main/query/execute_background.c',
+                'src/main/query/aggregate.c',
                 'src/main/scan/type.c',
                 'src/main/scan/foreach.c',
                 'src/main/scan/results.c',
                 'src/main/scan/select.c',
+                'src/main/scan/export.c',
+                'src/main/scan/page.c',
+                'src/main/scan/aggregate.c',
                 'src/main/geospatial/type.c',
                 'src/main/geospatial/wrap.c',
                 'src/main/geospatial/unwrap.c',
@@ -288,10 +306,30 @@ setup(
                 'src/main/policy_config.c',
                 'src/main/calc_digest.c',
                 'src/main/predicates.c',
+                'src/main/paging.c',
+                'src/main/throttle.c',
+                'src/main/latency.c',
+                'src/main/trace.c',
                 'src/main/tls_config.c',
                 'src/main/global_hosts/type.c',
                 'src/main/nullobject/type.c',
                 'src/main/cdt_types/type.c',
+                'src/main/columnar/type.c',
+                'src/main/columnar/builder.c',
+                'src/main/columnar/ipc.c',
+                'src/main/job/type.c',
+                'src/main/compiled_ops/type.c',
+                'src/main/operation/type.c',
+                'src/main/compiled_policy/type.c',
+                'src/main/cdt_context/type.c',
+                'src/main/hll/type.c',
+                'src/main/aggregate/reduce.c',
+                'src/main/aggregate/conversions.c',
+                'src/main/counter_buffer/type.c',
+                'src/main/counter_buffer/table.c',
+                'src/main/write_queue/type.c',
+                'src/main/write_queue/command.c',
+                'src/main/multi_client/type.c',
             ],
 
             # Compile
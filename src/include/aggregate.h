@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/as_bin.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+/*******************************************************************************
+ * NATIVE AGGREGATION
+ *
+ * The aggregate() methods of scans and queries, and client.aggregate_many(),
+ * reduce each record as it arrives, on the C client's threads and without the
+ * GIL. Only the reduced values are converted to Python objects, once the
+ * command is done.
+ ******************************************************************************/
+
+enum aerospike_aggregate_types {
+	AGGREGATE_COUNT = 0,
+	AGGREGATE_SUM,
+	AGGREGATE_MIN,
+	AGGREGATE_MAX,
+	AGGREGATE_HISTOGRAM
+};
+
+typedef struct {
+	int64_t start;
+	int64_t count;
+} as_aggregate_bucket;
+
+typedef struct {
+	char * name;                        // key of the value in the result
+	int type;
+	char bin[AS_BIN_NAME_MAX_SIZE];     // empty to count records
+	int64_t bucket_width;
+
+	int64_t count;                      // number of values reduced
+	bool is_double;                     // a float was reduced, the value is d
+	int64_t i;
+	double d;
+
+	// Histogram buckets, sorted by start
+	as_aggregate_bucket * buckets;
+	uint32_t n_buckets;
+	uint32_t buckets_capacity;
+} as_aggregate;
+
+/*
+ * Records may be added from the C client's threads, additions are
+ * serialized by the lock.
+ */
+typedef struct {
+	pthread_mutex_t lock;
+	as_aggregate * aggregates;
+	uint32_t n_aggregates;
+} as_aggregates;
+
+/**
+ * Parse a dict of aggregate name to aggregate spec, as built by
+ * aerospike_helpers.aggregates. The aggregates are destroyed on error.
+ */
+as_status pyobject_to_aggregates(as_error * err, PyObject * py_aggregates, as_aggregates * aggregates);
+
+void as_aggregates_destroy(as_aggregates * aggregates);
+
+/**
+ * The distinct bins read by the aggregates, to select in a batch read.
+ * bins must have room for n_aggregates names.
+ */
+uint32_t as_aggregates_bins(as_aggregates * aggregates, char ** bins);
+
+/**
+ * Reduce a record into every aggregate. Safe to call without the GIL.
+ */
+as_status as_aggregates_add_record(as_aggregates * aggregates, as_error * err, const as_record * rec);
+
+/**
+ * Convert the reduced values to a dict of aggregate name to value.
+ */
+as_status as_aggregates_to_pyobject(as_error * err, as_aggregates * aggregates, PyObject ** py_result);
@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * BACKGROUND OBJECTS
+ *
+ * Jobs, page cursors, write queues and counter buffers run threads of their
+ * own on the cluster of the client. Each is registered with the client for
+ * its lifetime, and client.close() stops them, or lets them drain, before
+ * closing the cluster, so their threads never use a closed one.
+ *
+ * The registry is guarded by the GIL.
+ ******************************************************************************/
+
+/**
+ * Stop the threads of a registered object. Called with the GIL held, which
+ * it may release, and with a reference to the object. May be called again
+ * on a stopped object.
+ */
+typedef void (*as_background_stop_fn)(PyObject * py_obj);
+
+typedef struct as_background_s {
+	struct as_background_s * prev;
+	struct as_background_s * next;
+	PyObject * py_obj;                  // not referenced, NULL unless registered
+	as_background_stop_fn stop;
+} as_background;
+
+typedef struct {
+	as_background * head;
+	bool closing;                       // set while close() runs, objects are not registered
+} as_background_list;
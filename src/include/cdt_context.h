@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+
+#include <aerospike/as_cdt_ctx.h>
+#include <aerospike/as_error.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * COMPILED CDT CONTEXTS
+ *
+ * aerospike.CDTContext holds a list of cdt_ctx objects converted once, by
+ * client.compile_ctx(), into an as_cdt_ctx. An operation with one in its
+ * "ctx" field gets a copy sharing the converted values, in place of the
+ * attribute lookups and value conversions of a list.
+ *
+ * The context is never written once compiled, so an object may be used from
+ * several threads at once.
+ ******************************************************************************/
+
+typedef struct {
+	PyObject_HEAD
+	as_cdt_ctx ctx;
+	as_static_pool * static_pool;   // bytes of the map keys and list values
+	PyObject * py_ctx;              // deep copy of the cdt_ctx list, owning the wrapped bytes
+} AerospikeCDTContext;
+
+extern PyTypeObject AerospikeCDTContext_Type;
+
+PyTypeObject * AerospikeCDTContext_Ready(void);
+
+#define AerospikeCDTContext_Check(__obj) (Py_TYPE(__obj) == &AerospikeCDTContext_Type)
+
+/**
+ * Compile a list of cdt_ctx objects.
+ */
+AerospikeCDTContext * AerospikeCDTContext_New(AerospikeClient * client, as_error * err, PyObject * py_ctx);
+
+/**
+ * Initialize cdt_ctx with the items of the compiled context. The values are
+ * shared, as_cdt_ctx_destroy() releases the copy's references to them.
+ */
+void AerospikeCDTContext_Copy(AerospikeCDTContext * self, as_cdt_ctx * cdt_ctx);
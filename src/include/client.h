@@ -64,6 +64,22 @@ PyObject * AerospikeClient_is_connected(AerospikeClient * self, PyObject * args,
  */
 PyObject * AerospikeClient_shm_key(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
+/**
+ * Get the connection pool statistics of each node.
+ *
+ *		client.stats()
+ *
+ */
+PyObject * AerospikeClient_Stats(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Get the latency histograms of the commands of the client.
+ *
+ *		client.latency_histograms(reset=False)
+ *
+ */
+PyObject * AerospikeClient_Latency_Histograms(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
 
 /*******************************************************************************
  * KVS OPERATIONS
@@ -121,6 +137,15 @@ PyObject * AerospikeClient_Select(AerospikeClient * self, PyObject * args, PyObj
  */
 PyObject * AerospikeClient_Put(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
+/**
+ * Read a record, change its bins with a function and write the changed bins,
+ * retrying on a concurrent change.
+ *
+ *		client.update((x,y,z), fn)
+ *
+ */
+PyObject * AerospikeClient_Update(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
 PyObject * AerospikeClient_Put_Invoke(
 		AerospikeClient * self,
 		PyObject * py_key, PyObject * py_bins, PyObject * py_meta, PyObject * py_policy,
@@ -165,6 +190,20 @@ PyObject * AerospikeClient_Prepend(AerospikeClient * self, PyObject * args, PyOb
  *
  */
 PyObject * AerospikeClient_Increment(AerospikeClient * self, PyObject * args, PyObject * kwds);
+/**
+ * Create a buffer of increments, written in the background.
+ *
+ *		client.counter_buffer(flush_interval_ms, max_keys, on_error)
+ *
+ */
+PyObject * AerospikeClient_Counter_Buffer(AerospikeClient * self, PyObject * args, PyObject * kwds);
+/**
+ * Create a queue of writes, sent in the background.
+ *
+ *		client.write_queue(max_inflight, max_queued, on_error)
+ *
+ */
+PyObject * AerospikeClient_Write_Queue(AerospikeClient * self, PyObject * args, PyObject * kwds);
 /**
  * Touch a record in the database.
  *
@@ -186,6 +225,38 @@ PyObject * AerospikeClient_Operate(AerospikeClient * self, PyObject * args, PyOb
  *
  */
 PyObject * AerospikeClient_OperateOrdered(AerospikeClient * self, PyObject * args, PyObject * kwds);
+/**
+ * Compiles a list of operations for operate and operate_ordered
+ *
+ *		client.compile_ops([x,y,z])
+ *
+ */
+PyObject * AerospikeClient_CompileOps(AerospikeClient * self, PyObject * args, PyObject * kwds);
+/**
+ * Compiles a list of cdt_ctx objects for the ctx of operations
+ *
+ *		client.compile_ctx([x,y,z])
+ *
+ */
+PyObject * AerospikeClient_CompileCtx(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+/*******************************************************************************
+ * COMPILED POLICIES
+ ******************************************************************************/
+/**
+ * Compile a policy for the matching commands
+ *
+ *		client.write_policy(key=aerospike.POLICY_KEY_SEND)
+ *
+ */
+PyObject * AerospikeClient_ReadPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeClient_WritePolicy(AerospikeClient * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeClient_OperatePolicy(AerospikeClient * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeClient_RemovePolicy(AerospikeClient * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeClient_ApplyPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeClient_BatchPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeClient_ScanPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeClient_QueryPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
 /*******************************************************************************
  * LIST FUNCTIONS(CDT)
@@ -404,6 +475,7 @@ PyObject * AerospikeClient_ScanInfo(AerospikeClient * self, PyObject * args, PyO
 AerospikeQuery * AerospikeClient_Query(AerospikeClient * self, PyObject * args, PyObject * kwds);
 PyObject * AerospikeClient_QueryApply(AerospikeClient * self, PyObject * args, PyObject * kwds);
 PyObject * AerospikeClient_JobInfo(AerospikeClient * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeClient_Job(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
 /*******************************************************************************
  * INFO OPERATIONS
@@ -554,6 +626,14 @@ PyObject * AerospikeClient_Get_Many(AerospikeClient * self, PyObject *args, PyOb
  */
 PyObject * AerospikeClient_Select_Many(AerospikeClient * self, PyObject *args, PyObject * kwds);
 
+/**
+ * Reduce a batch of records to the given aggregates
+ *
+ *		client.aggregate_many([keys], aggregates, policies)
+ *
+ */
+PyObject * AerospikeClient_Aggregate_Many(AerospikeClient * self, PyObject *args, PyObject * kwds);
+
 /**
  * Check existence of given keys
  *
@@ -603,6 +683,34 @@ char* return_search_string(aerospike *as);
  * Close the aerospike object depending on the global_hosts entries
  */
 void close_aerospike_object(aerospike *as, as_error *err, char *alias_to_search, PyObject *py_persistent_item, bool do_destroy);
+/**
+ * Register the fork handler which invalidates the clusters inherited by a child.
+ */
+void as_fork_handlers_install(void);
+/**
+ * Connect a new cluster in place of the one inherited from the parent process,
+ * if the client was connected before a fork.
+ */
+as_status AerospikeClient_Check_Fork(AerospikeClient * self, as_error * err);
+/**
+ * Called on each use of the client, or of a Query, Scan, Job, WriteQueue or
+ * CounterBuffer holding it, so a client connected before a fork is reconnected
+ * on its first use in the child. On failure the client is left disconnected,
+ * and its commands raise.
+ */
+void AerospikeClient_Fork_Ready(AerospikeClient * self);
+/**
+ * Register a job, page cursor, write queue or counter buffer with the client
+ * until it is freed, so that close() stops it first. Fails if the client is
+ * not connected, or closing. These must be called with the GIL held.
+ */
+as_status AerospikeClient_Register_Background(AerospikeClient * self, as_error * err,
+		as_background * entry, PyObject * py_obj, as_background_stop_fn stop);
+void AerospikeClient_Unregister_Background(AerospikeClient * self, as_background * entry);
+/**
+ * Stop the registered objects, called by close() before the cluster is closed.
+ */
+void AerospikeClient_Stop_Background(AerospikeClient * self);
 /**
  * Check type for 'operate' operation
  */
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <aerospike/as_bin.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * ARROW C DATA INTERFACE
+ * https://arrow.apache.org/docs/format/CDataInterface.html
+ * These definitions are ABI stable and may be shared with other producers.
+ ******************************************************************************/
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+	const char * format;
+	const char * name;
+	const char * metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema ** children;
+	struct ArrowSchema * dictionary;
+	void (*release)(struct ArrowSchema *);
+	void * private_data;
+};
+
+struct ArrowArray {
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void ** buffers;
+	struct ArrowArray ** children;
+	struct ArrowArray * dictionary;
+	void (*release)(struct ArrowArray *);
+	void * private_data;
+};
+
+#endif
+
+/*******************************************************************************
+ * COLUMN BUILDERS
+ ******************************************************************************/
+
+#define RESULT_FORMAT_COLUMNAR "columnar"
+
+typedef enum {
+	COLUMN_NULL,	// Only nulls seen so far
+	COLUMN_INT64,
+	COLUMN_DOUBLE,
+	COLUMN_UTF8,
+	COLUMN_BINARY,
+	COLUMN_LIST
+} as_column_type;
+
+typedef struct {
+	uint8_t * data;
+	size_t size;
+	size_t capacity;
+} as_column_buffer;
+
+typedef struct as_column_s {
+	char name[AS_BIN_NAME_MAX_SIZE];
+	as_column_type type;
+	int64_t length;
+	int64_t null_count;
+	as_column_buffer validity;
+	// int32 offsets for utf8, binary and list columns
+	as_column_buffer offsets;
+	// Fixed width values, or the character data of utf8 and binary columns
+	as_column_buffer values;
+	// Element column of a list column
+	struct as_column_s * child;
+} as_column;
+
+/*
+ * One column per bin name, all of n_rows length. Records may be appended
+ * from the C client's threads, appends are serialized by the lock.
+ */
+typedef struct {
+	pthread_mutex_t lock;
+	as_column ** columns;
+	uint32_t n_columns;
+	uint32_t capacity;
+	int64_t n_rows;
+} as_columns;
+
+void as_columns_init(as_columns * columns);
+
+void as_columns_destroy(as_columns * columns);
+
+/**
+ * Append a record as a row. A NULL record appends a row of nulls.
+ * Safe to call without the GIL.
+ */
+as_status as_columns_append_record(as_columns * columns, as_error * err, const as_record * rec);
+
+/**
+ * Empty the columns for the next batch of rows.
+ * The columns, their order and their types are kept.
+ */
+void as_columns_reset(as_columns * columns);
+
+/*******************************************************************************
+ * ARROW IPC STREAM WRITER
+ * https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format
+ ******************************************************************************/
+
+/*
+ * Writes as_columns batches as an Arrow IPC stream. The schema is written
+ * with the first batch, later batches must have the same columns and types.
+ */
+typedef struct {
+	FILE * file;
+	// Column types of the schema, depth first, list columns followed by their element type.
+	as_column_type * types;
+	uint32_t n_types;
+	uint32_t n_fields;
+	bool schema_written;
+	// Reused for the flatbuffer metadata of each message.
+	as_column_buffer metadata;
+} as_ipc_writer;
+
+void as_ipc_writer_init(as_ipc_writer * writer, FILE * file);
+
+void as_ipc_writer_destroy(as_ipc_writer * writer);
+
+/**
+ * Write the rows of columns as a record batch and reset the columns.
+ * The first batch also writes the schema. Safe to call without the GIL.
+ */
+as_status as_ipc_write_batch(as_ipc_writer * writer, as_error * err, as_columns * columns);
+
+/**
+ * Write the remaining rows of columns and the end of stream marker.
+ */
+as_status as_ipc_write_end(as_ipc_writer * writer, as_error * err, as_columns * columns);
+
+/*******************************************************************************
+ * PYTHON TYPE
+ ******************************************************************************/
+
+typedef struct {
+	PyObject_HEAD
+	as_columns columns;
+} AerospikeColumnar;
+
+PyTypeObject * AerospikeColumnar_Ready(void);
+
+AerospikeColumnar * AerospikeColumnar_New(void);
+
+/**
+ * Parse the format argument of the result returning APIs.
+ * Sets columnar to true if the columnar format was requested.
+ */
+as_status pyobject_to_result_format(as_error * err, PyObject * py_format, bool * columnar);
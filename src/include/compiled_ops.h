@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_vector.h>
+
+#include "macros.h"
+#include "types.h"
+
+#define AS_COMPILED_OPS_NAME "aerospike.CompiledOperations"
+#define AS_PLACEHOLDER_NAME "aerospike.Placeholder"
+
+/*******************************************************************************
+ * COMPILED OPERATIONS
+ *
+ * A list of operation dicts encoded once into an as_operations. Operations
+ * holding an aerospike.Placeholder are kept as dicts and encoded on each call
+ * with the values passed to operate(), the others are copied into the
+ * command as they are. The encoded binops point at the bytes of the values,
+ * so they are encoded from copies kept by the object.
+ *
+ * The encoded operations are only read once compiled, so an object may be
+ * used from several threads at once.
+ ******************************************************************************/
+
+typedef struct {
+	PyObject * py_op;           // op dict, NULL if the slot is encoded
+	PyObject * py_params;       // list of (dict key, placeholder index) tuples
+} as_compiled_slot;
+
+typedef struct {
+	PyObject_HEAD
+	as_operations ops;          // one binop per slot, empty for the placeholder slots
+	as_static_pool * static_pool;
+	as_vector * unicode_strs;
+	as_compiled_slot * slots;
+	PyObject * py_ops;          // copies of the encoded op dicts, owning their bytes
+	uint32_t size;
+	uint32_t num_params;        // highest placeholder index + 1
+} AerospikeCompiledOps;
+
+typedef struct {
+	PyObject_HEAD
+	uint32_t index;
+} AerospikePlaceholder;
+
+PyTypeObject * AerospikeCompiledOps_Ready(void);
+PyTypeObject * AerospikePlaceholder_Ready(void);
+
+#define AerospikeCompiledOps_Check(__obj) AS_Matches_Classname(__obj, AS_COMPILED_OPS_NAME)
+
+/**
+ * Compile a list of operation dicts.
+ */
+AerospikeCompiledOps * AerospikeCompiledOps_New(AerospikeClient * client, as_error * err, PyObject * py_list);
+
+/**
+ * Fill ops, initialized with a capacity of compiled->size, with the compiled
+ * operations and the placeholder operations encoded with py_values.
+ * Strings and bytes of the placeholder operations are allocated from
+ * unicode_strs and static_pool, as for the operation dicts.
+ */
+as_status compiled_ops_fill(AerospikeClient * client, as_error * err, AerospikeCompiledOps * compiled,
+		PyObject * py_values, as_vector * unicode_strs, as_static_pool * static_pool, as_operations * ops);
+
+/**
+ * Destroy the placeholder operations of ops, leaving the compiled ones to
+ * the compiled object. ops may then be destroyed as usual.
+ */
+void compiled_ops_release(AerospikeCompiledOps * compiled, as_operations * ops);
+
+/**
+ * Encode an operation dict into ops. Defined in client/operate.c.
+ */
+as_status add_op(AerospikeClient * self, as_error * err, PyObject * py_val, as_vector * unicodeStrVector,
+		as_static_pool * static_pool, as_operations * ops, long * op, long * ret_type);
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_predexp.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * COMPILED POLICIES
+ *
+ * aerospike.Policy holds a policy converted once, by client.write_policy()
+ * and the other policy methods, from the client defaults and the given
+ * fields. The pyobject_to_policy_* functions hand out a pointer to it, so a
+ * command passed a compiled policy does no dict lookups for it.
+ *
+ * The policy is never written once compiled, so an object may be used from
+ * several threads at once.
+ ******************************************************************************/
+
+typedef enum {
+	AS_POLICY_KIND_READ,
+	AS_POLICY_KIND_WRITE,
+	AS_POLICY_KIND_OPERATE,
+	AS_POLICY_KIND_REMOVE,
+	AS_POLICY_KIND_APPLY,
+	AS_POLICY_KIND_BATCH,
+	AS_POLICY_KIND_SCAN,
+	AS_POLICY_KIND_QUERY
+} as_policy_kind;
+
+typedef struct {
+	PyObject_HEAD
+	as_policy_kind kind;
+	union {
+		as_policy_read read;
+		as_policy_write write;
+		as_policy_operate operate;
+		as_policy_remove remove;
+		as_policy_apply apply;
+		as_policy_batch batch;
+		as_policy_scan scan;
+		as_policy_query query;
+	} policy;
+	as_predexp_list predexps;   // referenced by the policy if it has a "predexp" field
+	bool has_predexp;
+	uint32_t records_per_second;    // scan and query policies, see throttle.h
+} AerospikePolicy;
+
+extern PyTypeObject AerospikePolicy_Type;
+
+PyTypeObject * AerospikePolicy_Ready(void);
+
+#define AerospikePolicy_Check(__obj) (Py_TYPE(__obj) == &AerospikePolicy_Type)
+
+/**
+ * Compile a policy of the given kind from the client defaults and the fields
+ * in py_fields, a dict or NULL.
+ */
+AerospikePolicy * AerospikePolicy_New(AerospikeClient * client, as_error * err, as_policy_kind kind, PyObject * py_fields);
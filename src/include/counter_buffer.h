@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/as_bin.h>
+#include <aerospike/as_key.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * COUNTER TABLE
+ *
+ * Pending increments, summed per key digest and bin. The table is not
+ * synchronized, the counter buffer serializes access with its lock.
+ ******************************************************************************/
+
+typedef struct {
+	char name[AS_BIN_NAME_MAX_SIZE];
+	int64_t delta;
+} as_counter_bin;
+
+typedef struct as_counter_entry_s {
+	struct as_counter_entry_s * next;
+	as_key key;                         // digest only key
+	as_counter_bin * bins;
+	uint32_t n_bins;
+	uint32_t capacity;
+	bool pinned;                        // in the near cache of the client, until flushed
+} as_counter_entry;
+
+typedef struct {
+	as_counter_entry ** buckets;
+	uint32_t n_buckets;
+	uint32_t n_entries;
+} as_counter_table;
+
+bool as_counter_table_init(as_counter_table * table, uint32_t n_buckets);
+
+void as_counter_table_destroy(as_counter_table * table);
+
+/**
+ * Add delta to the pending increment of bin in the record of key, which must
+ * have its digest computed. Returns the entry of key, or NULL if memory could
+ * not be allocated.
+ */
+as_counter_entry * as_counter_table_add(as_counter_table * table, as_key * key, const char * bin, int64_t delta);
+
+/*******************************************************************************
+ * PYTHON TYPE
+ *
+ * aerospike.CounterBuffer, returned by client.counter_buffer(). Increments
+ * are buffered in the table, and a background thread writes each key's
+ * increments as one operate command every flush interval, or once max_keys
+ * keys are pending.
+ *
+ * In a child forked while increments were pending, they are left to the
+ * parent to write, and the flush thread is started again on first use.
+ ******************************************************************************/
+
+typedef struct {
+	PyObject_HEAD
+	AerospikeClient * client;
+	PyObject * on_error;                // called with (key, bins, exception)
+
+	uint32_t flush_interval_ms;         // 0 for no periodic flush
+	uint32_t max_keys;                  // 0 for no size threshold
+
+	pthread_mutex_t lock;               // guards table, flush_requested and closing
+	pthread_cond_t cond;
+	as_counter_table table;
+	bool flush_requested;
+	bool closing;
+
+	pthread_mutex_t flush_lock;         // keeps flushes in order
+	pthread_t thread;
+	bool thread_started;
+	uint32_t fork_generation;           // of the process running the flush thread
+
+	as_background background;           // closed by client.close(), once flushed
+} AerospikeCounterBuffer;
+
+PyTypeObject * AerospikeCounterBuffer_Ready(void);
+
+AerospikeCounterBuffer * AerospikeCounterBuffer_New(AerospikeClient * client, as_error * err,
+		uint32_t flush_interval_ms, uint32_t max_keys, PyObject * on_error);
@@ -44,6 +44,7 @@ struct exceptions {
 	PyObject *ScanAbortedError; //15
 	PyObject *ElementNotFoundError; //23
 	PyObject *ElementExistsError; //24
+	PyObject *FilteredOut; //27
 	PyObject *BatchDisabledError; //150
 	PyObject *BatchMaxRequestError; //151
 	PyObject *BatchQueueFullError; //152
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_record.h>
+
+#include "latency.h"
+
+/*******************************************************************************
+ * HEDGED READS
+ *
+ * A read with a hedge_delay or hedge_percentile in its policy is run by a
+ * worker thread of the client while the caller waits, ahead of the hedges
+ * queued for other reads. If it has not answered
+ * after the delay, the same read is sent by another worker with the ANY
+ * replica policy, and the caller returns whichever answers first. A timeout
+ * or connection error of one read waits for the other.
+ *
+ * Sync commands can not be interrupted, so the losing read runs to its end in
+ * its worker, within what was left of the total timeout, and its result is
+ * dropped. Workers are started on demand, up to AS_HEDGE_MAX_THREADS, and the
+ * reads they share with the caller are freed by the last one done with them.
+ ******************************************************************************/
+
+#define AS_HEDGE_MAX_THREADS 64
+
+// Delay of the reads going through the workers only to record their latency
+#define AS_HEDGE_NEVER UINT32_MAX
+
+typedef struct as_hedge_task_s as_hedge_task;
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;                // signalled when a task is queued
+	pthread_t threads[AS_HEDGE_MAX_THREADS];
+	uint32_t n_threads;
+	uint32_t n_idle;
+	uint32_t n_queued;
+	bool stopping;
+	as_hedge_task * head;
+	as_hedge_task * tail;
+
+	// Under the lock
+	uint64_t reads;
+	uint64_t issued;
+	uint64_t won;
+	as_latency_histogram latency;
+} as_hedger;
+
+void as_hedger_init(as_hedger * hedger);
+
+/**
+ * The hedger must be stopped.
+ */
+void as_hedger_destroy(as_hedger * hedger);
+
+/**
+ * Wait for the queued and running reads, then join the workers. Must be
+ * called without the GIL.
+ */
+void as_hedger_stop(as_hedger * hedger);
+
+/**
+ * Forget the workers of the parent process, which do not exist in a forked
+ * child. Must only be called in the child.
+ */
+void as_hedger_after_fork(as_hedger * hedger);
+
+/**
+ * The hedge delay of a read from the hedge_delay and hedge_percentile of its
+ * policy dict: 0 if it is not hedged, or AS_HEDGE_NEVER while too few reads
+ * were recorded for the percentile. Reads with predexps are not hedged. The
+ * GIL must be held.
+ */
+as_status as_hedge_delay(as_hedger * hedger, as_error * err, PyObject * py_policy,
+		const as_policy_read * policy, uint32_t * delay_ms);
+
+/**
+ * Get key, or select bins of key if bins is not NULL, hedging after delay_ms.
+ * *rec is owned by the caller. Must be called without the GIL.
+ */
+void as_hedge_read(as_hedger * hedger, aerospike * as, as_error * err, const as_policy_read * policy,
+		const as_key * key, const char ** bins, uint32_t delay_ms, as_record ** rec);
+
+/**
+ * The counters, as a dict.
+ */
+PyObject * as_hedger_stats(as_hedger * hedger);
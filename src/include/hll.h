@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * HYPERLOGLOG VALUES
+ *
+ * aerospike.HyperLogLog is a bytes subclass for the value of an HLL bin. HLL
+ * values read from the server are returned as one, and one given as a bin or
+ * operation value is sent as an HLL rather than as a blob.
+ ******************************************************************************/
+
+extern PyTypeObject AerospikeHyperLogLog_Type;
+
+PyTypeObject * AerospikeHyperLogLog_Ready(void);
+
+#define AerospikeHyperLogLog_Check(__obj) PyObject_TypeCheck(__obj, &AerospikeHyperLogLog_Type)
+
+/**
+ * Create an aerospike.HyperLogLog holding a copy of size bytes of value.
+ */
+PyObject * AerospikeHyperLogLog_New(const uint8_t * value, uint32_t size);
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/aerospike_index.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_job.h>
+#include <aerospike/as_policy.h>
+
+#include "types.h"
+
+// Module of the jobs tracking a secondary index build
+#define JOB_MODULE_SINDEX "sindex"
+
+/*
+ * A background job on the cluster. A thread polls the nodes, all at once,
+ * with exponential backoff until the job completes, so callers read the last
+ * known progress without a round trip.
+ */
+typedef struct {
+	PyObject_HEAD
+	AerospikeClient * client;
+	char module[16];
+	uint64_t job_id;
+	as_index_task task;
+	as_policy_info policy;
+
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	bool started;
+	uint32_t fork_generation;           // as_fork_generation when the thread was started
+	bool done;
+	bool cancelled;
+	as_job_info info;
+	as_error err;
+
+	// (loop, future, job) of the coroutines awaiting the job
+	PyObject * py_waiters;
+
+	as_background background;           // stopped by client.close(), failing the job if running
+} AerospikeJob;
+
+PyTypeObject * AerospikeJob_Ready(void);
+
+/**
+ * Create a job for a background scan or query, module is "scan" or "query".
+ * Starts polling immediately.
+ */
+AerospikeJob * AerospikeJob_New(AerospikeClient * client, as_error * err, const char * module,
+		uint64_t job_id, const as_policy_info * policy);
+
+/**
+ * Create a job for the build of a secondary index. Starts polling immediately.
+ */
+AerospikeJob * AerospikeJob_New_Index(AerospikeClient * client, as_error * err, const as_index_task * task,
+		const as_policy_info * policy);
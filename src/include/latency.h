@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <aerospike/as_error.h>
+
+/*******************************************************************************
+ * LATENCY HISTOGRAMS
+ *
+ * Per client histograms of the time commands spend converting their Python
+ * arguments to C (to_c), in the C client with the GIL released (in_c, which
+ * includes taking the GIL back), and converting the results to Python
+ * (to_python). Samples are only recorded with the GIL held, so the buckets
+ * are plain counters.
+ *
+ * Buckets are log-linear, as in HDR histograms: each power of two of
+ * nanoseconds is split in AS_LATENCY_SUB_BUCKETS, so a bucket is at most 25%
+ * wider than its lower bound.
+ ******************************************************************************/
+
+#define AS_LATENCY_CONFIG_KEY "latency_histograms"
+
+#define AS_LATENCY_SUB_BUCKET_BITS 2
+#define AS_LATENCY_SUB_BUCKETS (1 << AS_LATENCY_SUB_BUCKET_BITS)
+#define AS_LATENCY_BUCKETS (64 * AS_LATENCY_SUB_BUCKETS)
+
+typedef enum {
+	AS_LATENCY_GET,
+	AS_LATENCY_PUT,
+	AS_LATENCY_OPERATE,
+	AS_LATENCY_BATCH,
+	AS_LATENCY_SCAN,
+	AS_LATENCY_QUERY,
+	AS_LATENCY_APPLY,
+	AS_LATENCY_INFO,
+	AS_LATENCY_COMMANDS
+} as_latency_command;
+
+typedef enum {
+	AS_LATENCY_TO_C,
+	AS_LATENCY_IN_C,
+	AS_LATENCY_TO_PYTHON,
+	AS_LATENCY_PHASES
+} as_latency_phase;
+
+typedef struct {
+	uint64_t count;
+	uint64_t total_ns;
+	uint64_t max_ns;
+	uint64_t buckets[AS_LATENCY_BUCKETS];
+} as_latency_histogram;
+
+typedef struct {
+	as_latency_histogram histograms[AS_LATENCY_COMMANDS][AS_LATENCY_PHASES];
+} as_latency;
+
+/**
+ * The phases of one command. A timer of a client without histograms does
+ * nothing.
+ */
+typedef struct {
+	as_latency * latency;
+	as_latency_command command;
+	uint64_t mark_ns;
+} as_latency_timer;
+
+static inline uint64_t as_latency_now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+}
+
+static inline uint32_t as_latency_bucket(uint64_t ns)
+{
+	if (ns < AS_LATENCY_SUB_BUCKETS) {
+		return (uint32_t) ns;
+	}
+
+	uint32_t exp = 63 - __builtin_clzll(ns);
+	uint32_t sub = (uint32_t) (ns >> (exp - AS_LATENCY_SUB_BUCKET_BITS)) & (AS_LATENCY_SUB_BUCKETS - 1);
+	return (exp - AS_LATENCY_SUB_BUCKET_BITS + 1) * AS_LATENCY_SUB_BUCKETS + sub;
+}
+
+/**
+ * Start timing a command, the GIL must be held.
+ */
+static inline void as_latency_timer_start(as_latency_timer * timer, as_latency * latency, as_latency_command command)
+{
+	timer->latency = latency;
+	timer->command = command;
+	timer->mark_ns = latency ? as_latency_now_ns() : 0;
+}
+
+/**
+ * Record the time since the previous mark as the phase, the GIL must be held.
+ */
+static inline void as_latency_timer_mark(as_latency_timer * timer, as_latency_phase phase)
+{
+	if (!timer->latency) {
+		return;
+	}
+
+	uint64_t now = as_latency_now_ns();
+	uint64_t ns = now - timer->mark_ns;
+	as_latency_histogram * histogram = &timer->latency->histograms[timer->command][phase];
+
+	histogram->count++;
+	histogram->total_ns += ns;
+	if (ns > histogram->max_ns) {
+		histogram->max_ns = ns;
+	}
+	histogram->buckets[as_latency_bucket(ns)]++;
+	timer->mark_ns = now;
+}
+
+const char * as_latency_command_name(as_latency_command command);
+
+/**
+ * Allocate zeroed histograms, NULL if out of memory.
+ */
+as_latency * as_latency_new(void);
+
+void as_latency_destroy(as_latency * latency);
+
+/**
+ * The upper bound of the bucket holding the percentile, 0 without samples.
+ */
+uint64_t as_latency_percentile_ns(const as_latency_histogram * histogram, double percentile);
+
+/**
+ * The histograms as a dict of the phases by command, the buckets with samples
+ * as a list of (lower_ns, upper_ns, count). Zeroes them if reset.
+ */
+PyObject * as_latency_to_pyobject(as_error * err, as_latency * latency, bool reset);
@@ -60,3 +60,8 @@ PyObject * Aerospike_Set_Log_Level(PyObject *parent, PyObject *args, PyObject *
  *          aerospike.set_log_handler( log_callback )
  */
 PyObject * Aerospike_Set_Log_Handler(PyObject *parent, PyObject *args, PyObject * kwds);
+
+/**
+ * Reset the log ring buffer in a forked child, from the atfork handler
+ */
+void as_log_after_fork(void);
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * MULTI-CLUSTER CLIENT
+ *
+ * aerospike.MultiClient, returned by aerospike.multi_client(). It holds one
+ * client per cluster config, in order of preference, and sends each command
+ * to them from C:
+ *
+ * - reads go to the first available cluster, and to the next one if it times
+ *   out or is unavailable;
+ * - writes go by the write mode: to the first available cluster, falling back
+ *   only when the write was not sent, to the first cluster only, or to every
+ *   available cluster.
+ *
+ * A cluster failing failure_threshold commands in a row, or failing to
+ * connect, is skipped for retry_interval ms, after which it is tried again,
+ * and reconnected first if needed. While every cluster is skipped, they are
+ * all tried. The state is only used with the GIL held.
+ ******************************************************************************/
+
+#define AS_MULTI_CLIENT_DEFAULT_FAILURE_THRESHOLD 3
+#define AS_MULTI_CLIENT_DEFAULT_RETRY_INTERVAL_MS 5000
+
+typedef enum {
+	AS_MULTI_WRITE_PREFERRED,           // first available cluster, next one if not sent
+	AS_MULTI_WRITE_PREFERRED_ONLY,      // first cluster, left to XDR to ship
+	AS_MULTI_WRITE_ALL                  // every available cluster
+} as_multi_write_mode;
+
+typedef struct {
+	AerospikeClient * client;
+	uint64_t reads;
+	uint64_t writes;
+	uint64_t failures;
+	uint64_t fallbacks;                 // commands sent to another cluster after failing here
+	uint32_t consecutive_failures;
+	uint64_t down_until_ms;             // skipped until then, 0 while available
+} as_multi_cluster;
+
+typedef struct {
+	PyObject_HEAD
+	as_multi_cluster * clusters;
+	uint32_t n_clusters;
+	as_multi_write_mode write_mode;
+	uint32_t failure_threshold;
+	uint32_t retry_interval_ms;
+	bool connected;
+	PyObject * py_username;             // of connect(), to reconnect clusters
+	PyObject * py_password;
+} AerospikeMultiClient;
+
+PyTypeObject * AerospikeMultiClient_Ready(void);
+
+/**
+ * aerospike.multi_client(config): a client per config of config['clusters'].
+ */
+AerospikeMultiClient * AerospikeMultiClient_New(PyObject * parent, PyObject * args, PyObject * kwds);
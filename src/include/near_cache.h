@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_record.h>
+
+/*******************************************************************************
+ * NEAR CACHE
+ *
+ * Per client cache of the records read by get(), keyed by namespace and
+ * digest, holding at most max_entries records and evicting the least
+ * recently used. An entry expires with its record, or after ttl seconds if
+ * that is sooner.
+ *
+ * In the default "trust" mode, an entry is returned without contacting the
+ * server. In "validate" mode, a metadata only read checks the generation of
+ * the record first, and the entry is only returned if it did not change.
+ *
+ * Writes of the client to a key drop its entry; writes of other clients are
+ * only seen in validate mode, or once the entry expires. Writes sent later by
+ * a background thread also pin their key until sent, so a get() meanwhile
+ * does not cache the record read before them. Only used with the GIL held,
+ * except the pins.
+ *
+ * Cached bins are copied, lists, maps and bytearrays deeply, on the way in
+ * and out, so neither the caller nor the cache see changes of the other.
+ ******************************************************************************/
+
+#define AS_NEAR_CACHE_CONFIG_KEY "near_cache"
+
+typedef struct as_near_cache_entry_s as_near_cache_entry;
+
+typedef struct {
+	bool validate;
+	uint32_t max_entries;
+	uint32_t ttl_ms;                    // 0 if entries live as long as their record
+	uint32_t size;
+	uint32_t n_buckets;                 // a power of 2
+	as_near_cache_entry ** buckets;
+	as_near_cache_entry * head;         // most recently used
+	as_near_cache_entry * tail;
+	uint32_t * pins;                    // per bucket, writes in flight to its keys
+	uint32_t * unpins;                  // per bucket, writes done, to spot those racing a get
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t stale;                     // misses of validate mode with an older entry
+	uint64_t evictions;
+	uint64_t expirations;
+	uint64_t invalidations;
+} as_near_cache;
+
+/**
+ * Create a cache from the near_cache dict of the client config:
+ * {'max_entries': int, 'ttl': seconds, 'mode': 'trust' or 'validate'}.
+ */
+as_status as_near_cache_new(as_error * err, PyObject * py_config, as_near_cache ** cache);
+
+void as_near_cache_destroy(as_near_cache * cache);
+
+/**
+ * Serve a get from the cache. Returns false if the record must be read, or
+ * true if py_rec was set from the cache, or err from its validation.
+ * The GIL is released while validating. epoch is set for as_near_cache_put.
+ */
+bool as_near_cache_get(as_near_cache * cache, aerospike * as, as_error * err,
+		as_policy_read * policy, as_key * key, uint32_t * epoch, PyObject ** py_rec);
+
+/**
+ * Cache the record read by a get, as converted to py_rec, unless a write to
+ * its key was pinned, or completed, since as_near_cache_get set epoch.
+ */
+void as_near_cache_put(as_near_cache * cache, as_key * key, uint32_t epoch, const as_record * rec,
+		PyObject * py_rec);
+
+/**
+ * Drop the entry of a key written by the client, and count the write done so
+ * that a get in flight does not cache what it read before. Does nothing
+ * without cache.
+ */
+void as_near_cache_invalidate(as_near_cache * cache, as_key * key);
+
+/**
+ * Count a write to key in flight, until as_near_cache_unpin(). Its entry is
+ * not dropped, see as_near_cache_invalidate(). Does nothing without cache,
+ * and may be called without the GIL, as may as_near_cache_unpin().
+ */
+void as_near_cache_pin(as_near_cache * cache, as_key * key);
+
+void as_near_cache_unpin(as_near_cache * cache, as_key * key);
+
+/**
+ * Forget the pins of the writes of the parent, which the child never sends.
+ * Must only be called in the child.
+ */
+void as_near_cache_after_fork(as_near_cache * cache);
+
+/**
+ * Drop every entry, as after a truncate, and keep the gets in flight from
+ * caching their records. Does nothing without cache.
+ */
+void as_near_cache_clear(as_near_cache * cache);
+
+/**
+ * The counters of the cache, as a dict.
+ */
+PyObject * as_near_cache_stats(as_near_cache * cache);
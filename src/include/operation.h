@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * OPERATIONS
+ *
+ * aerospike.Operation is the immutable dict returned by the aerospike_helpers
+ * operation functions. The entries read by every operation are also held in
+ * fixed slots, filled once when the operation is created, so encoding an
+ * operation reads them without hashing the dict. The other entries are read
+ * from a private copy made then, so an operation changed through the methods
+ * of dict itself, like dict.update(op, ...), still runs as created.
+ *
+ * Plain dicts are still accepted everywhere an operation is, the accessors
+ * below fall back to a dict lookup for them.
+ ******************************************************************************/
+
+typedef enum {
+	AS_OP_FIELD_BIN,
+	AS_OP_FIELD_VAL,
+	AS_OP_FIELD_CTX,
+	AS_OP_FIELD_POLICY,         // list_policy, map_policy or policy
+	AS_OP_FIELD_RETURN_TYPE,
+	AS_OP_FIELD_INVERTED,
+	AS_OP_FIELD_COUNT
+} as_operation_field;
+
+typedef struct {
+	PyDictObject dict;
+	long op;
+	bool has_op;                // false if "op" is missing or not an int
+	PyObject * fields[AS_OP_FIELD_COUNT];
+	PyObject * py_entries;      // the entries as created, NULL until initialised
+} AerospikeOperation;
+
+extern PyTypeObject AerospikeOperation_Type;
+
+PyTypeObject * AerospikeOperation_Ready(void);
+
+#define AerospikeOperation_Check(__obj) (Py_TYPE(__obj) == &AerospikeOperation_Type)
+
+/**
+ * Return a borrowed reference to an entry of an operation, or NULL if the
+ * operation does not have it. key is only looked up for plain dicts.
+ */
+static inline PyObject * operation_get(PyObject * op_dict, as_operation_field field, const char * key)
+{
+	if (AerospikeOperation_Check(op_dict)) {
+		return ((AerospikeOperation *) op_dict)->fields[field];
+	}
+	return PyDict_GetItemString(op_dict, key);
+}
+
+/**
+ * Return a borrowed reference to any entry of an operation, or NULL if the
+ * operation does not have it.
+ */
+static inline PyObject * operation_get_entry(PyObject * op_dict, const char * key)
+{
+	if (AerospikeOperation_Check(op_dict)) {
+		PyObject * py_entries = ((AerospikeOperation *) op_dict)->py_entries;
+		return py_entries ? PyDict_GetItemString(py_entries, key) : NULL;
+	}
+	return PyDict_GetItemString(op_dict, key);
+}
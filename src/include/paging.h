@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdint.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_predexp.h>
+#include <aerospike/as_query.h>
+#include <aerospike/as_scan.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * PAGE CURSORS
+ *
+ * A cursor runs a query or scan on its own thread and hands the results to
+ * the caller one page at a time. The producing thread blocks once a page is
+ * full, so at most one page of records is buffered per cursor.
+ *
+ * Cursors are kept in a dict on the Query or Scan object, keyed by an opaque
+ * token. A token is only valid on the object, and in the process, that
+ * issued it. A cursor runs on a copy of the query or scan, and stops once
+ * its page is not taken for a minute.
+ ******************************************************************************/
+
+typedef struct as_page_cursor_s as_page_cursor;
+
+/**
+ * Create a cursor over a copy of the query. The cursor holds a reference to
+ * the client, the throttle must outlive the cursor.
+ */
+as_page_cursor * as_page_cursor_query(AerospikeClient * client, const as_query * query,
+		const as_policy_query * policy, as_throttle * throttle);
+
+/**
+ * Create a cursor over a copy of the scan, optionally limited to a node.
+ * The cursor holds a reference to the client, the throttle must outlive the
+ * cursor. The cursor takes over predexps if the policy refers to them, and
+ * holds a reference to py_policy.
+ */
+as_page_cursor * as_page_cursor_scan(AerospikeClient * client, const as_scan * scan,
+		PyObject * py_policy, const as_policy_scan * policy, as_predexp_list * predexps,
+		const char * nodename, as_throttle * throttle);
+
+/**
+ * Return the next page of at most max_records results as a (records, token)
+ * tuple. The token is None once the results are exhausted.
+ *
+ * If py_token is None, new_cursor is started and registered in py_cursors,
+ * which is created if needed. Otherwise new_cursor must be NULL and the
+ * cursor registered under py_token is resumed.
+ */
+PyObject * page_cursor_next(as_error * err, PyObject ** py_cursors, PyObject * py_token,
+		uint32_t max_records, as_page_cursor * new_cursor);
+
+/**
+ * Parse the max_records argument of the page methods.
+ */
+as_status pyobject_to_max_records(as_error * err, PyObject * py_max_records, uint32_t * max_records);
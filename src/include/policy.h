@@ -22,6 +22,8 @@
 #include <aerospike/as_map_operations.h>
 #include <aerospike/as_list_operations.h>
 #include <aerospike/as_bit_operations.h>
+#include <aerospike/as_hll_operations.h>
+#include <aerospike/as_predexp.h>
 
 #define MAX_CONSTANT_STR_SIZE 512
 
@@ -129,6 +131,20 @@ enum aerospike_bitwise_operations {
     OP_BIT_RSCAN
 };
 
+enum aerospike_hll_operations {
+    OP_HLL_INIT = 2100,
+    OP_HLL_ADD,
+    OP_HLL_GET_COUNT,
+    OP_HLL_GET_UNION,
+    OP_HLL_GET_UNION_COUNT,
+    OP_HLL_GET_INTERSECT_COUNT,
+    OP_HLL_GET_SIMILARITY,
+    OP_HLL_DESCRIBE,
+    OP_HLL_FOLD,
+    OP_HLL_REFRESH_COUNT,
+    OP_HLL_SET_UNION
+};
+
 typedef struct Aerospike_Constants {
     long    constantno;
     char    constant_str[MAX_CONSTANT_STR_SIZE];
@@ -149,7 +165,8 @@ as_status pyobject_to_policy_admin(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_apply(as_error * err, PyObject * py_policy,
 									as_policy_apply * policy,
 									as_policy_apply ** policy_p,
-									as_policy_apply * config_apply_policy);
+									as_policy_apply * config_apply_policy,
+									as_predexp_list * predexp_list);
 
 as_status pyobject_to_policy_info(as_error * err, PyObject * py_policy,
 									as_policy_info * policy,
@@ -164,32 +181,38 @@ as_status pyobject_to_policy_query(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_read(as_error * err, PyObject * py_policy,
 									as_policy_read * policy,
 									as_policy_read ** policy_p,
-									as_policy_read * config_read_policy);
+									as_policy_read * config_read_policy,
+									as_predexp_list * predexp_list);
 
 as_status pyobject_to_policy_remove(as_error * err, PyObject * py_policy,
 									as_policy_remove * policy,
 									as_policy_remove ** policy_p,
-									as_policy_remove * config_remove_policy);
+									as_policy_remove * config_remove_policy,
+									as_predexp_list * predexp_list);
 
 as_status pyobject_to_policy_scan(as_error * err, PyObject * py_policy,
 									as_policy_scan * policy,
 									as_policy_scan ** policy_p,
-									as_policy_scan * config_scan_policy);
+									as_policy_scan * config_scan_policy,
+									as_predexp_list * predexp_list);
 
 as_status pyobject_to_policy_write(as_error * err, PyObject * py_policy,
 									as_policy_write * policy,
 									as_policy_write ** policy_p,
-									as_policy_write * config_write_policy);
+									as_policy_write * config_write_policy,
+									as_predexp_list * predexp_list);
 
 as_status pyobject_to_policy_operate(as_error * err, PyObject * py_policy,
                                     as_policy_operate * policy,
                                     as_policy_operate ** policy_p,
-									as_policy_operate * config_operate_policy);
+									as_policy_operate * config_operate_policy,
+									as_predexp_list * predexp_list);
 
 as_status pyobject_to_policy_batch(as_error * err, PyObject * py_policy,
                                    as_policy_batch * policy,
                                    as_policy_batch ** policy_p,
-								   as_policy_batch * config_batch_policy);
+								   as_policy_batch * config_batch_policy,
+									as_predexp_list * predexp_list);
 
 as_status pyobject_to_map_policy(as_error * err, PyObject * py_policy,
 									as_map_policy * policy);
@@ -204,3 +227,5 @@ as_status pyobject_to_list_policy(as_error * err, PyObject * py_policy,
 									as_list_policy * policy);
 
 as_status pyobject_to_bit_policy(as_error* err, PyObject* py_policy, as_bit_policy* policy);
+
+as_status pyobject_to_hll_policy(as_error* err, PyObject* py_policy, as_hll_policy* policy);
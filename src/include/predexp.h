@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_predexp.h>
+
+/**
+ * Convert a list of aerospike.predexp tuples into predexps, in order.
+ * On success predexps is initialized and owned by the caller, on error
+ * there is nothing to destroy.
+ */
+as_status pyobject_to_predexp_list(as_error* err, PyObject* py_predicates, as_predexp_list* predexps);
+
+/**
+ * Destroy the predexps of a command, if the policy it used was converted
+ * from a dict with a "predexp" entry. A compiled policy keeps its own.
+ */
+#define PREDEXP_LIST_DESTROY(__policy_p, __predexps) \
+	do {\
+		if ((__policy_p) && (__policy_p)->base.predexp == (__predexps)) {\
+			as_predexp_list_destroy(__predexps);\
+		}\
+	} while (0)
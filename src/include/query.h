@@ -94,6 +94,25 @@ PyObject * AerospikeQuery_Foreach(AerospikeQuery * self, PyObject * args, PyObje
  */
 PyObject * AerospikeQuery_Results(AerospikeQuery * self, PyObject * args, PyObject * kwds);
 
+/**
+ * Execute the query and return its results a page at a time.
+ *
+ *		records, token = query.page(1000)
+ *		while token:
+ *			records, token = query.page(1000, token)
+ *
+ */
+PyObject * AerospikeQuery_Page(AerospikeQuery * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Execute the query and reduce its records to the given aggregates,
+ * without converting them to Python objects.
+ *
+ *		query.aggregate({'total': aggregates.sum('views')})
+ *
+ */
+PyObject * AerospikeQuery_Aggregate(AerospikeQuery * self, PyObject * args, PyObject * kwds);
+
 /**
  * Execute a UDF in the background. Returns the query id to allow status of the query to be monitored
  * */
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_node.h>
+#include <aerospike/as_policy.h>
+
+#include "latency.h"
+
+/*******************************************************************************
+ * LATENCY AWARE READS
+ *
+ * A thread times a small info request to each node every tend interval, and
+ * keeps an EWMA of it per node. A node is degraded when its EWMA is more than
+ * degraded_factor times the median of the nodes.
+ *
+ * While a node is degraded, single record reads are sent with the SEQUENCE
+ * replica policy and a socket timeout of the given percentile of their recent
+ * latency, so a read its master has not answered by then is retried on the
+ * next replica rather than waiting for the slow node. With every node
+ * healthy, reads use their policy as it is, so a cluster which is slow as a
+ * whole does not get retries on top of its load.
+ *
+ * The read latencies are only recorded with the GIL held, the node EWMAs are
+ * guarded by the lock.
+ ******************************************************************************/
+
+#define AS_READ_ROUTER_CONFIG_KEY "latency_aware_reads"
+
+// Nodes followed, the others are never considered degraded.
+#define AS_READ_ROUTER_MAX_NODES 128
+
+typedef struct {
+	char name[AS_NODE_NAME_MAX_SIZE];
+	uint64_t ewma_us;
+	bool degraded;
+} as_read_router_node;
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	pthread_t thread;
+	bool started;
+	bool stopping;
+	aerospike * as;
+
+	// Config
+	double percentile;
+	uint32_t min_delay_ms;
+	double degraded_factor;
+
+	// Written by the thread, under the lock
+	as_read_router_node nodes[AS_READ_ROUTER_MAX_NODES];
+	uint32_t n_nodes;
+	volatile bool degraded;
+
+	// Read latencies, under the GIL
+	as_latency_histogram reads;
+	uint32_t delay_ms;
+	uint32_t samples_since_delay;
+	uint64_t rerouted;
+} as_read_router;
+
+/**
+ * Create a router from the latency_aware_reads dict of the client config:
+ * {'percentile': float, 'min_delay': ms, 'degraded_factor': float}.
+ */
+as_status as_read_router_new(as_error * err, PyObject * py_config, as_read_router ** router);
+
+/**
+ * The router must be stopped. Does nothing without router.
+ */
+void as_read_router_destroy(as_read_router * router);
+
+/**
+ * Start probing the nodes of as. Does nothing without router, or if it is
+ * started. Returns false if the thread could not be started.
+ */
+bool as_read_router_start(as_read_router * router, aerospike * as);
+
+/**
+ * Stop the thread, if started. Must be called without the GIL.
+ */
+void as_read_router_stop(as_read_router * router);
+
+/**
+ * Forget the thread of the parent process, which does not exist in a forked
+ * child. Must only be called in the child.
+ */
+void as_read_router_after_fork(as_read_router * router);
+
+/**
+ * Route a read away from slow masters while a node is degraded, copying the
+ * config default or compiled policy into policy first, as they are shared.
+ * Only reads whose total timeout is at least twice the retry delay are
+ * routed, reads without a total timeout are left unbounded.
+ * Does nothing without router. Returns the time the read starts, for as_read_router_record().
+ */
+uint64_t as_read_router_route(as_read_router * router, as_policy_read * config_policy,
+		as_policy_read * policy, as_policy_read ** policy_p);
+
+/**
+ * Record the latency of a read routed from start_ns.
+ */
+void as_read_router_record(as_read_router * router, uint64_t start_ns);
+
+/**
+ * Add the EWMA and state of each node to the node dicts of py_nodes, by node
+ * name, and the state of the router to py_stats under 'read_routing'.
+ */
+int as_read_router_stats(as_read_router * router, PyObject * py_stats, PyObject * py_nodes);
@@ -77,3 +77,31 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
  *
  */
 PyObject * AerospikeScan_Results(AerospikeScan * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Execute the scan and return its records a page at a time.
+ *
+ *    records, token = scan.page(1000)
+ *    while token:
+ *      records, token = scan.page(1000, token)
+ *
+ */
+PyObject * AerospikeScan_Page(AerospikeScan * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Execute the scan and write the records to a file, without converting
+ * them to Python objects. Returns the number of records written.
+ *
+ *    scan.export(path, format="ndjson")
+ *
+ */
+PyObject * AerospikeScan_Export(AerospikeScan * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Execute the scan and reduce its records to the given aggregates,
+ * without converting them to Python objects.
+ *
+ *    scan.aggregate({'total': aggregates.sum('views')})
+ *
+ */
+PyObject * AerospikeScan_Aggregate(AerospikeScan * self, PyObject * args, PyObject * kwds);
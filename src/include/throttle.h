@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdint.h>
+
+#include <aerospike/as_error.h>
+
+/*******************************************************************************
+ * RECORD THROTTLE
+ *
+ * A token bucket limiting the rate records are handed to the application.
+ * One bucket is shared by all node threads of a scan or query, and the rate
+ * may be changed while they run.
+ ******************************************************************************/
+
+#define THROTTLE_POLICY_KEY "records_per_second"
+
+typedef struct {
+	pthread_mutex_t lock;
+	// Records per second, 0 is unthrottled
+	uint32_t rate;
+	double tokens;
+	uint64_t last_ns;
+} as_throttle;
+
+void as_throttle_init(as_throttle * throttle);
+
+void as_throttle_destroy(as_throttle * throttle);
+
+void as_throttle_set_rate(as_throttle * throttle, uint32_t rate);
+
+/**
+ * Take a token, sleeping until one is available.
+ * Must be called without the GIL.
+ */
+void as_throttle_acquire(as_throttle * throttle);
+
+/**
+ * Read the records_per_second field of a policy dict, 0 if the dict is NULL
+ * or has none.
+ */
+as_status pyobject_to_records_per_second(as_error * err, PyObject * py_policy, uint32_t * rate);
+
+/**
+ * Set the rate from the records_per_second field of a policy dict or compiled
+ * policy. A call without one is not throttled.
+ */
+as_status pyobject_to_throttle(as_error * err, PyObject * py_policy, as_throttle * throttle);
+
+/**
+ * Implements set_records_per_second(rate) for the Scan and Query types.
+ */
+PyObject * throttle_set_records_per_second(as_throttle * throttle, PyObject * args, PyObject * kwds);
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <aerospike/as_batch.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_record.h>
+
+#include "latency.h"
+
+/*******************************************************************************
+ * TRACE HOOK
+ *
+ * With a hook set by aerospike.set_trace_hook(), each command fills a span
+ * on its stack and appends it, with the GIL held, to a preallocated buffer.
+ * A thread hands the buffered spans to the exporter in batches, so Python is
+ * called once per batch rather than once per command. Without a hook, a
+ * command only tests a global pointer.
+ ******************************************************************************/
+
+typedef struct as_tracer_s as_tracer;
+
+// The hook of the process, NULL if tracing is off. Only changed with the GIL held.
+extern as_tracer * as_trace_tracer;
+
+typedef struct {
+	bool active;
+	as_latency_command command;
+	as_status status;
+	uint32_t records;
+	uint64_t payload_bytes;
+	uint64_t start_ns;                  // since the epoch
+	uint64_t start_mono_ns;
+	uint64_t duration_ns;
+	char ns[AS_NAMESPACE_MAX_SIZE];
+	char set[AS_SET_MAX_SIZE];
+} as_trace_span;
+
+void as_trace_start(as_trace_span * span, as_latency_command command);
+
+void as_trace_finish(as_trace_span * span, as_status status);
+
+uint64_t as_trace_record_size(const as_record * rec);
+
+/**
+ * Start the span of a command, the GIL must be held.
+ */
+static inline void as_trace_begin(as_trace_span * span, as_latency_command command)
+{
+	span->active = as_trace_tracer != NULL;
+	if (span->active) {
+		as_trace_start(span, command);
+	}
+}
+
+static inline void as_trace_namespace(as_trace_span * span, const char * ns, const char * set)
+{
+	if (span->active) {
+		strncpy(span->ns, ns, AS_NAMESPACE_MAX_SIZE - 1);
+		strncpy(span->set, set, AS_SET_MAX_SIZE - 1);
+	}
+}
+
+static inline void as_trace_key(as_trace_span * span, const as_key * key)
+{
+	as_trace_namespace(span, key->ns, key->set);
+}
+
+/**
+ * Add a record sent or received to the payload of the span.
+ */
+static inline void as_trace_record(as_trace_span * span, const as_record * rec)
+{
+	if (span->active && rec) {
+		span->records++;
+		span->payload_bytes += as_trace_record_size(rec);
+	}
+}
+
+/**
+ * Take the namespace and set from the first key, and the payload from the
+ * records found.
+ */
+static inline void as_trace_batch_read(as_trace_span * span, as_batch_read_records * records)
+{
+	for (uint32_t i = 0; span->active && i < records->list.size; i++) {
+		as_batch_read_record * record = (as_batch_read_record *) as_vector_get(&records->list, i);
+		if (i == 0) {
+			as_trace_key(span, &record->key);
+		}
+		if (record->result == AEROSPIKE_OK) {
+			as_trace_record(span, &record->record);
+		}
+	}
+}
+
+/**
+ * Complete the span with the status of the command and queue it for the
+ * exporter, the GIL must be held.
+ */
+static inline void as_trace_end(as_trace_span * span, as_error * err)
+{
+	if (span->active) {
+		as_trace_finish(span, err->code);
+	}
+}
+
+/**
+ * Set the exporter of the spans, or turn tracing off with None
+ *
+ *		aerospike.set_trace_hook(exporter, batch_size=100, flush_interval_ms=1000, max_queued=10000)
+ *
+ */
+PyObject * Aerospike_Set_Trace_Hook(PyObject * parent, PyObject * args, PyObject * kwds);
@@ -25,13 +25,22 @@
 #include <aerospike/as_scan.h>
 #include <aerospike/as_bin.h>
 #include "pool.h"
+#include "background.h"
+#include "latency.h"
+#include "near_cache.h"
+#include "read_routing.h"
+#include "hedge.h"
+#include "throttle.h"
+#include "trace.h"
+#include "warmup.h"
 
 // Bin names can be of type Unicode in Python
 // DB supports 32767 maximum number of bins
 #define MAX_UNICODE_OBJECTS 32767
 extern int counter;
 extern PyObject *py_global_hosts;
-extern bool user_shm_key;
+// Incremented in the child of each fork, see client/fork.c
+extern volatile uint32_t as_fork_generation;
 
 typedef struct {
 	PyObject_HEAD
@@ -50,6 +59,7 @@ typedef struct {
 	aerospike * as;
 	int shm_key;
 	int ref_cnt;
+	uint32_t fork_generation;           // as_fork_generation when as was connected
 } AerospikeGlobalHosts;
 
 typedef struct {
@@ -72,6 +82,16 @@ typedef struct {
 	uint8_t strict_types;
 	bool has_connected;
 	bool use_shared_connection;
+	bool user_shm_key;                  // shm_key of the config, used by the first connect
+	uint32_t fork_generation;           // as_fork_generation when as was connected
+	uint32_t min_conns_per_node;
+	uint32_t max_idle_conns_per_node;   // AS_CONN_NO_TRIM if idle connections are not trimmed
+	as_conn_warmer warmer;
+	as_latency * latency;               // NULL unless latency_histograms is set
+	as_near_cache * near_cache;         // NULL unless near_cache is set
+	as_read_router * read_router;       // NULL unless latency_aware_reads is set
+	as_hedger hedger;
+	as_background_list background;      // jobs, page cursors, write queues and counter buffers
 } AerospikeClient;
 
 typedef struct {
@@ -79,12 +99,18 @@ typedef struct {
 	AerospikeClient * client;
 	as_query query;
 	UnicodePyObjects u_objs;
+	// Page cursors by token, see paging.h
+	PyObject * py_cursors;
+	as_throttle throttle;
 } AerospikeQuery;
 
 typedef struct {
 	PyObject_HEAD
 	AerospikeClient * client;
 	as_scan scan;
+	// Page cursors by token, see paging.h
+	PyObject * py_cursors;
+	as_throttle throttle;
 } AerospikeScan;
 
 typedef struct {
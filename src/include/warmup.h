@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/aerospike.h>
+
+/*******************************************************************************
+ * CONNECTION WARMER
+ *
+ * Opens min_conns connections to each node of a cluster, so commands find
+ * them in the pools rather than connecting in the request path. A thread
+ * repeats it every tend interval, opening only as many as were closed since,
+ * until the warmer is stopped.
+ *
+ * The same thread trims the pools: each round closes half of the idle
+ * connections of a node above max_idle, so a pool grown by a burst shrinks
+ * back gradually rather than at once.
+ ******************************************************************************/
+
+#define WARMUP_CONFIG_KEY "min_conns_per_node"
+#define TRIM_CONFIG_KEY "max_idle_conns_per_node"
+
+// max_idle of a warmer which does not trim
+#define AS_CONN_NO_TRIM UINT32_MAX
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	pthread_t thread;
+	bool started;
+	bool stopping;
+	aerospike * as;
+	uint32_t min_conns;
+	uint32_t max_idle;
+} as_conn_warmer;
+
+void as_conn_warmer_init(as_conn_warmer * warmer);
+
+void as_conn_warmer_destroy(as_conn_warmer * warmer);
+
+/**
+ * Open the connections each node is short of min_conns, pooled and in use
+ * together, in parallel, up to the pool limits. Must be called without the
+ * GIL.
+ */
+void as_conn_warmup(aerospike * as, uint32_t min_conns);
+
+/**
+ * Close half of the idle connections of each node above max_idle. Must be
+ * called without the GIL.
+ */
+void as_conn_trim(aerospike * as, uint32_t max_idle);
+
+/**
+ * Start keeping min_conns connections to each node of as, and trimming the
+ * idle ones above max_idle. Does nothing if there is neither to do or the
+ * warmer is started. Returns false if the thread could not be started.
+ */
+bool as_conn_warmer_start(as_conn_warmer * warmer, aerospike * as, uint32_t min_conns, uint32_t max_idle);
+
+/**
+ * Stop the thread, if started. Must be called without the GIL.
+ */
+void as_conn_warmer_stop(as_conn_warmer * warmer);
+
+/**
+ * Forget the thread of the parent process, which does not exist in a forked
+ * child. Must only be called in the child.
+ */
+void as_conn_warmer_after_fork(as_conn_warmer * warmer);
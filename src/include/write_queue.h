@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_predexp.h>
+#include <aerospike/as_record.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * WRITE COMMAND
+ *
+ * A put or an operate converted on the caller thread. The values are copied
+ * out of the Python objects and the static pool, so the command may be sent
+ * and destroyed without the GIL, unless it references a compiled policy.
+ ******************************************************************************/
+
+typedef enum {
+	AS_WRITE_COMMAND_PUT,
+	AS_WRITE_COMMAND_OPERATE
+} as_write_command_type;
+
+typedef struct as_write_command_s {
+	struct as_write_command_s * next;
+	as_write_command_type type;
+
+	as_key key;
+	as_record rec;                          // AS_WRITE_COMMAND_PUT
+	as_operations ops;                      // AS_WRITE_COMMAND_OPERATE
+
+	as_policy_write write_policy;
+	as_policy_write * write_policy_p;
+	as_policy_operate operate_policy;
+	as_policy_operate * operate_policy_p;
+	as_predexp_list predexp_list;           // referenced by a policy dict with a "predexp" field
+	PyObject * py_policy;                   // compiled policy whose predexps are referenced
+	as_near_cache * near_cache;             // pinning the key until the command is sent, or NULL
+
+	as_error err;
+} as_write_command;
+
+/**
+ * Convert a put into a new command. Must be called with the GIL.
+ */
+as_status as_write_command_put(AerospikeClient * client, as_error * err, PyObject * py_key,
+		PyObject * py_bins, PyObject * py_meta, PyObject * py_policy, as_write_command ** cmd);
+
+/**
+ * Convert an operate, from a list of operation dicts or compiled operations,
+ * into a new command. Must be called with the GIL.
+ */
+as_status as_write_command_operate(AerospikeClient * client, as_error * err, PyObject * py_key,
+		PyObject * py_list, PyObject * py_meta, PyObject * py_policy, as_write_command ** cmd);
+
+/**
+ * Send the command, its result is set in cmd->err, and unpin its key from
+ * the near cache. Called without the GIL.
+ */
+void as_write_command_execute(aerospike * as, as_write_command * cmd);
+
+/**
+ * Needs the GIL if cmd->py_policy is set.
+ */
+void as_write_command_destroy(as_write_command * cmd);
+
+/*******************************************************************************
+ * PYTHON TYPE
+ *
+ * aerospike.WriteQueue, returned by client.write_queue(). Commands wait in a
+ * FIFO until one of the max_inflight sender threads takes them, so at most
+ * max_inflight commands are in flight at once. Failed commands are kept until
+ * the next call on the caller thread, which reports them to on_error.
+ *
+ * In a child forked while commands were pending, they are left to the parent
+ * to send, and the sender threads are started again on first use.
+ ******************************************************************************/
+
+typedef struct {
+	PyObject_HEAD
+	AerospikeClient * client;
+	PyObject * on_error;                    // called with (key, exception)
+
+	uint32_t max_inflight;
+	uint32_t max_queued;                    // 0 for no bound
+
+	pthread_mutex_t lock;                   // guards everything below
+	pthread_cond_t cond;                    // signalled when a command is queued or on close
+	pthread_cond_t done_cond;               // broadcast when a command completes
+	as_write_command * head;
+	as_write_command * tail;
+	as_write_command * done;                // failed commands and the ones to destroy with the GIL
+	uint32_t n_waiting;
+	uint32_t n_inflight;
+	bool closing;
+
+	uint64_t queued;
+	uint64_t sent;
+	uint64_t failed;
+
+	pthread_t * threads;
+	uint32_t n_threads;
+	uint32_t fork_generation;               // of the process running the sender threads
+
+	as_background background;               // closed by client.close(), once the queue is sent
+} AerospikeWriteQueue;
+
+PyTypeObject * AerospikeWriteQueue_Ready(void);
+
+AerospikeWriteQueue * AerospikeWriteQueue_New(AerospikeClient * client, as_error * err,
+		uint32_t max_inflight, uint32_t max_queued, PyObject * on_error);
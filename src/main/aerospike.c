@@ -32,10 +32,20 @@
 #include "module_functions.h"
 #include "nullobject.h"
 #include "cdt_types.h"
+#include "columnar.h"
+#include "job.h"
+#include "compiled_ops.h"
+#include "operation.h"
+#include "compiled_policy.h"
+#include "cdt_context.h"
+#include "hll.h"
+#include "counter_buffer.h"
+#include "write_queue.h"
+#include "multi_client.h"
+#include "trace.h"
 
 PyObject *py_global_hosts;
 int counter = 0xA8000000;
-bool user_shm_key = false;
 
 PyDoc_STRVAR(client_doc,
 "client(config) -> client object\n\
@@ -49,6 +59,17 @@ config = {\n\
 }\n\
 client = aerospike.client(config)");
 
+PyDoc_STRVAR(multi_client_doc,
+"multi_client(config) -> MultiClient\n\
+\n\
+Creates a client of several clusters, which reads from the first available one and writes by the write mode.\n\
+\n\
+config = {\n\
+    'clusters': [ {'hosts': [ ('10.0.0.1', 3000) ]}, {'hosts': [ ('10.1.0.1', 3000) ]} ],\n\
+    'write_mode': aerospike.MULTI_WRITE_PREFERRED,\n\
+}\n\
+client = aerospike.multi_client(config).connect()");
+
 static PyMethodDef Aerospike_Methods[] = {
 
 	//Serialization
@@ -64,10 +85,14 @@ static PyMethodDef Aerospike_Methods[] = {
 
 	{"client",		(PyCFunction) AerospikeClient_New,              METH_VARARGS | METH_KEYWORDS,
 		client_doc},
+	{"multi_client", (PyCFunction) AerospikeMultiClient_New,        METH_VARARGS | METH_KEYWORDS,
+		multi_client_doc},
 	{"set_log_level",	(PyCFunction)Aerospike_Set_Log_Level,       METH_VARARGS | METH_KEYWORDS,
 		"Sets the log level"},
 	{"set_log_handler", (PyCFunction)Aerospike_Set_Log_Handler,     METH_VARARGS | METH_KEYWORDS,
 		"Sets the log handler"},
+	{"set_trace_hook", (PyCFunction)Aerospike_Set_Trace_Hook,       METH_VARARGS | METH_KEYWORDS,
+		"Sets the exporter of the command spans, or turns tracing off with None"},
 	{"geodata", (PyCFunction)Aerospike_Set_Geo_Data,                METH_VARARGS | METH_KEYWORDS,
 		"Creates a GeoJSON object from geospatial data."},
 	{"geojson", (PyCFunction)Aerospike_Set_Geo_Json,                METH_VARARGS | METH_KEYWORDS,
@@ -106,6 +131,8 @@ MOD_INIT(aerospike)
 
 	py_global_hosts = PyDict_New();
 
+	as_fork_handlers_install();
+
 	PyModule_AddStringConstant(aerospike, "__version__", version);
 
 	PyObject * exception = AerospikeException_New();
@@ -160,5 +187,49 @@ MOD_INIT(aerospike)
 	Py_INCREF(infinite_object);
 	PyModule_AddObject(aerospike, "CDTInfinite", (PyObject *) infinite_object);
 
+	PyTypeObject * columnar = AerospikeColumnar_Ready();
+	Py_INCREF(columnar);
+	PyModule_AddObject(aerospike, "ColumnarResult", (PyObject *) columnar);
+
+	PyTypeObject * job = AerospikeJob_Ready();
+	Py_INCREF(job);
+	PyModule_AddObject(aerospike, "Job", (PyObject *) job);
+
+	PyTypeObject * compiled_ops = AerospikeCompiledOps_Ready();
+	Py_INCREF(compiled_ops);
+	PyModule_AddObject(aerospike, "CompiledOperations", (PyObject *) compiled_ops);
+
+	PyTypeObject * placeholder = AerospikePlaceholder_Ready();
+	Py_INCREF(placeholder);
+	PyModule_AddObject(aerospike, "Placeholder", (PyObject *) placeholder);
+
+	PyTypeObject * operation = AerospikeOperation_Ready();
+	Py_INCREF(operation);
+	PyModule_AddObject(aerospike, "Operation", (PyObject *) operation);
+
+	PyTypeObject * policy = AerospikePolicy_Ready();
+	Py_INCREF(policy);
+	PyModule_AddObject(aerospike, "Policy", (PyObject *) policy);
+
+	PyTypeObject * cdt_context = AerospikeCDTContext_Ready();
+	Py_INCREF(cdt_context);
+	PyModule_AddObject(aerospike, "CDTContext", (PyObject *) cdt_context);
+
+	PyTypeObject * hll = AerospikeHyperLogLog_Ready();
+	Py_INCREF(hll);
+	PyModule_AddObject(aerospike, "HyperLogLog", (PyObject *) hll);
+
+	PyTypeObject * counter_buffer = AerospikeCounterBuffer_Ready();
+	Py_INCREF(counter_buffer);
+	PyModule_AddObject(aerospike, "CounterBuffer", (PyObject *) counter_buffer);
+
+	PyTypeObject * write_queue = AerospikeWriteQueue_Ready();
+	Py_INCREF(write_queue);
+	PyModule_AddObject(aerospike, "WriteQueue", (PyObject *) write_queue);
+
+	PyTypeObject * multi_client = AerospikeMultiClient_Ready();
+	Py_INCREF(multi_client);
+	PyModule_AddObject(aerospike, "MultiClient", (PyObject *) multi_client);
+
 	return MOD_SUCCESS_VAL(aerospike);
 }
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+
+#include "aggregate.h"
+#include "conversions.h"
+#include "macros.h"
+
+#define AGGREGATE_TYPE_KEY "aggregate"
+#define AGGREGATE_BIN_KEY "bin"
+#define AGGREGATE_BUCKET_WIDTH_KEY "bucket_width"
+
+/*
+ * Copy a Python string to a NUL terminated C string, which must be freed.
+ */
+static char * pystring_dup(PyObject * py_string, as_error * err)
+{
+	PyObject * py_ustr = NULL;
+	char * c_str = NULL;
+
+	if (string_and_pyuni_from_pystring(py_string, &py_ustr, &c_str, err) != AEROSPIKE_OK) {
+		return NULL;
+	}
+
+	char * dup = strdup(c_str);
+	Py_XDECREF(py_ustr);
+	return dup;
+}
+
+static as_status pyobject_to_aggregate(as_error * err, PyObject * py_name, PyObject * py_spec, as_aggregate * agg)
+{
+	agg->name = pystring_dup(py_name, err);
+	if (!agg->name) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Aggregate names must be strings");
+	}
+
+	if (!PyDict_Check(py_spec)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Aggregate %s should be a dict built by aerospike_helpers.aggregates", agg->name);
+	}
+
+	PyObject * py_type = PyDict_GetItemString(py_spec, AGGREGATE_TYPE_KEY);
+	if (!py_type || !PyInt_Check(py_type)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Aggregate %s must have an integer \"aggregate\" entry", agg->name);
+	}
+
+	agg->type = (int) PyInt_AsLong(py_type);
+	if (agg->type < AGGREGATE_COUNT || agg->type > AGGREGATE_HISTOGRAM) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Unknown aggregate type %d for %s", agg->type, agg->name);
+	}
+
+	PyObject * py_bin = PyDict_GetItemString(py_spec, AGGREGATE_BIN_KEY);
+	if (py_bin && py_bin != Py_None) {
+		char * bin = pystring_dup(py_bin, err);
+		if (!bin) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "The bin of aggregate %s must be a string", agg->name);
+		}
+		if (strlen(bin) >= AS_BIN_NAME_MAX_SIZE) {
+			free(bin);
+			return as_error_update(err, AEROSPIKE_ERR_BIN_NAME, "A bin name should not exceed 14 characters limit");
+		}
+		strcpy(agg->bin, bin);
+		free(bin);
+	} else if (agg->type != AGGREGATE_COUNT) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Aggregate %s must have a \"bin\" entry", agg->name);
+	}
+
+	if (agg->type == AGGREGATE_HISTOGRAM) {
+		PyObject * py_width = PyDict_GetItemString(py_spec, AGGREGATE_BUCKET_WIDTH_KEY);
+		if (!py_width || !PyInt_Check(py_width)) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Histogram %s must have an integer \"bucket_width\" entry", agg->name);
+		}
+		agg->bucket_width = PyLong_AsLongLong(py_width);
+		if (agg->bucket_width <= 0) {
+			PyErr_Clear();
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "The bucket_width of histogram %s must be positive", agg->name);
+		}
+	}
+
+	return AEROSPIKE_OK;
+}
+
+as_status pyobject_to_aggregates(as_error * err, PyObject * py_aggregates, as_aggregates * aggregates)
+{
+	pthread_mutex_init(&aggregates->lock, NULL);
+	aggregates->aggregates = NULL;
+	aggregates->n_aggregates = 0;
+
+	if (!py_aggregates || !PyDict_Check(py_aggregates) || PyDict_Size(py_aggregates) == 0) {
+		as_aggregates_destroy(aggregates);
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Aggregates should be a non empty dict of name to aggregate");
+	}
+
+	aggregates->aggregates = calloc(PyDict_Size(py_aggregates), sizeof(as_aggregate));
+	if (!aggregates->aggregates) {
+		as_aggregates_destroy(aggregates);
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for aggregates");
+	}
+
+	PyObject * py_name = NULL;
+	PyObject * py_spec = NULL;
+	Py_ssize_t pos = 0;
+
+	while (PyDict_Next(py_aggregates, &pos, &py_name, &py_spec)) {
+		// Counted before parsing, so the name is freed on error.
+		as_aggregate * agg = &aggregates->aggregates[aggregates->n_aggregates++];
+		if (pyobject_to_aggregate(err, py_name, py_spec, agg) != AEROSPIKE_OK) {
+			as_aggregates_destroy(aggregates);
+			return err->code;
+		}
+	}
+
+	return AEROSPIKE_OK;
+}
+
+static PyObject * aggregate_to_pyobject(as_aggregate * agg)
+{
+	switch (agg->type) {
+		case AGGREGATE_COUNT:
+			return PyLong_FromLongLong(agg->count);
+		case AGGREGATE_HISTOGRAM: {
+			PyObject * py_buckets = PyDict_New();
+			if (!py_buckets) {
+				return NULL;
+			}
+			for (uint32_t i = 0; i < agg->n_buckets; i++) {
+				PyObject * py_start = PyLong_FromLongLong(agg->buckets[i].start);
+				PyObject * py_count = PyLong_FromLongLong(agg->buckets[i].count);
+				int rc = (py_start && py_count) ? PyDict_SetItem(py_buckets, py_start, py_count) : -1;
+				Py_XDECREF(py_start);
+				Py_XDECREF(py_count);
+				if (rc != 0) {
+					Py_DECREF(py_buckets);
+					return NULL;
+				}
+			}
+			return py_buckets;
+		}
+		default:
+			if (agg->count == 0) {
+				// The sum of no values is 0, their min and max are None.
+				if (agg->type == AGGREGATE_SUM) {
+					return PyLong_FromLong(0);
+				}
+				Py_RETURN_NONE;
+			}
+			return agg->is_double ? PyFloat_FromDouble(agg->d) : PyLong_FromLongLong(agg->i);
+	}
+}
+
+as_status as_aggregates_to_pyobject(as_error * err, as_aggregates * aggregates, PyObject ** py_result)
+{
+	*py_result = PyDict_New();
+	if (!*py_result) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to create the aggregates dict");
+	}
+
+	for (uint32_t i = 0; i < aggregates->n_aggregates; i++) {
+		as_aggregate * agg = &aggregates->aggregates[i];
+		PyObject * py_value = aggregate_to_pyobject(agg);
+
+		if (!py_value || PyDict_SetItemString(*py_result, agg->name, py_value) != 0) {
+			PyErr_Clear();
+			Py_XDECREF(py_value);
+			Py_CLEAR(*py_result);
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to convert aggregate %s", agg->name);
+		}
+		Py_DECREF(py_value);
+	}
+
+	return AEROSPIKE_OK;
+}
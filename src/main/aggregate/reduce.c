@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_double.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_integer.h>
+#include <aerospike/as_record.h>
+
+#include "aggregate.h"
+
+// Smallest allocation for the buckets of a histogram.
+#define AGGREGATE_BUCKETS_MIN_CAPACITY 16
+
+/*
+ * Everything in this file runs without the GIL, on the C client's threads
+ * for scans and queries, so it must not touch Python objects.
+ */
+
+/*
+ * Start of the bucket holding value, rounding down for negative values.
+ */
+static int64_t bucket_start(int64_t value, int64_t width)
+{
+	int64_t quotient = value / width;
+	if (value % width != 0 && value < 0) {
+		quotient--;
+	}
+	return quotient * width;
+}
+
+static bool histogram_add(as_aggregate * agg, int64_t value)
+{
+	int64_t start = bucket_start(value, agg->bucket_width);
+
+	// Binary search for the bucket, or the position to insert it at.
+	uint32_t low = 0;
+	uint32_t high = agg->n_buckets;
+	while (low < high) {
+		uint32_t mid = low + (high - low) / 2;
+		if (agg->buckets[mid].start < start) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (low < agg->n_buckets && agg->buckets[low].start == start) {
+		agg->buckets[low].count++;
+		return true;
+	}
+
+	if (agg->n_buckets == agg->buckets_capacity) {
+		uint32_t capacity = agg->buckets_capacity ? agg->buckets_capacity * 2 : AGGREGATE_BUCKETS_MIN_CAPACITY;
+		as_aggregate_bucket * buckets = realloc(agg->buckets, capacity * sizeof(as_aggregate_bucket));
+		if (!buckets) {
+			return false;
+		}
+		agg->buckets = buckets;
+		agg->buckets_capacity = capacity;
+	}
+
+	memmove(&agg->buckets[low + 1], &agg->buckets[low],
+			(agg->n_buckets - low) * sizeof(as_aggregate_bucket));
+	agg->buckets[low].start = start;
+	agg->buckets[low].count = 1;
+	agg->n_buckets++;
+	return true;
+}
+
+/*
+ * Switch an integer sum, min or max to a double, once a float is reduced.
+ */
+static void aggregate_to_double(as_aggregate * agg)
+{
+	if (!agg->is_double) {
+		agg->d = (double) agg->i;
+		agg->is_double = true;
+	}
+}
+
+static as_status aggregate_add_number(as_aggregate * agg, as_error * err, const as_val * val)
+{
+	bool is_int = as_val_type(val) == AS_INTEGER;
+	int64_t i = is_int ? as_integer_get((as_integer *) val) : 0;
+	double d = is_int ? (double) i : as_double_get((as_double *) val);
+
+	if (!is_int) {
+		aggregate_to_double(agg);
+	}
+
+	if (agg->count == 0) {
+		agg->i = i;
+		agg->d = d;
+		agg->count++;
+		return AEROSPIKE_OK;
+	}
+
+	switch (agg->type) {
+		case AGGREGATE_SUM:
+			if (agg->is_double) {
+				agg->d += d;
+			} else if (__builtin_add_overflow(agg->i, i, &agg->i)) {
+				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Integer overflow in the sum of bin %s", agg->bin);
+			}
+			break;
+		case AGGREGATE_MIN:
+			if (agg->is_double ? d < agg->d : i < agg->i) {
+				agg->i = i;
+				agg->d = d;
+			}
+			break;
+		case AGGREGATE_MAX:
+			if (agg->is_double ? d > agg->d : i > agg->i) {
+				agg->i = i;
+				agg->d = d;
+			}
+			break;
+	}
+
+	agg->count++;
+	return AEROSPIKE_OK;
+}
+
+static as_status aggregate_add_record(as_aggregate * agg, as_error * err, const as_record * rec)
+{
+	if (agg->type == AGGREGATE_COUNT && agg->bin[0] == '\0') {
+		agg->count++;
+		return AEROSPIKE_OK;
+	}
+
+	as_val * val = (as_val *) as_record_get((as_record *) rec, agg->bin);
+	if (!val || as_val_type(val) == AS_NIL) {
+		return AEROSPIKE_OK;
+	}
+
+	switch (agg->type) {
+		case AGGREGATE_COUNT:
+			agg->count++;
+			break;
+		case AGGREGATE_HISTOGRAM:
+			if (as_val_type(val) != AS_INTEGER) {
+				break;
+			}
+			if (!histogram_add(agg, as_integer_get((as_integer *) val))) {
+				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for histogram of bin %s", agg->bin);
+			}
+			agg->count++;
+			break;
+		default:
+			// Values other than numbers are not reduced by sum, min and max.
+			if (as_val_type(val) == AS_INTEGER || as_val_type(val) == AS_DOUBLE) {
+				return aggregate_add_number(agg, err, val);
+			}
+			break;
+	}
+
+	return AEROSPIKE_OK;
+}
+
+void as_aggregates_destroy(as_aggregates * aggregates)
+{
+	for (uint32_t i = 0; i < aggregates->n_aggregates; i++) {
+		free(aggregates->aggregates[i].name);
+		free(aggregates->aggregates[i].buckets);
+	}
+	free(aggregates->aggregates);
+	aggregates->aggregates = NULL;
+	aggregates->n_aggregates = 0;
+	pthread_mutex_destroy(&aggregates->lock);
+}
+
+uint32_t as_aggregates_bins(as_aggregates * aggregates, char ** bins)
+{
+	uint32_t n_bins = 0;
+
+	for (uint32_t i = 0; i < aggregates->n_aggregates; i++) {
+		char * bin = aggregates->aggregates[i].bin;
+		if (bin[0] == '\0') {
+			continue;
+		}
+
+		bool found = false;
+		for (uint32_t j = 0; j < n_bins && !found; j++) {
+			found = strcmp(bins[j], bin) == 0;
+		}
+		if (!found) {
+			bins[n_bins++] = bin;
+		}
+	}
+
+	return n_bins;
+}
+
+as_status as_aggregates_add_record(as_aggregates * aggregates, as_error * err, const as_record * rec)
+{
+	pthread_mutex_lock(&aggregates->lock);
+
+	for (uint32_t i = 0; i < aggregates->n_aggregates; i++) {
+		if (aggregate_add_record(&aggregates->aggregates[i], err, rec) != AEROSPIKE_OK) {
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&aggregates->lock);
+	return err->code;
+}
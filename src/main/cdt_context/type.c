@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <aerospike/as_cdt_ctx.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_val.h>
+
+#include "cdt_context.h"
+#include "conversions.h"
+#include "policy.h"
+
+/*
+ * Whether the item holds an as_val, rather than an index or a rank.
+ */
+static bool cdt_ctx_item_has_val(as_cdt_ctx_item * item)
+{
+	return item->type == AS_CDT_CTX_LIST_VALUE ||
+		item->type == AS_CDT_CTX_MAP_KEY ||
+		item->type == AS_CDT_CTX_MAP_VALUE;
+}
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+static Py_ssize_t AerospikeCDTContext_Length(AerospikeCDTContext * self)
+{
+	return (Py_ssize_t) self->ctx.list.size;
+}
+
+static PyObject * AerospikeCDTContext_Repr(AerospikeCDTContext * self)
+{
+	return PyString_FromFormat("<aerospike.CDTContext depth=%u>", self->ctx.list.size);
+}
+
+static PySequenceMethods AerospikeCDTContext_Type_Sequence = {
+	(lenfunc) AerospikeCDTContext_Length,   // sq_length
+};
+
+static void AerospikeCDTContext_Type_Dealloc(AerospikeCDTContext * self)
+{
+	// The values are shared with no command once the object is unreferenced.
+	as_cdt_ctx_destroy(&self->ctx);
+	free(self->static_pool);
+	Py_XDECREF(self->py_ctx);
+	PyObject_Del(self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+PyTypeObject AerospikeCDTContext_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.CDTContext",             // tp_name
+	sizeof(AerospikeCDTContext),        // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikeCDTContext_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	(reprfunc) AerospikeCDTContext_Repr,
+	                                    // tp_repr
+	0,                                  // tp_as_number
+	&AerospikeCDTContext_Type_Sequence, // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	0,                                  // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"A list of cdt_ctx objects compiled by client.compile_ctx(),\n"
+	"to be passed as the ctx of list and map operations.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	0,                                  // tp_methods
+	0,                                  // tp_members
+	0,                                  // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0                                   // tp_new
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeCDTContext_Ready()
+{
+	return PyType_Ready(&AerospikeCDTContext_Type) == 0 ? &AerospikeCDTContext_Type : NULL;
+}
+
+AerospikeCDTContext * AerospikeCDTContext_New(AerospikeClient * client, as_error * err, PyObject * py_ctx)
+{
+	if (!PyList_Check(py_ctx)) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "CDT context should be a list of cdt_ctx objects");
+		return NULL;
+	}
+
+	if (PyList_Size(py_ctx) == 0) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "CDT context should not be empty");
+		return NULL;
+	}
+
+	AerospikeCDTContext * self = PyObject_New(AerospikeCDTContext, &AerospikeCDTContext_Type);
+	if (!self) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the CDT context");
+		return NULL;
+	}
+
+	// The bytes outlive the call, so they come from a pool of the object.
+	self->static_pool = (as_static_pool *) calloc(1, sizeof(as_static_pool));
+	self->py_ctx = NULL;
+	if (!self->static_pool) {
+		as_cdt_ctx_init(&self->ctx, 0);
+		Py_DECREF(self);
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the CDT context");
+		return NULL;
+	}
+
+	// Bytes and bytearray values are wrapped rather than copied, so they are
+	// converted from a copy of the list which lives as long as the object.
+	PyObject * py_copy_module = PyImport_ImportModule("copy");
+	if (py_copy_module) {
+		self->py_ctx = PyObject_CallMethod(py_copy_module, "deepcopy", "O", py_ctx);
+		Py_DECREF(py_copy_module);
+	}
+	if (!self->py_ctx) {
+		PyErr_Clear();
+		as_cdt_ctx_init(&self->ctx, 0);
+		Py_DECREF(self);
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to copy the CDT context");
+		return NULL;
+	}
+
+	if (pyobject_to_cdt_ctx(client, err, self->py_ctx, &self->ctx, self->static_pool, SERIALIZER_PYTHON) != AEROSPIKE_OK) {
+		as_cdt_ctx_init(&self->ctx, 0);
+		Py_DECREF(self);
+		return NULL;
+	}
+
+	return self;
+}
+
+void AerospikeCDTContext_Copy(AerospikeCDTContext * self, as_cdt_ctx * cdt_ctx)
+{
+	as_cdt_ctx_init(cdt_ctx, self->ctx.list.size);
+
+	for (uint32_t i = 0; i < self->ctx.list.size; i++) {
+		as_cdt_ctx_item * item = (as_cdt_ctx_item *) as_vector_get(&self->ctx.list, i);
+
+		if (cdt_ctx_item_has_val(item)) {
+			as_val_reserve(item->val.pval);
+		}
+		as_vector_append(&cdt_ctx->list, item);
+	}
+}
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <aerospike/aerospike_batch.h>
+#include <aerospike/as_batch.h>
+#include <aerospike/as_error.h>
+
+#include "aggregate.h"
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "policy.h"
+#include "predexp.h"
+
+#define MAX_STACK_ALLOCATION 4000
+
+/**
+ *******************************************************************************************************
+ * Reads a batch of records and reduces them to the values of the aggregates.
+ * Only the bins used by the aggregates are read, only the headers if none is.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns a dict of aggregate name to value.
+ * In case of error,appropriate exceptions will be raised.
+ *******************************************************************************************************
+ */
+PyObject * AerospikeClient_Aggregate_Many(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_keys = NULL;
+	PyObject * py_aggregates = NULL;
+	PyObject * py_policy = NULL;
+	PyObject * py_result = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_batch policy;
+	as_policy_batch * batch_policy_p = NULL;
+	as_predexp_list predexp_list;
+	as_batch_read_records records;
+	as_aggregates aggregates;
+	char ** bins = NULL;
+	uint32_t n_bins = 0;
+
+	// Initialisation flags
+	bool batch_initialised = false;
+	bool aggregates_initialised = false;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"keys", "aggregates", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|O:aggregate_many", kwlist,
+			&py_keys, &py_aggregates, &py_policy) == false) {
+		return NULL;
+	}
+
+	// Initialize error
+	as_error_init(&err);
+
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	if (!PyList_Check(py_keys) && !PyTuple_Check(py_keys)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Keys should be specified as a list or tuple.");
+		goto CLEANUP;
+	}
+
+	// Convert python policy object to as_policy_batch
+	pyobject_to_policy_batch(&err, py_policy, &policy, &batch_policy_p,
+			&self->as->config.policies.batch, &predexp_list);
+	if (err.code != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_aggregates(&err, py_aggregates, &aggregates) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	aggregates_initialised = true;
+
+	bins = (char **) malloc(sizeof(char *) * aggregates.n_aggregates);
+	if (!bins) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for bin names");
+		goto CLEANUP;
+	}
+	n_bins = as_aggregates_bins(&aggregates, bins);
+
+	Py_ssize_t size = PySequence_Size(py_keys);
+
+	if (size > MAX_STACK_ALLOCATION) {
+		as_batch_read_init(&records, size);
+	} else {
+		as_batch_read_inita(&records, size);
+	}
+	batch_initialised = true;
+
+	for (Py_ssize_t i = 0; i < size; i++) {
+		PyObject * py_key = PyList_Check(py_keys) ?
+				PyList_GetItem(py_keys, i) : PyTuple_GetItem(py_keys, i);
+
+		if (!PyTuple_Check(py_key)) {
+			as_error_update(&err, AEROSPIKE_ERR_PARAM, "Key should be a tuple.");
+			goto CLEANUP;
+		}
+
+		as_batch_read_record * record = as_batch_read_reserve(&records);
+
+		pyobject_to_key(&err, py_key, &record->key);
+		if (err.code != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+
+		// The bin names belong to the aggregates, they outlive the batch.
+		record->read_all_bins = false;
+		record->bin_names = n_bins ? bins : NULL;
+		record->n_bin_names = n_bins;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+
+	if (aerospike_batch_read(self->as, &err, batch_policy_p, &records) == AEROSPIKE_OK) {
+		for (uint32_t i = 0; i < records.list.size; i++) {
+			as_batch_read_record * r = as_vector_get(&records.list, i);
+			if (r->result != AEROSPIKE_OK) {
+				continue;
+			}
+			if (as_aggregates_add_record(&aggregates, &err, &r->record) != AEROSPIKE_OK) {
+				break;
+			}
+		}
+	}
+
+	Py_END_ALLOW_THREADS
+
+	if (err.code == AEROSPIKE_OK) {
+		as_aggregates_to_pyobject(&err, &aggregates, &py_result);
+	}
+
+CLEANUP:
+	PREDEXP_LIST_DESTROY(batch_policy_p, &predexp_list);
+
+	if (batch_initialised) {
+		as_batch_read_destroy(&records);
+	}
+
+	free(bins);
+
+	if (aggregates_initialised) {
+		as_aggregates_destroy(&aggregates);
+	}
+
+	if (err.code != AEROSPIKE_OK) {
+		Py_XDECREF(py_result);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		if (PyObject_HasAttrString(exception_type, "key")) {
+			PyObject_SetAttrString(exception_type, "key", py_keys);
+		}
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return py_result;
+}
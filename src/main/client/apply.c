@@ -26,6 +26,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 /**
  *******************************************************************************************************
@@ -53,11 +54,14 @@ PyObject * AerospikeClient_Apply_Invoke(
 	as_error err;
 	as_policy_apply apply_policy;
 	as_policy_apply * apply_policy_p = NULL;
+	as_predexp_list predexp_list;
 	as_key key;
 	char * module = NULL;
 	char * function = NULL;
 	as_list * arglist = NULL;
 	as_val * result = NULL;
+	as_latency_timer timer;
+	as_trace_span span;
 
 	PyObject * py_umodule   = NULL;
 	PyObject * py_ufunction = NULL;
@@ -69,6 +73,7 @@ PyObject * AerospikeClient_Apply_Invoke(
 
 	// Initialize error
 	as_error_init(&err);
+	as_trace_begin(&span, AS_LATENCY_APPLY);
 
 	if (!PyList_Check(py_arglist)) {
 		PyErr_SetString(PyExc_TypeError, "expected UDF method arguments in a 'list'");
@@ -85,6 +90,8 @@ PyObject * AerospikeClient_Apply_Invoke(
 		goto CLEANUP;
 	}
 
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_APPLY);
+
 	self->is_client_put_serializer = false;
 	// Convert python key object to as_key
 	pyobject_to_key(&err, py_key, &key);
@@ -93,6 +100,7 @@ PyObject * AerospikeClient_Apply_Invoke(
 	}
 	// Key is initialiased successfully
 	key_initialised = true;
+	as_trace_key(&span, &key);
 
 	// Convert python list to as_list
 	pyobject_to_list(self, &err, py_arglist, &arglist, &static_pool, SERIALIZER_PYTHON);
@@ -102,7 +110,7 @@ PyObject * AerospikeClient_Apply_Invoke(
 
 	// Convert python policy object to as_policy_apply
 	pyobject_to_policy_apply(&err, py_policy, &apply_policy, &apply_policy_p,
-			&self->as->config.policies.apply);
+			&self->as->config.policies.apply, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
@@ -132,17 +140,24 @@ PyObject * AerospikeClient_Apply_Invoke(
 	}
 
 	// Invoke operation
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_key_apply(self->as, &err, apply_policy_p, &key, module, function, arglist, &result);
 	Py_END_ALLOW_THREADS
+	as_near_cache_invalidate(self->near_cache, &key);
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 
 	if (err.code == AEROSPIKE_OK) {
 		val_to_pyobject(self, &err, result, &py_result);
+		as_latency_timer_mark(&timer, AS_LATENCY_TO_PYTHON);
 	} else {
 		as_error_update(&err, err.code, NULL);
 	}
 
 CLEANUP:
+	as_trace_end(&span, &err);
+	PREDEXP_LIST_DESTROY(apply_policy_p, &predexp_list);
+
 
 	if (py_umodule) {
 		Py_DECREF(py_umodule);
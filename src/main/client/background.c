@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdlib.h>
+
+#include <aerospike/as_error.h>
+
+#include "background.h"
+#include "client.h"
+
+as_status AerospikeClient_Register_Background(AerospikeClient * self, as_error * err,
+		as_background * entry, PyObject * py_obj, as_background_stop_fn stop)
+{
+	// Closing stops the objects registered so far, none may be added after.
+	if (!self->as || !self->is_conn_16 || self->background.closing) {
+		return as_error_update(err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+	}
+
+	entry->prev = NULL;
+	entry->next = self->background.head;
+	entry->py_obj = py_obj;
+	entry->stop = stop;
+	if (entry->next) {
+		entry->next->prev = entry;
+	}
+	self->background.head = entry;
+	return AEROSPIKE_OK;
+}
+
+void AerospikeClient_Unregister_Background(AerospikeClient * self, as_background * entry)
+{
+	if (!entry->py_obj) {
+		return;
+	}
+
+	if (entry->prev) {
+		entry->prev->next = entry->next;
+	}
+	else {
+		self->background.head = entry->next;
+	}
+	if (entry->next) {
+		entry->next->prev = entry->prev;
+	}
+	entry->prev = NULL;
+	entry->next = NULL;
+	entry->py_obj = NULL;
+}
+
+void AerospikeClient_Stop_Background(AerospikeClient * self)
+{
+	// Stopping releases the GIL, so objects may be freed meanwhile. The ones
+	// registered now are held until they are stopped.
+	uint32_t n_entries = 0;
+	for (as_background * entry = self->background.head; entry; entry = entry->next) {
+		n_entries++;
+	}
+	as_background ** entries = n_entries ? malloc(n_entries * sizeof(as_background *)) : NULL;
+	if (!entries) {
+		return;
+	}
+
+	uint32_t i = 0;
+	for (as_background * entry = self->background.head; entry; entry = entry->next) {
+		Py_INCREF(entry->py_obj);
+		entries[i++] = entry;
+	}
+
+	for (i = 0; i < n_entries; i++) {
+		// The entry lives in the object, which the reference keeps alive.
+		PyObject * py_obj = entries[i]->py_obj;
+		entries[i]->stop(py_obj);
+		Py_DECREF(py_obj);
+	}
+
+	free(entries);
+}
@@ -30,6 +30,7 @@
 #include "serializer.h"
 #include "cdt_list_operations.h"
 #include "cdt_operation_utils.h"
+#include "operation.h"
 
 #define AS_PY_LIST_RETURN_KEY "return_type"
 #define AS_PY_LIST_ORDER "list_order"
@@ -366,7 +367,7 @@ get_list_return_type(as_error* err, PyObject* op_dict, int* return_type)
         return err->code;
     }
     *return_type = int64_return_type;
-    PyObject* py_inverted = PyDict_GetItemString(op_dict, "inverted"); //NOT A MAGIC STRING
+    PyObject* py_inverted = operation_get(op_dict, AS_OP_FIELD_INVERTED, "inverted"); //NOT A MAGIC STRING
 
     if (py_inverted) {
         py_bool_val = PyObject_IsTrue(py_inverted);
@@ -1667,7 +1668,7 @@ static as_status
 get_list_policy(as_error* err, PyObject* op_dict, as_list_policy* policy, bool* found) {
 	*found = false;
 
-	PyObject* list_policy = PyDict_GetItemString(op_dict, AS_PY_LIST_POLICY);
+	PyObject* list_policy = operation_get(op_dict, AS_OP_FIELD_POLICY, AS_PY_LIST_POLICY);
 
 	if (list_policy) {
 		if (pyobject_to_list_policy(err, list_policy, policy) != AEROSPIKE_OK) {
@@ -29,6 +29,7 @@
 #include "serializer.h"
 #include "cdt_map_operations.h"
 #include "cdt_operation_utils.h"
+#include "operation.h"
 
 
 #define AS_PY_MAP_RETURN_KEY "return_type"
@@ -338,7 +339,7 @@ get_map_return_type(as_error * err, PyObject * op_dict, int* return_type)
         return err->code;
     }
     *return_type = int64_return_type;
-    PyObject* py_inverted = PyDict_GetItemString(op_dict, AS_PY_RETURN_INVERTED_KEY); //NOT A MAGIC STRING
+    PyObject* py_inverted = operation_get(op_dict, AS_OP_FIELD_INVERTED, AS_PY_RETURN_INVERTED_KEY); //NOT A MAGIC STRING
 
     if (py_inverted) {
         py_bool_val = PyObject_IsTrue(py_inverted);
@@ -4,6 +4,26 @@
 #include "exceptions.h"
 #include "policy.h"
 #include "conversions.h"
+#include "operation.h"
+
+/*
+Look up an entry of an operation, reading the slot of an aerospike.Operation
+for the entries it holds.
+*/
+static PyObject*
+get_op_entry(PyObject * op_dict, const char* key)
+{
+        if (AerospikeOperation_Check(op_dict)) {
+            if (!strcmp(key, AS_PY_VAL_KEY)) {
+                return ((AerospikeOperation *) op_dict)->fields[AS_OP_FIELD_VAL];
+            }
+            if (!strcmp(key, "return_type")) {
+                return ((AerospikeOperation *) op_dict)->fields[AS_OP_FIELD_RETURN_TYPE];
+            }
+        }
+        return operation_get_entry(op_dict, key);
+}
+
 /*
 The caller of this does not own the pointer to binName, and should not free it. It is either
 held by Python, or is added to the list of chars to free later.
@@ -14,7 +34,7 @@ get_bin(as_error * err, PyObject * op_dict, as_vector * unicodeStrVector, char**
 {
         PyObject* intermediateUnicode = NULL;
 
-        PyObject* py_bin = PyDict_GetItemString(op_dict, AS_PY_BIN_KEY);
+        PyObject* py_bin = operation_get(op_dict, AS_OP_FIELD_BIN, AS_PY_BIN_KEY);
 
         if (!py_bin) {
             return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation must contain a \"bin\" entry");
@@ -43,7 +63,7 @@ get_asval(AerospikeClient * self, as_error * err, char* key, PyObject * op_dict,
              as_static_pool * static_pool, int serializer_type, bool required)
 {
         *val = NULL;
-        PyObject* py_val = PyDict_GetItemString(op_dict, key);
+        PyObject* py_val = get_op_entry(op_dict, key);
         if (!py_val) {
             if (required) {  
                 return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation must contain a \"%s\" entry", key);
@@ -66,7 +86,7 @@ as_status
 get_val_list(AerospikeClient * self, as_error * err, const char* list_key, PyObject * op_dict, as_list** list_val, as_static_pool * static_pool, int serializer_type)
 {
         *list_val = NULL;
-        PyObject* py_val = PyDict_GetItemString(op_dict, list_key);
+        PyObject* py_val = operation_get_entry(op_dict, list_key);
         if (!py_val) {
             return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation must contain a \"values\" entry");
         }
@@ -93,7 +113,7 @@ as_status
 get_optional_int64_t(as_error * err, const char* key,  PyObject * op_dict, int64_t* i64_valptr, bool* found)
 {
         *found = false;
-        PyObject* py_val = PyDict_GetItemString(op_dict, key);
+        PyObject* py_val = get_op_entry(op_dict, key);
         if (!py_val) {
             return AEROSPIKE_OK;
         }
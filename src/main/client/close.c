@@ -55,10 +55,21 @@ PyObject * AerospikeClient_Close(AerospikeClient * self, PyObject * args, PyObje
 		goto CLEANUP;
 	}
 
-	if (!self->is_conn_16) {
+	if (!self->is_conn_16 || self->background.closing) {
 		goto CLEANUP;
 	}
 
+	// The GIL is released until the cluster is closed, nothing new may use it
+	// meanwhile. Write queues and counter buffers send what is pending first.
+	self->background.closing = true;
+	AerospikeClient_Stop_Background(self);
+
+	Py_BEGIN_ALLOW_THREADS
+	as_conn_warmer_stop(&self->warmer);
+	as_read_router_stop(self->read_router);
+	as_hedger_stop(&self->hedger);
+	Py_END_ALLOW_THREADS
+
 	if (self->use_shared_connection) {
 		alias_to_search = return_search_string(self->as);
 		py_persistent_item = PyDict_GetItemString(py_global_hosts, alias_to_search);
@@ -78,6 +89,7 @@ PyObject * AerospikeClient_Close(AerospikeClient * self, PyObject * args, PyObje
 		aerospike_close(self->as, &err);
 	}
 	self->is_conn_16 = false;
+	self->background.closing = false;
 
 CLEANUP:
 	if (err.code != AEROSPIKE_OK) {
@@ -144,9 +156,13 @@ char* return_search_string(aerospike *as)
 void close_aerospike_object(aerospike *as, as_error *err, char *alias_to_search, PyObject *py_persistent_item, bool do_destroy)
 {
 	if (((AerospikeGlobalHosts*)py_persistent_item)->ref_cnt == 1) {
+		bool inherited = ((AerospikeGlobalHosts*)py_persistent_item)->fork_generation != as_fork_generation;
 		PyDict_DelItemString(py_global_hosts, alias_to_search);
 		AerospikeGlobalHosts_Del(py_persistent_item);
-		aerospike_close(as, err);
+		// A cluster inherited from the parent process can not be closed, see client/fork.c
+		if (!inherited) {
+			aerospike_close(as, err);
+		}
 	} else {
 		((AerospikeGlobalHosts*)py_persistent_item)->ref_cnt--;
 	}
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/as_error.h>
+
+#include "client.h"
+#include "compiled_policy.h"
+#include "conversions.h"
+#include "exceptions.h"
+
+/**
+ *******************************************************************************************************
+ * Compiles a policy of the given kind from the keyword arguments.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  Positional arguments, none are accepted
+ * @param kwds                  The policy fields
+ * @param kind                  The commands the policy is for
+ *
+ * Returns an aerospike.Policy.
+ * In case of error,appropriate exceptions will be raised.
+ *******************************************************************************************************
+ */
+static PyObject * AerospikeClient_CompilePolicy(AerospikeClient * self, PyObject * args, PyObject * kwds,
+		as_policy_kind kind)
+{
+	// Initialize error
+	as_error err;
+	as_error_init(&err);
+
+	AerospikePolicy * policy = NULL;
+
+	if (args && PyTuple_Size(args) > 0) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Policy fields must be given as keyword arguments");
+		goto CLEANUP;
+	}
+
+	// Compiling only converts, it does not need a connection.
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	policy = AerospikePolicy_New(self, &err, kind, kwds);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return (PyObject *) policy;
+}
+
+PyObject * AerospikeClient_ReadPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return AerospikeClient_CompilePolicy(self, args, kwds, AS_POLICY_KIND_READ);
+}
+
+PyObject * AerospikeClient_WritePolicy(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return AerospikeClient_CompilePolicy(self, args, kwds, AS_POLICY_KIND_WRITE);
+}
+
+PyObject * AerospikeClient_OperatePolicy(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return AerospikeClient_CompilePolicy(self, args, kwds, AS_POLICY_KIND_OPERATE);
+}
+
+PyObject * AerospikeClient_RemovePolicy(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return AerospikeClient_CompilePolicy(self, args, kwds, AS_POLICY_KIND_REMOVE);
+}
+
+PyObject * AerospikeClient_ApplyPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return AerospikeClient_CompilePolicy(self, args, kwds, AS_POLICY_KIND_APPLY);
+}
+
+PyObject * AerospikeClient_BatchPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return AerospikeClient_CompilePolicy(self, args, kwds, AS_POLICY_KIND_BATCH);
+}
+
+PyObject * AerospikeClient_ScanPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return AerospikeClient_CompilePolicy(self, args, kwds, AS_POLICY_KIND_SCAN);
+}
+
+PyObject * AerospikeClient_QueryPolicy(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return AerospikeClient_CompilePolicy(self, args, kwds, AS_POLICY_KIND_QUERY);
+}
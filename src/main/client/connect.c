@@ -47,8 +47,12 @@ PyObject * AerospikeClient_Connect(AerospikeClient * self, PyObject * args, PyOb
 	bool free_alias_to_search = false;
 	PyObject * py_username = NULL;
 	PyObject * py_password = NULL;
+	PyObject * py_warmup = NULL;
 
-	if (PyArg_ParseTuple(args, "|OO:connect", &py_username, &py_password) == false) {
+	static char * kwlist[] = {"username", "password", "warmup", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|OOO:connect", kwlist,
+			&py_username, &py_password, &py_warmup) == false) {
 		return NULL;
 	}
 
@@ -81,6 +85,7 @@ PyObject * AerospikeClient_Connect(AerospikeClient * self, PyObject * args, PyOb
 				}
 				self->as = as;
 				self->as->config.shm_key = ((AerospikeGlobalHosts*)py_persistent_item)->shm_key;
+				self->fork_generation = ((AerospikeGlobalHosts*)py_persistent_item)->fork_generation;
 
 				//Increase ref count of global host entry
 				((AerospikeGlobalHosts*)py_persistent_item)->ref_cnt++;
@@ -101,9 +106,9 @@ PyObject * AerospikeClient_Connect(AerospikeClient * self, PyObject * args, PyOb
 	int flag = 0;
 	int shm_key;
 	if (self->as->config.use_shm) {
-		if (user_shm_key) {
+		if (self->user_shm_key) {
 			shm_key = self->as->config.shm_key;
-			user_shm_key = false;
+			self->user_shm_key = false;
 		} else {
 			shm_key = counter;
 		}
@@ -130,6 +135,7 @@ PyObject * AerospikeClient_Connect(AerospikeClient * self, PyObject * args, PyOb
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
+	self->fork_generation = as_fork_generation;
 	if (self->use_shared_connection) {
 		PyObject * py_newobject = (PyObject *)AerospikeGobalHosts_New(self->as);
 		PyDict_SetItemString(py_global_hosts, alias_to_search, py_newobject);
@@ -151,6 +157,16 @@ CLEANUP:
 		Py_DECREF(py_err);
 		return NULL;
 	}
+
+	// Best effort, the pools fill on demand if the connections can not be opened.
+	if (self->min_conns_per_node && (!py_warmup || PyObject_IsTrue(py_warmup))) {
+		Py_BEGIN_ALLOW_THREADS
+		as_conn_warmup(self->as, self->min_conns_per_node);
+		Py_END_ALLOW_THREADS
+	}
+	as_conn_warmer_start(&self->warmer, self->as, self->min_conns_per_node, self->max_idle_conns_per_node);
+	as_read_router_start(self->read_router, self->as);
+
 	self->is_conn_16 = true;
 	self->has_connected = true;
 	Py_INCREF(self);
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "counter_buffer.h"
+#include "exceptions.h"
+
+#define COUNTER_BUFFER_DEFAULT_FLUSH_INTERVAL_MS 100
+#define COUNTER_BUFFER_DEFAULT_MAX_KEYS 10000
+
+/**
+ *******************************************************************************************************
+ * Creates a buffer of increments, written in the background as one operate
+ * command per key.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns an aerospike.CounterBuffer.
+ * In case of error,appropriate exceptions will be raised.
+ *******************************************************************************************************
+ */
+PyObject * AerospikeClient_Counter_Buffer(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	unsigned int flush_interval_ms = COUNTER_BUFFER_DEFAULT_FLUSH_INTERVAL_MS;
+	unsigned int max_keys = COUNTER_BUFFER_DEFAULT_MAX_KEYS;
+	PyObject * py_on_error = NULL;
+	AerospikeCounterBuffer * py_buffer = NULL;
+
+	static char * kwlist[] = {"flush_interval_ms", "max_keys", "on_error", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|IIO:counter_buffer", kwlist,
+			&flush_interval_ms, &max_keys, &py_on_error) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	if (py_on_error && py_on_error != Py_None && !PyCallable_Check(py_on_error)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "on_error must be callable");
+		goto CLEANUP;
+	}
+
+	py_buffer = AerospikeCounterBuffer_New(self, &err, flush_interval_ms, max_keys,
+			py_on_error ? py_on_error : Py_None);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return (PyObject *) py_buffer;
+}
@@ -26,6 +26,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 /**
  *******************************************************************************************************
@@ -49,6 +50,7 @@ extern PyObject * AerospikeClient_Exists_Invoke(
 	as_error err;
 	as_policy_read read_policy;
 	as_policy_read * read_policy_p = NULL;
+	as_predexp_list predexp_list;
 	as_key key;
 	as_record * rec = NULL;
 
@@ -78,15 +80,19 @@ extern PyObject * AerospikeClient_Exists_Invoke(
 
 	// Convert python policy object to as_policy_exists
 	pyobject_to_policy_read(&err, py_policy, &read_policy, &read_policy_p,
-			&self->as->config.policies.read);
+			&self->as->config.policies.read, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
+	uint64_t routed_ns = as_read_router_route(self->read_router, &self->as->config.policies.read,
+			&read_policy, &read_policy_p);
+
 	// Invoke operation
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_key_exists(self->as, &err, read_policy_p, &key, &rec);
 	Py_END_ALLOW_THREADS
+	as_read_router_record(self->read_router, routed_ns);
 
 	if (err.code == AEROSPIKE_OK) {
 		PyObject * py_result_key = NULL;
@@ -117,6 +123,8 @@ extern PyObject * AerospikeClient_Exists_Invoke(
 	}
 
 CLEANUP:
+	PREDEXP_LIST_DESTROY(read_policy_p, &predexp_list);
+
 
 	if (key_initialised == true) {
 		// Destroy the key if it is initialised successfully.
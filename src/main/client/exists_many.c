@@ -28,6 +28,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 
 typedef struct _exists_many_cb_data {
@@ -138,6 +139,11 @@ static PyObject * batch_exists_aerospike_batch_exists(as_error *err, AerospikeCl
 	as_error_init(&local_err);
 	cb_data.py_recs = NULL;
 	cb_data.cb_err = &local_err;
+	as_latency_timer timer;
+	as_trace_span span;
+
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_BATCH);
+	as_trace_begin(&span, AS_LATENCY_BATCH);
 
 	// Convert python keys list to as_key ** and add it to as_batch.keys
 	// keys can be specified in PyList or PyTuple
@@ -205,11 +211,17 @@ static PyObject * batch_exists_aerospike_batch_exists(as_error *err, AerospikeCl
 		goto CLEANUP;
 	}
 
-	// Invoke C-client API
+	if (batch.keys.size) {
+		as_trace_key(&span, as_batch_keyat(&batch, 0));
+	}
+
+	// Invoke C-client API, the results are converted by the callback
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_batch_exists(self->as, err, batch_policy_p, &batch,
 			(aerospike_batch_read_callback) batch_exists_cb, &cb_data);
 	Py_END_ALLOW_THREADS
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 	if (err->code != AEROSPIKE_OK) {
 		as_error_update(err, err->code, NULL);
 		Py_CLEAR(cb_data.py_recs);
@@ -220,6 +232,7 @@ static PyObject * batch_exists_aerospike_batch_exists(as_error *err, AerospikeCl
 	}
 
 CLEANUP:
+	as_trace_end(&span, err);
 	if (batch_initialised == true) {
 		// We should destroy batch object as we are using 'as_batch_init' for initialisation
 		// Also, pyobject_to_key is soing strdup() in case of Unicode. So, object destruction
@@ -252,6 +265,7 @@ PyObject * AerospikeClient_Exists_Many_Invoke(
 	as_error err;
 	as_policy_batch policy;
 	as_policy_batch * batch_policy_p = NULL;
+	as_predexp_list predexp_list;
 	// Initialize error
 	as_error_init(&err);
 
@@ -267,7 +281,7 @@ PyObject * AerospikeClient_Exists_Many_Invoke(
 
 	// Convert python policy object to as_policy_batch
 	pyobject_to_policy_batch(&err, py_policy, &policy, &batch_policy_p,
-			&self->as->config.policies.batch);
+			&self->as->config.policies.batch, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
@@ -277,6 +291,8 @@ PyObject * AerospikeClient_Exists_Many_Invoke(
 
 
 CLEANUP:
+	PREDEXP_LIST_DESTROY(batch_policy_p, &predexp_list);
+
 
 	if (err.code != AEROSPIKE_OK) {
 		PyObject * py_err = NULL;
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/as_error.h>
+
+#include "client.h"
+#include "global_hosts.h"
+#include "log.h"
+
+/*
+ * A cluster connected before a fork is unusable in the child: its tend
+ * thread was not forked, and its sockets and mutexes are shared with, or
+ * were held by, the parent. The child can not close it either, as closing
+ * joins the tend thread, so it is left as it is and a new one is connected
+ * from the same config on the first use of the client in the child.
+ *
+ * With shared memory enabled, the new cluster attaches to the segment kept
+ * up to date by the parent, so the child starts with the partition map
+ * rather than discovering the cluster.
+ */
+
+volatile uint32_t as_fork_generation = 0;
+
+static void fork_child(void)
+{
+	// Only the forking thread exists in the child, so this does not race.
+	as_fork_generation++;
+	as_log_after_fork();
+}
+
+void as_fork_handlers_install(void)
+{
+	pthread_atfork(NULL, NULL, fork_child);
+}
+
+as_status AerospikeClient_Check_Fork(AerospikeClient * self, as_error * err)
+{
+	as_error_reset(err);
+
+	if (!self->as || !self->is_conn_16 || self->fork_generation == as_fork_generation) {
+		return err->code;
+	}
+
+	aerospike * inherited = self->as;
+	AerospikeGlobalHosts * global_host = NULL;
+
+	as_conn_warmer_after_fork(&self->warmer);
+	as_read_router_after_fork(self->read_router);
+	as_hedger_after_fork(&self->hedger);
+	as_near_cache_after_fork(self->near_cache);
+
+	if (self->use_shared_connection) {
+		char * alias_to_search = return_search_string(inherited);
+		global_host = (AerospikeGlobalHosts *) PyDict_GetItemString(py_global_hosts, alias_to_search);
+		PyMem_Free(alias_to_search);
+
+		// Another client sharing the connection reconnected it already.
+		if (global_host && global_host->as != inherited &&
+				global_host->fork_generation == as_fork_generation) {
+			self->as = global_host->as;
+			self->fork_generation = as_fork_generation;
+			as_conn_warmer_start(&self->warmer, self->as, self->min_conns_per_node, self->max_idle_conns_per_node);
+			as_read_router_start(self->read_router, self->as);
+			return err->code;
+		}
+
+		if (global_host && global_host->as != inherited) {
+			global_host = NULL;
+		}
+	}
+
+	// The inherited cluster is never used again, so its config memory may be shared.
+	aerospike * as = aerospike_new(&inherited->config);
+
+	// The GIL is kept, so other threads do not use the client meanwhile.
+	aerospike_connect(as, err);
+
+	self->as = as;
+	self->fork_generation = as_fork_generation;
+
+	if (err->code != AEROSPIKE_OK) {
+		// Its commands raise until connect() succeeds.
+		self->is_conn_16 = false;
+		return err->code;
+	}
+
+	if (global_host) {
+		global_host->as = as;
+		global_host->fork_generation = as_fork_generation;
+	}
+
+	as_conn_warmer_start(&self->warmer, self->as, self->min_conns_per_node, self->max_idle_conns_per_node);
+	as_read_router_start(self->read_router, self->as);
+	return err->code;
+}
+
+void AerospikeClient_Fork_Ready(AerospikeClient * self)
+{
+	if (self->fork_generation != as_fork_generation) {
+		as_error err;
+		as_error_init(&err);
+		AerospikeClient_Check_Fork(self, &err);
+	}
+}
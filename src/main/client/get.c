@@ -26,6 +26,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 /**
  *******************************************************************************************************
@@ -51,8 +52,12 @@ PyObject * AerospikeClient_Get_Invoke(
 	as_error err;
 	as_policy_read read_policy;
 	as_policy_read * read_policy_p = NULL;
+	as_predexp_list predexp_list;
 	as_key key;
 	as_record * rec = NULL;
+	as_latency_timer timer;
+	as_trace_span span;
+	uint32_t near_cache_epoch = 0;
 
 	// Initialised flags
 	bool key_initialised = false;
@@ -60,6 +65,7 @@ PyObject * AerospikeClient_Get_Invoke(
 
 	// Initialize error
 	as_error_init(&err);
+	as_trace_begin(&span, AS_LATENCY_GET);
 
 	if (!self || !self->as) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
@@ -71,6 +77,8 @@ PyObject * AerospikeClient_Get_Invoke(
 		goto CLEANUP;
 	}
 
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_GET);
+
 	// Convert python key object to as_key
 	pyobject_to_key(&err, py_key, &key);
 	if (err.code != AEROSPIKE_OK) {
@@ -78,21 +86,44 @@ PyObject * AerospikeClient_Get_Invoke(
 	}
 	// Key is successfully initialised.
 	key_initialised = true;
+	as_trace_key(&span, &key);
 
 	// Convert python policy object to as_policy_exists
 	pyobject_to_policy_read(&err, py_policy, &read_policy, &read_policy_p,
-			&self->as->config.policies.read);
+			&self->as->config.policies.read, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
 
+	// Served from the near cache, or failed validating it
+	if (as_near_cache_get(self->near_cache, self->as, &err, read_policy_p, &key,
+			&near_cache_epoch, &py_rec)) {
+		goto CLEANUP;
+	}
+
+	uint32_t hedge_delay_ms;
+	if (as_hedge_delay(&self->hedger, &err, py_policy, read_policy_p, &hedge_delay_ms) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	uint64_t routed_ns = as_read_router_route(self->read_router, &self->as->config.policies.read,
+			&read_policy, &read_policy_p);
+
 	// Invoke operation
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
-	aerospike_key_get(self->as, &err, read_policy_p, &key, &rec);
+	if (hedge_delay_ms) {
+		as_hedge_read(&self->hedger, self->as, &err, read_policy_p, &key, NULL, hedge_delay_ms, &rec);
+	} else {
+		aerospike_key_get(self->as, &err, read_policy_p, &key, &rec);
+	}
 	Py_END_ALLOW_THREADS
+	as_read_router_record(self->read_router, routed_ns);
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 	if (err.code == AEROSPIKE_OK) {
 		record_initialised = true;
+		as_trace_record(&span, rec);
 
 		if (record_to_pyobject(self, &err, rec, &key, &py_rec) != AEROSPIKE_OK) {
 			goto CLEANUP;
@@ -108,12 +139,17 @@ PyObject * AerospikeClient_Get_Invoke(
 			Py_INCREF(Py_None);
 			PyTuple_SetItem(p_key, 2, Py_None);
 		}
+		as_near_cache_put(self->near_cache, &key, near_cache_epoch, rec, py_rec);
+		as_latency_timer_mark(&timer, AS_LATENCY_TO_PYTHON);
 	}
 	else {
 		as_error_update(&err, err.code, NULL);
 	}
 
 CLEANUP:
+	as_trace_end(&span, &err);
+	PREDEXP_LIST_DESTROY(read_policy_p, &predexp_list);
+
 
 	if (key_initialised == true) {
 		// Destroy key only if it is initialised.
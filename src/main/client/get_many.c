@@ -25,9 +25,11 @@
 #include <aerospike/as_batch.h>
 
 #include "client.h"
+#include "columnar.h"
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 #define MAX_STACK_ALLOCATION 4000
 
@@ -41,11 +43,12 @@
  * @param self                  AerospikeClient object
  * @param py_keys               The list of keys
  * @param batch_policy_p        as_policy_batch object
+ * @param columnar              Return the records as columns, one row per key
  *
  * Returns the record if key exists otherwise NULL.
  *******************************************************************************************************
  */
-static PyObject * batch_get_aerospike_batch_read(as_error *err, AerospikeClient * self, PyObject *py_keys, as_policy_batch * batch_policy_p)
+static PyObject * batch_get_aerospike_batch_read(as_error *err, AerospikeClient * self, PyObject *py_keys, as_policy_batch * batch_policy_p, bool columnar)
 {
 	PyObject * py_recs = NULL;
 
@@ -54,6 +57,11 @@ static PyObject * batch_get_aerospike_batch_read(as_error *err, AerospikeClient
 	// Initialisation flags
 	bool batch_initialised = false;
 	as_batch_read_record* record = NULL;
+	as_latency_timer timer;
+	as_trace_span span;
+
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_BATCH);
+	as_trace_begin(&span, AS_LATENCY_BATCH);
 
 	// Convert python keys list to as_key ** and add it to as_batch.keys
 	// keys can be specified in PyList or PyTuple
@@ -123,16 +131,49 @@ static PyObject * batch_get_aerospike_batch_read(as_error *err, AerospikeClient
 	}
 
 	// Invoke C-client API
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_batch_read(self->as, err, batch_policy_p, &records);
 	Py_END_ALLOW_THREADS
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
+	as_trace_batch_read(&span, &records);
 	if (err->code != AEROSPIKE_OK)
 	{
 		goto CLEANUP;
 	}
+
+	if (columnar) {
+		// Rows follow the order of the keys, missing records are rows of nulls.
+		AerospikeColumnar * py_columnar = AerospikeColumnar_New();
+		py_recs = (PyObject *) py_columnar;
+		if (!py_columnar) {
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate results");
+			goto CLEANUP;
+		}
+
+		Py_BEGIN_ALLOW_THREADS
+		for (uint32_t i = 0; i < records.list.size; i++) {
+			as_batch_read_record * r = as_vector_get(&records.list, i);
+			if (as_columns_append_record(&py_columnar->columns, err,
+					r->result == AEROSPIKE_OK ? &r->record : NULL) != AEROSPIKE_OK) {
+				break;
+			}
+		}
+		Py_END_ALLOW_THREADS
+
+		if (err->code != AEROSPIKE_OK) {
+			Py_CLEAR(py_recs);
+		} else {
+			as_latency_timer_mark(&timer, AS_LATENCY_TO_PYTHON);
+		}
+		goto CLEANUP;
+	}
+
 	batch_read_records_to_pyobject(self, err, &records, &py_recs);
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_PYTHON);
 
 CLEANUP:
+	as_trace_end(&span, err);
 	if (batch_initialised == true) {
 		// We should destroy batch object as we are using 'as_batch_init' for initialisation
 		// Also, pyobject_to_key is doing strdup() in case of Unicode. So, object destruction
@@ -160,6 +201,7 @@ CLEANUP:
  * @param self                  AerospikeClient object
  * @param py_keys               The list of keys
  * @param py_policy             The dictionary of policies
+ * @param py_format             The result format, None or "columnar"
  *
  * Returns the record if key exists otherwise NULL.
  *******************************************************************************************************
@@ -167,7 +209,7 @@ CLEANUP:
 static
 PyObject * AerospikeClient_Get_Many_Invoke(
 	AerospikeClient * self,
-	PyObject * py_keys, PyObject * py_policy)
+	PyObject * py_keys, PyObject * py_policy, PyObject * py_format)
 {
 	// Python Return Value
 	PyObject * py_recs = NULL;
@@ -176,6 +218,8 @@ PyObject * AerospikeClient_Get_Many_Invoke(
 	as_error err;
 	as_policy_batch policy;
 	as_policy_batch * batch_policy_p = NULL;
+	as_predexp_list predexp_list;
+	bool columnar = false;
 	// Initialize error
 	as_error_init(&err);
 
@@ -191,16 +235,22 @@ PyObject * AerospikeClient_Get_Many_Invoke(
 
 	// Convert python policy object to as_policy_batch
 	pyobject_to_policy_batch(&err, py_policy, &policy, &batch_policy_p,
-			&self->as->config.policies.batch);
+			&self->as->config.policies.batch, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
 
-	py_recs = batch_get_aerospike_batch_read(&err, self, py_keys, batch_policy_p);
+	if (pyobject_to_result_format(&err, py_format, &columnar) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	py_recs = batch_get_aerospike_batch_read(&err, self, py_keys, batch_policy_p, columnar);
 
 
 CLEANUP:
+	PREDEXP_LIST_DESTROY(batch_policy_p, &predexp_list);
+
 	if (err.code != AEROSPIKE_OK) {
 		PyObject * py_err = NULL;
 		error_to_pyobject(&err, &py_err);
@@ -238,16 +288,17 @@ PyObject * AerospikeClient_Get_Many(AerospikeClient * self, PyObject * args, PyO
 	// Python Function Arguments
 	PyObject * py_keys = NULL;
 	PyObject * py_policy = NULL;
+	PyObject * py_format = NULL;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"keys", "policy", NULL};
+	static char * kwlist[] = {"keys", "policy", "format", NULL};
 
 	// Python Function Argument Parsing
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "O|O:get_many", kwlist,
-			&py_keys, &py_policy) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O|OO:get_many", kwlist,
+			&py_keys, &py_policy, &py_format) == false) {
 		return NULL;
 	}
 
 	// Invoke Operation
-	return AerospikeClient_Get_Many_Invoke(self, py_keys, py_policy);
+	return AerospikeClient_Get_Many_Invoke(self, py_keys, py_policy, py_format);
 }
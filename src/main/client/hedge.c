@@ -0,0 +1,499 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_bin.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_record.h>
+
+#include "hedge.h"
+#include "macros.h"
+
+// Reads recorded before hedge_percentile is used
+#define HEDGE_MIN_SAMPLES 100
+
+// Past this many reads, the counts are halved so recent reads weigh more.
+#define HEDGE_DECAY_SAMPLES (1 << 16)
+
+typedef struct as_hedge_request_s as_hedge_request;
+
+struct as_hedge_task_s {
+	as_hedge_task * next;
+	as_hedge_request * req;
+	uint32_t attempt;
+};
+
+typedef struct {
+	as_policy_read policy;
+	as_error err;
+	as_record * rec;
+	bool done;
+} as_hedge_attempt;
+
+/*
+ * Shared by the caller and the workers running its attempts, under the lock
+ * of the hedger. The key and bins are copies, as the loser may outlive the
+ * call.
+ */
+struct as_hedge_request_s {
+	aerospike * as;
+	as_key key;
+	char (* bin_names)[AS_BIN_NAME_MAX_SIZE];
+	const char ** bins;
+	pthread_cond_t cond;                // signalled when an attempt is done
+	uint32_t refs;
+	uint32_t started;
+	int winner;
+	as_hedge_attempt attempts[2];
+	as_hedge_task tasks[2];
+};
+
+static void hedge_deadline(struct timespec * ts, uint32_t ms)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	uint64_t ns = (uint64_t) now.tv_usec * 1000 + (uint64_t) ms * 1000000;
+	ts->tv_sec = now.tv_sec + (time_t) (ns / 1000000000);
+	ts->tv_nsec = (long) (ns % 1000000000);
+}
+
+static as_hedge_request * hedge_request_new(aerospike * as, const as_policy_read * policy,
+		const as_key * key, const char ** bins)
+{
+	as_digest * digest = as_key_digest((as_key *) key);
+	if (!digest) {
+		return NULL;
+	}
+
+	as_hedge_request * req = calloc(1, sizeof(as_hedge_request));
+	if (!req) {
+		return NULL;
+	}
+
+	uint32_t n_bins = 0;
+	while (bins && bins[n_bins]) {
+		n_bins++;
+	}
+
+	if (bins) {
+		req->bin_names = calloc(n_bins ? n_bins : 1, AS_BIN_NAME_MAX_SIZE);
+		req->bins = calloc(n_bins + 1, sizeof(char *));
+		if (!req->bin_names || !req->bins) {
+			free(req->bin_names);
+			free(req->bins);
+			free(req);
+			return NULL;
+		}
+		for (uint32_t i = 0; i < n_bins; i++) {
+			strncpy(req->bin_names[i], bins[i], AS_BIN_NAME_MAX_SIZE - 1);
+			req->bins[i] = req->bin_names[i];
+		}
+	}
+
+	// Reads do not send the user key, the digest is enough.
+	as_key_init_digest(&req->key, key->ns, key->set, digest->value);
+
+	req->as = as;
+	pthread_cond_init(&req->cond, NULL);
+	req->refs = 1;
+	req->winner = -1;
+	req->attempts[0].policy = *policy;
+	req->attempts[0].policy.key = AS_POLICY_KEY_DIGEST;
+
+	for (uint32_t i = 0; i < 2; i++) {
+		as_error_init(&req->attempts[i].err);
+		req->tasks[i].req = req;
+		req->tasks[i].attempt = i;
+	}
+	return req;
+}
+
+static void hedge_request_release(as_hedge_request * req)
+{
+	if (--req->refs) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < 2; i++) {
+		if (req->attempts[i].rec) {
+			as_record_destroy(req->attempts[i].rec);
+		}
+	}
+
+	pthread_cond_destroy(&req->cond);
+	as_key_destroy(&req->key);
+	free(req->bin_names);
+	free(req->bins);
+	free(req);
+}
+
+static void hedge_execute(as_hedge_request * req, uint32_t i)
+{
+	as_hedge_attempt * attempt = &req->attempts[i];
+
+	if (req->bins) {
+		aerospike_key_select(req->as, &attempt->err, &attempt->policy, &req->key, req->bins, &attempt->rec);
+	} else {
+		aerospike_key_get(req->as, &attempt->err, &attempt->policy, &req->key, &attempt->rec);
+	}
+}
+
+/*
+ * A timeout or connection error of one attempt leaves the other to answer, if
+ * it is still running.
+ */
+static bool hedge_is_final(as_hedge_request * req, uint32_t i)
+{
+	as_status code = req->attempts[i].err.code;
+
+	if (code != AEROSPIKE_ERR_TIMEOUT && code != AEROSPIKE_ERR_CONNECTION) {
+		return true;
+	}
+
+	for (uint32_t j = 0; j < req->started; j++) {
+		if (j != i && !req->attempts[j].done) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void * hedge_worker(void * udata)
+{
+	as_hedger * hedger = (as_hedger *) udata;
+
+	pthread_mutex_lock(&hedger->lock);
+
+	while (true) {
+		while (!hedger->head && !hedger->stopping) {
+			hedger->n_idle++;
+			pthread_cond_wait(&hedger->cond, &hedger->lock);
+			hedger->n_idle--;
+		}
+
+		// Queued reads are run even when stopping, their callers wait for them.
+		as_hedge_task * task = hedger->head;
+		if (!task) {
+			break;
+		}
+
+		hedger->head = task->next;
+		if (!hedger->head) {
+			hedger->tail = NULL;
+		}
+		hedger->n_queued--;
+
+		pthread_mutex_unlock(&hedger->lock);
+		hedge_execute(task->req, task->attempt);
+		pthread_mutex_lock(&hedger->lock);
+
+		as_hedge_request * req = task->req;
+		req->attempts[task->attempt].done = true;
+
+		if (req->winner < 0 && hedge_is_final(req, task->attempt)) {
+			req->winner = (int) task->attempt;
+			pthread_cond_signal(&req->cond);
+		}
+		hedge_request_release(req);
+	}
+
+	pthread_mutex_unlock(&hedger->lock);
+	return NULL;
+}
+
+/*
+ * Queue an attempt, starting a worker if none is idle for it. First attempts
+ * go ahead of the queued hedges, so a read is never sent late because of
+ * the others. Called with the lock held.
+ */
+static bool hedge_submit(as_hedger * hedger, as_hedge_task * task, bool first)
+{
+	if (hedger->stopping) {
+		return false;
+	}
+
+	if (hedger->n_idle <= hedger->n_queued && hedger->n_threads < AS_HEDGE_MAX_THREADS) {
+		if (pthread_create(&hedger->threads[hedger->n_threads], NULL, hedge_worker, hedger) == 0) {
+			hedger->n_threads++;
+		}
+	}
+
+	if (!hedger->n_threads) {
+		return false;
+	}
+
+	if (first) {
+		task->next = hedger->head;
+		hedger->head = task;
+		if (!hedger->tail) {
+			hedger->tail = task;
+		}
+	} else {
+		task->next = NULL;
+		if (hedger->tail) {
+			hedger->tail->next = task;
+		} else {
+			hedger->head = task;
+		}
+		hedger->tail = task;
+	}
+	hedger->n_queued++;
+
+	task->req->refs++;
+	task->req->started++;
+	pthread_cond_signal(&hedger->cond);
+	return true;
+}
+
+/*
+ * The hedge reads from any replica, within what is left of the total timeout
+ * of the first attempt. Returns false if nothing is left.
+ */
+static bool hedge_policy(as_hedge_request * req, uint64_t elapsed_ms)
+{
+	as_policy_read * policy = &req->attempts[1].policy;
+
+	*policy = req->attempts[0].policy;
+	policy->replica = AS_POLICY_REPLICA_ANY;
+
+	if (!policy->base.total_timeout) {
+		return true;
+	}
+
+	if (elapsed_ms >= policy->base.total_timeout) {
+		return false;
+	}
+
+	policy->base.total_timeout -= (uint32_t) elapsed_ms;
+	if (policy->base.socket_timeout > policy->base.total_timeout) {
+		policy->base.socket_timeout = policy->base.total_timeout;
+	}
+	return true;
+}
+
+static void hedge_record(as_hedger * hedger, uint64_t ns)
+{
+	as_latency_histogram * latency = &hedger->latency;
+
+	latency->count++;
+	latency->total_ns += ns;
+	if (ns > latency->max_ns) {
+		latency->max_ns = ns;
+	}
+	latency->buckets[as_latency_bucket(ns)]++;
+
+	if (latency->count >= HEDGE_DECAY_SAMPLES) {
+		latency->count = 0;
+		latency->total_ns /= 2;
+		latency->max_ns /= 2;
+		for (uint32_t i = 0; i < AS_LATENCY_BUCKETS; i++) {
+			latency->buckets[i] /= 2;
+			latency->count += latency->buckets[i];
+		}
+	}
+}
+
+void as_hedger_init(as_hedger * hedger)
+{
+	memset(hedger, 0, sizeof(as_hedger));
+	pthread_mutex_init(&hedger->lock, NULL);
+	pthread_cond_init(&hedger->cond, NULL);
+}
+
+void as_hedger_destroy(as_hedger * hedger)
+{
+	pthread_cond_destroy(&hedger->cond);
+	pthread_mutex_destroy(&hedger->lock);
+}
+
+void as_hedger_stop(as_hedger * hedger)
+{
+	pthread_mutex_lock(&hedger->lock);
+	hedger->stopping = true;
+	pthread_cond_broadcast(&hedger->cond);
+	uint32_t n_threads = hedger->n_threads;
+	pthread_mutex_unlock(&hedger->lock);
+
+	for (uint32_t i = 0; i < n_threads; i++) {
+		pthread_join(hedger->threads[i], NULL);
+	}
+
+	// Workers are started again by the next hedged read.
+	pthread_mutex_lock(&hedger->lock);
+	hedger->n_threads = 0;
+	hedger->stopping = false;
+	pthread_mutex_unlock(&hedger->lock);
+}
+
+void as_hedger_after_fork(as_hedger * hedger)
+{
+	// The lock may have been held by a worker when the parent forked, and the
+	// reads queued or running in the parent have no caller in the child.
+	pthread_mutex_init(&hedger->lock, NULL);
+	pthread_cond_init(&hedger->cond, NULL);
+	hedger->n_threads = 0;
+	hedger->n_idle = 0;
+	hedger->n_queued = 0;
+	hedger->stopping = false;
+	hedger->head = NULL;
+	hedger->tail = NULL;
+}
+
+as_status as_hedge_delay(as_hedger * hedger, as_error * err, PyObject * py_policy,
+		const as_policy_read * policy, uint32_t * delay_ms)
+{
+	as_error_reset(err);
+	*delay_ms = 0;
+
+	if (!py_policy || !PyDict_Check(py_policy)) {
+		return err->code;
+	}
+
+	PyObject * py_delay = PyDict_GetItemString(py_policy, "hedge_delay");
+	PyObject * py_percentile = PyDict_GetItemString(py_policy, "hedge_percentile");
+
+	if (py_delay && py_delay != Py_None) {
+		long delay = (PyInt_Check(py_delay) || PyLong_Check(py_delay)) ? PyInt_AsLong(py_delay) : 0;
+		if (delay <= 0 || delay >= AS_HEDGE_NEVER) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "hedge_delay is invalid");
+		}
+		*delay_ms = (uint32_t) delay;
+	}
+
+	if (py_percentile && py_percentile != Py_None) {
+		double percentile = PyFloat_Check(py_percentile) || PyInt_Check(py_percentile) ||
+				PyLong_Check(py_percentile) ? PyFloat_AsDouble(py_percentile) : -1;
+		if (!(percentile > 0 && percentile < 100)) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "hedge_percentile is invalid");
+		}
+
+		uint64_t ns = 0;
+		Py_BEGIN_ALLOW_THREADS
+		pthread_mutex_lock(&hedger->lock);
+		if (hedger->latency.count >= HEDGE_MIN_SAMPLES) {
+			ns = as_latency_percentile_ns(&hedger->latency, percentile);
+		}
+		pthread_mutex_unlock(&hedger->lock);
+		Py_END_ALLOW_THREADS
+
+		if (ns) {
+			uint64_t ms = (ns + 999999) / 1000000;
+			*delay_ms = ms < AS_HEDGE_NEVER ? (uint32_t) ms : AS_HEDGE_NEVER;
+		} else if (!*delay_ms) {
+			// Until enough reads are recorded, or with the hedge_delay.
+			*delay_ms = AS_HEDGE_NEVER;
+		}
+	}
+
+	// The predexps of the policy may be freed before the loser is done.
+	if (policy && policy->base.predexp) {
+		*delay_ms = 0;
+	}
+	return err->code;
+}
+
+void as_hedge_read(as_hedger * hedger, aerospike * as, as_error * err, const as_policy_read * policy,
+		const as_key * key, const char ** bins, uint32_t delay_ms, as_record ** rec)
+{
+	if (!policy) {
+		policy = &as->config.policies.read;
+	}
+
+	uint64_t start_ns = as_latency_now_ns();
+	as_hedge_request * req = hedge_request_new(as, policy, key, bins);
+
+	pthread_mutex_lock(&hedger->lock);
+
+	if (!req || !hedge_submit(hedger, &req->tasks[0], true)) {
+		pthread_mutex_unlock(&hedger->lock);
+		if (req) {
+			hedge_request_release(req);
+		}
+
+		// Read from this thread, unhedged.
+		if (bins) {
+			aerospike_key_select(as, err, policy, key, bins, rec);
+		} else {
+			aerospike_key_get(as, err, policy, key, rec);
+		}
+		return;
+	}
+
+	hedger->reads++;
+
+	if (delay_ms != AS_HEDGE_NEVER) {
+		struct timespec deadline;
+		hedge_deadline(&deadline, delay_ms);
+
+		while (req->winner < 0) {
+			if (pthread_cond_timedwait(&req->cond, &hedger->lock, &deadline) == ETIMEDOUT) {
+				break;
+			}
+		}
+
+		uint64_t elapsed_ms = (as_latency_now_ns() - start_ns) / 1000000;
+		if (req->winner < 0 && hedge_policy(req, elapsed_ms) && hedge_submit(hedger, &req->tasks[1], false)) {
+			hedger->issued++;
+		}
+	}
+
+	while (req->winner < 0) {
+		pthread_cond_wait(&req->cond, &hedger->lock);
+	}
+
+	as_hedge_attempt * winner = &req->attempts[req->winner];
+	as_error_copy(err, &winner->err);
+	*rec = winner->rec;
+	winner->rec = NULL;
+
+	if (req->winner == 1) {
+		hedger->won++;
+	}
+	hedge_record(hedger, as_latency_now_ns() - start_ns);
+	hedge_request_release(req);
+
+	pthread_mutex_unlock(&hedger->lock);
+}
+
+PyObject * as_hedger_stats(as_hedger * hedger)
+{
+	uint64_t reads, issued, won;
+
+	Py_BEGIN_ALLOW_THREADS
+	pthread_mutex_lock(&hedger->lock);
+	reads = hedger->reads;
+	issued = hedger->issued;
+	won = hedger->won;
+	pthread_mutex_unlock(&hedger->lock);
+	Py_END_ALLOW_THREADS
+
+	return Py_BuildValue("{s:K,s:K,s:K}",
+			"reads", (unsigned long long) reads,
+			"issued", (unsigned long long) issued,
+			"won", (unsigned long long) won);
+}
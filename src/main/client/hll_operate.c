@@ -0,0 +1,376 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_hll_operations.h>
+
+#include "hll_operations.h"
+#include "client.h"
+#include "cdt_operation_utils.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "operation.h"
+#include "policy.h"
+#include "serializer.h"
+
+#define POLICY_KEY  "policy"
+#define INDEX_BIT_COUNT_KEY "index_bit_count"
+#define MH_BIT_COUNT_KEY "mh_bit_count"
+
+//Dictionary field extraction functions
+
+static as_status get_hll_policy(as_error * err, PyObject * op_dict, as_hll_policy * policy);
+
+static as_status get_bit_count(as_error * err, const char * key, PyObject * op_dict, int * bit_count);
+
+static as_status
+add_op_hll_init(AerospikeClient * self, as_error * err, char * bin,
+                     PyObject * op_dict, as_operations * ops,
+                     as_static_pool * static_pool, int serializer_type);
+
+static as_status
+add_op_hll_add(AerospikeClient * self, as_error * err, char * bin,
+                     PyObject * op_dict, as_operations * ops,
+                     as_static_pool * static_pool, int serializer_type);
+
+static as_status
+add_op_hll_set_union(AerospikeClient * self, as_error * err, char * bin,
+                     PyObject * op_dict, as_operations * ops,
+                     as_static_pool * static_pool, int serializer_type);
+
+static as_status
+add_op_hll_fold(AerospikeClient * self, as_error * err, char * bin,
+                     PyObject * op_dict, as_operations * ops,
+                     as_static_pool * static_pool, int serializer_type);
+
+static as_status
+add_op_hll_read(AerospikeClient * self, as_error * err, char * bin,
+                     PyObject * op_dict, as_operations * ops,
+                     as_static_pool * static_pool, int serializer_type, long operation_code);
+
+static as_status
+add_op_hll_read_list(AerospikeClient * self, as_error * err, char * bin,
+                     PyObject * op_dict, as_operations * ops,
+                     as_static_pool * static_pool, int serializer_type, long operation_code);
+
+// End forwards
+as_status
+add_new_hll_op(AerospikeClient * self, as_error * err, PyObject * op_dict, as_vector * unicodeStrVector,
+		as_static_pool * static_pool, as_operations * ops, long operation_code, long * ret_type, int serializer_type)
+
+{
+    char* bin = NULL;
+
+    if (get_bin(err, op_dict, unicodeStrVector, &bin) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    switch(operation_code) {
+        case OP_HLL_INIT:
+            return add_op_hll_init(self, err, bin, op_dict, ops, static_pool, serializer_type);
+        case OP_HLL_ADD:
+            return add_op_hll_add(self, err, bin, op_dict, ops, static_pool, serializer_type);
+        case OP_HLL_SET_UNION:
+            return add_op_hll_set_union(self, err, bin, op_dict, ops, static_pool, serializer_type);
+        case OP_HLL_FOLD:
+            return add_op_hll_fold(self, err, bin, op_dict, ops, static_pool, serializer_type);
+        case OP_HLL_GET_COUNT:
+        case OP_HLL_DESCRIBE:
+        case OP_HLL_REFRESH_COUNT:
+            return add_op_hll_read(self, err, bin, op_dict, ops, static_pool, serializer_type, operation_code);
+        case OP_HLL_GET_UNION:
+        case OP_HLL_GET_UNION_COUNT:
+        case OP_HLL_GET_INTERSECT_COUNT:
+        case OP_HLL_GET_SIMILARITY:
+            return add_op_hll_read_list(self, err, bin, op_dict, ops, static_pool, serializer_type, operation_code);
+
+        default:
+            // This should never be possible since we only get here if we know that the operation is valid.
+            return as_error_update(err, AEROSPIKE_ERR_PARAM, "Unknown operation");
+    }
+
+	return err->code;
+}
+
+static as_status
+add_op_hll_init(AerospikeClient * self, as_error * err, char * bin, PyObject * op_dict, as_operations * ops,
+        as_static_pool * static_pool, int serializer_type)
+{
+    as_hll_policy hll_policy;
+    int index_bit_count;
+    int mh_bit_count;
+    bool ctx_in_use = false;
+    as_cdt_ctx ctx;
+
+    if (get_hll_policy(err, op_dict, &hll_policy) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_bit_count(err, INDEX_BIT_COUNT_KEY, op_dict, &index_bit_count) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_bit_count(err, MH_BIT_COUNT_KEY, op_dict, &mh_bit_count) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_cdt_ctx(self, err, &ctx, op_dict, &ctx_in_use, static_pool, serializer_type) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (! as_operations_hll_init_mh(ops, bin, (ctx_in_use ? &ctx : NULL), &hll_policy, index_bit_count, mh_bit_count)) {
+        as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add hll_init operation");
+    }
+
+    if (ctx_in_use) {
+        as_cdt_ctx_destroy(&ctx);
+    }
+
+    return err->code;
+}
+
+static as_status
+add_op_hll_add(AerospikeClient * self, as_error * err, char * bin, PyObject * op_dict, as_operations * ops,
+        as_static_pool * static_pool, int serializer_type)
+{
+    as_hll_policy hll_policy;
+    as_list * value_list = NULL;
+    int index_bit_count;
+    int mh_bit_count;
+    bool ctx_in_use = false;
+    as_cdt_ctx ctx;
+
+    if (get_hll_policy(err, op_dict, &hll_policy) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_bit_count(err, INDEX_BIT_COUNT_KEY, op_dict, &index_bit_count) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_bit_count(err, MH_BIT_COUNT_KEY, op_dict, &mh_bit_count) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_val_list(self, err, AS_PY_VALUES_KEY, op_dict, &value_list, static_pool, serializer_type) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_cdt_ctx(self, err, &ctx, op_dict, &ctx_in_use, static_pool, serializer_type) != AEROSPIKE_OK) {
+        as_val_destroy(value_list);
+        return err->code;
+    }
+
+    // The list is consumed by the operation
+    if (! as_operations_hll_add_mh(ops, bin, (ctx_in_use ? &ctx : NULL), &hll_policy, value_list,
+            index_bit_count, mh_bit_count)) {
+        as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add hll_add operation");
+    }
+
+    if (ctx_in_use) {
+        as_cdt_ctx_destroy(&ctx);
+    }
+
+    return err->code;
+}
+
+static as_status
+add_op_hll_set_union(AerospikeClient * self, as_error * err, char * bin, PyObject * op_dict, as_operations * ops,
+        as_static_pool * static_pool, int serializer_type)
+{
+    as_hll_policy hll_policy;
+    as_list * value_list = NULL;
+    bool ctx_in_use = false;
+    as_cdt_ctx ctx;
+
+    if (get_hll_policy(err, op_dict, &hll_policy) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_val_list(self, err, AS_PY_VALUES_KEY, op_dict, &value_list, static_pool, serializer_type) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_cdt_ctx(self, err, &ctx, op_dict, &ctx_in_use, static_pool, serializer_type) != AEROSPIKE_OK) {
+        as_val_destroy(value_list);
+        return err->code;
+    }
+
+    if (! as_operations_hll_set_union(ops, bin, (ctx_in_use ? &ctx : NULL), &hll_policy, value_list)) {
+        as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add hll_set_union operation");
+    }
+
+    if (ctx_in_use) {
+        as_cdt_ctx_destroy(&ctx);
+    }
+
+    return err->code;
+}
+
+static as_status
+add_op_hll_fold(AerospikeClient * self, as_error * err, char * bin, PyObject * op_dict, as_operations * ops,
+        as_static_pool * static_pool, int serializer_type)
+{
+    int64_t index_bit_count;
+    bool ctx_in_use = false;
+    as_cdt_ctx ctx;
+
+    if (get_int64_t(err, INDEX_BIT_COUNT_KEY, op_dict, &index_bit_count) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_cdt_ctx(self, err, &ctx, op_dict, &ctx_in_use, static_pool, serializer_type) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (! as_operations_hll_fold(ops, bin, (ctx_in_use ? &ctx : NULL), (int) index_bit_count)) {
+        as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add hll_fold operation");
+    }
+
+    if (ctx_in_use) {
+        as_cdt_ctx_destroy(&ctx);
+    }
+
+    return err->code;
+}
+
+/*
+ * The operations reading the bin alone.
+ */
+static as_status
+add_op_hll_read(AerospikeClient * self, as_error * err, char * bin, PyObject * op_dict, as_operations * ops,
+        as_static_pool * static_pool, int serializer_type, long operation_code)
+{
+    bool ctx_in_use = false;
+    as_cdt_ctx ctx;
+    as_cdt_ctx * ctx_ref = NULL;
+    bool success = false;
+
+    if (get_cdt_ctx(self, err, &ctx, op_dict, &ctx_in_use, static_pool, serializer_type) != AEROSPIKE_OK) {
+        return err->code;
+    }
+    ctx_ref = (ctx_in_use ? &ctx : NULL);
+
+    switch(operation_code) {
+        case OP_HLL_GET_COUNT:
+            success = as_operations_hll_get_count(ops, bin, ctx_ref);
+            break;
+        case OP_HLL_DESCRIBE:
+            success = as_operations_hll_describe(ops, bin, ctx_ref);
+            break;
+        case OP_HLL_REFRESH_COUNT:
+            success = as_operations_hll_refresh_count(ops, bin, ctx_ref);
+            break;
+    }
+
+    if (! success) {
+        as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add hll operation");
+    }
+
+    if (ctx_in_use) {
+        as_cdt_ctx_destroy(&ctx);
+    }
+
+    return err->code;
+}
+
+/*
+ * The operations reading the bin together with a list of HLL values.
+ */
+static as_status
+add_op_hll_read_list(AerospikeClient * self, as_error * err, char * bin, PyObject * op_dict, as_operations * ops,
+        as_static_pool * static_pool, int serializer_type, long operation_code)
+{
+    as_list * value_list = NULL;
+    bool ctx_in_use = false;
+    as_cdt_ctx ctx;
+    as_cdt_ctx * ctx_ref = NULL;
+    bool success = false;
+
+    if (get_val_list(self, err, AS_PY_VALUES_KEY, op_dict, &value_list, static_pool, serializer_type) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (get_cdt_ctx(self, err, &ctx, op_dict, &ctx_in_use, static_pool, serializer_type) != AEROSPIKE_OK) {
+        as_val_destroy(value_list);
+        return err->code;
+    }
+    ctx_ref = (ctx_in_use ? &ctx : NULL);
+
+    switch(operation_code) {
+        case OP_HLL_GET_UNION:
+            success = as_operations_hll_get_union(ops, bin, ctx_ref, value_list);
+            break;
+        case OP_HLL_GET_UNION_COUNT:
+            success = as_operations_hll_get_union_count(ops, bin, ctx_ref, value_list);
+            break;
+        case OP_HLL_GET_INTERSECT_COUNT:
+            success = as_operations_hll_get_intersect_count(ops, bin, ctx_ref, value_list);
+            break;
+        case OP_HLL_GET_SIMILARITY:
+            success = as_operations_hll_get_similarity(ops, bin, ctx_ref, value_list);
+            break;
+    }
+
+    if (! success) {
+        as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add hll operation");
+    }
+
+    if (ctx_in_use) {
+        as_cdt_ctx_destroy(&ctx);
+    }
+
+    return err->code;
+}
+
+static as_status
+get_hll_policy(as_error * err, PyObject * op_dict, as_hll_policy * policy) {
+	PyObject* py_hll_policy = operation_get(op_dict, AS_OP_FIELD_POLICY, POLICY_KEY);
+
+    // This handles a null policy
+    if (pyobject_to_hll_policy(err, py_hll_policy, policy) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+	return AEROSPIKE_OK;
+}
+
+/*
+ * An optional bit count, -1 when it is not given.
+ */
+static as_status
+get_bit_count(as_error * err, const char * key, PyObject * op_dict, int * bit_count) {
+    int64_t count64;
+    bool found = false;
+    *bit_count = -1;
+
+    if (get_optional_int64_t(err, key, op_dict, &count64, &found) != AEROSPIKE_OK) {
+        return err->code;
+    }
+
+    if (found) {
+        if (count64 < -1 || count64 > 64) {
+            return as_error_update(err, AEROSPIKE_ERR_PARAM, "%s is not a valid bit count", key);
+        }
+        *bit_count = (int) count64;
+    }
+
+    return AEROSPIKE_OK;
+}
@@ -70,6 +70,10 @@ static PyObject * AerospikeClient_InfoNode_Invoke(
 	long port_no;
 	char* response_p = NULL;
 	as_status status = AEROSPIKE_OK;
+	as_latency_timer timer;
+	as_trace_span span;
+
+	as_trace_begin(&span, AS_LATENCY_INFO);
 
 	if (!self || !self->as) {
 		as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
@@ -81,6 +85,8 @@ static PyObject * AerospikeClient_InfoNode_Invoke(
 		goto CLEANUP;
 	}
 
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_INFO);
+
 	if (self->as->config.hosts->size == 0) {
 		as_error_update(err, AEROSPIKE_ERR_CLUSTER, "No hosts in configuration");
 		goto CLEANUP;
@@ -151,6 +157,7 @@ static PyObject * AerospikeClient_InfoNode_Invoke(
 		goto CLEANUP;
 	}
 
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 	if (!tls_name) {
 		status = aerospike_info_host(self->as, err, info_policy_p,
@@ -162,10 +169,12 @@ static PyObject * AerospikeClient_InfoNode_Invoke(
 									   (const char *) request_str_p, &response_p);
 	}
 	Py_END_ALLOW_THREADS
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 	if (err->code == AEROSPIKE_OK) {
 		if (response_p && status == AEROSPIKE_OK) {
 			py_response = PyString_FromString(response_p);
 			free(response_p);
+			as_latency_timer_mark(&timer, AS_LATENCY_TO_PYTHON);
 		} else if (!response_p) {
 			as_error_update(err, AEROSPIKE_ERR_CLIENT, "Invalid info operation");
 			goto CLEANUP;
@@ -179,6 +188,7 @@ static PyObject * AerospikeClient_InfoNode_Invoke(
 	}
 
 CLEANUP:
+	as_trace_end(&span, err);
 
 	if (py_ustr) {
 		Py_DECREF(py_ustr);
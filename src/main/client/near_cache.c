@@ -0,0 +1,524 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_record.h>
+#include <citrusleaf/cf_clock.h>
+
+#include "conversions.h"
+#include "macros.h"
+#include "near_cache.h"
+
+#define NEAR_CACHE_DEFAULT_MAX_ENTRIES 10000
+#define NEAR_CACHE_MAX_BUCKETS (1u << 30)
+
+// The ttl of a record which never expires.
+#define NEAR_CACHE_NO_EXPIRE ((uint32_t) -1)
+
+struct as_near_cache_entry_s {
+	as_near_cache_entry * next;         // in its bucket
+	as_near_cache_entry * lru_prev;
+	as_near_cache_entry * lru_next;
+	as_namespace ns;
+	as_digest_value digest;
+	uint16_t gen;
+	uint64_t void_ms;                   // 0 if the record never expires
+	uint64_t expires_ms;                // 0 if the entry never expires
+	PyObject * py_bins;                 // owned by the cache, never returned
+};
+
+/*
+ * Digests are hashes already, so their first bytes pick the bucket.
+ */
+static uint32_t cache_bucket(as_near_cache * cache, const uint8_t * digest)
+{
+	uint32_t hash;
+	memcpy(&hash, digest, sizeof(hash));
+	return hash & (cache->n_buckets - 1);
+}
+
+static as_near_cache_entry ** cache_find(as_near_cache * cache, const char * ns, const uint8_t * digest)
+{
+	as_near_cache_entry ** link = &cache->buckets[cache_bucket(cache, digest)];
+
+	while (*link && (memcmp((*link)->digest, digest, AS_DIGEST_VALUE_SIZE) != 0 ||
+			strcmp((*link)->ns, ns) != 0)) {
+		link = &(*link)->next;
+	}
+	return link;
+}
+
+static void lru_unlink(as_near_cache * cache, as_near_cache_entry * e)
+{
+	if (e->lru_prev) {
+		e->lru_prev->lru_next = e->lru_next;
+	} else {
+		cache->head = e->lru_next;
+	}
+
+	if (e->lru_next) {
+		e->lru_next->lru_prev = e->lru_prev;
+	} else {
+		cache->tail = e->lru_prev;
+	}
+
+	e->lru_prev = NULL;
+	e->lru_next = NULL;
+}
+
+static void lru_push_front(as_near_cache * cache, as_near_cache_entry * e)
+{
+	e->lru_prev = NULL;
+	e->lru_next = cache->head;
+
+	if (cache->head) {
+		cache->head->lru_prev = e;
+	} else {
+		cache->tail = e;
+	}
+	cache->head = e;
+}
+
+/*
+ * The entry is unlinked before its bins are released, as releasing them may
+ * run Python code which uses the cache.
+ */
+static void cache_remove(as_near_cache * cache, as_near_cache_entry ** link)
+{
+	as_near_cache_entry * e = *link;
+
+	*link = e->next;
+	lru_unlink(cache, e);
+	cache->size--;
+
+	Py_XDECREF(e->py_bins);
+	free(e);
+}
+
+static uint64_t record_void_ms(uint32_t ttl, uint64_t now)
+{
+	return ttl == NEAR_CACHE_NO_EXPIRE ? 0 : now + (uint64_t) ttl * 1000;
+}
+
+static uint64_t entry_expires_ms(as_near_cache * cache, uint64_t void_ms, uint64_t now)
+{
+	if (!cache->ttl_ms) {
+		return void_ms;
+	}
+
+	uint64_t expires_ms = now + cache->ttl_ms;
+	return void_ms && void_ms < expires_ms ? void_ms : expires_ms;
+}
+
+/*
+ * Copy the bins of a record, and deeply their lists, maps and bytearrays,
+ * which the caller may change in place. Returns NULL with a Python error
+ * set on failure.
+ */
+static PyObject * bins_copy(PyObject * py_bins)
+{
+	if (!PyDict_Check(py_bins)) {
+		Py_INCREF(py_bins);
+		return py_bins;
+	}
+
+	PyObject * py_copy = PyDict_New();
+	PyObject * py_deepcopy = NULL;
+	PyObject * py_name = NULL;
+	PyObject * py_value = NULL;
+	Py_ssize_t pos = 0;
+
+	while (py_copy && PyDict_Next(py_bins, &pos, &py_name, &py_value)) {
+		PyObject * py_value_copy = NULL;
+
+		if (PyList_Check(py_value) || PyDict_Check(py_value) || PyByteArray_Check(py_value)) {
+			if (!py_deepcopy) {
+				PyObject * py_copy_module = PyImport_ImportModule("copy");
+				py_deepcopy = py_copy_module ? PyObject_GetAttrString(py_copy_module, "deepcopy") : NULL;
+				Py_XDECREF(py_copy_module);
+			}
+			py_value_copy = py_deepcopy ? PyObject_CallFunctionObjArgs(py_deepcopy, py_value, NULL) : NULL;
+		} else {
+			Py_INCREF(py_value);
+			py_value_copy = py_value;
+		}
+
+		if (!py_value_copy || PyDict_SetItem(py_copy, py_name, py_value_copy) < 0) {
+			Py_XDECREF(py_value_copy);
+			Py_CLEAR(py_copy);
+			break;
+		}
+		Py_DECREF(py_value_copy);
+	}
+
+	Py_XDECREF(py_deepcopy);
+	return py_copy;
+}
+
+/*
+ * Build the (key, meta, bins) tuple of a get from an entry. The bins are
+ * copied, so changes of the caller do not reach the cache.
+ */
+static PyObject * cache_record(as_error * err, as_near_cache_entry * e, as_policy_read * policy,
+		as_key * key, uint64_t now)
+{
+	PyObject * py_key = NULL;
+
+	if (key_to_pyobject(err, key, &py_key) != AEROSPIKE_OK) {
+		return NULL;
+	}
+
+	if (!policy || policy->key == AS_POLICY_KEY_DIGEST) {
+		// As for a get, the primary key part is None unless the key is sent.
+		Py_INCREF(Py_None);
+		PyTuple_SetItem(py_key, 2, Py_None);
+	}
+
+	unsigned long ttl = NEAR_CACHE_NO_EXPIRE;
+	if (e->void_ms) {
+		ttl = e->void_ms > now ? (unsigned long) ((e->void_ms - now + 999) / 1000) : 0;
+	}
+
+	PyObject * py_meta = Py_BuildValue("{s:k,s:k}", "ttl", ttl, "gen", (unsigned long) e->gen);
+
+	// Copying may run Python code which drops the entry.
+	PyObject * py_cached = e->py_bins;
+	Py_INCREF(py_cached);
+	PyObject * py_bins = bins_copy(py_cached);
+	Py_DECREF(py_cached);
+
+	if (!py_meta || !py_bins) {
+		Py_DECREF(py_key);
+		Py_XDECREF(py_meta);
+		Py_XDECREF(py_bins);
+		PyErr_Clear();
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to copy the cached record");
+		return NULL;
+	}
+
+	return Py_BuildValue("(NNN)", py_key, py_meta, py_bins);
+}
+
+as_status as_near_cache_new(as_error * err, PyObject * py_config, as_near_cache ** cache)
+{
+	as_error_reset(err);
+	*cache = NULL;
+
+	if (!PyDict_Check(py_config)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "near_cache must be a dict");
+	}
+
+	long max_entries = NEAR_CACHE_DEFAULT_MAX_ENTRIES;
+	PyObject * py_max_entries = PyDict_GetItemString(py_config, "max_entries");
+	if (py_max_entries) {
+		if (!PyInt_Check(py_max_entries) && !PyLong_Check(py_max_entries)) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "near_cache max_entries must be an integer");
+		}
+		max_entries = PyInt_AsLong(py_max_entries);
+		if (max_entries <= 0 || max_entries > NEAR_CACHE_MAX_BUCKETS) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "near_cache max_entries is out of range");
+		}
+	}
+
+	long ttl = 0;
+	PyObject * py_ttl = PyDict_GetItemString(py_config, "ttl");
+	if (py_ttl) {
+		if (!PyInt_Check(py_ttl) && !PyLong_Check(py_ttl)) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "near_cache ttl must be an integer");
+		}
+		ttl = PyInt_AsLong(py_ttl);
+		if (ttl < 0 || ttl > UINT32_MAX / 1000) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "near_cache ttl is out of range");
+		}
+	}
+
+	bool validate = false;
+	PyObject * py_mode = PyDict_GetItemString(py_config, "mode");
+	if (py_mode) {
+		const char * mode = PyString_Check(py_mode) ? PyString_AsString(py_mode) : NULL;
+		if (!mode || (strcmp(mode, "trust") != 0 && strcmp(mode, "validate") != 0)) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "near_cache mode must be 'trust' or 'validate'");
+		}
+		validate = strcmp(mode, "validate") == 0;
+	}
+
+	uint32_t n_buckets = 1;
+	while (n_buckets < (uint32_t) max_entries) {
+		n_buckets <<= 1;
+	}
+
+	as_near_cache * c = calloc(1, sizeof(as_near_cache));
+	as_near_cache_entry ** buckets = calloc(n_buckets, sizeof(as_near_cache_entry *));
+	uint32_t * pins = calloc(n_buckets, sizeof(uint32_t));
+	uint32_t * unpins = calloc(n_buckets, sizeof(uint32_t));
+
+	if (!c || !buckets || !pins || !unpins) {
+		free(c);
+		free(buckets);
+		free(pins);
+		free(unpins);
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to allocate the near cache");
+	}
+
+	c->validate = validate;
+	c->max_entries = (uint32_t) max_entries;
+	c->ttl_ms = (uint32_t) ttl * 1000;
+	c->n_buckets = n_buckets;
+	c->buckets = buckets;
+	c->pins = pins;
+	c->unpins = unpins;
+
+	*cache = c;
+	return err->code;
+}
+
+void as_near_cache_destroy(as_near_cache * cache)
+{
+	if (!cache) {
+		return;
+	}
+
+	as_near_cache_clear(cache);
+	free(cache->buckets);
+	free(cache->pins);
+	free(cache->unpins);
+	free(cache);
+}
+
+bool as_near_cache_get(as_near_cache * cache, aerospike * as, as_error * err,
+		as_policy_read * policy, as_key * key, uint32_t * epoch, PyObject ** py_rec)
+{
+	*epoch = 0;
+
+	// Filtered reads may not return a record which is cached.
+	if (!cache || (policy && policy->base.predexp)) {
+		return false;
+	}
+
+	as_digest * digest = as_key_digest(key);
+	if (!digest) {
+		return false;
+	}
+
+	// Read before the record, so a write completing meanwhile is seen.
+	*epoch = __atomic_load_n(&cache->unpins[cache_bucket(cache, digest->value)], __ATOMIC_ACQUIRE);
+
+	uint64_t now = cf_getms();
+	as_near_cache_entry ** link = cache_find(cache, key->ns, digest->value);
+
+	if (!*link) {
+		cache->misses++;
+		return false;
+	}
+
+	if ((*link)->expires_ms && (*link)->expires_ms <= now) {
+		cache_remove(cache, link);
+		cache->expirations++;
+		cache->misses++;
+		return false;
+	}
+
+	if (cache->validate) {
+		as_record * rec = NULL;
+
+		Py_BEGIN_ALLOW_THREADS
+		aerospike_key_exists(as, err, policy, key, &rec);
+		Py_END_ALLOW_THREADS
+
+		// Other threads may have changed the cache meanwhile.
+		now = cf_getms();
+		link = cache_find(cache, key->ns, digest->value);
+
+		if (err->code != AEROSPIKE_OK || !*link || (*link)->gen != rec->gen) {
+			if (*link) {
+				cache_remove(cache, link);
+			}
+			if (rec) {
+				as_record_destroy(rec);
+			}
+			cache->stale++;
+			cache->misses++;
+
+			// A missing record raises as the get would, without reading it.
+			return err->code != AEROSPIKE_OK;
+		}
+
+		(*link)->void_ms = record_void_ms(rec->ttl, now);
+		(*link)->expires_ms = entry_expires_ms(cache, (*link)->void_ms, now);
+		as_record_destroy(rec);
+	}
+
+	as_near_cache_entry * e = *link;
+	lru_unlink(cache, e);
+	lru_push_front(cache, e);
+	cache->hits++;
+
+	*py_rec = cache_record(err, e, policy, key, now);
+	return true;
+}
+
+void as_near_cache_put(as_near_cache * cache, as_key * key, uint32_t epoch, const as_record * rec,
+		PyObject * py_rec)
+{
+	if (!cache || !rec || !py_rec) {
+		return;
+	}
+
+	as_digest * digest = as_key_digest(key);
+	PyObject * py_bins = PyTuple_GetItem(py_rec, 2);
+
+	if (!digest || !py_bins) {
+		PyErr_Clear();
+		return;
+	}
+
+	// The caller owns py_rec, and may change its bins.
+	PyObject * py_copy = bins_copy(py_bins);
+
+	if (!py_copy) {
+		PyErr_Clear();
+		return;
+	}
+
+	// The record may be older than a write sent meanwhile, or still in flight.
+	uint32_t bucket = cache_bucket(cache, digest->value);
+	if (__atomic_load_n(&cache->pins[bucket], __ATOMIC_ACQUIRE) ||
+			__atomic_load_n(&cache->unpins[bucket], __ATOMIC_ACQUIRE) != epoch) {
+		Py_DECREF(py_copy);
+		return;
+	}
+
+	uint64_t now = cf_getms();
+	as_near_cache_entry ** link = cache_find(cache, key->ns, digest->value);
+	as_near_cache_entry * e = *link;
+	PyObject * py_old = NULL;
+
+	if (e) {
+		lru_unlink(cache, e);
+		py_old = e->py_bins;
+	} else {
+		e = calloc(1, sizeof(as_near_cache_entry));
+		if (!e) {
+			Py_DECREF(py_copy);
+			return;
+		}
+		strcpy(e->ns, key->ns);
+		memcpy(e->digest, digest->value, AS_DIGEST_VALUE_SIZE);
+		*link = e;
+		cache->size++;
+	}
+
+	e->gen = rec->gen;
+	e->void_ms = record_void_ms(rec->ttl, now);
+	e->expires_ms = entry_expires_ms(cache, e->void_ms, now);
+	e->py_bins = py_copy;
+	lru_push_front(cache, e);
+
+	while (cache->size > cache->max_entries) {
+		as_near_cache_entry * lru = cache->tail;
+		cache_remove(cache, cache_find(cache, lru->ns, lru->digest));
+		cache->evictions++;
+	}
+
+	Py_XDECREF(py_old);
+}
+
+void as_near_cache_invalidate(as_near_cache * cache, as_key * key)
+{
+	as_digest * digest = cache ? as_key_digest(key) : NULL;
+	if (!digest) {
+		return;
+	}
+
+	// A get which released the GIL may have read the record before the write.
+	__atomic_add_fetch(&cache->unpins[cache_bucket(cache, digest->value)], 1, __ATOMIC_RELEASE);
+
+	as_near_cache_entry ** link = cache_find(cache, key->ns, digest->value);
+	if (*link) {
+		cache_remove(cache, link);
+		cache->invalidations++;
+	}
+}
+
+void as_near_cache_pin(as_near_cache * cache, as_key * key)
+{
+	as_digest * digest = cache ? as_key_digest(key) : NULL;
+	if (!digest) {
+		return;
+	}
+
+	__atomic_add_fetch(&cache->pins[cache_bucket(cache, digest->value)], 1, __ATOMIC_RELEASE);
+}
+
+void as_near_cache_unpin(as_near_cache * cache, as_key * key)
+{
+	as_digest * digest = cache ? as_key_digest(key) : NULL;
+	if (!digest) {
+		return;
+	}
+
+	// Counted as done first, so a get seeing the pin gone sees it done too.
+	uint32_t bucket = cache_bucket(cache, digest->value);
+	__atomic_add_fetch(&cache->unpins[bucket], 1, __ATOMIC_RELEASE);
+	__atomic_sub_fetch(&cache->pins[bucket], 1, __ATOMIC_RELEASE);
+}
+
+void as_near_cache_after_fork(as_near_cache * cache)
+{
+	if (cache) {
+		memset(cache->pins, 0, cache->n_buckets * sizeof(uint32_t));
+	}
+}
+
+void as_near_cache_clear(as_near_cache * cache)
+{
+	if (!cache) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < cache->n_buckets; i++) {
+		__atomic_add_fetch(&cache->unpins[i], 1, __ATOMIC_RELEASE);
+	}
+
+	while (cache->head) {
+		as_near_cache_entry * e = cache->head;
+		cache_remove(cache, cache_find(cache, e->ns, e->digest));
+		cache->invalidations++;
+	}
+}
+
+PyObject * as_near_cache_stats(as_near_cache * cache)
+{
+	return Py_BuildValue("{s:I,s:I,s:K,s:K,s:K,s:K,s:K,s:K}",
+			"entries", cache->size,
+			"max_entries", cache->max_entries,
+			"hits", (unsigned long long) cache->hits,
+			"misses", (unsigned long long) cache->misses,
+			"stale", (unsigned long long) cache->stale,
+			"evictions", (unsigned long long) cache->evictions,
+			"expirations", (unsigned long long) cache->expirations,
+			"invalidations", (unsigned long long) cache->invalidations);
+}
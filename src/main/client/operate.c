@@ -29,11 +29,16 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 #include "serializer.h"
 #include "geo.h"
 #include "cdt_list_operations.h"
 #include "cdt_map_operations.h"
 #include "bit_operations.h"
+#include "hll_operations.h"
+#include "compiled_ops.h"
+#include "cdt_context.h"
+#include "operation.h"
 
 #include <aerospike/as_double.h>
 #include <aerospike/as_integer.h>
@@ -48,6 +53,7 @@ get_operation(as_error* err, PyObject* op_dict, long* operation_ptr);
 static inline bool isListOp(int op);
 static inline bool isNewMapOp(int op);
 static inline bool isBitOp(int op);
+static inline bool isHllOp(int op);
 
 
 #define PY_OPERATION_KEY "op"
@@ -239,6 +245,12 @@ static inline bool isBitOp(int op) {
 	return (op >= bit_start && op <= bit_end);
 }
 
+static inline bool isHllOp(int op) {
+	int hll_start = OP_HLL_INIT;
+	int hll_end = OP_HLL_SET_UNION;
+	return (op >= hll_start && op <= hll_end);
+}
+
 bool opRequiresIndex(int op) {
 	return (op == OP_LIST_INSERT               || op == OP_LIST_INSERT_ITEMS  ||
 			op == OP_LIST_POP                  || op == OP_LIST_POP_RANGE     ||
@@ -345,7 +357,31 @@ as_status add_op(AerospikeClient * self, as_error * err, PyObject * py_val, as_v
 			ops, operation, ret_type, SERIALIZER_PYTHON);
     }
 
-	while (PyDict_Next(py_val, &pos, &key_op, &value)) {
+	if (isHllOp(operation)) {
+		return add_new_hll_op(self, err, py_val, unicodeStrVector, static_pool,
+			ops, operation, ret_type, SERIALIZER_PYTHON);
+	}
+
+	if (AerospikeOperation_Check(py_val)) {
+		/* The common entries are in slots, the others are only read by the operations using them */
+		py_bin = operation_get(py_val, AS_OP_FIELD_BIN, "bin");
+		py_value = operation_get(py_val, AS_OP_FIELD_VAL, "val");
+		py_map_policy = operation_get(py_val, AS_OP_FIELD_POLICY, "map_policy");
+		py_return_type = operation_get(py_val, AS_OP_FIELD_RETURN_TYPE, "return_type");
+		if (opRequiresIndex(operation)) {
+			py_index = operation_get_entry(py_val, "index");
+		}
+		if (opRequiresKey(operation)) {
+			py_key = operation_get_entry(py_val, "key");
+		}
+		if (opRequiresRange(operation)) {
+			py_range = operation_get_entry(py_val, "range");
+		}
+		CONVERT_PY_CTX_TO_AS_CTX();
+		ctx_ref = (ctx_in_use ? &ctx : NULL);
+	}
+
+	while (!AerospikeOperation_Check(py_val) && PyDict_Next(py_val, &pos, &key_op, &value)) {
 		if (!PyString_Check(key_op)) {
 			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "An operation key must be a string.");
 		} else {
@@ -710,7 +746,7 @@ static
 PyObject *  AerospikeClient_Operate_Invoke(
 	AerospikeClient * self, as_error *err,
 	as_key * key, PyObject * py_list, PyObject * py_meta,
-	PyObject * py_policy)
+	PyObject * py_policy, PyObject * py_values)
 {
 	int i = 0;
 	long operation;
@@ -720,16 +756,25 @@ PyObject *  AerospikeClient_Operate_Invoke(
 	as_record * rec = NULL;
 	as_policy_operate operate_policy;
 	as_policy_operate *operate_policy_p = NULL;
+	as_predexp_list predexp_list;
+	as_latency_timer timer;
+	as_trace_span span;
+
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_OPERATE);
+	as_trace_begin(&span, AS_LATENCY_OPERATE);
+	as_trace_key(&span, key);
 
 	as_vector * unicodeStrVector = as_vector_create(sizeof(char *), 128);
 
+	AerospikeCompiledOps * compiled = AerospikeCompiledOps_Check(py_list) ? (AerospikeCompiledOps *) py_list : NULL;
+
 	as_operations ops;
-	Py_ssize_t size = PyList_Size(py_list);
+	Py_ssize_t size = compiled ? compiled->size : PyList_Size(py_list);
 	as_operations_inita(&ops, size);
 
 	if (py_policy) {
 		if(pyobject_to_policy_operate(err, py_policy, &operate_policy, &operate_policy_p,
-				&self->as->config.policies.operate) != AEROSPIKE_OK) {
+				&self->as->config.policies.operate, &predexp_list) != AEROSPIKE_OK) {
 			goto CLEANUP;
 		}
 	}
@@ -745,7 +790,13 @@ PyObject *  AerospikeClient_Operate_Invoke(
 		}
 	}
 
-	for (i = 0; i < size; i++) {
+	if (compiled) {
+		if (compiled_ops_fill(self, err, compiled, py_values, unicodeStrVector, &static_pool, &ops) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	for (i = 0; !compiled && i < size; i++) {
 		PyObject * py_val = PyList_GetItem(py_list, i);
 
 		if (PyDict_Check(py_val)) {
@@ -760,9 +811,12 @@ PyObject *  AerospikeClient_Operate_Invoke(
 	}
 
 
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_key_operate(self->as, err, operate_policy_p, key, &ops, &rec);
 	Py_END_ALLOW_THREADS
+	as_near_cache_invalidate(self->near_cache, key);
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 
 	if (err->code != AEROSPIKE_OK) {
 		as_error_update(err, err->code, NULL);
@@ -770,12 +824,17 @@ PyObject *  AerospikeClient_Operate_Invoke(
 	}
 	/* The op succeeded; it's now safe to free the record */
 	operation_succeeded = true;
+	as_trace_record(&span, rec);
 
 	if (rec) {
 		record_to_pyobject(self, err, rec, key, &py_rec);
+		as_latency_timer_mark(&timer, AS_LATENCY_TO_PYTHON);
 	}
 
 CLEANUP:
+	as_trace_end(&span, err);
+	PREDEXP_LIST_DESTROY(operate_policy_p, &predexp_list);
+
 	for (unsigned int i=0; i<unicodeStrVector->size ; i++) {
 		free(as_vector_get_ptr(unicodeStrVector, i));
 	}
@@ -789,6 +848,10 @@ CLEANUP:
 		as_key_destroy(key);
 	}
 
+	// The compiled operations are owned by the compiled object.
+	if (compiled) {
+		compiled_ops_release(compiled, &ops);
+	}
 	as_operations_destroy(&ops);
 
 	if (err->code != AEROSPIKE_OK) {
@@ -826,11 +889,12 @@ PyObject * AerospikeClient_Operate(AerospikeClient * self, PyObject * args, PyOb
 	BASE_VARIABLES
 	PyObject * py_list = NULL;
 	PyObject * py_bin = NULL;
+	PyObject * py_values = NULL;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"key", "list", "meta", "policy", NULL};
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO:operate", kwlist,
-				&py_key, &py_list, &py_meta, &py_policy) == false) {
+	static char * kwlist[] = {"key", "list", "meta", "policy", "values", NULL};
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOO:operate", kwlist,
+				&py_key, &py_list, &py_meta, &py_policy, &py_values) == false) {
 		return NULL;
 	}
 
@@ -840,9 +904,9 @@ PyObject * AerospikeClient_Operate(AerospikeClient * self, PyObject * args, PyOb
 		goto CLEANUP;
 	}
 
-	if (py_list && PyList_Check(py_list)) {
+	if (py_list && (PyList_Check(py_list) || AerospikeCompiledOps_Check(py_list))) {
 		py_result = AerospikeClient_Operate_Invoke(self, &err, &key, py_list, py_meta,
-				py_policy);
+				py_policy, py_values);
 	} else {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Operations should be of type list");
 	}
@@ -870,7 +934,7 @@ CLEANUP:
 static PyObject *  AerospikeClient_OperateOrdered_Invoke(
 	AerospikeClient * self, as_error *err,
 	as_key * key, PyObject * py_list, PyObject * py_meta,
-	PyObject * py_policy)
+	PyObject * py_policy, PyObject * py_values)
 {
 	long operation;
 	long return_type = -1;
@@ -880,14 +944,23 @@ static PyObject *  AerospikeClient_OperateOrdered_Invoke(
 	as_record * rec = NULL;
 	as_policy_operate operate_policy;
 	as_policy_operate *operate_policy_p = NULL;
+	as_predexp_list predexp_list;
+	as_latency_timer timer;
+	as_trace_span span;
+
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_OPERATE);
+	as_trace_begin(&span, AS_LATENCY_OPERATE);
+	as_trace_key(&span, key);
 
 	as_vector * unicodeStrVector = as_vector_create(sizeof(char *), 128);
 
 	as_static_pool static_pool;
 	memset(&static_pool, 0, sizeof(static_pool));
 
+	AerospikeCompiledOps * compiled = AerospikeCompiledOps_Check(py_list) ? (AerospikeCompiledOps *) py_list : NULL;
+
 	as_operations ops;
-	Py_ssize_t ops_list_size = PyList_Size(py_list);
+	Py_ssize_t ops_list_size = compiled ? compiled->size : PyList_Size(py_list);
 	as_operations_inita(&ops, ops_list_size);
 
 	/* These are the values which will be returned in a 3 element list */
@@ -899,7 +972,7 @@ static PyObject *  AerospikeClient_OperateOrdered_Invoke(
 
 	if (py_policy) {
 		if (pyobject_to_policy_operate(err, py_policy, &operate_policy,
-				&operate_policy_p, &self->as->config.policies.operate) != AEROSPIKE_OK) {
+				&operate_policy_p, &self->as->config.policies.operate, &predexp_list) != AEROSPIKE_OK) {
 			goto CLEANUP;
 		}
 	}
@@ -910,7 +983,13 @@ static PyObject *  AerospikeClient_OperateOrdered_Invoke(
 		}
 	}
 
-	for (Py_ssize_t i = 0; i < ops_list_size; i++) {
+	if (compiled) {
+		if (compiled_ops_fill(self, err, compiled, py_values, unicodeStrVector, &static_pool, &ops) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	for (Py_ssize_t i = 0; !compiled && i < ops_list_size; i++) {
 
 		PyObject* py_current_op = NULL;
 		py_current_op = PyList_GetItem(py_list, i);
@@ -931,9 +1010,12 @@ static PyObject *  AerospikeClient_OperateOrdered_Invoke(
 		goto CLEANUP;
 	}
 
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_key_operate(self->as, err, operate_policy_p, key, &ops, &rec);
 	Py_END_ALLOW_THREADS
+	as_near_cache_invalidate(self->near_cache, key);
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 
 	if (err->code != AEROSPIKE_OK) {
 		as_error_update(err, err->code, NULL);
@@ -941,6 +1023,7 @@ static PyObject *  AerospikeClient_OperateOrdered_Invoke(
 	}
 
 	operation_succeeded = true;
+	as_trace_record(&span, rec);
 	if (rec) {
 		/* Build the return tuple: (key, meta, bins) */
 		key_to_pyobject(err, key, &py_return_key);
@@ -975,9 +1058,13 @@ static PyObject *  AerospikeClient_OperateOrdered_Invoke(
 		Py_XDECREF(py_return_key);
 		Py_XDECREF(py_return_bins);
 		Py_XDECREF(py_return_meta);
+		as_latency_timer_mark(&timer, AS_LATENCY_TO_PYTHON);
 	}
 
 CLEANUP:
+	as_trace_end(&span, err);
+	PREDEXP_LIST_DESTROY(operate_policy_p, &predexp_list);
+
 	for (unsigned int i=0; i<unicodeStrVector->size ; i++) {
 		free(as_vector_get_ptr(unicodeStrVector, i));
 	}
@@ -991,6 +1078,10 @@ CLEANUP:
 		as_key_destroy(key);
 	}
 
+	// The compiled operations are owned by the compiled object.
+	if (compiled) {
+		compiled_ops_release(compiled, &ops);
+	}
 	as_operations_destroy(&ops);
 
 	if (err->code != AEROSPIKE_OK) {
@@ -1035,15 +1126,16 @@ PyObject * AerospikeClient_OperateOrdered(AerospikeClient * self, PyObject * arg
 	PyObject * py_policy = NULL;
 	PyObject * py_result = NULL;
 	PyObject * py_meta = NULL;
+	PyObject * py_values = NULL;
 
 	as_key key;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"key", "list", "meta", "policy", NULL};
+	static char * kwlist[] = {"key", "list", "meta", "policy", "values", NULL};
 
 	// Python Function Argument Parsing
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO:operate_ordered", kwlist,
-				&py_key, &py_list, &py_meta, &py_policy) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOO:operate_ordered", kwlist,
+				&py_key, &py_list, &py_meta, &py_policy, &py_values) == false) {
 		return NULL;
 	}
 
@@ -1053,9 +1145,9 @@ PyObject * AerospikeClient_OperateOrdered(AerospikeClient * self, PyObject * arg
 		goto CLEANUP;
 	}
 
-	if (py_list && PyList_Check(py_list)) {
+	if (py_list && (PyList_Check(py_list) || AerospikeCompiledOps_Check(py_list))) {
 		py_result = AerospikeClient_OperateOrdered_Invoke(self, &err, &key, py_list, py_meta,
-				py_policy);
+				py_policy, py_values);
 	} else {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Operations should be of type list");
 		goto CLEANUP;
@@ -1076,6 +1168,110 @@ CLEANUP:
 	return py_result;
 }
 
+/**
+ *******************************************************************************************************
+ * Encodes a list of operations once, for operate and operate_ordered.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns an aerospike.CompiledOperations on success.
+ * In case of error,appropriate exceptions will be raised.
+ *******************************************************************************************************
+ */
+PyObject * AerospikeClient_CompileOps(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Initialize error
+	as_error err;
+	as_error_init(&err);
+
+	// Python Function Arguments
+	PyObject * py_list = NULL;
+	AerospikeCompiledOps * compiled = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"list", NULL};
+
+	// Python Function Argument Parsing
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O:compile_ops", kwlist, &py_list) == false) {
+		return NULL;
+	}
+
+	// Compiling only encodes, it does not need a connection.
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	compiled = AerospikeCompiledOps_New(self, &err, py_list);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return (PyObject *) compiled;
+}
+
+/**
+ *******************************************************************************************************
+ * Converts a list of cdt_ctx objects once, for the ctx of list and map operations.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns an aerospike.CDTContext on success.
+ * In case of error,appropriate exceptions will be raised.
+ *******************************************************************************************************
+ */
+PyObject * AerospikeClient_CompileCtx(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Initialize error
+	as_error err;
+	as_error_init(&err);
+
+	// Python Function Arguments
+	PyObject * py_ctx = NULL;
+	AerospikeCDTContext * compiled = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"ctx", NULL};
+
+	// Python Function Argument Parsing
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O:compile_ctx", kwlist, &py_ctx) == false) {
+		return NULL;
+	}
+
+	// Compiling only converts, it does not need a connection.
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	compiled = AerospikeCDTContext_New(self, &err, py_ctx);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return (PyObject *) compiled;
+}
+
 /**
  *******************************************************************************************************
  * Appends a string to the string value in a bin.
@@ -1111,7 +1307,7 @@ PyObject * AerospikeClient_Append(AerospikeClient * self, PyObject * args, PyObj
 	PyObject * py_list = NULL;
 	py_list = create_pylist(py_list, AS_OPERATOR_APPEND, py_bin, py_append_str);
 	py_result = AerospikeClient_Operate_Invoke(self, &err, &key, py_list,
-			py_meta, py_policy);
+			py_meta, py_policy, NULL);
 
 	DECREF_LIST_AND_RESULT();
 
@@ -1156,7 +1352,7 @@ PyObject * AerospikeClient_Prepend(AerospikeClient * self, PyObject * args, PyOb
 	PyObject * py_list = NULL;
 	py_list = create_pylist(py_list, AS_OPERATOR_PREPEND, py_bin, py_prepend_str);
 	py_result = AerospikeClient_Operate_Invoke(self, &err, &key, py_list,
-			py_meta, py_policy);
+			py_meta, py_policy, NULL);
 
 	DECREF_LIST_AND_RESULT();
 
@@ -1202,7 +1398,7 @@ PyObject * AerospikeClient_Increment(AerospikeClient * self, PyObject * args, Py
 	PyObject * py_list = NULL;
 	py_list = create_pylist(py_list, AS_OPERATOR_INCR, py_bin, py_offset_value);
 	py_result = AerospikeClient_Operate_Invoke(self, &err, &key, py_list,
-			py_meta, py_policy);
+			py_meta, py_policy, NULL);
 
 	DECREF_LIST_AND_RESULT();
 
@@ -1247,7 +1443,7 @@ PyObject * AerospikeClient_Touch(AerospikeClient * self, PyObject * args, PyObje
 	PyObject * py_list = NULL;
 	py_list = create_pylist(py_list, AS_OPERATOR_TOUCH, NULL, py_touchvalue);
 	py_result = AerospikeClient_Operate_Invoke(self, &err, &key, py_list,
-			py_meta, py_policy);
+			py_meta, py_policy, NULL);
 
 	DECREF_LIST_AND_RESULT();
 
@@ -1260,7 +1456,12 @@ CLEANUP:
 static as_status
 get_operation(as_error* err, PyObject* op_dict, long* operation_ptr)
 {
-        PyObject* py_operation = PyDict_GetItemString(op_dict, PY_OPERATION_KEY);
+        if (AerospikeOperation_Check(op_dict) && ((AerospikeOperation *) op_dict)->has_op) {
+            *operation_ptr = ((AerospikeOperation *) op_dict)->op;
+            return AEROSPIKE_OK;
+        }
+
+        PyObject* py_operation = operation_get_entry(op_dict, PY_OPERATION_KEY);
         if (!py_operation) {
             return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation must contain an \"op\" entry");
         }
@@ -1282,7 +1483,7 @@ get_operation(as_error* err, PyObject* op_dict, long* operation_ptr)
 
 static as_status
 invertIfSpecified(as_error* err, PyObject* op_dict, uint64_t* return_value) {
-	PyObject* pyInverted = PyDict_GetItemString(op_dict, "inverted");
+	PyObject* pyInverted = operation_get(op_dict, AS_OP_FIELD_INVERTED, "inverted");
 	int truthValue;
 	if (!pyInverted) {
 		return AEROSPIKE_OK;
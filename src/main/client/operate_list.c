@@ -66,7 +66,7 @@
 #define POLICY_KEY_META_BIN()\
 	if (py_policy) {\
 		if (pyobject_to_policy_operate(&err, py_policy, &operate_policy, &operate_policy_p,\
-				&self->as->config.policies.operate) != AEROSPIKE_OK) {\
+				&self->as->config.policies.operate, NULL) != AEROSPIKE_OK) {\
 			goto CLEANUP;\
 		}\
 	}\
@@ -87,7 +87,8 @@
 #define DO_OPERATION(__rec)\
 	Py_BEGIN_ALLOW_THREADS\
 	aerospike_key_operate(self->as, &err, operate_policy_p, &key, &ops, __rec);\
-	Py_END_ALLOW_THREADS
+	Py_END_ALLOW_THREADS\
+	as_near_cache_invalidate(self->near_cache, &key);
 
 #define EXCEPTION_ON_ERROR()\
 	if (key_created) {\
@@ -55,7 +55,7 @@
 #define POLICY_KEY_META_BIN()\
 	if (py_policy) {\
 		if (pyobject_to_policy_operate(&err, py_policy, &operate_policy, &operate_policy_p,\
-				&self->as->config.policies.operate) != AEROSPIKE_OK) {\
+				&self->as->config.policies.operate, NULL) != AEROSPIKE_OK) {\
 			goto CLEANUP;\
 		}\
 	}\
@@ -94,6 +94,7 @@
 	Py_BEGIN_ALLOW_THREADS\
 	aerospike_key_operate(self->as, &err, operate_policy_p, &key, &ops, &rec);\
 	Py_END_ALLOW_THREADS\
+	as_near_cache_invalidate(self->near_cache, &key);\
     if (err.code != AEROSPIKE_OK) { goto CLEANUP;}
 
 #define SETUP_RETURN_VAL()\
@@ -151,6 +152,7 @@ PyObject * AerospikeClient_MapSetPolicy(AerospikeClient * self, PyObject * args,
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_key_operate(self->as, &err, NULL, &key, &ops, &rec);
 	Py_END_ALLOW_THREADS
+	as_near_cache_invalidate(self->near_cache, &key);
 
 CLEANUP:
 	CLEANUP_AND_EXCEPTION_ON_ERROR(err);
@@ -26,6 +26,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 /**
  *******************************************************************************************************
@@ -51,8 +52,11 @@ PyObject * AerospikeClient_Put_Invoke(
 	as_error err;
 	as_policy_write write_policy;
 	as_policy_write * write_policy_p = NULL;
+	as_predexp_list predexp_list;
 	as_key key;
 	as_record rec;
+	as_latency_timer timer;
+	as_trace_span span;
 
 	// Initialisation flags
 	bool key_initialised = false;
@@ -67,6 +71,7 @@ PyObject * AerospikeClient_Put_Invoke(
 
 	// Initialize error
 	as_error_init(&err);
+	as_trace_begin(&span, AS_LATENCY_PUT);
 
 	if (!self || !self->as) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
@@ -78,6 +83,8 @@ PyObject * AerospikeClient_Put_Invoke(
 		goto CLEANUP;
 	}
 
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_PUT);
+
 	// Convert python key object to as_key
 	pyobject_to_key(&err, py_key, &key);
 	if (err.code != AEROSPIKE_OK) {
@@ -85,6 +92,7 @@ PyObject * AerospikeClient_Put_Invoke(
 	}
 	// Key is initialised successfully.
 	key_initialised = true;
+	as_trace_key(&span, &key);
 
 	// Convert python bins and metadata objects to as_record
 	pyobject_to_record(self, &err, py_bins, py_meta, &rec, serializer_option, &static_pool);
@@ -94,20 +102,27 @@ PyObject * AerospikeClient_Put_Invoke(
 
 	// Convert python policy object to as_policy_write
 	pyobject_to_policy_write(&err, py_policy, &write_policy, &write_policy_p,
-			&self->as->config.policies.write);
+			&self->as->config.policies.write, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
 	// Invoke operation
+	as_trace_record(&span, &rec);
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_key_put(self->as, &err, write_policy_p, &key, &rec);
 	Py_END_ALLOW_THREADS
+	as_near_cache_invalidate(self->near_cache, &key);
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 	if (err.code != AEROSPIKE_OK) {
 		as_error_update(&err, err.code, NULL);
 	}
 
 CLEANUP:
+	as_trace_end(&span, &err);
+	PREDEXP_LIST_DESTROY(write_policy_p, &predexp_list);
+
 	POOL_DESTROY(&static_pool);
 
 	if (key_initialised == true) {
@@ -21,6 +21,7 @@
 #include "query.h"
 #include "conversions.h"
 #include "exceptions.h"
+#include "job.h"
 #include "policy.h"
 
 #include <aerospike/aerospike_query.h>
@@ -285,7 +286,7 @@ PyObject * AerospikeClient_QueryApply_Invoke(
 
 	if (py_policy) {
 		pyobject_to_policy_write(&err, py_policy, &write_policy, &write_policy_p,
-				&self->as->config.policies.write);
+				&self->as->config.policies.write, NULL);
 
 		if (err.code != AEROSPIKE_OK) {
 			goto CLEANUP;
@@ -556,3 +557,79 @@ CLEANUP:
 	return retObj;
 
 }
+
+/**
+ *******************************************************************************************************
+ * Returns an aerospike.Job tracking a scan or query running in the background.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns the Job on success.
+ * In case of error,appropriate exceptions will be raised.
+ *******************************************************************************************************
+ */
+PyObject * AerospikeClient_Job(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Initialize error
+	as_error err;
+	as_error_init(&err);
+
+	// Python Function Arguments
+	PyObject * py_policy = NULL;
+	AerospikeJob * job = NULL;
+
+	uint64_t ujobId = 0;
+	char *module = NULL;
+
+	as_policy_info info_policy;
+	as_policy_info *info_policy_p = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"job_id", "module", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "Ks|O:job", kwlist, &ujobId, &module, &py_policy) == false) {
+		return NULL;
+	}
+
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	// Convert python object to policy_info
+	pyobject_to_policy_info( &err, py_policy, &info_policy, &info_policy_p,
+			&self->as->config.policies.info);
+	if (err.code != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (strcmp(module, "scan") && strcmp(module, "query")) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Module can have only two values: aerospike.JOB_SCAN or aerospike.JOB_QUERY");
+		goto CLEANUP;
+	}
+
+	job = AerospikeJob_New(self, &err, module, ujobId,
+			info_policy_p ? info_policy_p : &self->as->config.policies.info);
+
+CLEANUP:
+
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_XDECREF(py_err);
+		return NULL;
+	}
+
+	return (PyObject *) job;
+}
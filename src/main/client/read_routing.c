@@ -0,0 +1,390 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/aerospike_info.h>
+#include <aerospike/as_cluster.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_node.h>
+#include <aerospike/as_policy.h>
+
+#include "macros.h"
+#include "read_routing.h"
+
+#define READ_ROUTER_DEFAULT_PERCENTILE 95.0
+#define READ_ROUTER_DEFAULT_MIN_DELAY_MS 2
+#define READ_ROUTER_DEFAULT_DEGRADED_FACTOR 3.0
+
+// The read delay is recomputed every this many reads.
+#define READ_ROUTER_DELAY_SAMPLES 256
+
+// Past this many reads, the counts are halved so recent reads weigh more.
+#define READ_ROUTER_DECAY_SAMPLES (1 << 16)
+
+static void router_deadline(struct timespec * ts, uint32_t ms)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	uint64_t ns = (uint64_t) now.tv_usec * 1000 + (uint64_t) ms * 1000000;
+	ts->tv_sec = now.tv_sec + (time_t) (ns / 1000000000);
+	ts->tv_nsec = (long) (ns % 1000000000);
+}
+
+static int router_compare_us(const void * a, const void * b)
+{
+	uint64_t x = *(const uint64_t *) a;
+	uint64_t y = *(const uint64_t *) b;
+	return x < y ? -1 : x > y;
+}
+
+/*
+ * Time an info request to each node, without the lock, then fold the samples
+ * in the EWMAs under it. Nodes which left the cluster are dropped.
+ */
+static void router_probe(as_read_router * router)
+{
+	aerospike * as = router->as;
+
+	if (!as->cluster) {
+		return;
+	}
+
+	as_read_router_node probed[AS_READ_ROUTER_MAX_NODES];
+	uint32_t n_probed = 0;
+
+	as_nodes * nodes = as_nodes_reserve(as->cluster);
+
+	for (uint32_t i = 0; i < nodes->size && n_probed < AS_READ_ROUTER_MAX_NODES; i++) {
+		as_error err;
+		as_error_init(&err);
+		char * res = NULL;
+
+		// A node which times out is sampled at the info timeout.
+		uint64_t start_ns = as_latency_now_ns();
+		aerospike_info_node(as, &err, NULL, nodes->array[i], "node", &res);
+		uint64_t us = (as_latency_now_ns() - start_ns) / 1000;
+		free(res);
+
+		strcpy(probed[n_probed].name, nodes->array[i]->name);
+		probed[n_probed].ewma_us = us;
+		probed[n_probed].degraded = false;
+		n_probed++;
+	}
+
+	as_nodes_release(nodes);
+
+	pthread_mutex_lock(&router->lock);
+
+	uint64_t sorted_us[AS_READ_ROUTER_MAX_NODES];
+
+	for (uint32_t i = 0; i < n_probed; i++) {
+		for (uint32_t j = 0; j < router->n_nodes; j++) {
+			if (strcmp(router->nodes[j].name, probed[i].name) == 0) {
+				// alpha = 1/4
+				probed[i].ewma_us = (3 * router->nodes[j].ewma_us + probed[i].ewma_us) / 4;
+				break;
+			}
+		}
+		sorted_us[i] = probed[i].ewma_us;
+	}
+
+	qsort(sorted_us, n_probed, sizeof(uint64_t), router_compare_us);
+
+	// The lower median, so the slower of two nodes is compared to the faster.
+	uint64_t median_us = n_probed ? sorted_us[(n_probed - 1) / 2] : 0;
+	uint64_t floor_us = (uint64_t) router->min_delay_ms * 1000;
+	bool degraded = false;
+
+	for (uint32_t i = 0; i < n_probed; i++) {
+		probed[i].degraded = probed[i].ewma_us > floor_us &&
+				probed[i].ewma_us > median_us * router->degraded_factor;
+		degraded = degraded || probed[i].degraded;
+	}
+
+	memcpy(router->nodes, probed, n_probed * sizeof(as_read_router_node));
+	router->n_nodes = n_probed;
+	router->degraded = degraded;
+
+	pthread_mutex_unlock(&router->lock);
+}
+
+static void * router_run(void * udata)
+{
+	as_read_router * router = (as_read_router *) udata;
+
+	pthread_mutex_lock(&router->lock);
+
+	while (!router->stopping) {
+		struct timespec deadline;
+		router_deadline(&deadline, router->as->config.tender_interval);
+
+		while (!router->stopping) {
+			if (pthread_cond_timedwait(&router->cond, &router->lock, &deadline) != 0) {
+				break;
+			}
+		}
+
+		if (router->stopping) {
+			break;
+		}
+
+		pthread_mutex_unlock(&router->lock);
+		router_probe(router);
+		pthread_mutex_lock(&router->lock);
+	}
+
+	pthread_mutex_unlock(&router->lock);
+	return NULL;
+}
+
+static as_status router_config_double(as_error * err, PyObject * py_config, const char * name,
+		double min, double max, double * value)
+{
+	PyObject * py_value = PyDict_GetItemString(py_config, name);
+
+	if (!py_value) {
+		return AEROSPIKE_OK;
+	}
+
+	if (!PyFloat_Check(py_value) && !PyInt_Check(py_value) && !PyLong_Check(py_value)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "latency_aware_reads %s must be a number", name);
+	}
+
+	*value = PyFloat_AsDouble(py_value);
+	if (!(*value > min && *value < max)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "latency_aware_reads %s is out of range", name);
+	}
+	return AEROSPIKE_OK;
+}
+
+as_status as_read_router_new(as_error * err, PyObject * py_config, as_read_router ** router)
+{
+	as_error_reset(err);
+	*router = NULL;
+
+	double percentile = READ_ROUTER_DEFAULT_PERCENTILE;
+	double degraded_factor = READ_ROUTER_DEFAULT_DEGRADED_FACTOR;
+	long min_delay = READ_ROUTER_DEFAULT_MIN_DELAY_MS;
+
+	if (PyDict_Check(py_config)) {
+		if (router_config_double(err, py_config, "percentile", 0, 100, &percentile) != AEROSPIKE_OK ||
+				router_config_double(err, py_config, "degraded_factor", 1, 1000, &degraded_factor) != AEROSPIKE_OK) {
+			return err->code;
+		}
+
+		PyObject * py_min_delay = PyDict_GetItemString(py_config, "min_delay");
+		if (py_min_delay) {
+			if (!PyInt_Check(py_min_delay) && !PyLong_Check(py_min_delay)) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "latency_aware_reads min_delay must be an integer");
+			}
+			min_delay = PyInt_AsLong(py_min_delay);
+			if (min_delay <= 0 || min_delay > UINT32_MAX) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "latency_aware_reads min_delay is out of range");
+			}
+		}
+	}
+	else if (!PyBool_Check(py_config)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "latency_aware_reads must be a dict or a bool");
+	}
+	else if (py_config == Py_False) {
+		return err->code;
+	}
+
+	as_read_router * r = calloc(1, sizeof(as_read_router));
+	if (!r) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to allocate the read router");
+	}
+
+	pthread_mutex_init(&r->lock, NULL);
+	pthread_cond_init(&r->cond, NULL);
+	r->percentile = percentile;
+	r->min_delay_ms = (uint32_t) min_delay;
+	r->degraded_factor = degraded_factor;
+	r->delay_ms = r->min_delay_ms;
+
+	*router = r;
+	return err->code;
+}
+
+void as_read_router_destroy(as_read_router * router)
+{
+	if (!router) {
+		return;
+	}
+
+	pthread_cond_destroy(&router->cond);
+	pthread_mutex_destroy(&router->lock);
+	free(router);
+}
+
+bool as_read_router_start(as_read_router * router, aerospike * as)
+{
+	if (!router || router->started) {
+		return true;
+	}
+
+	router->as = as;
+	router->stopping = false;
+	router->started = pthread_create(&router->thread, NULL, router_run, router) == 0;
+	return router->started;
+}
+
+void as_read_router_stop(as_read_router * router)
+{
+	if (!router || !router->started) {
+		return;
+	}
+
+	pthread_mutex_lock(&router->lock);
+	router->stopping = true;
+	pthread_cond_signal(&router->cond);
+	pthread_mutex_unlock(&router->lock);
+
+	pthread_join(router->thread, NULL);
+	router->started = false;
+
+	// The nodes of the next cluster are probed from scratch.
+	router->n_nodes = 0;
+	router->degraded = false;
+}
+
+void as_read_router_after_fork(as_read_router * router)
+{
+	if (!router) {
+		return;
+	}
+
+	// The lock may have been held by the thread when the parent forked.
+	pthread_mutex_init(&router->lock, NULL);
+	pthread_cond_init(&router->cond, NULL);
+	router->started = false;
+	router->n_nodes = 0;
+	router->degraded = false;
+}
+
+uint64_t as_read_router_route(as_read_router * router, as_policy_read * config_policy,
+		as_policy_read * policy, as_policy_read ** policy_p)
+{
+	if (!router) {
+		return 0;
+	}
+
+	// A read without a total timeout is never bounded, and the retry of a
+	// read only has time to run if it has as long as the first attempt.
+	as_policy_read * current = *policy_p ? *policy_p : config_policy;
+	uint32_t delay_ms = router->delay_ms;
+	uint32_t total_timeout = current->base.total_timeout;
+
+	if (router->degraded && total_timeout && delay_ms <= total_timeout / 2) {
+		// The config default and compiled policies are shared, so they are copied.
+		if (current != policy) {
+			as_policy_read_copy(current, policy);
+			*policy_p = policy;
+		}
+
+		if (policy->replica != AS_POLICY_REPLICA_PREFER_RACK) {
+			policy->replica = AS_POLICY_REPLICA_SEQUENCE;
+		}
+		if (!policy->base.socket_timeout || delay_ms < policy->base.socket_timeout) {
+			policy->base.socket_timeout = delay_ms;
+		}
+		if (policy->base.max_retries < 1) {
+			policy->base.max_retries = 1;
+		}
+		router->rerouted++;
+	}
+
+	return as_latency_now_ns();
+}
+
+void as_read_router_record(as_read_router * router, uint64_t start_ns)
+{
+	if (!router || !start_ns) {
+		return;
+	}
+
+	as_latency_histogram * reads = &router->reads;
+	uint64_t ns = as_latency_now_ns() - start_ns;
+
+	reads->count++;
+	reads->total_ns += ns;
+	if (ns > reads->max_ns) {
+		reads->max_ns = ns;
+	}
+	reads->buckets[as_latency_bucket(ns)]++;
+
+	if (++router->samples_since_delay < READ_ROUTER_DELAY_SAMPLES) {
+		return;
+	}
+	router->samples_since_delay = 0;
+
+	uint64_t delay_ms = (as_latency_percentile_ns(reads, router->percentile) + 999999) / 1000000;
+	router->delay_ms = delay_ms > router->min_delay_ms ? (uint32_t) delay_ms : router->min_delay_ms;
+
+	if (reads->count >= READ_ROUTER_DECAY_SAMPLES) {
+		reads->count = 0;
+		reads->total_ns /= 2;
+		reads->max_ns /= 2;
+		for (uint32_t i = 0; i < AS_LATENCY_BUCKETS; i++) {
+			reads->buckets[i] /= 2;
+			reads->count += reads->buckets[i];
+		}
+	}
+}
+
+int as_read_router_stats(as_read_router * router, PyObject * py_stats, PyObject * py_nodes)
+{
+	as_read_router_node nodes[AS_READ_ROUTER_MAX_NODES];
+	uint32_t n_nodes;
+
+	Py_BEGIN_ALLOW_THREADS
+	pthread_mutex_lock(&router->lock);
+	n_nodes = router->n_nodes;
+	memcpy(nodes, router->nodes, n_nodes * sizeof(as_read_router_node));
+	pthread_mutex_unlock(&router->lock);
+	Py_END_ALLOW_THREADS
+
+	for (uint32_t i = 0; i < n_nodes; i++) {
+		PyObject * py_node = PyDict_GetItemString(py_nodes, nodes[i].name);
+		if (!py_node) {
+			continue;
+		}
+
+		PyObject * py_ewma = PyLong_FromUnsignedLongLong(nodes[i].ewma_us);
+		if (!py_ewma || PyDict_SetItemString(py_node, "latency_ewma_us", py_ewma) < 0 ||
+				PyDict_SetItemString(py_node, "degraded", nodes[i].degraded ? Py_True : Py_False) < 0) {
+			Py_XDECREF(py_ewma);
+			return -1;
+		}
+		Py_DECREF(py_ewma);
+	}
+
+	PyObject * py_read_routing = Py_BuildValue("{s:O,s:I,s:K}",
+			"degraded", router->degraded ? Py_True : Py_False,
+			"delay_ms", router->delay_ms,
+			"rerouted", (unsigned long long) router->rerouted);
+	int rc = py_read_routing ? PyDict_SetItemString(py_stats, "read_routing", py_read_routing) : -1;
+	Py_XDECREF(py_read_routing);
+	return rc;
+}
@@ -26,6 +26,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 /**
  *******************************************************************************************************
@@ -49,6 +50,7 @@ PyObject * AerospikeClient_Remove_Invoke(
 	as_error err;
 	as_policy_remove remove_policy;
 	as_policy_remove * remove_policy_p = NULL;
+	as_predexp_list predexp_list;
 	as_key key;
 
 	// Initialisation flags
@@ -78,13 +80,19 @@ PyObject * AerospikeClient_Remove_Invoke(
 	// Convert python policy object to as_policy_exists
 	if (py_policy) {
 		pyobject_to_policy_remove(&err, py_policy, &remove_policy, &remove_policy_p,
-				&self->as->config.policies.remove);
+				&self->as->config.policies.remove, &predexp_list);
 		if (err.code != AEROSPIKE_OK) {
 			goto CLEANUP;
 		} else {
 			if (py_meta && PyDict_Check(py_meta)) {
 				PyObject * py_gen = PyDict_GetItemString(py_meta, "gen");
 
+				if (py_gen && remove_policy_p && remove_policy_p != &remove_policy) {
+					// A compiled policy is shared, set the generation on a copy.
+					remove_policy = *remove_policy_p;
+					remove_policy_p = &remove_policy;
+				}
+
 				if (py_gen) {
 					if (PyInt_Check(py_gen)) {
 						remove_policy_p->generation = (uint16_t) PyInt_AsLong(py_gen);
@@ -106,11 +114,14 @@ PyObject * AerospikeClient_Remove_Invoke(
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_key_remove(self->as, &err, remove_policy_p, &key);
 	Py_END_ALLOW_THREADS
+	as_near_cache_invalidate(self->near_cache, &key);
 	if (err.code != AEROSPIKE_OK) {
 		as_error_update(&err, err.code, NULL);
 	}
 
 CLEANUP:
+	PREDEXP_LIST_DESTROY(remove_policy_p, &predexp_list);
+
 
 	if (key_initialised == true) {
 		// Destroy the key if it is initialised successfully.
@@ -26,6 +26,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 /**
  ******************************************************************************************************
@@ -50,6 +51,7 @@ PyObject * AerospikeClient_RemoveBin_Invoke(
 	// Aerospike Client Arguments
 	as_policy_write write_policy;
 	as_policy_write * write_policy_p = NULL;
+	as_predexp_list predexp_list;
 	as_key key;
 	bool key_initialized = false;
 	as_record rec;
@@ -71,7 +73,7 @@ PyObject * AerospikeClient_RemoveBin_Invoke(
 
 	// Convert python policy object to as_policy_write
 	pyobject_to_policy_write(err, py_policy, &write_policy, &write_policy_p,
-			&self->as->config.policies.write);
+			&self->as->config.policies.write, &predexp_list);
 	if (err->code != AEROSPIKE_OK) {
 		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Incorrect policy");
 		goto CLEANUP;
@@ -146,12 +148,15 @@ PyObject * AerospikeClient_RemoveBin_Invoke(
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_key_put(self->as, err, write_policy_p, &key, &rec);
 	Py_END_ALLOW_THREADS
+	as_near_cache_invalidate(self->near_cache, &key);
 	if (err->code != AEROSPIKE_OK) {
 		as_error_update(err, err->code, NULL);
 		goto CLEANUP;
 	}
 
 CLEANUP:
+	PREDEXP_LIST_DESTROY(write_policy_p, &predexp_list);
+
 
 	as_record_destroy(&rec);
 
@@ -20,6 +20,7 @@
 #include "client.h"
 #include "scan.h"
 #include "policy.h"
+#include "predexp.h"
 #include "conversions.h"
 #include "exceptions.h"
 #include <aerospike/aerospike_scan.h>
@@ -71,6 +72,7 @@ PyObject * AerospikeClient_ScanApply_Invoke(
 	as_list* arglist = NULL;
 	as_policy_scan scan_policy;
 	as_policy_scan* scan_policy_p = NULL;
+	as_predexp_list predexp_list;
 	as_policy_info info_policy;
 	as_policy_info* info_policy_p = NULL;
 	as_error err;
@@ -127,7 +129,7 @@ PyObject * AerospikeClient_ScanApply_Invoke(
 
 	if (py_policy) {
 		pyobject_to_policy_scan(&err, py_policy, &scan_policy, &scan_policy_p,
-				&self->as->config.policies.scan);
+				&self->as->config.policies.scan, &predexp_list);
 
 		if (err.code != AEROSPIKE_OK) {
 			goto CLEANUP;
@@ -202,6 +204,8 @@ PyObject * AerospikeClient_ScanApply_Invoke(
 	}
 
 CLEANUP:
+	PREDEXP_LIST_DESTROY(scan_policy_p, &predexp_list);
+
 	if (py_ustr1) {
 		Py_DECREF(py_ustr1);
 	}
@@ -28,15 +28,16 @@
 #include "client.h"
 #include "conversions.h"
 #include "exceptions.h"
+#include "job.h"
 #include "policy.h"
 
 static bool getDataTypeFromPyObject(PyObject* py_datatype, as_index_datatype* idx_datatype, as_error* err);
 
-static PyObject* createIndexWithCollectionType(AerospikeClient* self, PyObject* py_policy, PyObject* py_ns, PyObject* py_set,
+static PyObject* createIndexWithCollectionType(AerospikeClient* self, PyObject* py_policy, PyObject* py_block, PyObject* py_ns, PyObject* py_set,
 	 PyObject* py_bin, PyObject* py_name, PyObject* py_datatype, as_index_type index_type);
 
 static PyObject*
-createIndexWithDataAndCollectionType(AerospikeClient* self, PyObject* py_policy, PyObject* py_ns, PyObject* py_set,
+createIndexWithDataAndCollectionType(AerospikeClient* self, PyObject* py_policy, PyObject* py_block, PyObject* py_ns, PyObject* py_set,
 	 PyObject* py_bin, PyObject* py_name, as_index_type index_type, as_index_datatype data_type);
 
 /**
@@ -64,17 +65,18 @@ PyObject * AerospikeClient_Index_Integer_Create(AerospikeClient * self, PyObject
 	PyObject * py_set = NULL;
 	PyObject * py_bin = NULL;
 	PyObject * py_name = NULL;
+	PyObject * py_block = NULL;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"ns", "set", "bin", "name", "policy", NULL};
+	static char * kwlist[] = {"ns", "set", "bin", "name", "policy", "block", NULL};
 
 	// Python Function Argument Parsing
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|O:index_integer_create", kwlist,
-				&py_ns, &py_set, &py_bin, &py_name, &py_policy) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|OO:index_integer_create", kwlist,
+				&py_ns, &py_set, &py_bin, &py_name, &py_policy, &py_block) == false) {
 		return NULL;
 	}
 
-	return createIndexWithDataAndCollectionType(self, py_policy, py_ns, py_set, py_bin, py_name, AS_INDEX_TYPE_DEFAULT, AS_INDEX_NUMERIC);
+	return createIndexWithDataAndCollectionType(self, py_policy, py_block, py_ns, py_set, py_bin, py_name, AS_INDEX_TYPE_DEFAULT, AS_INDEX_NUMERIC);
 
 }
 
@@ -103,17 +105,18 @@ PyObject * AerospikeClient_Index_String_Create(AerospikeClient * self, PyObject
 	PyObject * py_set = NULL;
 	PyObject * py_bin = NULL;
 	PyObject * py_name = NULL;
+	PyObject * py_block = NULL;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"ns", "set", "bin", "name", "policy", NULL};
+	static char * kwlist[] = {"ns", "set", "bin", "name", "policy", "block", NULL};
 
 	// Python Function Argument Parsing
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|O:index_string_create", kwlist,
-				&py_ns, &py_set, &py_bin, &py_name, &py_policy) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|OO:index_string_create", kwlist,
+				&py_ns, &py_set, &py_bin, &py_name, &py_policy, &py_block) == false) {
 		return NULL;
 	}
 
-	return createIndexWithDataAndCollectionType(self, py_policy, py_ns, py_set, py_bin, py_name, AS_INDEX_TYPE_DEFAULT, AS_INDEX_STRING);
+	return createIndexWithDataAndCollectionType(self, py_policy, py_block, py_ns, py_set, py_bin, py_name, AS_INDEX_TYPE_DEFAULT, AS_INDEX_STRING);
 }
 
 /**
@@ -231,18 +234,19 @@ PyObject * AerospikeClient_Index_List_Create(AerospikeClient * self, PyObject *a
 	PyObject * py_bin = NULL;
 	PyObject * py_name = NULL;
 	PyObject * py_datatype = NULL;
+	PyObject * py_block = NULL;
 
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"ns", "set", "bin", "index_datatype", "name", "policy", NULL};
+	static char * kwlist[] = {"ns", "set", "bin", "index_datatype", "name", "policy", "block", NULL};
 
 	// Python Function Argument Parsing
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOOO|O:index_list_create", kwlist,
-				&py_ns, &py_set, &py_bin, &py_datatype, &py_name, &py_policy) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOOO|OO:index_list_create", kwlist,
+				&py_ns, &py_set, &py_bin, &py_datatype, &py_name, &py_policy, &py_block) == false) {
 		return NULL;
 	}
 
-	return createIndexWithCollectionType(self, py_policy, py_ns, py_set, py_bin, py_name, py_datatype, AS_INDEX_TYPE_LIST);
+	return createIndexWithCollectionType(self, py_policy, py_block, py_ns, py_set, py_bin, py_name, py_datatype, AS_INDEX_TYPE_LIST);
 }
 
 PyObject * AerospikeClient_Index_Map_Keys_Create(AerospikeClient * self, PyObject *args, PyObject * kwds)
@@ -258,18 +262,19 @@ PyObject * AerospikeClient_Index_Map_Keys_Create(AerospikeClient * self, PyObjec
 	PyObject * py_bin = NULL;
 	PyObject * py_name = NULL;
 	PyObject * py_datatype = NULL;
+	PyObject * py_block = NULL;
 
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"ns", "set", "bin", "index_datatype", "name", "policy", NULL};
+	static char * kwlist[] = {"ns", "set", "bin", "index_datatype", "name", "policy", "block", NULL};
 
 	// Python Function Argument Parsing
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOOO|O:index_map_keys_create", kwlist,
-				&py_ns, &py_set, &py_bin, &py_datatype, &py_name, &py_policy) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOOO|OO:index_map_keys_create", kwlist,
+				&py_ns, &py_set, &py_bin, &py_datatype, &py_name, &py_policy, &py_block) == false) {
 		return NULL;
 	}
 
-	return createIndexWithCollectionType(self, py_policy, py_ns, py_set, py_bin, py_name, py_datatype, AS_INDEX_TYPE_MAPKEYS);
+	return createIndexWithCollectionType(self, py_policy, py_block, py_ns, py_set, py_bin, py_name, py_datatype, AS_INDEX_TYPE_MAPKEYS);
 
 }
 
@@ -286,17 +291,18 @@ PyObject * AerospikeClient_Index_Map_Values_Create(AerospikeClient * self, PyObj
 	PyObject * py_bin = NULL;
 	PyObject * py_name = NULL;
 	PyObject * py_datatype = NULL;
+	PyObject * py_block = NULL;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"ns", "set", "bin", "index_datatype", "name", "policy", NULL};
+	static char * kwlist[] = {"ns", "set", "bin", "index_datatype", "name", "policy", "block", NULL};
 
 	// Python Function Argument Parsing
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOOO|O:index_map_values_create", kwlist,
-				&py_ns, &py_set, &py_bin, &py_datatype, &py_name, &py_policy) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOOO|OO:index_map_values_create", kwlist,
+				&py_ns, &py_set, &py_bin, &py_datatype, &py_name, &py_policy, &py_block) == false) {
 		return NULL;
 	}
 
-	return createIndexWithCollectionType(self, py_policy, py_ns, py_set, py_bin, py_name, py_datatype, AS_INDEX_TYPE_MAPVALUES);
+	return createIndexWithCollectionType(self, py_policy, py_block, py_ns, py_set, py_bin, py_name, py_datatype, AS_INDEX_TYPE_MAPVALUES);
 }
 
 PyObject * AerospikeClient_Index_2dsphere_Create(AerospikeClient * self, PyObject *args, PyObject * kwds)
@@ -311,17 +317,18 @@ PyObject * AerospikeClient_Index_2dsphere_Create(AerospikeClient * self, PyObjec
 	PyObject * py_set = NULL;
 	PyObject * py_bin = NULL;
 	PyObject * py_name = NULL;
+	PyObject * py_block = NULL;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"ns", "set", "bin", "name", "policy", NULL};
+	static char * kwlist[] = {"ns", "set", "bin", "name", "policy", "block", NULL};
 
 	// Python Function Argument Parsing
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|O:index_geo2dsphere_create", kwlist,
-				&py_ns, &py_set, &py_bin, &py_name, &py_policy) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|OO:index_geo2dsphere_create", kwlist,
+				&py_ns, &py_set, &py_bin, &py_name, &py_policy, &py_block) == false) {
 		return NULL;
 	}
 
-	return createIndexWithDataAndCollectionType(self, py_policy, py_ns, py_set, py_bin, py_name, AS_INDEX_TYPE_DEFAULT, AS_INDEX_GEO2DSPHERE);
+	return createIndexWithDataAndCollectionType(self, py_policy, py_block, py_ns, py_set, py_bin, py_name, AS_INDEX_TYPE_DEFAULT, AS_INDEX_GEO2DSPHERE);
 
 }
 
@@ -367,7 +374,7 @@ getDataTypeFromPyObject(PyObject* py_datatype, as_index_datatype* idx_datatype,
  * Figure out the data_type from a PyObject and call createIndexWithDataAndCollectionType.
  */
 static PyObject*
-createIndexWithCollectionType(AerospikeClient* self, PyObject* py_policy, PyObject* py_ns, PyObject* py_set,
+createIndexWithCollectionType(AerospikeClient* self, PyObject* py_policy, PyObject* py_block, PyObject* py_ns, PyObject* py_set,
 	 PyObject* py_bin, PyObject* py_name, PyObject* py_datatype, as_index_type index_type) {
 	
 	as_index_datatype data_type = AS_INDEX_STRING;
@@ -379,18 +386,18 @@ createIndexWithCollectionType(AerospikeClient* self, PyObject* py_policy, PyObje
 		return NULL;
 	}
 
-	return createIndexWithDataAndCollectionType(self, py_policy, py_ns, py_set, py_bin, py_name, index_type, data_type);
+	return createIndexWithDataAndCollectionType(self, py_policy, py_block, py_ns, py_set, py_bin, py_name, index_type, data_type);
 	
 }
 
 
 /*
- * Create a complex index on the specified ns/set/bin with the given name and index and data_type. Return PyObject(0) on success
- * else return NULL with an error raised.
+ * Create a complex index on the specified ns/set/bin with the given name and index and data_type. Return PyObject(0) on success,
+ * or an aerospike.Job tracking the build if block is False, else return NULL with an error raised.
  */
 
 static PyObject*
-createIndexWithDataAndCollectionType(AerospikeClient* self, PyObject* py_policy, PyObject* py_ns, PyObject* py_set,
+createIndexWithDataAndCollectionType(AerospikeClient* self, PyObject* py_policy, PyObject* py_block, PyObject* py_ns, PyObject* py_set,
 	 PyObject* py_bin, PyObject* py_name, as_index_type index_type, as_index_datatype data_type) {
 
 	// Initialize error
@@ -404,6 +411,8 @@ createIndexWithDataAndCollectionType(AerospikeClient* self, PyObject* py_policy,
 	as_policy_info info_policy;
 	as_policy_info *info_policy_p = NULL;
 	as_index_task task;
+	AerospikeJob * job = NULL;
+	bool block = true;
 
 	if (!self || !self->as) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
@@ -422,6 +431,15 @@ createIndexWithDataAndCollectionType(AerospikeClient* self, PyObject* py_policy,
 		goto CLEANUP;
 	}
 
+	// block=False hands back a Job tracking the build instead of waiting on it
+	if (py_block && py_block != Py_None) {
+		if (!PyBool_Check(py_block)) {
+			as_error_update(&err, AEROSPIKE_ERR_PARAM, "block should be a boolean");
+			goto CLEANUP;
+		}
+		block = py_block == Py_True;
+	}
+
 	// Convert python object into namespace string
 	if( !PyString_Check(py_ns) ) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Namespace should be a string");
@@ -474,10 +492,13 @@ createIndexWithDataAndCollectionType(AerospikeClient* self, PyObject* py_policy,
 	if (err.code != AEROSPIKE_OK) {
 		as_error_update(&err, err.code, NULL);
 		goto CLEANUP;
-	} else {
+	} else if (block) {
 		Py_BEGIN_ALLOW_THREADS
 		aerospike_index_create_wait(&err, &task, 2000);
 		Py_END_ALLOW_THREADS
+	} else {
+		job = AerospikeJob_New_Index(self, &err, &task,
+				info_policy_p ? info_policy_p : &self->as->config.policies.info);
 	}
 
 CLEANUP:
@@ -499,5 +520,8 @@ CLEANUP:
 		return NULL;
 	}
 
+	if (job) {
+		return (PyObject *) job;
+	}
 	return PyLong_FromLong(0);
 }
@@ -26,6 +26,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 /**
  *******************************************************************************************************
@@ -51,6 +52,7 @@ PyObject * AerospikeClient_Select_Invoke(
 	as_error err;
 	as_policy_read read_policy;
 	as_policy_read * read_policy_p = NULL;
+	as_predexp_list predexp_list;
 	as_key key;
 	as_record * rec = NULL;
     // It's only safe to free the record if this succeeded.
@@ -132,15 +134,29 @@ PyObject * AerospikeClient_Select_Invoke(
 
 	// Convert python policy object to as_policy_exists
 	pyobject_to_policy_read(&err, py_policy, &read_policy, &read_policy_p,
-			&self->as->config.policies.read);
+			&self->as->config.policies.read, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
+	uint32_t hedge_delay_ms;
+	if (as_hedge_delay(&self->hedger, &err, py_policy, read_policy_p, &hedge_delay_ms) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	uint64_t routed_ns = as_read_router_route(self->read_router, &self->as->config.policies.read,
+			&read_policy, &read_policy_p);
+
 	// Invoke operation
 	Py_BEGIN_ALLOW_THREADS
-	aerospike_key_select(self->as, &err, read_policy_p, &key, (const char **) bins, &rec);
+	if (hedge_delay_ms) {
+		as_hedge_read(&self->hedger, self->as, &err, read_policy_p, &key, (const char **) bins,
+				hedge_delay_ms, &rec);
+	} else {
+		aerospike_key_select(self->as, &err, read_policy_p, &key, (const char **) bins, &rec);
+	}
 	Py_END_ALLOW_THREADS
+	as_read_router_record(self->read_router, routed_ns);
 
 	if (err.code == AEROSPIKE_OK) {
 		select_succeeded = true;
@@ -151,6 +167,8 @@ PyObject * AerospikeClient_Select_Invoke(
 	}
 
 CLEANUP:
+	PREDEXP_LIST_DESTROY(read_policy_p, &predexp_list);
+
 
 	if (py_ustr) {
 		Py_DECREF(py_ustr);
@@ -28,6 +28,7 @@
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 
 /**
  *************************************************************************
@@ -66,6 +67,11 @@ static PyObject * batch_select_aerospike_batch_read(as_error *err, AerospikeClie
 
 	as_batch_read_record* record = NULL;
 	bool batch_initialised = false;
+	as_latency_timer timer;
+	as_trace_span span;
+
+	as_latency_timer_start(&timer, self->latency, AS_LATENCY_BATCH);
+	as_trace_begin(&span, AS_LATENCY_BATCH);
 
 	// Convert python keys list to as_key ** and add it to as_batch.keys
 	// keys can be specified in PyList or PyTuple
@@ -136,16 +142,21 @@ static PyObject * batch_select_aerospike_batch_read(as_error *err, AerospikeClie
 	}
 
 	// Invoke C-client API
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 	aerospike_batch_read(self->as, err, batch_policy_p, &records);
 	Py_END_ALLOW_THREADS
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
+	as_trace_batch_read(&span, &records);
 	if (err->code != AEROSPIKE_OK)
 	{
 		goto CLEANUP;
 	}
 	batch_read_records_to_pyobject(self, err, &records, &py_recs);
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_PYTHON);
 
 CLEANUP:
+	as_trace_end(&span, err);
 	if (batch_initialised == true) {
 		// We should destroy batch object as we are using 'as_batch_init' for initialisation
 		// Also, pyobject_to_key is soing strdup() in case of Unicode. So, object destruction
@@ -180,6 +191,7 @@ PyObject * AerospikeClient_Select_Many_Invoke(
 	as_error err;
 	as_policy_batch policy;
 	as_policy_batch * batch_policy_p = NULL;
+	as_predexp_list predexp_list;
 	Py_ssize_t bins_size = 0;
 	char **filter_bins = NULL;
 
@@ -242,7 +254,7 @@ PyObject * AerospikeClient_Select_Many_Invoke(
 
 	// Convert python policy object to as_policy_batch
 	pyobject_to_policy_batch(&err, py_policy, &policy, &batch_policy_p,
-			&self->as->config.policies.batch);
+			&self->as->config.policies.batch, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
@@ -251,6 +263,8 @@ PyObject * AerospikeClient_Select_Many_Invoke(
 	py_recs = batch_select_aerospike_batch_read(&err, self, py_keys, batch_policy_p, filter_bins, bins_size);
 
 CLEANUP:
+	PREDEXP_LIST_DESTROY(batch_policy_p, &predexp_list);
+
 
 	if (filter_bins) {
 		free(filter_bins);
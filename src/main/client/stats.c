@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/aerospike_stats.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_node.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+
+static int stats_set_uint(PyObject * py_dict, const char * name, uint32_t value)
+{
+	PyObject * py_value = PyLong_FromUnsignedLong(value);
+	if (!py_value) {
+		return -1;
+	}
+	int rc = PyDict_SetItemString(py_dict, name, py_value);
+	Py_DECREF(py_value);
+	return rc;
+}
+
+static PyObject * stats_node_to_pyobject(as_node_stats * node_stats)
+{
+	as_conn_stats * sync = &node_stats->sync;
+	PyObject * py_node = PyDict_New();
+
+	if (!py_node) {
+		return NULL;
+	}
+
+	PyObject * py_address = PyString_FromString(as_node_get_address_string(node_stats->node));
+	if (!py_address || PyDict_SetItemString(py_node, "address", py_address) < 0 ||
+			stats_set_uint(py_node, "open", sync->in_use + sync->in_pool) < 0 ||
+			stats_set_uint(py_node, "in_use", sync->in_use) < 0 ||
+			stats_set_uint(py_node, "idle", sync->in_pool) < 0 ||
+			stats_set_uint(py_node, "connects", sync->opened) < 0 ||
+			stats_set_uint(py_node, "closes", sync->closed) < 0) {
+		Py_XDECREF(py_address);
+		Py_DECREF(py_node);
+		return NULL;
+	}
+
+	Py_DECREF(py_address);
+	return py_node;
+}
+
+/**
+ ********************************************************************************************************
+ * Returns the connection pool statistics of each node of the cluster.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns a dict of the node stats by node name, under 'nodes', and of the
+ * near cache counters under 'near_cache' if the client has one. With
+ * latency_aware_reads, the nodes have their latency EWMA, under 'read_routing'
+ * the state of the routing. The hedged read counters are under 'hedged_reads'.
+ * In case of error, appropriate exceptions will be raised.
+ ********************************************************************************************************
+ */
+PyObject * AerospikeClient_Stats(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	as_error err;
+	as_error_init(&err);
+	as_cluster_stats stats;
+	bool stats_taken = false;
+	PyObject * py_stats = NULL;
+	PyObject * py_nodes = NULL;
+
+	static char * kwlist[] = {NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, ":stats", kwlist) == false) {
+		return NULL;
+	}
+
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	// Only counters are read, under the pool locks.
+	aerospike_stats(self->as, &stats);
+	stats_taken = true;
+
+	py_stats = PyDict_New();
+	py_nodes = PyDict_New();
+	if (!py_stats || !py_nodes || PyDict_SetItemString(py_stats, "nodes", py_nodes) < 0 ||
+			stats_set_uint(py_stats, "thread_pool_queued_tasks", stats.thread_pool_queued_tasks) < 0) {
+		goto CLEANUP;
+	}
+
+	if (self->near_cache) {
+		PyObject * py_near_cache = as_near_cache_stats(self->near_cache);
+		int rc = py_near_cache ? PyDict_SetItemString(py_stats, "near_cache", py_near_cache) : -1;
+		Py_XDECREF(py_near_cache);
+		if (rc < 0) {
+			goto CLEANUP;
+		}
+	}
+
+	for (uint32_t i = 0; i < stats.nodes_size; i++) {
+		PyObject * py_node = stats_node_to_pyobject(&stats.nodes[i]);
+		if (!py_node) {
+			goto CLEANUP;
+		}
+
+		int rc = PyDict_SetItemString(py_nodes, stats.nodes[i].node->name, py_node);
+		Py_DECREF(py_node);
+		if (rc < 0) {
+			goto CLEANUP;
+		}
+	}
+
+	if (self->read_router && as_read_router_stats(self->read_router, py_stats, py_nodes) < 0) {
+		goto CLEANUP;
+	}
+
+	PyObject * py_hedged = as_hedger_stats(&self->hedger);
+	int rc = py_hedged ? PyDict_SetItemString(py_stats, "hedged_reads", py_hedged) : -1;
+	Py_XDECREF(py_hedged);
+	if (rc < 0) {
+		goto CLEANUP;
+	}
+
+CLEANUP:
+
+	if (stats_taken) {
+		aerospike_stats_destroy(&stats);
+	}
+
+	Py_XDECREF(py_nodes);
+
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	if (PyErr_Occurred()) {
+		Py_XDECREF(py_stats);
+		return NULL;
+	}
+
+	return py_stats;
+}
+
+/**
+ ********************************************************************************************************
+ * Returns the latency histograms of the commands of the client.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns a dict of the histograms of each phase by command, empty if the
+ * client does not record them.
+ * In case of error, appropriate exceptions will be raised.
+ ********************************************************************************************************
+ */
+PyObject * AerospikeClient_Latency_Histograms(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	as_error err;
+	as_error_init(&err);
+	PyObject * py_reset = NULL;
+	PyObject * py_histograms = NULL;
+
+	static char * kwlist[] = {"reset", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|O:latency_histograms", kwlist, &py_reset) == false) {
+		return NULL;
+	}
+
+	if (!self) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	py_histograms = as_latency_to_pyobject(&err, self->latency, py_reset && PyObject_IsTrue(py_reset));
+
+CLEANUP:
+
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return py_histograms;
+}
@@ -41,6 +41,8 @@ AerospikeClient_TruncateInvoke(
 	}
 
 	status = aerospike_truncate(self->as, err, info_policy_p, namespace, set, nanos);
+	// Entries do not record their set, so all are dropped.
+	as_near_cache_clear(self->near_cache);
 	if (status != AEROSPIKE_OK) {
 		// The truncate operation failed. Update the err->code and return
 		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Truncate operation failed");
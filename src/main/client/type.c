@@ -39,17 +39,34 @@ static int set_use_services_alternate(as_config* conf, PyObject* config_dict);
 enum {INIT_SUCCESS, INIT_NO_CONFIG_ERR, INIT_CONFIG_TYPE_ERR, INIT_LUA_USER_ERR,
 	  INIT_LUA_SYS_ERR,  INIT_HOST_TYPE_ERR, INIT_EMPTY_HOSTS_ERR,
 	  INIT_INVALID_ADRR_ERR, INIT_SERIALIZE_ERR, INIT_DESERIALIZE_ERR,
-	  INIT_COMPRESSION_ERR, INIT_POLICY_PARAM_ERR};
+	  INIT_COMPRESSION_ERR, INIT_POLICY_PARAM_ERR, INIT_NEAR_CACHE_ERR,
+	  INIT_READ_ROUTING_ERR};
 
 /*******************************************************************************
  * PYTHON DOC METHODS
  ******************************************************************************/
 
 PyDoc_STRVAR(connect_doc,
-"connect([username, password])\n\
+"connect([username, password[, warmup]])\n\
 \n\
 Connect to the cluster. The optional username and password only apply when \
-connecting to the Enterprise Edition of Aerospike.");
+connecting to the Enterprise Edition of Aerospike. With min_conns_per_node configured, \
+warmup, True by default, opens those connections to each node before returning.");
+
+PyDoc_STRVAR(stats_doc,
+"stats() -> {}\n\
+\n\
+Return the connection pool statistics of each node, by node name under 'nodes': \
+the open, in_use and idle connections, and the connects and closes since the client connected. \
+With a near_cache configured, its counters are under 'near_cache'. \
+With latency_aware_reads, each node has its latency EWMA, and the routing state is under 'read_routing'. \
+The counters of the hedged reads are under 'hedged_reads'.");
+
+PyDoc_STRVAR(latency_histograms_doc,
+"latency_histograms([reset]) -> {}\n\
+\n\
+Return the latency histograms of the commands of the client, if its config enabled latency_histograms, \
+by command and phase: to_c, in_c and to_python. With reset True, they are zeroed after being read.");
 
 PyDoc_STRVAR(exists_doc,
 "exists(key[, policy]) -> (key, meta)\n\
@@ -75,6 +92,12 @@ PyDoc_STRVAR(put_doc,
 \n\
 Write a record with a given key to the cluster.");
 
+PyDoc_STRVAR(update_doc,
+"update(key, fn[, max_retries[, policy[, backoff_ms]]]) -> dict\n\
+\n\
+Read a record, pass its bins to fn and write the bins fn changed if the record did not change meanwhile, \
+retrying up to max_retries times otherwise.");
+
 PyDoc_STRVAR(remove_doc,
 "remove(key[, policy])\n\
 \n\
@@ -111,8 +134,20 @@ PyDoc_STRVAR(increment_doc,
 \n\
 Increment the integer value in bin by the integer val.");
 
+PyDoc_STRVAR(counter_buffer_doc,
+"counter_buffer([flush_interval_ms[, max_keys[, on_error]]]) -> CounterBuffer\n\
+\n\
+Create a buffer of increments, summed per key and bin and written as one operate command per key \
+every flush_interval_ms, or once max_keys keys are pending. Failed writes are passed to on_error(key, bins, exception).");
+
+PyDoc_STRVAR(write_queue_doc,
+"write_queue([max_inflight[, max_queued[, on_error]]]) -> WriteQueue\n\
+\n\
+Create a queue of puts and operates, converted on the caller thread and sent by max_inflight background threads \
+without waiting for their results. Failed writes are passed to on_error(key, exception).");
+
 PyDoc_STRVAR(operate_doc,
-"operate(key, list[, meta[, policy]]) -> (key, meta, bins)\n\
+"operate(key, list[, meta[, policy[, values]]]) -> (key, meta, bins)\n\
 \n\
 Perform multiple bin operations on a record with a given key, In Aerospike server versions prior to 3.6.0, \
 non-existent bins being read will have a None value. \
@@ -121,11 +156,62 @@ The returned record tuple will only contain one entry per bin, \
 even if multiple operations were performed on the bin.");
 
 PyDoc_STRVAR(operate_ordered_doc,
-"operate_ordered(key, list[, meta[, policy]]) -> (key, meta, bins)\n\
+"operate_ordered(key, list[, meta[, policy[, values]]]) -> (key, meta, bins)\n\
 \n\
 Perform multiple bin operations on a record with the results being returned as a list of (bin-name, result) tuples. \
 The order of the elements in the list will correspond to the order of the operations from the input parameters.");
 
+PyDoc_STRVAR(compile_ops_doc,
+"compile_ops(list) -> CompiledOperations\n\
+\n\
+Encode a list of operations once, to be passed to operate() and operate_ordered() in place of the list. \
+Values given as aerospike.Placeholder(n) are taken from the values argument of each call.");
+
+PyDoc_STRVAR(compile_ctx_doc,
+"compile_ctx(ctx) -> CDTContext\n\
+\n\
+Convert a list of cdt_ctx objects once, to be passed as the ctx of list and map operations in place of the list.");
+
+PyDoc_STRVAR(read_policy_doc,
+"read_policy(**fields) -> Policy\n\
+\n\
+Compile a read policy from the client defaults and the given fields, to be passed as the policy of get(), select(), exists().");
+
+PyDoc_STRVAR(write_policy_doc,
+"write_policy(**fields) -> Policy\n\
+\n\
+Compile a write policy from the client defaults and the given fields, to be passed as the policy of put().");
+
+PyDoc_STRVAR(operate_policy_doc,
+"operate_policy(**fields) -> Policy\n\
+\n\
+Compile a operate policy from the client defaults and the given fields, to be passed as the policy of operate(), operate_ordered(), append() and the other single bin operations.");
+
+PyDoc_STRVAR(remove_policy_doc,
+"remove_policy(**fields) -> Policy\n\
+\n\
+Compile a remove policy from the client defaults and the given fields, to be passed as the policy of remove().");
+
+PyDoc_STRVAR(apply_policy_doc,
+"apply_policy(**fields) -> Policy\n\
+\n\
+Compile a apply policy from the client defaults and the given fields, to be passed as the policy of apply().");
+
+PyDoc_STRVAR(batch_policy_doc,
+"batch_policy(**fields) -> Policy\n\
+\n\
+Compile a batch policy from the client defaults and the given fields, to be passed as the policy of get_many(), select_many() and exists_many().");
+
+PyDoc_STRVAR(scan_policy_doc,
+"scan_policy(**fields) -> Policy\n\
+\n\
+Compile a scan policy from the client defaults and the given fields, to be passed as the policy of Scan methods.");
+
+PyDoc_STRVAR(query_policy_doc,
+"query_policy(**fields) -> Policy\n\
+\n\
+Compile a query policy from the client defaults and the given fields, to be passed as the policy of Query methods.");
+
 PyDoc_STRVAR(list_append_doc,
 "list_append(key, bin, val[, meta[, policy]])\n\
 \n\
@@ -365,6 +451,11 @@ PyDoc_STRVAR(job_info_doc,
 \n\
 Return the status of a job running in the background.");
 
+PyDoc_STRVAR(job_doc,
+"job(job_id, module[, policy]) -> Job\n\
+\n\
+Return an `aerospike.Job` tracking a scan or query running in the background.");
+
 PyDoc_STRVAR(scan_doc,
 "scan(namespace[, set]) -> Scan\n\
 \n\
@@ -428,12 +519,12 @@ PyDoc_STRVAR(udf_get_doc,
 Return the content of a UDF module which is registered with the cluster.");
 
 PyDoc_STRVAR(index_integer_create_doc,
-"index_integer_create(ns, set, bin, index_name[, policy])\n\
+"index_integer_create(ns, set, bin, index_name[, policy[, block]])\n\
 \n\
 Create an integer index with index_name on the bin in the specified ns, set.");
 
 PyDoc_STRVAR(index_string_create_doc,
-"index_string_create(ns, set, bin, index_name[, policy])\n\
+"index_string_create(ns, set, bin, index_name[, policy[, block]])\n\
 \n\
 Create a string index with index_name on the bin in the specified ns, set.");
 
@@ -443,33 +534,34 @@ PyDoc_STRVAR(index_remove_doc,
 Remove the index with index_name from the namespace.");
 
 PyDoc_STRVAR(index_list_create_doc,
-"index_list_create(ns, set, bin, index_datatype, index_name[, policy])\n\
+"index_list_create(ns, set, bin, index_datatype, index_name[, policy[, block]])\n\
 \n\
 Create an index named index_name for numeric, string or GeoJSON values (as defined by index_datatype) \
 on records of the specified ns, set whose bin is a list.");
 
 PyDoc_STRVAR(index_map_keys_create_doc,
-"index_map_keys_create(ns, set, bin, index_datatype, index_name[, policy])\n\
+"index_map_keys_create(ns, set, bin, index_datatype, index_name[, policy[, block]])\n\
 \n\
 Create an index named index_name for numeric, string or GeoJSON values (as defined by index_datatype) \
 on records of the specified ns, set whose bin is a map. The index will include the keys of the map.");
 
 PyDoc_STRVAR(index_map_values_create_doc,
-"index_map_values_create(ns, set, bin, index_datatype, index_name[, policy])\n\
+"index_map_values_create(ns, set, bin, index_datatype, index_name[, policy[, block]])\n\
 \n\
 Create an index named index_name for numeric, string or GeoJSON values (as defined by index_datatype) \
 on records of the specified ns, set whose bin is a map. The index will include the values of the map.");
 
 PyDoc_STRVAR(index_geo2dsphere_create_doc,
-"index_geo2dsphere_create(ns, set, bin, index_name[, policy])\n\
+"index_geo2dsphere_create(ns, set, bin, index_name[, policy[, block]])\n\
 \n\
 Create a geospatial 2D spherical index with index_name on the bin in the specified ns, set.");
 
 PyDoc_STRVAR(get_many_doc,
-"get_many(keys[, policy]) -> [ (key, meta, bins)]\n\
+"get_many(keys[, policy[, format]]) -> [ (key, meta, bins)]\n\
 \n\
 Batch-read multiple records, and return them as a list. \
-Any record that does not exist will have a None value for metadata and bins in the record tuple.");
+Any record that does not exist will have a None value for metadata and bins in the record tuple. \
+With format='columnar' the records are returned as a ColumnarResult, one row per key.");
 
 PyDoc_STRVAR(select_many_doc,
 "select_many(keys, bins[, policy]) -> [(key, meta, bins)]\n\
@@ -478,6 +570,13 @@ Batch-read multiple records, and return them as a list. \
 Any record that does not exist will have a None value for metadata and bins in the record tuple. \
 The bins will be filtered as specified.");
 
+PyDoc_STRVAR(aggregate_many_doc,
+"aggregate_many(keys, aggregates[, policy]) -> dict\n\
+\n\
+Batch-read multiple records and reduce them to the aggregates, a dict of name to an aggregate built by \
+aerospike_helpers.aggregates. Only the bins used by the aggregates are read, and the records are reduced \
+without creating Python objects. Returns a dict of name to reduced value.");
+
 PyDoc_STRVAR(exists_many_doc,
 "exists_many(keys[, policy]) -> [ (key, meta)]\n\
 \n\
@@ -520,6 +619,12 @@ static PyMethodDef AerospikeClient_Type_Methods[] = {
 	{"shm_key",
 		(PyCFunction) AerospikeClient_shm_key, METH_VARARGS | METH_KEYWORDS,
 		"Get the shm key of the cluster"},
+	{"stats",
+		(PyCFunction) AerospikeClient_Stats, METH_VARARGS | METH_KEYWORDS,
+		stats_doc},
+	{"latency_histograms",
+		(PyCFunction) AerospikeClient_Latency_Histograms, METH_VARARGS | METH_KEYWORDS,
+		latency_histograms_doc},
 
 	// ADMIN OPERATIONS
 
@@ -578,6 +683,9 @@ static PyMethodDef AerospikeClient_Type_Methods[] = {
 	{"put",
 		(PyCFunction) AerospikeClient_Put, METH_VARARGS | METH_KEYWORDS,
 		put_doc},
+	{"update",
+		(PyCFunction) AerospikeClient_Update, METH_VARARGS | METH_KEYWORDS,
+		update_doc},
 	{"remove",
 		(PyCFunction) AerospikeClient_Remove, METH_VARARGS | METH_KEYWORDS,
 		remove_doc},
@@ -599,12 +707,51 @@ static PyMethodDef AerospikeClient_Type_Methods[] = {
 	{"increment",
 		(PyCFunction) AerospikeClient_Increment, METH_VARARGS | METH_KEYWORDS,
 		increment_doc},
+	{"counter_buffer",
+		(PyCFunction) AerospikeClient_Counter_Buffer, METH_VARARGS | METH_KEYWORDS,
+		counter_buffer_doc},
+	{"write_queue",
+		(PyCFunction) AerospikeClient_Write_Queue, METH_VARARGS | METH_KEYWORDS,
+		write_queue_doc},
 	{"operate",
 		(PyCFunction) AerospikeClient_Operate, METH_VARARGS | METH_KEYWORDS,
 		operate_doc},
 	{"operate_ordered",
 		(PyCFunction) AerospikeClient_OperateOrdered, METH_VARARGS | METH_KEYWORDS,
 		operate_ordered_doc},
+	{"compile_ops",
+		(PyCFunction) AerospikeClient_CompileOps, METH_VARARGS | METH_KEYWORDS,
+		compile_ops_doc},
+	{"compile_ctx",
+		(PyCFunction) AerospikeClient_CompileCtx, METH_VARARGS | METH_KEYWORDS,
+		compile_ctx_doc},
+
+	// COMPILED POLICIES
+
+	{"read_policy",
+		(PyCFunction) AerospikeClient_ReadPolicy, METH_VARARGS | METH_KEYWORDS,
+		read_policy_doc},
+	{"write_policy",
+		(PyCFunction) AerospikeClient_WritePolicy, METH_VARARGS | METH_KEYWORDS,
+		write_policy_doc},
+	{"operate_policy",
+		(PyCFunction) AerospikeClient_OperatePolicy, METH_VARARGS | METH_KEYWORDS,
+		operate_policy_doc},
+	{"remove_policy",
+		(PyCFunction) AerospikeClient_RemovePolicy, METH_VARARGS | METH_KEYWORDS,
+		remove_policy_doc},
+	{"apply_policy",
+		(PyCFunction) AerospikeClient_ApplyPolicy, METH_VARARGS | METH_KEYWORDS,
+		apply_policy_doc},
+	{"batch_policy",
+		(PyCFunction) AerospikeClient_BatchPolicy, METH_VARARGS | METH_KEYWORDS,
+		batch_policy_doc},
+	{"scan_policy",
+		(PyCFunction) AerospikeClient_ScanPolicy, METH_VARARGS | METH_KEYWORDS,
+		scan_policy_doc},
+	{"query_policy",
+		(PyCFunction) AerospikeClient_QueryPolicy, METH_VARARGS | METH_KEYWORDS,
+		query_policy_doc},
 
 	// LIST OPERATIONS
 
@@ -746,6 +893,9 @@ static PyMethodDef AerospikeClient_Type_Methods[] = {
 	{"job_info",
 		(PyCFunction) AerospikeClient_JobInfo, METH_VARARGS | METH_KEYWORDS,
 		job_info_doc},
+	{"job",
+		(PyCFunction) AerospikeClient_Job, METH_VARARGS | METH_KEYWORDS,
+		job_doc},
 
 	// SCAN OPERATIONS
 
@@ -825,6 +975,9 @@ static PyMethodDef AerospikeClient_Type_Methods[] = {
 	{"select_many",
 		(PyCFunction)AerospikeClient_Select_Many, METH_VARARGS | METH_KEYWORDS,
 		select_many_doc},
+	{"aggregate_many",
+		(PyCFunction)AerospikeClient_Aggregate_Many, METH_VARARGS | METH_KEYWORDS,
+		aggregate_many_doc},
 	{"exists_many",
 		(PyCFunction)AerospikeClient_Exists_Many, METH_VARARGS | METH_KEYWORDS,
 		exists_many_doc},
@@ -863,6 +1016,17 @@ static int AerospikeClient_Type_Init(AerospikeClient * self, PyObject * args, Py
 
 	self->has_connected = false;
 	self->use_shared_connection = false;
+	self->user_shm_key = false;
+	self->fork_generation = as_fork_generation;
+	self->min_conns_per_node = 0;
+	self->max_idle_conns_per_node = AS_CONN_NO_TRIM;
+	as_conn_warmer_init(&self->warmer);
+	self->latency = NULL;
+	self->near_cache = NULL;
+	self->read_router = NULL;
+	as_hedger_init(&self->hedger);
+	self->background.head = NULL;
+	self->background.closing = false;
 	self->as=NULL;
 
 	if (PyArg_ParseTupleAndKeywords(args, kwds, "O:client", kwlist, &py_config) == false) {
@@ -979,6 +1143,7 @@ static int AerospikeClient_Type_Init(AerospikeClient * self, PyObject * args, Py
 		goto CONSTRUCTOR_ERROR;
 	}
 
+	self->user_shm_key = false;
 	PyObject * py_shm = PyDict_GetItemString(py_config, "shm");
 	if (py_shm && PyDict_Check(py_shm) ) {
 
@@ -1019,7 +1184,7 @@ static int AerospikeClient_Type_Init(AerospikeClient * self, PyObject * args, Py
 
 		PyObject* py_shm_cluster_key = PyDict_GetItemString(py_shm, "shm_key");
 		if (py_shm_cluster_key && PyInt_Check(py_shm_cluster_key)) {
-			user_shm_key = true;
+			self->user_shm_key = true;
 			config.shm_key = PyInt_AsLong(py_shm_cluster_key);
 		}
 	}
@@ -1226,6 +1391,21 @@ static int AerospikeClient_Type_Init(AerospikeClient * self, PyObject * args, Py
 		config.max_conns_per_node = PyInt_AsLong(py_max_conns);
 	}
 
+	// min_conns_per_node, kept open by the client as the C client has no such setting
+	PyObject * py_min_conns = PyDict_GetItemString(py_config, WARMUP_CONFIG_KEY);
+	if (py_min_conns && (PyInt_Check(py_min_conns) || PyLong_Check(py_min_conns))) {
+		self->min_conns_per_node = PyInt_AsLong(py_min_conns);
+	}
+
+	// max_idle_conns_per_node, the floor above which idle connections are trimmed
+	PyObject * py_max_idle = PyDict_GetItemString(py_config, TRIM_CONFIG_KEY);
+	if (py_max_idle && (PyInt_Check(py_max_idle) || PyLong_Check(py_max_idle))) {
+		long max_idle = PyInt_AsLong(py_max_idle);
+		if (max_idle >= 0 && max_idle < AS_CONN_NO_TRIM) {
+			self->max_idle_conns_per_node = (uint32_t) max_idle;
+		}
+	}
+
 
 	//conn_timeout_ms
 	PyObject * py_connect_timeout = PyDict_GetItemString(py_config, "connect_timeout");
@@ -1239,6 +1419,30 @@ static int AerospikeClient_Type_Init(AerospikeClient * self, PyObject * args, Py
 		self->use_shared_connection = PyObject_IsTrue(py_share_connect);
 	}
 
+	// latency_histograms, recorded by the commands of this client
+	PyObject * py_latency = PyDict_GetItemString(py_config, AS_LATENCY_CONFIG_KEY);
+	if (py_latency && PyObject_IsTrue(py_latency) && !self->latency) {
+		self->latency = as_latency_new();
+	}
+
+	// near_cache, of the records read by get()
+	PyObject * py_near_cache = PyDict_GetItemString(py_config, AS_NEAR_CACHE_CONFIG_KEY);
+	if (py_near_cache && py_near_cache != Py_None && !self->near_cache) {
+		if (as_near_cache_new(&constructor_err, py_near_cache, &self->near_cache) != AEROSPIKE_OK) {
+			error_code = INIT_NEAR_CACHE_ERR;
+			goto CONSTRUCTOR_ERROR;
+		}
+	}
+
+	// latency_aware_reads, probing the nodes once connected
+	PyObject * py_read_routing = PyDict_GetItemString(py_config, AS_READ_ROUTER_CONFIG_KEY);
+	if (py_read_routing && py_read_routing != Py_None && !self->read_router) {
+		if (as_read_router_new(&constructor_err, py_read_routing, &self->read_router) != AEROSPIKE_OK) {
+			error_code = INIT_READ_ROUTING_ERR;
+			goto CONSTRUCTOR_ERROR;
+		}
+	}
+
 	//compression_threshold
 	PyObject * py_compression_threshold = PyDict_GetItemString(py_config, "compression_threshold");
 	if (py_compression_threshold && PyInt_Check(py_compression_threshold)) {
@@ -1343,6 +1547,11 @@ CONSTRUCTOR_ERROR:
 			as_error_update(&constructor_err, AEROSPIKE_ERR_PARAM, "Invalid Policy setting value");
 			break;
 		}
+		case INIT_NEAR_CACHE_ERR:
+		case INIT_READ_ROUTING_ERR: {
+			// constructor_err has the message
+			break;
+		}
 		default:
 			// If a generic error was caught during init, use this message
 			as_error_update(&constructor_err, AEROSPIKE_ERR_PARAM, "Invalid Parameters");
@@ -1413,6 +1622,21 @@ static void AerospikeClient_Type_Dealloc(PyObject * self)
 	AerospikeGlobalHosts* global_host = NULL;
 	AerospikeClient* client = (AerospikeClient*)self;
 
+	// The warmer thread of the parent process does not exist in a forked child.
+	if (client->fork_generation != as_fork_generation) {
+		as_conn_warmer_after_fork(&client->warmer);
+		as_read_router_after_fork(client->read_router);
+		as_hedger_after_fork(&client->hedger);
+	}
+	as_conn_warmer_stop(&client->warmer);
+	as_conn_warmer_destroy(&client->warmer);
+	as_read_router_stop(client->read_router);
+	as_read_router_destroy(client->read_router);
+	as_hedger_stop(&client->hedger);
+	as_hedger_destroy(&client->hedger);
+	as_latency_destroy(client->latency);
+	as_near_cache_destroy(client->near_cache);
+
 	// If the client has never connected
 	// It is safe to destroy the aerospike structure
 	if (client->as) {
@@ -1435,7 +1659,8 @@ static void AerospikeClient_Type_Dealloc(PyObject * self)
 					}
 				}
 			// Connection is not shared, so it is safe to destroy the as object
-			} else {
+			// unless it was inherited from the parent process, see client/fork.c
+			} else if (client->fork_generation == as_fork_generation) {
 				if (client->is_conn_16) {
 					aerospike_close(client->as, &err);
 				}
@@ -1446,6 +1671,17 @@ static void AerospikeClient_Type_Dealloc(PyObject * self)
 	self->ob_type->tp_free((PyObject *) self);
 }
 
+/*
+ * Every method is looked up here, so a client connected before a fork is
+ * reconnected on its first use in the child.
+ */
+static PyObject * AerospikeClient_Type_Getattro(AerospikeClient * self, PyObject * py_name)
+{
+	AerospikeClient_Fork_Ready(self);
+
+	return PyObject_GenericGetAttr((PyObject *) self, py_name);
+}
+
 /*******************************************************************************
  * PYTHON TYPE DESCRIPTOR
  ******************************************************************************/
@@ -1468,7 +1704,8 @@ static PyTypeObject AerospikeClient_Type = {
 	0,                                  // tp_hash
 	0,                                  // tp_call
 	0,                                  // tp_str
-	0,                                  // tp_getattro
+	(getattrofunc) AerospikeClient_Type_Getattro,
+	                                    // tp_getattro
 	0,                                  // tp_setattro
 	0,                                  // tp_as_buffer
 	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
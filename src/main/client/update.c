@@ -0,0 +1,367 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_buffer.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_msgpack.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_record_iterator.h>
+#include <aerospike/as_serializer.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "policy.h"
+#include "predexp.h"
+
+#define UPDATE_DEFAULT_MAX_RETRIES 5
+#define UPDATE_DEFAULT_BACKOFF_MS 1
+
+// Longest single backoff, the backoff doubles on each retry up to it.
+#define UPDATE_MAX_BACKOFF_MS 1000
+
+/*
+ * A bin still holding the very object read from the record is unchanged if
+ * the object can not be modified in place.
+ */
+static bool update_is_immutable(PyObject * py_value)
+{
+	return py_value == Py_None || PyLong_CheckExact(py_value) ||
+		PyInt_Check(py_value) || PyFloat_CheckExact(py_value) ||
+		PyUnicode_CheckExact(py_value) || PyBytes_CheckExact(py_value);
+}
+
+static bool update_vals_equal(const as_val * a, const as_val * b)
+{
+	if (as_val_type(a) != as_val_type(b)) {
+		return false;
+	}
+
+	// Compared on their wire format, a map whose order differs is sent again.
+	as_serializer ser;
+	as_buffer buffer_a;
+	as_buffer buffer_b;
+
+	as_msgpack_init(&ser);
+	as_buffer_init(&buffer_a);
+	as_buffer_init(&buffer_b);
+
+	bool equal = as_serializer_serialize(&ser, (as_val *) a, &buffer_a) == 0 &&
+		as_serializer_serialize(&ser, (as_val *) b, &buffer_b) == 0 &&
+		buffer_a.size == buffer_b.size &&
+		memcmp(buffer_a.data, buffer_b.data, buffer_a.size) == 0;
+
+	as_buffer_destroy(&buffer_a);
+	as_buffer_destroy(&buffer_b);
+	as_serializer_destroy(&ser);
+	return equal;
+}
+
+static bool update_retryable(as_status code)
+{
+	// The record changed, was created or was removed since it was read.
+	return code == AEROSPIKE_ERR_RECORD_GENERATION || code == AEROSPIKE_ERR_RECORD_EXISTS ||
+		code == AEROSPIKE_ERR_RECORD_NOT_FOUND;
+}
+
+/*
+ * Call fn with the bins of rec, NULL if the record does not exist, and write
+ * the bins which differ, checking that the record did not change meanwhile.
+ * On success py_result is the new bins. If fn raises, the Python error is
+ * left set.
+ */
+static as_status update_attempt(AerospikeClient * self, as_error * err, as_key * key, as_record * rec,
+		PyObject * py_fn, as_policy_write * policy, PyObject ** py_result)
+{
+	PyObject * py_bins = NULL;
+	PyObject * py_orig = NULL;
+	PyObject * py_ret = NULL;
+	PyObject * py_changed = NULL;
+	PyObject * py_new = NULL;
+	as_record changed;
+	as_record write_rec;
+
+	as_record_init(&changed, 0);
+	as_record_init(&write_rec, 0);
+
+	as_static_pool static_pool;
+	memset(&static_pool, 0, sizeof(static_pool));
+
+	if (rec) {
+		if (bins_to_pyobject(self, err, rec, &py_bins, false) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+	else {
+		py_bins = PyDict_New();
+	}
+
+	// fn may modify the bins, so keep the objects read to recognise the unchanged ones.
+	py_orig = py_bins ? PyDict_Copy(py_bins) : NULL;
+	if (!py_orig) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to copy the bins");
+		goto CLEANUP;
+	}
+
+	py_ret = PyObject_CallFunctionObjArgs(py_fn, py_bins, NULL);
+	if (!py_ret) {
+		goto CLEANUP;
+	}
+
+	if (py_ret == Py_None) {
+		py_new = py_bins;
+	}
+	else if (PyDict_Check(py_ret)) {
+		py_new = py_ret;
+	}
+	else {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "fn must return a dict of bins or None");
+		goto CLEANUP;
+	}
+
+	py_changed = PyDict_New();
+	if (!py_changed) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the changed bins");
+		goto CLEANUP;
+	}
+
+	PyObject * py_name = NULL;
+	PyObject * py_value = NULL;
+	Py_ssize_t pos = 0;
+
+	while (PyDict_Next(py_new, &pos, &py_name, &py_value)) {
+		PyObject * py_old = PyDict_GetItem(py_orig, py_name);
+		if (py_old == py_value && update_is_immutable(py_value)) {
+			continue;
+		}
+		if (PyDict_SetItem(py_changed, py_name, py_value) != 0) {
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to collect the changed bins");
+			goto CLEANUP;
+		}
+	}
+
+	// Converted as put() does, then compared with the record on the wire format.
+	self->is_client_put_serializer = false;
+	if (pyobject_to_record(self, err, py_changed, NULL, &changed, SERIALIZER_PYTHON, &static_pool) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	as_record_destroy(&write_rec);
+	as_record_init(&write_rec, changed.bins.size + (rec ? rec->bins.size : 0));
+
+	as_record_iterator it;
+	as_record_iterator_init(&it, &changed);
+
+	while (as_record_iterator_has_next(&it)) {
+		as_bin * bin = as_record_iterator_next(&it);
+		as_val * value = (as_val *) as_bin_get_value(bin);
+		as_val * old = rec ? (as_val *) as_record_get(rec, as_bin_get_name(bin)) : NULL;
+
+		if (old ? update_vals_equal(old, value) : as_val_type(value) == AS_NIL) {
+			continue;
+		}
+		as_val_reserve(value);
+		as_record_set(&write_rec, as_bin_get_name(bin), (as_bin_value *) value);
+	}
+	as_record_iterator_destroy(&it);
+
+	// The bins removed by fn are deleted.
+	if (rec) {
+		as_record_iterator_init(&it, rec);
+		while (as_record_iterator_has_next(&it)) {
+			as_bin * bin = as_record_iterator_next(&it);
+			if (!PyDict_GetItemString(py_new, as_bin_get_name(bin))) {
+				as_record_set_nil(&write_rec, as_bin_get_name(bin));
+			}
+		}
+		as_record_iterator_destroy(&it);
+	}
+
+	if (write_rec.bins.size) {
+		// Keep the expiration of an existing record.
+		write_rec.ttl = rec ? rec->ttl : 0;
+		write_rec.gen = rec ? rec->gen : 0;
+		policy->gen = rec ? AS_POLICY_GEN_EQ : AS_POLICY_GEN_IGNORE;
+		policy->exists = rec ? AS_POLICY_EXISTS_UPDATE : AS_POLICY_EXISTS_CREATE;
+
+		Py_BEGIN_ALLOW_THREADS
+		aerospike_key_put(self->as, err, policy, key, &write_rec);
+		Py_END_ALLOW_THREADS
+		as_near_cache_invalidate(self->near_cache, key);
+		if (err->code != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	Py_INCREF(py_new);
+	*py_result = py_new;
+
+CLEANUP:
+	as_record_destroy(&write_rec);
+	POOL_DESTROY(&static_pool);
+	as_record_destroy(&changed);
+
+	Py_XDECREF(py_bins);
+	Py_XDECREF(py_orig);
+	Py_XDECREF(py_ret);
+	Py_XDECREF(py_changed);
+
+	return err->code;
+}
+
+/**
+ *******************************************************************************************************
+ * Reads a record, passes its bins to fn and writes the bins fn changed,
+ * retrying from the read if the record changed meanwhile.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns the bins written.
+ * In case of error,appropriate exceptions will be raised.
+ *******************************************************************************************************
+ */
+PyObject * AerospikeClient_Update(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_key = NULL;
+	PyObject * py_fn = NULL;
+	PyObject * py_policy = NULL;
+	PyObject * py_result = NULL;
+	unsigned int max_retries = UPDATE_DEFAULT_MAX_RETRIES;
+	unsigned int backoff_ms = UPDATE_DEFAULT_BACKOFF_MS;
+
+	as_policy_write write_policy;
+	as_policy_write * write_policy_p = NULL;
+	as_policy_write update_policy;
+	as_predexp_list predexp_list;
+	as_key key;
+	bool key_initialised = false;
+
+	static char * kwlist[] = {"key", "fn", "max_retries", "policy", "backoff_ms", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|IOI:update", kwlist,
+			&py_key, &py_fn, &max_retries, &py_policy, &backoff_ms) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	if (!PyCallable_Check(py_fn)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "fn must be callable");
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_key(&err, py_key, &key) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	key_initialised = true;
+
+	if (pyobject_to_policy_write(&err, py_policy, &write_policy, &write_policy_p,
+			&self->as->config.policies.write, &predexp_list) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	// The generation and existence checks are set on a copy for each write.
+	if (write_policy_p) {
+		update_policy = *write_policy_p;
+	}
+	else {
+		as_policy_write_copy(&self->as->config.policies.write, &update_policy);
+	}
+
+	for (uint32_t attempt = 0; ; attempt++) {
+		as_record * rec = NULL;
+
+		as_error_reset(&err);
+		Py_BEGIN_ALLOW_THREADS
+		aerospike_key_get(self->as, &err, NULL, &key, &rec);
+		Py_END_ALLOW_THREADS
+
+		if (err.code == AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+			as_error_reset(&err);
+		}
+		if (err.code == AEROSPIKE_OK) {
+			update_attempt(self, &err, &key, rec, py_fn, &update_policy, &py_result);
+		}
+		if (rec) {
+			as_record_destroy(rec);
+		}
+
+		if (err.code == AEROSPIKE_OK || PyErr_Occurred()) {
+			break;
+		}
+		if (!update_retryable(err.code) || attempt >= max_retries) {
+			break;
+		}
+
+		uint32_t shift = attempt < 10 ? attempt : 10;
+		uint64_t sleep_ms = (uint64_t) backoff_ms << shift;
+		if (sleep_ms) {
+			Py_BEGIN_ALLOW_THREADS
+			usleep((useconds_t) (sleep_ms < UPDATE_MAX_BACKOFF_MS ? sleep_ms : UPDATE_MAX_BACKOFF_MS) * 1000);
+			Py_END_ALLOW_THREADS
+		}
+	}
+
+CLEANUP:
+	PREDEXP_LIST_DESTROY(write_policy_p, &predexp_list);
+
+	if (key_initialised) {
+		as_key_destroy(&key);
+	}
+
+	// An exception raised by fn is passed on as it is.
+	if (PyErr_Occurred()) {
+		Py_XDECREF(py_result);
+		return NULL;
+	}
+
+	if (err.code != AEROSPIKE_OK) {
+		Py_XDECREF(py_result);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		if (PyObject_HasAttrString(exception_type, "key")) {
+			PyObject_SetAttrString(exception_type, "key", py_key);
+		}
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return py_result;
+}
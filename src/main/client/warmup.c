@@ -0,0 +1,263 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/aerospike_stats.h>
+#include <aerospike/as_cluster.h>
+#include <aerospike/as_conn_pool.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_node.h>
+#include <aerospike/as_socket.h>
+#include <citrusleaf/cf_clock.h>
+
+#include "warmup.h"
+
+/*
+ * Everything in this file runs without the GIL.
+ */
+
+typedef struct {
+	pthread_t thread;
+	as_node * node;
+	uint32_t n_conns;
+	uint32_t timeout_ms;
+} warmup_node_task;
+
+static void warmer_deadline(struct timespec * ts, uint32_t ms)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	uint64_t ns = (uint64_t) now.tv_usec * 1000 + (uint64_t) ms * 1000000;
+	ts->tv_sec = now.tv_sec + (time_t) (ns / 1000000000);
+	ts->tv_nsec = (long) (ns % 1000000000);
+}
+
+/*
+ * Connections of the node open short of min_conns, pooled or in use.
+ */
+static uint32_t warmup_shortfall(as_node * node, uint32_t min_conns)
+{
+	as_node_stats stats;
+	aerospike_node_stats(node, &stats);
+	uint32_t open = stats.sync.in_pool + stats.sync.in_use;
+	aerospike_node_stats_destroy(&stats);
+
+	return open < min_conns ? min_conns - open : 0;
+}
+
+/*
+ * Open and authenticate n_conns new connections to the node, spread over its
+ * pools, and put each one in its pool at once. The pooled connections are
+ * left where they are, so commands keep finding them meanwhile, and the
+ * pool limits are taken like the commands do, so they are never exceeded.
+ */
+static void * warmup_node(void * udata)
+{
+	warmup_node_task * task = (warmup_node_task *) udata;
+	as_node * node = task->node;
+	uint32_t n_pools = node->cluster->conn_pools_per_node;
+	uint32_t full = 0;
+
+	for (uint32_t i = 0; i < task->n_conns && full < n_pools; i++) {
+		as_conn_pool * pool = &node->sync_conn_pools[i % n_pools];
+
+		if (!as_conn_pool_inc(pool)) {
+			full++;
+			continue;
+		}
+
+		as_error err;
+		as_error_init(&err);
+		as_socket sock;
+
+		// Gives the slot back on failure.
+		uint64_t deadline_ms = cf_getms() + task->timeout_ms;
+		if (as_node_create_connection(&err, node, task->timeout_ms, deadline_ms, pool, &sock) != AEROSPIKE_OK) {
+			// The node is unreachable, the next round tries again.
+			break;
+		}
+		as_node_put_connection(&sock);
+	}
+
+	return NULL;
+}
+
+void as_conn_warmup(aerospike * as, uint32_t min_conns)
+{
+	if (!as->cluster || !min_conns) {
+		return;
+	}
+
+	if (as->config.max_conns_per_node && min_conns > as->config.max_conns_per_node) {
+		min_conns = as->config.max_conns_per_node;
+	}
+
+	as_nodes * nodes = as_nodes_reserve(as->cluster);
+	warmup_node_task * tasks = calloc(nodes->size, sizeof(warmup_node_task));
+	bool * started = calloc(nodes->size, sizeof(bool));
+
+	for (uint32_t i = 0; tasks && started && i < nodes->size; i++) {
+		tasks[i].node = nodes->array[i];
+		tasks[i].n_conns = warmup_shortfall(nodes->array[i], min_conns);
+		tasks[i].timeout_ms = as->config.conn_timeout_ms;
+		if (!tasks[i].n_conns) {
+			continue;
+		}
+		started[i] = pthread_create(&tasks[i].thread, NULL, warmup_node, &tasks[i]) == 0;
+		if (!started[i]) {
+			warmup_node(&tasks[i]);
+		}
+	}
+
+	for (uint32_t i = 0; tasks && started && i < nodes->size; i++) {
+		if (started[i]) {
+			pthread_join(tasks[i].thread, NULL);
+		}
+	}
+
+	free(started);
+	free(tasks);
+	as_nodes_release(nodes);
+}
+
+void as_conn_trim(aerospike * as, uint32_t max_idle)
+{
+	if (!as->cluster || max_idle == AS_CONN_NO_TRIM) {
+		return;
+	}
+
+	as_nodes * nodes = as_nodes_reserve(as->cluster);
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		as_node_stats stats;
+		aerospike_node_stats(nodes->array[i], &stats);
+		uint32_t idle = stats.sync.in_pool;
+		aerospike_node_stats_destroy(&stats);
+
+		if (idle <= max_idle) {
+			continue;
+		}
+
+		// Only idle sockets are taken from the pools, round robin, so no
+		// connection is ever opened here. Stop when the pools are empty.
+		as_node * node = nodes->array[i];
+		uint32_t n_pools = node->cluster->conn_pools_per_node;
+		uint32_t empty = 0;
+
+		for (uint32_t n = (idle - max_idle + 1) / 2, p = 0; n > 0 && empty < n_pools; p++) {
+			as_socket sock;
+
+			if (!as_conn_pool_get(&node->sync_conn_pools[p % n_pools], &sock)) {
+				empty++;
+				continue;
+			}
+			empty = 0;
+			as_node_close_connection(&sock);
+			n--;
+		}
+	}
+
+	as_nodes_release(nodes);
+}
+
+static void * warmer_run(void * udata)
+{
+	as_conn_warmer * warmer = (as_conn_warmer *) udata;
+
+	pthread_mutex_lock(&warmer->lock);
+
+	while (!warmer->stopping) {
+		struct timespec deadline;
+		warmer_deadline(&deadline, warmer->as->config.tender_interval);
+
+		while (!warmer->stopping) {
+			if (pthread_cond_timedwait(&warmer->cond, &warmer->lock, &deadline) != 0) {
+				break;
+			}
+		}
+
+		if (warmer->stopping) {
+			break;
+		}
+
+		pthread_mutex_unlock(&warmer->lock);
+		as_conn_warmup(warmer->as, warmer->min_conns);
+		as_conn_trim(warmer->as, warmer->max_idle);
+		pthread_mutex_lock(&warmer->lock);
+	}
+
+	pthread_mutex_unlock(&warmer->lock);
+	return NULL;
+}
+
+void as_conn_warmer_init(as_conn_warmer * warmer)
+{
+	pthread_mutex_init(&warmer->lock, NULL);
+	pthread_cond_init(&warmer->cond, NULL);
+	warmer->started = false;
+	warmer->stopping = false;
+	warmer->as = NULL;
+	warmer->min_conns = 0;
+	warmer->max_idle = AS_CONN_NO_TRIM;
+}
+
+void as_conn_warmer_destroy(as_conn_warmer * warmer)
+{
+	pthread_cond_destroy(&warmer->cond);
+	pthread_mutex_destroy(&warmer->lock);
+}
+
+bool as_conn_warmer_start(as_conn_warmer * warmer, aerospike * as, uint32_t min_conns, uint32_t max_idle)
+{
+	if ((!min_conns && max_idle == AS_CONN_NO_TRIM) || warmer->started) {
+		return true;
+	}
+
+	warmer->as = as;
+	warmer->min_conns = min_conns;
+	// Connections kept open by the warmup are not trimmed.
+	warmer->max_idle = max_idle < min_conns ? min_conns : max_idle;
+	warmer->stopping = false;
+	warmer->started = pthread_create(&warmer->thread, NULL, warmer_run, warmer) == 0;
+	return warmer->started;
+}
+
+void as_conn_warmer_stop(as_conn_warmer * warmer)
+{
+	if (!warmer->started) {
+		return;
+	}
+
+	pthread_mutex_lock(&warmer->lock);
+	warmer->stopping = true;
+	pthread_cond_signal(&warmer->cond);
+	pthread_mutex_unlock(&warmer->lock);
+
+	pthread_join(warmer->thread, NULL);
+	warmer->started = false;
+}
+
+void as_conn_warmer_after_fork(as_conn_warmer * warmer)
+{
+	// The lock may have been held by the thread when the parent forked.
+	as_conn_warmer_init(warmer);
+}
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "write_queue.h"
+
+#define WRITE_QUEUE_DEFAULT_MAX_INFLIGHT 16
+#define WRITE_QUEUE_DEFAULT_MAX_QUEUED 10000
+
+// Each write in flight has its own sender thread.
+#define WRITE_QUEUE_MAX_INFLIGHT 1024
+
+/**
+ *******************************************************************************************************
+ * Creates a queue of puts and operates, sent in the background without
+ * waiting for their results.
+ *
+ * @param self                  AerospikeClient object
+ * @param args                  The args is a tuple object containing an argument
+ *                              list passed from Python to a C function
+ * @param kwds                  Dictionary of keywords
+ *
+ * Returns an aerospike.WriteQueue.
+ * In case of error,appropriate exceptions will be raised.
+ *******************************************************************************************************
+ */
+PyObject * AerospikeClient_Write_Queue(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	unsigned int max_inflight = WRITE_QUEUE_DEFAULT_MAX_INFLIGHT;
+	unsigned int max_queued = WRITE_QUEUE_DEFAULT_MAX_QUEUED;
+	PyObject * py_on_error = NULL;
+	AerospikeWriteQueue * py_queue = NULL;
+
+	static char * kwlist[] = {"max_inflight", "max_queued", "on_error", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|IIO:write_queue", kwlist,
+			&max_inflight, &max_queued, &py_on_error) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (!self || !self->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	if (max_inflight == 0 || max_inflight > WRITE_QUEUE_MAX_INFLIGHT) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "max_inflight must be between 1 and %d",
+				WRITE_QUEUE_MAX_INFLIGHT);
+		goto CLEANUP;
+	}
+
+	if (py_on_error && py_on_error != Py_None && !PyCallable_Check(py_on_error)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "on_error must be callable");
+		goto CLEANUP;
+	}
+
+	py_queue = AerospikeWriteQueue_New(self, &err, max_inflight, max_queued,
+			py_on_error ? py_on_error : Py_None);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return (PyObject *) py_queue;
+}
@@ -0,0 +1,433 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_geojson.h>
+#include <aerospike/as_list.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_record_iterator.h>
+
+#include "columnar.h"
+
+// Smallest allocation for a column buffer, keeps data buffers 8 byte aligned.
+#define COLUMN_BUFFER_MIN_CAPACITY 64
+
+#define LIST_ITEM_NAME "item"
+
+/*
+ * Everything in this file runs without the GIL, on the C client's threads
+ * for scans and queries, so it must not touch Python objects.
+ */
+
+static bool buffer_reserve(as_column_buffer * buf, size_t extra)
+{
+	if (buf->size + extra <= buf->capacity) {
+		return true;
+	}
+
+	size_t capacity = buf->capacity ? buf->capacity : COLUMN_BUFFER_MIN_CAPACITY;
+	while (capacity < buf->size + extra) {
+		capacity *= 2;
+	}
+
+	uint8_t * data = realloc(buf->data, capacity);
+	if (!data) {
+		return false;
+	}
+	buf->data = data;
+	buf->capacity = capacity;
+	return true;
+}
+
+static bool buffer_append(as_column_buffer * buf, const void * data, size_t size)
+{
+	if (!buffer_reserve(buf, size)) {
+		return false;
+	}
+	if (size) {
+		memcpy(buf->data + buf->size, data, size);
+		buf->size += size;
+	}
+	return true;
+}
+
+static bool buffer_append_zeros(as_column_buffer * buf, size_t size)
+{
+	if (!buffer_reserve(buf, size)) {
+		return false;
+	}
+	memset(buf->data + buf->size, 0, size);
+	buf->size += size;
+	return true;
+}
+
+static bool buffer_append_offset(as_column_buffer * buf, int32_t offset)
+{
+	return buffer_append(buf, &offset, sizeof(int32_t));
+}
+
+static int32_t buffer_last_offset(as_column_buffer * buf)
+{
+	int32_t offset = 0;
+	memcpy(&offset, buf->data + buf->size - sizeof(int32_t), sizeof(int32_t));
+	return offset;
+}
+
+static as_column * column_new(const char * name)
+{
+	as_column * col = calloc(1, sizeof(as_column));
+	if (col) {
+		strncpy(col->name, name, AS_BIN_NAME_MAX_LEN);
+		col->name[AS_BIN_NAME_MAX_LEN] = '\0';
+		col->type = COLUMN_NULL;
+	}
+	return col;
+}
+
+static void column_destroy(as_column * col)
+{
+	if (!col) {
+		return;
+	}
+	free(col->validity.data);
+	free(col->offsets.data);
+	free(col->values.data);
+	column_destroy(col->child);
+	free(col);
+}
+
+/*
+ * Make room for the validity bit of the next value.
+ * New bytes are zeroed, so the bit reads as null until it is set.
+ */
+static bool column_reserve_validity(as_column * col)
+{
+	size_t needed = (size_t) (col->length / 8) + 1;
+	if (col->validity.size < needed) {
+		return buffer_append_zeros(&col->validity, needed - col->validity.size);
+	}
+	return true;
+}
+
+static bool column_append_null(as_column * col)
+{
+	if (!column_reserve_validity(col)) {
+		return false;
+	}
+
+	switch (col->type) {
+		case COLUMN_INT64:
+		case COLUMN_DOUBLE:
+			if (!buffer_append_zeros(&col->values, sizeof(int64_t))) {
+				return false;
+			}
+			break;
+		case COLUMN_UTF8:
+		case COLUMN_BINARY:
+		case COLUMN_LIST:
+			if (!buffer_append_offset(&col->offsets, buffer_last_offset(&col->offsets))) {
+				return false;
+			}
+			break;
+		default:
+			break;
+	}
+
+	col->length++;
+	col->null_count++;
+	return true;
+}
+
+static void column_set_valid(as_column * col)
+{
+	col->validity.data[col->length / 8] |= (uint8_t) (1 << (col->length % 8));
+	col->length++;
+}
+
+/*
+ * Fix the type of a column that has only seen nulls so far,
+ * filling the value buffers for the existing null slots.
+ */
+static bool column_set_type(as_column * col, as_column_type type)
+{
+	col->type = type;
+
+	switch (type) {
+		case COLUMN_INT64:
+		case COLUMN_DOUBLE:
+			return buffer_append_zeros(&col->values, (size_t) col->length * sizeof(int64_t));
+		case COLUMN_UTF8:
+		case COLUMN_BINARY:
+			return buffer_append_zeros(&col->offsets, (size_t) (col->length + 1) * sizeof(int32_t)) &&
+				buffer_reserve(&col->values, 1);
+		case COLUMN_LIST:
+			col->child = column_new(LIST_ITEM_NAME);
+			return col->child &&
+				buffer_append_zeros(&col->offsets, (size_t) (col->length + 1) * sizeof(int32_t));
+		default:
+			return true;
+	}
+}
+
+static as_status column_append_val(as_column * col, as_error * err, const as_val * val);
+
+typedef struct {
+	as_column * col;
+	as_error * err;
+} list_append_data;
+
+static bool list_item_append(as_val * val, void * udata)
+{
+	list_append_data * data = (list_append_data *) udata;
+	return column_append_val(data->col, data->err, val) == AEROSPIKE_OK;
+}
+
+static as_status column_append_val(as_column * col, as_error * err, const as_val * val)
+{
+	as_column_type type = COLUMN_NULL;
+
+	if (!val || as_val_type(val) == AS_NIL) {
+		if (!column_append_null(col)) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for column %s", col->name);
+		}
+		return AEROSPIKE_OK;
+	}
+
+	switch (as_val_type(val)) {
+		case AS_INTEGER:
+			type = COLUMN_INT64;
+			break;
+		case AS_DOUBLE:
+			type = COLUMN_DOUBLE;
+			break;
+		case AS_STRING:
+		case AS_GEOJSON:
+			type = COLUMN_UTF8;
+			break;
+		case AS_BYTES:
+			type = COLUMN_BINARY;
+			break;
+		case AS_LIST:
+			type = COLUMN_LIST;
+			break;
+		default:
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT,
+					"Column %s has a value type that can not be stored in a column", col->name);
+	}
+
+	if (col->type == COLUMN_NULL) {
+		if (!column_set_type(col, type)) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for column %s", col->name);
+		}
+	}
+	else if (col->type != type) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Column %s has values of different types", col->name);
+	}
+
+	if (!column_reserve_validity(col)) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for column %s", col->name);
+	}
+
+	bool ok = true;
+	switch (type) {
+		case COLUMN_INT64: {
+			int64_t i = as_integer_get(as_integer_fromval(val));
+			ok = buffer_append(&col->values, &i, sizeof(int64_t));
+			break;
+		}
+		case COLUMN_DOUBLE: {
+			double d = as_double_get(as_double_fromval(val));
+			ok = buffer_append(&col->values, &d, sizeof(double));
+			break;
+		}
+		case COLUMN_UTF8:
+		case COLUMN_BINARY: {
+			const uint8_t * data = NULL;
+			size_t size = 0;
+			if (as_val_type(val) == AS_STRING) {
+				as_string * str = as_string_fromval(val);
+				data = (const uint8_t *) as_string_get(str);
+				size = as_string_len(str);
+			}
+			else if (as_val_type(val) == AS_GEOJSON) {
+				const char * geo = as_geojson_get(as_geojson_fromval(val));
+				data = (const uint8_t *) geo;
+				size = geo ? strlen(geo) : 0;
+			}
+			else {
+				as_bytes * bytes = as_bytes_fromval(val);
+				data = as_bytes_get(bytes);
+				size = as_bytes_size(bytes);
+			}
+			if (col->values.size + size > INT32_MAX) {
+				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Column %s is larger than 2GB", col->name);
+			}
+			ok = buffer_append(&col->values, data, size) &&
+				buffer_append_offset(&col->offsets, (int32_t) col->values.size);
+			break;
+		}
+		case COLUMN_LIST: {
+			list_append_data data = {col->child, err};
+			as_list_foreach(as_list_fromval((as_val *) val), list_item_append, &data);
+			if (err->code != AEROSPIKE_OK) {
+				return err->code;
+			}
+			if (col->child->length > INT32_MAX) {
+				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Column %s has too many list elements", col->name);
+			}
+			ok = buffer_append_offset(&col->offsets, (int32_t) col->child->length);
+			break;
+		}
+		default:
+			break;
+	}
+
+	if (!ok) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for column %s", col->name);
+	}
+
+	column_set_valid(col);
+	return AEROSPIKE_OK;
+}
+
+static as_column * columns_get(as_columns * columns, const char * name, uint32_t hint)
+{
+	// Records usually carry their bins in the same order, try that position first.
+	if (hint < columns->n_columns && strcmp(columns->columns[hint]->name, name) == 0) {
+		return columns->columns[hint];
+	}
+
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		if (strcmp(columns->columns[i]->name, name) == 0) {
+			return columns->columns[i];
+		}
+	}
+
+	if (columns->n_columns == columns->capacity) {
+		uint32_t capacity = columns->capacity ? columns->capacity * 2 : 8;
+		as_column ** list = realloc(columns->columns, capacity * sizeof(as_column *));
+		if (!list) {
+			return NULL;
+		}
+		columns->columns = list;
+		columns->capacity = capacity;
+	}
+
+	as_column * col = column_new(name);
+	if (!col) {
+		return NULL;
+	}
+
+	// A new bin, the rows before this one are null.
+	for (int64_t i = 0; i < columns->n_rows; i++) {
+		if (!column_append_null(col)) {
+			column_destroy(col);
+			return NULL;
+		}
+	}
+
+	columns->columns[columns->n_columns++] = col;
+	return col;
+}
+
+void as_columns_init(as_columns * columns)
+{
+	pthread_mutex_init(&columns->lock, NULL);
+	columns->columns = NULL;
+	columns->n_columns = 0;
+	columns->capacity = 0;
+	columns->n_rows = 0;
+}
+
+void as_columns_destroy(as_columns * columns)
+{
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		column_destroy(columns->columns[i]);
+	}
+	free(columns->columns);
+	columns->columns = NULL;
+	columns->n_columns = 0;
+	columns->capacity = 0;
+	columns->n_rows = 0;
+	pthread_mutex_destroy(&columns->lock);
+}
+
+static void column_reset(as_column * col)
+{
+	col->length = 0;
+	col->null_count = 0;
+	col->validity.size = 0;
+	col->values.size = 0;
+	// Offsets start with the offset of the first value.
+	col->offsets.size = col->offsets.size ? sizeof(int32_t) : 0;
+	if (col->child) {
+		column_reset(col->child);
+	}
+}
+
+void as_columns_reset(as_columns * columns)
+{
+	pthread_mutex_lock(&columns->lock);
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		column_reset(columns->columns[i]);
+	}
+	columns->n_rows = 0;
+	pthread_mutex_unlock(&columns->lock);
+}
+
+as_status as_columns_append_record(as_columns * columns, as_error * err, const as_record * rec)
+{
+	pthread_mutex_lock(&columns->lock);
+
+	if (rec) {
+		as_record_iterator it;
+		as_record_iterator_init(&it, rec);
+		uint32_t position = 0;
+		while (as_record_iterator_has_next(&it)) {
+			as_bin * bin = as_record_iterator_next(&it);
+			as_column * col = columns_get(columns, as_bin_get_name(bin), position++);
+			if (!col) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for column %s",
+						as_bin_get_name(bin));
+				break;
+			}
+			if (column_append_val(col, err, (as_val *) as_bin_get_value(bin)) != AEROSPIKE_OK) {
+				break;
+			}
+		}
+		as_record_iterator_destroy(&it);
+	}
+
+	if (err->code == AEROSPIKE_OK) {
+		// Bins missing from this record are null.
+		for (uint32_t i = 0; i < columns->n_columns; i++) {
+			as_column * col = columns->columns[i];
+			if (col->length == columns->n_rows && !column_append_null(col)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for column %s", col->name);
+				break;
+			}
+		}
+		columns->n_rows++;
+	}
+
+	pthread_mutex_unlock(&columns->lock);
+	return err->code;
+}
@@ -0,0 +1,562 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+
+#include "columnar.h"
+
+/*
+ * Arrow IPC stream writer. Each message is a 0xFFFFFFFF continuation marker,
+ * the size of its flatbuffer metadata, the metadata and the body holding the buffers.
+ * The flatbuffers are encoded here, front to back: a table is written before
+ * the objects it refers to and its offsets are patched once they are written.
+ * Everything in this file runs without the GIL.
+ */
+
+#define IPC_ALIGNMENT 8
+
+// Enum and union values of Schema.fbs and Message.fbs
+#define IPC_METADATA_V5 4
+#define IPC_ENDIANNESS_LITTLE 0
+#define IPC_ENDIANNESS_BIG 1
+#define IPC_HEADER_SCHEMA 1
+#define IPC_HEADER_RECORD_BATCH 3
+#define IPC_TYPE_NULL 1
+#define IPC_TYPE_INT 2
+#define IPC_TYPE_FLOATING_POINT 3
+#define IPC_TYPE_BINARY 4
+#define IPC_TYPE_UTF8 5
+#define IPC_TYPE_LIST 12
+#define IPC_PRECISION_DOUBLE 2
+
+#define FB_MAX_FIELDS 8
+
+// Size of FieldNode and Buffer structs in a RecordBatch
+#define FB_STRUCT_SIZE 16
+
+#define ALIGN(size, align) (((size) + (align) - 1) / (align) * (align))
+
+typedef struct {
+	as_column_buffer * buf;
+	bool failed;
+} fb_builder;
+
+/*
+ * A table field. Fields are indexed by their slot in the schema,
+ * fields of size 0 are left out. An offset field is patched
+ * with fb_patch() at pos once its target is written.
+ */
+typedef struct {
+	uint8_t size;
+	bool offset;
+	uint64_t value;
+	size_t pos;
+} fb_field;
+
+typedef struct {
+	int64_t length;
+	int64_t null_count;
+} ipc_node;
+
+typedef struct {
+	const uint8_t * data;
+	int64_t size;
+} ipc_body;
+
+static bool fb_reserve(fb_builder * fb, size_t extra)
+{
+	as_column_buffer * buf = fb->buf;
+
+	if (fb->failed) {
+		return false;
+	}
+	if (buf->size + extra <= buf->capacity) {
+		return true;
+	}
+
+	size_t capacity = buf->capacity ? buf->capacity : 256;
+	while (capacity < buf->size + extra) {
+		capacity *= 2;
+	}
+
+	uint8_t * data = realloc(buf->data, capacity);
+	if (!data) {
+		fb->failed = true;
+		return false;
+	}
+	buf->data = data;
+	buf->capacity = capacity;
+	return true;
+}
+
+static size_t fb_zeros(fb_builder * fb, size_t size)
+{
+	size_t pos = fb->buf->size;
+	if (fb_reserve(fb, size)) {
+		memset(fb->buf->data + pos, 0, size);
+		fb->buf->size += size;
+	}
+	return pos;
+}
+
+static void fb_pad(fb_builder * fb, size_t align)
+{
+	fb_zeros(fb, ALIGN(fb->buf->size, align) - fb->buf->size);
+}
+
+// Flatbuffer scalars are little endian whatever the host.
+static void fb_set(fb_builder * fb, size_t pos, uint64_t value, uint8_t size)
+{
+	if (fb->failed) {
+		return;
+	}
+	for (uint8_t i = 0; i < size; i++) {
+		fb->buf->data[pos + i] = (uint8_t) (value >> (8 * i));
+	}
+}
+
+static void fb_patch(fb_builder * fb, size_t pos, size_t target)
+{
+	fb_set(fb, pos, (uint64_t) (target - pos), sizeof(uint32_t));
+}
+
+static size_t fb_table(fb_builder * fb, fb_field * fields, uint16_t n_fields)
+{
+	uint16_t vtable[2 + FB_MAX_FIELDS] = {0};
+	bool wide = false;
+
+	for (uint16_t i = 0; i < n_fields; i++) {
+		if (fields[i].offset) {
+			fields[i].size = sizeof(uint32_t);
+		}
+		wide = wide || fields[i].size == 8;
+	}
+
+	fb_pad(fb, sizeof(uint16_t));
+	size_t vt = fb->buf->size;
+	size_t vt_size = (2 + n_fields) * sizeof(uint16_t);
+	size_t table = ALIGN(vt + vt_size, IPC_ALIGNMENT);
+
+	// Wider fields first, keeping each one aligned to its size.
+	size_t pos = table + (wide ? 8 : 4);
+	for (uint8_t size = 8; size > 0; size /= 2) {
+		for (uint16_t i = 0; i < n_fields; i++) {
+			if (fields[i].size == size) {
+				fields[i].pos = pos;
+				vtable[2 + i] = (uint16_t) (pos - table);
+				pos += size;
+			}
+		}
+	}
+	vtable[0] = (uint16_t) vt_size;
+	vtable[1] = (uint16_t) (pos - table);
+
+	fb_zeros(fb, pos - vt);
+	for (uint16_t i = 0; i < 2 + n_fields; i++) {
+		fb_set(fb, vt + i * sizeof(uint16_t), vtable[i], sizeof(uint16_t));
+	}
+	fb_set(fb, table, (uint64_t) (table - vt), sizeof(int32_t));
+	for (uint16_t i = 0; i < n_fields; i++) {
+		if (fields[i].size && !fields[i].offset) {
+			fb_set(fb, fields[i].pos, fields[i].value, fields[i].size);
+		}
+	}
+	return table;
+}
+
+static size_t fb_string(fb_builder * fb, const char * str)
+{
+	size_t len = strlen(str);
+
+	fb_pad(fb, sizeof(uint32_t));
+	size_t pos = fb_zeros(fb, sizeof(uint32_t) + len + 1);
+	fb_set(fb, pos, len, sizeof(uint32_t));
+	if (!fb->failed) {
+		memcpy(fb->buf->data + pos + sizeof(uint32_t), str, len);
+	}
+	return pos;
+}
+
+/*
+ * Write the length of a vector and room for its elements,
+ * the first element is at the returned position + 4.
+ */
+static size_t fb_vector(fb_builder * fb, uint32_t length, size_t elem_size, size_t align)
+{
+	while ((fb->buf->size + sizeof(uint32_t)) % align) {
+		fb_zeros(fb, 1);
+	}
+	size_t pos = fb_zeros(fb, sizeof(uint32_t) + length * elem_size);
+	fb_set(fb, pos, length, sizeof(uint32_t));
+	return pos;
+}
+
+/*
+ * Start a message, returns the position of its header offset.
+ */
+static size_t fb_message(fb_builder * fb, uint8_t header_type, int64_t body_length)
+{
+	fb_field fields[4] = {
+		{2, false, IPC_METADATA_V5, 0},
+		{1, false, header_type, 0},
+		{0, true, 0, 0},
+		{8, false, (uint64_t) body_length, 0}
+	};
+
+	fb->buf->size = 0;
+	size_t root = fb_zeros(fb, sizeof(uint32_t));
+	fb_patch(fb, root, fb_table(fb, fields, 4));
+	return fields[2].pos;
+}
+
+static void fb_field_schema(fb_builder * fb, const as_column * col, size_t ref)
+{
+	uint8_t type_type = IPC_TYPE_NULL;
+	switch (col->type) {
+		case COLUMN_INT64:
+			type_type = IPC_TYPE_INT;
+			break;
+		case COLUMN_DOUBLE:
+			type_type = IPC_TYPE_FLOATING_POINT;
+			break;
+		case COLUMN_UTF8:
+			type_type = IPC_TYPE_UTF8;
+			break;
+		case COLUMN_BINARY:
+			type_type = IPC_TYPE_BINARY;
+			break;
+		case COLUMN_LIST:
+			type_type = IPC_TYPE_LIST;
+			break;
+		default:
+			break;
+	}
+
+	// name, nullable, type_type, type, dictionary, children
+	fb_field fields[6] = {
+		{0, true, 0, 0},
+		{1, false, 1, 0},
+		{1, false, type_type, 0},
+		{0, true, 0, 0},
+		{0, false, 0, 0},
+		{0, true, 0, 0}
+	};
+	fb_patch(fb, ref, fb_table(fb, fields, 6));
+	fb_patch(fb, fields[0].pos, fb_string(fb, col->name));
+
+	fb_field type_fields[2] = {{0, false, 0, 0}, {0, false, 0, 0}};
+	uint16_t n_type_fields = 0;
+	if (col->type == COLUMN_INT64) {
+		// bitWidth, is_signed
+		type_fields[0] = (fb_field) {4, false, 64, 0};
+		type_fields[1] = (fb_field) {1, false, 1, 0};
+		n_type_fields = 2;
+	}
+	else if (col->type == COLUMN_DOUBLE) {
+		// precision
+		type_fields[0] = (fb_field) {2, false, IPC_PRECISION_DOUBLE, 0};
+		n_type_fields = 1;
+	}
+	fb_patch(fb, fields[3].pos, fb_table(fb, type_fields, n_type_fields));
+
+	// Readers expect the children vector, even when it is empty.
+	size_t children = fb_vector(fb, col->child ? 1 : 0, sizeof(uint32_t), sizeof(uint32_t));
+	fb_patch(fb, fields[5].pos, children);
+	if (col->child) {
+		fb_field_schema(fb, col->child, children + sizeof(uint32_t));
+	}
+}
+
+static void fb_schema(fb_builder * fb, const as_columns * columns)
+{
+	size_t header = fb_message(fb, IPC_HEADER_SCHEMA, 0);
+
+	uint16_t one = 1;
+	uint8_t endianness = *(uint8_t *) &one ? IPC_ENDIANNESS_LITTLE : IPC_ENDIANNESS_BIG;
+
+	// endianness, fields
+	fb_field fields[2] = {
+		{2, false, endianness, 0},
+		{0, true, 0, 0}
+	};
+	fb_patch(fb, header, fb_table(fb, fields, 2));
+
+	size_t vector = fb_vector(fb, columns->n_columns, sizeof(uint32_t), sizeof(uint32_t));
+	fb_patch(fb, fields[1].pos, vector);
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		fb_field_schema(fb, columns->columns[i], vector + sizeof(uint32_t) * (i + 1));
+	}
+}
+
+static void fb_record_batch(fb_builder * fb, int64_t length, const ipc_node * nodes, uint32_t n_nodes,
+		const ipc_body * bodies, uint32_t n_bodies, int64_t body_length)
+{
+	size_t header = fb_message(fb, IPC_HEADER_RECORD_BATCH, body_length);
+
+	// length, nodes, buffers
+	fb_field fields[3] = {
+		{8, false, (uint64_t) length, 0},
+		{0, true, 0, 0},
+		{0, true, 0, 0}
+	};
+	fb_patch(fb, header, fb_table(fb, fields, 3));
+
+	size_t vector = fb_vector(fb, n_nodes, FB_STRUCT_SIZE, IPC_ALIGNMENT);
+	fb_patch(fb, fields[1].pos, vector);
+	for (uint32_t i = 0; i < n_nodes; i++) {
+		size_t pos = vector + sizeof(uint32_t) + i * FB_STRUCT_SIZE;
+		fb_set(fb, pos, (uint64_t) nodes[i].length, 8);
+		fb_set(fb, pos + 8, (uint64_t) nodes[i].null_count, 8);
+	}
+
+	vector = fb_vector(fb, n_bodies, FB_STRUCT_SIZE, IPC_ALIGNMENT);
+	fb_patch(fb, fields[2].pos, vector);
+	int64_t offset = 0;
+	for (uint32_t i = 0; i < n_bodies; i++) {
+		size_t pos = vector + sizeof(uint32_t) + i * FB_STRUCT_SIZE;
+		fb_set(fb, pos, (uint64_t) offset, 8);
+		fb_set(fb, pos + 8, (uint64_t) bodies[i].size, 8);
+		offset += ALIGN(bodies[i].size, IPC_ALIGNMENT);
+	}
+}
+
+static uint32_t column_count_types(const as_column * col)
+{
+	return 1 + (col->child ? column_count_types(col->child) : 0);
+}
+
+static as_column_type * column_store_types(const as_column * col, as_column_type * types)
+{
+	*types++ = col->type;
+	return col->child ? column_store_types(col->child, types) : types;
+}
+
+static bool column_has_types(const as_column * col, const as_column_type ** types)
+{
+	if (col->type != *(*types)++) {
+		return false;
+	}
+	return !col->child || column_has_types(col->child, types);
+}
+
+/*
+ * Nodes and body buffers of a column and its children, depth first.
+ */
+static void column_collect(const as_column * col, ipc_node * nodes, uint32_t * n_nodes,
+		ipc_body * bodies, uint32_t * n_bodies)
+{
+	nodes[(*n_nodes)++] = (ipc_node) {col->length, col->null_count};
+
+	if (col->type == COLUMN_NULL) {
+		return;
+	}
+
+	bodies[(*n_bodies)++] = (ipc_body) {col->validity.data, (col->length + 7) / 8};
+	switch (col->type) {
+		case COLUMN_INT64:
+		case COLUMN_DOUBLE:
+			bodies[(*n_bodies)++] = (ipc_body) {col->values.data, (int64_t) col->values.size};
+			break;
+		case COLUMN_UTF8:
+		case COLUMN_BINARY:
+			bodies[(*n_bodies)++] = (ipc_body) {col->offsets.data, (int64_t) col->offsets.size};
+			bodies[(*n_bodies)++] = (ipc_body) {col->values.data, (int64_t) col->values.size};
+			break;
+		case COLUMN_LIST:
+			bodies[(*n_bodies)++] = (ipc_body) {col->offsets.data, (int64_t) col->offsets.size};
+			column_collect(col->child, nodes, n_nodes, bodies, n_bodies);
+			break;
+		default:
+			break;
+	}
+}
+
+static bool write_padded(FILE * file, const void * data, size_t size)
+{
+	static const uint8_t zeros[IPC_ALIGNMENT] = {0};
+	size_t padding = ALIGN(size, IPC_ALIGNMENT) - size;
+
+	return (size == 0 || fwrite(data, 1, size, file) == size) &&
+		(padding == 0 || fwrite(zeros, 1, padding, file) == padding);
+}
+
+static void ipc_prefix(uint8_t * prefix, uint32_t size)
+{
+	for (int i = 0; i < 4; i++) {
+		prefix[i] = 0xFF;
+		prefix[4 + i] = (uint8_t) (size >> (8 * i));
+	}
+}
+
+static as_status write_message(as_ipc_writer * writer, as_error * err, fb_builder * fb,
+		const ipc_body * bodies, uint32_t n_bodies)
+{
+	fb_pad(fb, IPC_ALIGNMENT);
+	if (fb->failed) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for export batch");
+	}
+
+	uint8_t prefix[8];
+	ipc_prefix(prefix, (uint32_t) fb->buf->size);
+	bool ok = write_padded(writer->file, prefix, sizeof(prefix)) &&
+		write_padded(writer->file, fb->buf->data, fb->buf->size);
+
+	for (uint32_t i = 0; ok && i < n_bodies; i++) {
+		ok = write_padded(writer->file, bodies[i].data, (size_t) bodies[i].size);
+	}
+
+	if (!ok) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to write to export file");
+	}
+	return AEROSPIKE_OK;
+}
+
+static as_status write_schema(as_ipc_writer * writer, as_error * err, as_columns * columns)
+{
+	uint32_t n_types = 0;
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		n_types += column_count_types(columns->columns[i]);
+	}
+
+	writer->types = malloc((n_types ? n_types : 1) * sizeof(as_column_type));
+	if (!writer->types) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for export batch");
+	}
+
+	as_column_type * types = writer->types;
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		types = column_store_types(columns->columns[i], types);
+	}
+	writer->n_types = n_types;
+	writer->n_fields = columns->n_columns;
+	writer->schema_written = true;
+
+	fb_builder fb = {&writer->metadata, false};
+	fb_schema(&fb, columns);
+	return write_message(writer, err, &fb, NULL, 0);
+}
+
+/*
+ * The schema can not change after the first batch, bins that show up later
+ * or that only had nulls in the first batch fail the export.
+ */
+static as_status check_schema(as_ipc_writer * writer, as_error * err, as_columns * columns)
+{
+	if (columns->n_columns > writer->n_fields) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT,
+				"Bin %s is not in the first batch of the export", columns->columns[writer->n_fields]->name);
+	}
+
+	const as_column_type * types = writer->types;
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		if (!column_has_types(columns->columns[i], &types)) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT,
+					"Bin %s has a different type than in the first batch of the export", columns->columns[i]->name);
+		}
+	}
+	return AEROSPIKE_OK;
+}
+
+void as_ipc_writer_init(as_ipc_writer * writer, FILE * file)
+{
+	writer->file = file;
+	writer->types = NULL;
+	writer->n_types = 0;
+	writer->n_fields = 0;
+	writer->schema_written = false;
+	writer->metadata.data = NULL;
+	writer->metadata.size = 0;
+	writer->metadata.capacity = 0;
+}
+
+void as_ipc_writer_destroy(as_ipc_writer * writer)
+{
+	free(writer->types);
+	free(writer->metadata.data);
+	writer->types = NULL;
+	writer->metadata.data = NULL;
+}
+
+as_status as_ipc_write_batch(as_ipc_writer * writer, as_error * err, as_columns * columns)
+{
+	if (!writer->schema_written) {
+		if (write_schema(writer, err, columns) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	}
+	else if (check_schema(writer, err, columns) != AEROSPIKE_OK) {
+		return err->code;
+	}
+
+	// Every type has a node and at most three buffers.
+	ipc_node * nodes = malloc((writer->n_types ? writer->n_types : 1) * sizeof(ipc_node));
+	ipc_body * bodies = malloc((writer->n_types ? writer->n_types : 1) * 3 * sizeof(ipc_body));
+	if (!nodes || !bodies) {
+		free(nodes);
+		free(bodies);
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for export batch");
+	}
+
+	uint32_t n_nodes = 0;
+	uint32_t n_bodies = 0;
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		column_collect(columns->columns[i], nodes, &n_nodes, bodies, &n_bodies);
+	}
+
+	int64_t body_length = 0;
+	for (uint32_t i = 0; i < n_bodies; i++) {
+		body_length += ALIGN(bodies[i].size, IPC_ALIGNMENT);
+	}
+
+	fb_builder fb = {&writer->metadata, false};
+	fb_record_batch(&fb, columns->n_rows, nodes, n_nodes, bodies, n_bodies, body_length);
+	write_message(writer, err, &fb, bodies, n_bodies);
+
+	free(nodes);
+	free(bodies);
+
+	if (err->code == AEROSPIKE_OK) {
+		as_columns_reset(columns);
+	}
+	return err->code;
+}
+
+as_status as_ipc_write_end(as_ipc_writer * writer, as_error * err, as_columns * columns)
+{
+	if (columns->n_rows > 0) {
+		if (as_ipc_write_batch(writer, err, columns) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	}
+	else if (!writer->schema_written) {
+		if (write_schema(writer, err, columns) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	}
+
+	uint8_t end[8];
+	ipc_prefix(end, 0);
+	if (fwrite(end, 1, sizeof(end), writer->file) != sizeof(end)) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to write to export file");
+	}
+	return AEROSPIKE_OK;
+}
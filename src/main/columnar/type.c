@@ -0,0 +1,583 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <structmember.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+
+#include "columnar.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "macros.h"
+
+#define ARROW_SCHEMA_CAPSULE "arrow_schema"
+#define ARROW_ARRAY_CAPSULE "arrow_array"
+
+/*******************************************************************************
+ * ARROW EXPORT
+ *
+ * The exported arrays point directly at the column buffers. Every array,
+ * children included, holds a reference to the AerospikeColumnar object, which
+ * keeps the buffers alive until the consumer releases it. A consumer may move
+ * a child out and release the parent first.
+ ******************************************************************************/
+
+static const char * column_format(as_column * col)
+{
+	switch (col->type) {
+		case COLUMN_INT64:
+			return "l";
+		case COLUMN_DOUBLE:
+			return "g";
+		case COLUMN_UTF8:
+			return "u";
+		case COLUMN_BINARY:
+			return "z";
+		case COLUMN_LIST:
+			return "+l";
+		default:
+			return "n";
+	}
+}
+
+static void release_schema(struct ArrowSchema * schema)
+{
+	for (int64_t i = 0; i < schema->n_children; i++) {
+		struct ArrowSchema * child = schema->children[i];
+		if (child->release) {
+			child->release(child);
+		}
+		free(child);
+	}
+	free(schema->children);
+	free((void *) schema->name);
+	schema->release = NULL;
+}
+
+static void release_array(struct ArrowArray * array)
+{
+	for (int64_t i = 0; i < array->n_children; i++) {
+		struct ArrowArray * child = array->children[i];
+		if (child->release) {
+			child->release(child);
+		}
+		free(child);
+	}
+	free(array->children);
+	free(array->buffers);
+
+	if (array->private_data) {
+		// Consumers may release from any thread.
+		PyGILState_STATE gstate = PyGILState_Ensure();
+		Py_DECREF((PyObject *) array->private_data);
+		PyGILState_Release(gstate);
+	}
+	array->release = NULL;
+}
+
+static bool schema_init(struct ArrowSchema * schema, const char * format, const char * name,
+		int64_t flags, int64_t n_children)
+{
+	memset(schema, 0, sizeof(struct ArrowSchema));
+	schema->format = format;
+	schema->flags = flags;
+	schema->release = release_schema;
+	schema->name = strdup(name);
+	if (n_children) {
+		schema->children = calloc(n_children, sizeof(struct ArrowSchema *));
+		if (!schema->children) {
+			return false;
+		}
+	}
+	// Children are counted as they are allocated so release only frees what exists.
+	return schema->name != NULL;
+}
+
+static bool array_init(struct ArrowArray * array, AerospikeColumnar * owner, int64_t length,
+		int64_t null_count, int64_t n_buffers, int64_t n_children)
+{
+	memset(array, 0, sizeof(struct ArrowArray));
+	array->length = length;
+	array->null_count = null_count;
+	array->n_buffers = n_buffers;
+	array->release = release_array;
+	Py_INCREF(owner);
+	array->private_data = owner;
+	if (n_buffers) {
+		array->buffers = calloc(n_buffers, sizeof(void *));
+		if (!array->buffers) {
+			return false;
+		}
+	}
+	if (n_children) {
+		array->children = calloc(n_children, sizeof(struct ArrowArray *));
+		if (!array->children) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool export_column_schema(as_column * col, struct ArrowSchema * schema)
+{
+	int64_t n_children = col->type == COLUMN_LIST ? 1 : 0;
+	if (!schema_init(schema, column_format(col), col->name, ARROW_FLAG_NULLABLE, n_children)) {
+		return false;
+	}
+
+	if (n_children) {
+		struct ArrowSchema * child = malloc(sizeof(struct ArrowSchema));
+		if (!child) {
+			return false;
+		}
+		schema->children[0] = child;
+		schema->n_children = 1;
+		return export_column_schema(col->child, child);
+	}
+	return true;
+}
+
+static bool export_column_array(AerospikeColumnar * owner, as_column * col, struct ArrowArray * array)
+{
+	const void * validity = col->null_count ? col->validity.data : NULL;
+
+	switch (col->type) {
+		case COLUMN_INT64:
+		case COLUMN_DOUBLE:
+			if (!array_init(array, owner, col->length, col->null_count, 2, 0)) {
+				return false;
+			}
+			array->buffers[0] = validity;
+			array->buffers[1] = col->values.data;
+			return true;
+		case COLUMN_UTF8:
+		case COLUMN_BINARY:
+			if (!array_init(array, owner, col->length, col->null_count, 3, 0)) {
+				return false;
+			}
+			array->buffers[0] = validity;
+			array->buffers[1] = col->offsets.data;
+			array->buffers[2] = col->values.data;
+			return true;
+		case COLUMN_LIST: {
+			if (!array_init(array, owner, col->length, col->null_count, 2, 1)) {
+				return false;
+			}
+			array->buffers[0] = validity;
+			array->buffers[1] = col->offsets.data;
+			struct ArrowArray * child = malloc(sizeof(struct ArrowArray));
+			if (!child) {
+				return false;
+			}
+			array->children[0] = child;
+			array->n_children = 1;
+			return export_column_array(owner, col->child, child);
+		}
+		default:
+			// The null type has no buffers.
+			return array_init(array, owner, col->length, col->length, 0, 0);
+	}
+}
+
+static bool export_schema(AerospikeColumnar * self, struct ArrowSchema * schema)
+{
+	as_columns * columns = &self->columns;
+
+	if (!schema_init(schema, "+s", "", 0, columns->n_columns)) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		struct ArrowSchema * child = malloc(sizeof(struct ArrowSchema));
+		if (!child) {
+			return false;
+		}
+		schema->children[i] = child;
+		schema->n_children = i + 1;
+		if (!export_column_schema(columns->columns[i], child)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool export_array(AerospikeColumnar * self, struct ArrowArray * array)
+{
+	as_columns * columns = &self->columns;
+
+	if (!array_init(array, self, columns->n_rows, 0, 1, columns->n_columns)) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < columns->n_columns; i++) {
+		struct ArrowArray * child = malloc(sizeof(struct ArrowArray));
+		if (!child) {
+			return false;
+		}
+		array->children[i] = child;
+		array->n_children = i + 1;
+		if (!export_column_array(self, columns->columns[i], child)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static PyObject * raise_export_error(void)
+{
+	as_error err;
+	as_error_init(&err);
+	as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for the arrow export");
+	PyObject * py_err = NULL;
+	error_to_pyobject(&err, &py_err);
+	PyObject *exception_type = raise_exception(&err);
+	PyErr_SetObject(exception_type, py_err);
+	Py_DECREF(py_err);
+	return NULL;
+}
+
+static void schema_capsule_destructor(PyObject * capsule)
+{
+	struct ArrowSchema * schema = PyCapsule_GetPointer(capsule, ARROW_SCHEMA_CAPSULE);
+	if (schema->release) {
+		schema->release(schema);
+	}
+	free(schema);
+}
+
+static void array_capsule_destructor(PyObject * capsule)
+{
+	struct ArrowArray * array = PyCapsule_GetPointer(capsule, ARROW_ARRAY_CAPSULE);
+	if (array->release) {
+		array->release(array);
+	}
+	free(array);
+}
+
+static PyObject * new_schema_capsule(AerospikeColumnar * self)
+{
+	struct ArrowSchema * schema = malloc(sizeof(struct ArrowSchema));
+	if (!schema) {
+		return raise_export_error();
+	}
+	if (!export_schema(self, schema)) {
+		schema->release(schema);
+		free(schema);
+		return raise_export_error();
+	}
+	return PyCapsule_New(schema, ARROW_SCHEMA_CAPSULE, schema_capsule_destructor);
+}
+
+static PyObject * new_array_capsule(AerospikeColumnar * self)
+{
+	struct ArrowArray * array = malloc(sizeof(struct ArrowArray));
+	if (!array) {
+		return raise_export_error();
+	}
+	if (!export_array(self, array)) {
+		array->release(array);
+		free(array);
+		return raise_export_error();
+	}
+	return PyCapsule_New(array, ARROW_ARRAY_CAPSULE, array_capsule_destructor);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+PyDoc_STRVAR(arrow_c_schema_doc,
+"__arrow_c_schema__() -> PyCapsule\n\
+\n\
+Export the schema of the columns as an Arrow C data interface ArrowSchema.");
+
+PyDoc_STRVAR(arrow_c_array_doc,
+"__arrow_c_array__([requested_schema]) -> (PyCapsule, PyCapsule)\n\
+\n\
+Export the columns as an Arrow C data interface struct array, without copying the column buffers.");
+
+PyDoc_STRVAR(export_to_c_doc,
+"_export_to_c(array_address[, schema_address])\n\
+\n\
+Export the columns to the ArrowArray and ArrowSchema structs at the given addresses.");
+
+PyDoc_STRVAR(to_pyarrow_doc,
+"to_pyarrow() -> pyarrow.RecordBatch\n\
+\n\
+Import the columns into a pyarrow RecordBatch without copying the column buffers.");
+
+static PyObject * AerospikeColumnar_Arrow_C_Schema(AerospikeColumnar * self, PyObject * args)
+{
+	return new_schema_capsule(self);
+}
+
+static PyObject * AerospikeColumnar_Arrow_C_Array(AerospikeColumnar * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_requested_schema = NULL;
+	static char * kwlist[] = {"requested_schema", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|O:__arrow_c_array__", kwlist,
+				&py_requested_schema) == false) {
+		return NULL;
+	}
+
+	// The requested schema is a hint, consumers cast if it is not honoured.
+	PyObject * py_schema = new_schema_capsule(self);
+	if (!py_schema) {
+		return NULL;
+	}
+	PyObject * py_array = new_array_capsule(self);
+	if (!py_array) {
+		Py_DECREF(py_schema);
+		return NULL;
+	}
+
+	PyObject * py_result = PyTuple_Pack(2, py_schema, py_array);
+	Py_DECREF(py_schema);
+	Py_DECREF(py_array);
+	return py_result;
+}
+
+static PyObject * AerospikeColumnar_Export_To_C(AerospikeColumnar * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_array_address = NULL;
+	PyObject * py_schema_address = NULL;
+	static char * kwlist[] = {"array_address", "schema_address", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O|O:_export_to_c", kwlist,
+				&py_array_address, &py_schema_address) == false) {
+		return NULL;
+	}
+
+	struct ArrowArray * array = PyLong_AsVoidPtr(py_array_address);
+	if (PyErr_Occurred()) {
+		return NULL;
+	}
+	struct ArrowSchema * schema = NULL;
+	if (py_schema_address && py_schema_address != Py_None) {
+		schema = PyLong_AsVoidPtr(py_schema_address);
+		if (PyErr_Occurred()) {
+			return NULL;
+		}
+	}
+
+	if (!export_array(self, array)) {
+		array->release(array);
+		return raise_export_error();
+	}
+	if (schema && !export_schema(self, schema)) {
+		schema->release(schema);
+		array->release(array);
+		return raise_export_error();
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeColumnar_To_Pyarrow(AerospikeColumnar * self, PyObject * args)
+{
+	PyObject * py_pyarrow = PyImport_ImportModule("pyarrow");
+	if (!py_pyarrow) {
+		return NULL;
+	}
+
+	PyObject * py_batch_type = PyObject_GetAttrString(py_pyarrow, "RecordBatch");
+	Py_DECREF(py_pyarrow);
+	if (!py_batch_type) {
+		return NULL;
+	}
+
+	struct ArrowArray array;
+	struct ArrowSchema schema;
+	if (!export_array(self, &array)) {
+		array.release(&array);
+		Py_DECREF(py_batch_type);
+		return raise_export_error();
+	}
+	if (!export_schema(self, &schema)) {
+		schema.release(&schema);
+		array.release(&array);
+		Py_DECREF(py_batch_type);
+		return raise_export_error();
+	}
+
+	// pyarrow moves the structs, and releases them once the batch is freed.
+	PyObject * py_batch = PyObject_CallMethod(py_batch_type, "_import_from_c", "NN",
+			PyLong_FromVoidPtr(&array), PyLong_FromVoidPtr(&schema));
+	Py_DECREF(py_batch_type);
+
+	if (array.release) {
+		array.release(&array);
+	}
+	if (schema.release) {
+		schema.release(&schema);
+	}
+	return py_batch;
+}
+
+static PyObject * AerospikeColumnar_Get_Num_Rows(AerospikeColumnar * self, void * closure)
+{
+	return PyLong_FromLongLong(self->columns.n_rows);
+}
+
+static PyObject * AerospikeColumnar_Get_Column_Names(AerospikeColumnar * self, void * closure)
+{
+	PyObject * py_names = PyList_New(self->columns.n_columns);
+	if (!py_names) {
+		return NULL;
+	}
+	for (uint32_t i = 0; i < self->columns.n_columns; i++) {
+		PyList_SetItem(py_names, i, PyString_FromString(self->columns.columns[i]->name));
+	}
+	return py_names;
+}
+
+static Py_ssize_t AerospikeColumnar_Length(AerospikeColumnar * self)
+{
+	return (Py_ssize_t) self->columns.n_rows;
+}
+
+static PyMethodDef AerospikeColumnar_Type_Methods[] = {
+
+	{"__arrow_c_schema__", (PyCFunction) AerospikeColumnar_Arrow_C_Schema, METH_NOARGS,
+				arrow_c_schema_doc},
+
+	{"__arrow_c_array__", (PyCFunction) AerospikeColumnar_Arrow_C_Array, METH_VARARGS | METH_KEYWORDS,
+				arrow_c_array_doc},
+
+	{"_export_to_c", (PyCFunction) AerospikeColumnar_Export_To_C, METH_VARARGS | METH_KEYWORDS,
+				export_to_c_doc},
+
+	{"to_pyarrow", (PyCFunction) AerospikeColumnar_To_Pyarrow, METH_NOARGS,
+				to_pyarrow_doc},
+
+	{NULL}
+};
+
+static PyGetSetDef AerospikeColumnar_Type_GetSet[] = {
+	{"num_rows", (getter) AerospikeColumnar_Get_Num_Rows, NULL,
+		"Number of rows in the columns.", NULL},
+	{"column_names", (getter) AerospikeColumnar_Get_Column_Names, NULL,
+		"Names of the columns, one per bin.", NULL},
+	{NULL}
+};
+
+static PySequenceMethods AerospikeColumnar_Type_Sequence = {
+	(lenfunc) AerospikeColumnar_Length, // sq_length
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static void AerospikeColumnar_Type_Dealloc(AerospikeColumnar * self)
+{
+	as_columns_destroy(&self->columns);
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeColumnar_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.ColumnarResult",         // tp_name
+	sizeof(AerospikeColumnar),          // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikeColumnar_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	0,                                  // tp_repr
+	0,                                  // tp_as_number
+	&AerospikeColumnar_Type_Sequence,   // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	0,                                  // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"Records in columnar form, one typed column per bin.\n"
+	"The columns are exposed through the Arrow C data interface.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	AerospikeColumnar_Type_Methods,     // tp_methods
+	0,                                  // tp_members
+	AerospikeColumnar_Type_GetSet,      // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0,                                  // tp_new
+	0,                                  // tp_free
+	0,                                  // tp_is_gc
+	0                                   // tp_bases
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeColumnar_Ready()
+{
+	return PyType_Ready(&AerospikeColumnar_Type) == 0 ? &AerospikeColumnar_Type : NULL;
+}
+
+AerospikeColumnar * AerospikeColumnar_New()
+{
+	AerospikeColumnar * self = PyObject_New(AerospikeColumnar, &AerospikeColumnar_Type);
+	if (self) {
+		as_columns_init(&self->columns);
+	}
+	return self;
+}
+
+as_status pyobject_to_result_format(as_error * err, PyObject * py_format, bool * columnar)
+{
+	*columnar = false;
+
+	if (!py_format || py_format == Py_None) {
+		return AEROSPIKE_OK;
+	}
+
+	if (!PyString_Check(py_format)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "format must be a string");
+	}
+
+	if (strcmp(PyString_AsString(py_format), RESULT_FORMAT_COLUMNAR) != 0) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid result format %s", PyString_AsString(py_format));
+	}
+
+	*columnar = true;
+	return AEROSPIKE_OK;
+}
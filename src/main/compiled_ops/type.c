@@ -0,0 +1,475 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_bin.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_vector.h>
+
+#include "compiled_ops.h"
+#include "conversions.h"
+#include "exceptions.h"
+
+/*******************************************************************************
+ * PLACEHOLDER
+ ******************************************************************************/
+
+static PyObject * AerospikePlaceholder_Type_New(PyTypeObject * type, PyObject * args, PyObject * kwds)
+{
+	long index = 0;
+	static char * kwlist[] = {"index", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "l:Placeholder", kwlist, &index) == false) {
+		return NULL;
+	}
+
+	if (index < 0 || index > UINT16_MAX) {
+		as_error err;
+		as_error_init(&err);
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Placeholder index should be between 0 and 65535");
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	AerospikePlaceholder * self = (AerospikePlaceholder *) type->tp_alloc(type, 0);
+	if (self) {
+		self->index = (uint32_t) index;
+	}
+	return (PyObject *) self;
+}
+
+static PyObject * AerospikePlaceholder_Repr(AerospikePlaceholder * self)
+{
+	return PyString_FromFormat("aerospike.Placeholder(%u)", self->index);
+}
+
+static PyObject * AerospikePlaceholder_Get_Index(AerospikePlaceholder * self, void * closure)
+{
+	return PyLong_FromUnsignedLong(self->index);
+}
+
+static PyGetSetDef AerospikePlaceholder_Type_GetSet[] = {
+	{"index", (getter) AerospikePlaceholder_Get_Index, NULL,
+		"Position of the value in the values passed to operate().", NULL},
+	{NULL}
+};
+
+static PyTypeObject AerospikePlaceholder_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	AS_PLACEHOLDER_NAME,                // tp_name
+	sizeof(AerospikePlaceholder),       // tp_basicsize
+	0,                                  // tp_itemsize
+	0,                                  // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	(reprfunc) AerospikePlaceholder_Repr,
+	                                    // tp_repr
+	0,                                  // tp_as_number
+	0,                                  // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	0,                                  // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"A value of a compiled operation which is given on each call.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	0,                                  // tp_methods
+	0,                                  // tp_members
+	AerospikePlaceholder_Type_GetSet,   // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	AerospikePlaceholder_Type_New       // tp_new
+};
+
+PyTypeObject * AerospikePlaceholder_Ready()
+{
+	return PyType_Ready(&AerospikePlaceholder_Type) == 0 ? &AerospikePlaceholder_Type : NULL;
+}
+
+/*******************************************************************************
+ * COMPILED OPERATIONS
+ ******************************************************************************/
+
+static Py_ssize_t AerospikeCompiledOps_Length(AerospikeCompiledOps * self)
+{
+	return (Py_ssize_t) self->size;
+}
+
+static PyObject * AerospikeCompiledOps_Get_Num_Params(AerospikeCompiledOps * self, void * closure)
+{
+	return PyLong_FromUnsignedLong(self->num_params);
+}
+
+static PyGetSetDef AerospikeCompiledOps_Type_GetSet[] = {
+	{"num_params", (getter) AerospikeCompiledOps_Get_Num_Params, NULL,
+		"Number of values expected by operate(), one more than the highest placeholder index.", NULL},
+	{NULL}
+};
+
+static PySequenceMethods AerospikeCompiledOps_Type_Sequence = {
+	(lenfunc) AerospikeCompiledOps_Length,  // sq_length
+};
+
+static void AerospikeCompiledOps_Type_Dealloc(AerospikeCompiledOps * self)
+{
+	// The placeholder slots hold empty binops.
+	for (uint32_t i = 0; i < self->ops.binops.size; i++) {
+		if (!self->slots || !self->slots[i].py_op) {
+			as_bin_destroy(&self->ops.binops.entries[i].bin);
+		}
+	}
+	self->ops.binops.size = 0;
+	as_operations_destroy(&self->ops);
+
+	if (self->unicode_strs) {
+		for (uint32_t i = 0; i < self->unicode_strs->size; i++) {
+			free(as_vector_get_ptr(self->unicode_strs, i));
+		}
+		as_vector_destroy(self->unicode_strs);
+	}
+
+	free(self->static_pool);
+
+	if (self->slots) {
+		for (uint32_t i = 0; i < self->size; i++) {
+			Py_XDECREF(self->slots[i].py_op);
+			Py_XDECREF(self->slots[i].py_params);
+		}
+		free(self->slots);
+	}
+
+	Py_XDECREF(self->py_ops);
+
+	PyObject_Del(self);
+}
+
+static PyTypeObject AerospikeCompiledOps_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	AS_COMPILED_OPS_NAME,               // tp_name
+	sizeof(AerospikeCompiledOps),       // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikeCompiledOps_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	0,                                  // tp_repr
+	0,                                  // tp_as_number
+	&AerospikeCompiledOps_Type_Sequence,
+	                                    // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	0,                                  // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"A list of operations encoded once by client.compile_ops(), to be passed\n"
+	"to operate() and operate_ordered() in place of the list.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	0,                                  // tp_methods
+	0,                                  // tp_members
+	AerospikeCompiledOps_Type_GetSet,   // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0                                   // tp_new
+};
+
+PyTypeObject * AerospikeCompiledOps_Ready()
+{
+	return PyType_Ready(&AerospikeCompiledOps_Type) == 0 ? &AerospikeCompiledOps_Type : NULL;
+}
+
+/*
+ * Collect the (key, index) pairs of the placeholders of an operation dict.
+ * Returns an empty list if the operation has none.
+ */
+static PyObject * get_placeholders(as_error * err, PyObject * py_op, uint32_t * num_params)
+{
+	PyObject * py_params = PyList_New(0);
+	if (!py_params) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the placeholders");
+		return NULL;
+	}
+
+	PyObject * py_key = NULL;
+	PyObject * py_value = NULL;
+	Py_ssize_t pos = 0;
+
+	while (PyDict_Next(py_op, &pos, &py_key, &py_value)) {
+		if (!AS_Matches_Classname(py_value, AS_PLACEHOLDER_NAME)) {
+			continue;
+		}
+
+		uint32_t index = ((AerospikePlaceholder *) py_value)->index;
+		PyObject * py_param = Py_BuildValue("(OI)", py_key, index);
+		if (!py_param || PyList_Append(py_params, py_param) != 0) {
+			Py_XDECREF(py_param);
+			Py_DECREF(py_params);
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the placeholders");
+			return NULL;
+		}
+		Py_DECREF(py_param);
+
+		if (index + 1 > *num_params) {
+			*num_params = index + 1;
+		}
+	}
+
+	return py_params;
+}
+
+/*
+ * Copy the dicts, lists, tuples and bytearrays of an operation dict. Bytes
+ * and the other values are shared, the copy holding a reference to them.
+ */
+static PyObject * op_copy(PyObject * py_obj)
+{
+	if (PyByteArray_CheckExact(py_obj)) {
+		return PyByteArray_FromStringAndSize(PyByteArray_AsString(py_obj), PyByteArray_Size(py_obj));
+	}
+
+	if (PyDict_CheckExact(py_obj)) {
+		PyObject * py_copy = PyDict_New();
+		PyObject * py_key = NULL;
+		PyObject * py_value = NULL;
+		Py_ssize_t pos = 0;
+
+		while (py_copy && PyDict_Next(py_obj, &pos, &py_key, &py_value)) {
+			PyObject * py_value_copy = op_copy(py_value);
+			if (!py_value_copy || PyDict_SetItem(py_copy, py_key, py_value_copy) != 0) {
+				Py_XDECREF(py_value_copy);
+				Py_CLEAR(py_copy);
+				break;
+			}
+			Py_DECREF(py_value_copy);
+		}
+		return py_copy;
+	}
+
+	if (PyList_CheckExact(py_obj) || PyTuple_CheckExact(py_obj)) {
+		Py_ssize_t size = PySequence_Fast_GET_SIZE(py_obj);
+		PyObject * py_copy = PyList_Check(py_obj) ? PyList_New(size) : PyTuple_New(size);
+
+		for (Py_ssize_t i = 0; py_copy && i < size; i++) {
+			PyObject * py_item_copy = op_copy(PySequence_Fast_GET_ITEM(py_obj, i));
+			if (!py_item_copy) {
+				Py_CLEAR(py_copy);
+				break;
+			}
+			if (PyList_Check(py_copy)) {
+				PyList_SET_ITEM(py_copy, i, py_item_copy);
+			} else {
+				PyTuple_SET_ITEM(py_copy, i, py_item_copy);
+			}
+		}
+		return py_copy;
+	}
+
+	Py_INCREF(py_obj);
+	return py_obj;
+}
+
+AerospikeCompiledOps * AerospikeCompiledOps_New(AerospikeClient * client, as_error * err, PyObject * py_list)
+{
+	if (!PyList_Check(py_list)) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Operations should be of type list");
+		return NULL;
+	}
+
+	Py_ssize_t size = PyList_Size(py_list);
+	if (size == 0) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Operations should not be empty");
+		return NULL;
+	}
+
+	AerospikeCompiledOps * self = PyObject_New(AerospikeCompiledOps, &AerospikeCompiledOps_Type);
+	if (!self) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the compiled operations");
+		return NULL;
+	}
+
+	as_operations_init(&self->ops, (uint16_t) size);
+	self->static_pool = (as_static_pool *) calloc(1, sizeof(as_static_pool));
+	self->unicode_strs = as_vector_create(sizeof(char *), 16);
+	self->slots = (as_compiled_slot *) calloc(size, sizeof(as_compiled_slot));
+	self->py_ops = PyList_New(0);
+	self->size = (uint32_t) size;
+	self->num_params = 0;
+
+	if (!self->static_pool || !self->slots || !self->py_ops) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the compiled operations");
+		goto CLEANUP;
+	}
+
+	for (Py_ssize_t i = 0; i < size; i++) {
+		PyObject * py_op = PyList_GetItem(py_list, i);
+		as_compiled_slot * slot = &self->slots[i];
+
+		if (!PyDict_Check(py_op)) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation must be a dict");
+			goto CLEANUP;
+		}
+
+		PyObject * py_params = get_placeholders(err, py_op, &self->num_params);
+		if (!py_params) {
+			goto CLEANUP;
+		}
+
+		if (PyList_Size(py_params) > 0) {
+			// Copied, so the operation cannot change after compiling.
+			slot->py_op = PyDict_Copy(py_op);
+			slot->py_params = py_params;
+			as_binop * binop = &self->ops.binops.entries[self->ops.binops.size++];
+			memset(binop, 0, sizeof(as_binop));
+			continue;
+		}
+		Py_DECREF(py_params);
+
+		// The binop wraps the bytes of the values without copying them, so it
+		// is encoded from a copy which lives as long as the object.
+		PyObject * py_op_copy = op_copy(py_op);
+		if (!py_op_copy || PyList_Append(self->py_ops, py_op_copy) != 0) {
+			Py_XDECREF(py_op_copy);
+			PyErr_Clear();
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to copy the operation");
+			goto CLEANUP;
+		}
+		Py_DECREF(py_op_copy);
+
+		long operation = 0;
+		long return_type = -1;
+		uint16_t binops_size = self->ops.binops.size;
+		if (add_op(client, err, py_op_copy, self->unicode_strs, self->static_pool, &self->ops,
+				&operation, &return_type) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+		if (self->ops.binops.size != binops_size + 1) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation %ld could not be compiled", operation);
+			goto CLEANUP;
+		}
+	}
+
+CLEANUP:
+	if (err->code != AEROSPIKE_OK) {
+		Py_DECREF(self);
+		return NULL;
+	}
+
+	return self;
+}
+
+as_status compiled_ops_fill(AerospikeClient * client, as_error * err, AerospikeCompiledOps * compiled,
+		PyObject * py_values, as_vector * unicode_strs, as_static_pool * static_pool, as_operations * ops)
+{
+	if (compiled->num_params) {
+		if (!py_values || !(PyList_Check(py_values) || PyTuple_Check(py_values))) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "values should be a list or tuple");
+		}
+		if (PySequence_Fast_GET_SIZE(py_values) < compiled->num_params) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "%u values are required", compiled->num_params);
+		}
+	}
+
+	// A touch operation with a ttl overrides the meta ttl, as for the dicts.
+	if (compiled->ops.ttl) {
+		ops->ttl = compiled->ops.ttl;
+	}
+
+	for (uint32_t i = 0; i < compiled->size; i++) {
+		as_compiled_slot * slot = &compiled->slots[i];
+
+		if (!slot->py_op) {
+			ops->binops.entries[ops->binops.size++] = compiled->ops.binops.entries[i];
+			continue;
+		}
+
+		PyObject * py_op = PyDict_Copy(slot->py_op);
+		if (!py_op) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to copy the operation");
+		}
+
+		for (Py_ssize_t j = 0; j < PyList_Size(slot->py_params); j++) {
+			PyObject * py_param = PyList_GetItem(slot->py_params, j);
+			Py_ssize_t index = PyInt_AsLong(PyTuple_GetItem(py_param, 1));
+			PyDict_SetItem(py_op, PyTuple_GetItem(py_param, 0),
+					PySequence_Fast_GET_ITEM(py_values, index));
+		}
+
+		long operation = 0;
+		long return_type = -1;
+		uint16_t binops_size = ops->binops.size;
+		add_op(client, err, py_op, unicode_strs, static_pool, ops, &operation, &return_type);
+		Py_DECREF(py_op);
+
+		if (err->code != AEROSPIKE_OK) {
+			return err->code;
+		}
+		if (ops->binops.size != binops_size + 1) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation %ld could not be encoded", operation);
+		}
+	}
+
+	return AEROSPIKE_OK;
+}
+
+void compiled_ops_release(AerospikeCompiledOps * compiled, as_operations * ops)
+{
+	for (uint32_t i = 0; i < ops->binops.size && i < compiled->size; i++) {
+		if (compiled->slots[i].py_op) {
+			as_bin_destroy(&ops->binops.entries[i].bin);
+		}
+	}
+	ops->binops.size = 0;
+}
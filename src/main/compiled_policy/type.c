@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_policy.h>
+
+#include "compiled_policy.h"
+#include "macros.h"
+#include "policy.h"
+
+static const char * policy_kind_names[] = {
+	"read",
+	"write",
+	"operate",
+	"remove",
+	"apply",
+	"batch",
+	"scan",
+	"query"
+};
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+static PyObject * AerospikePolicy_Get_Kind(AerospikePolicy * self, void * closure)
+{
+	return PyString_FromString(policy_kind_names[self->kind]);
+}
+
+static PyObject * AerospikePolicy_Repr(AerospikePolicy * self)
+{
+	return PyString_FromFormat("<aerospike.Policy %s>", policy_kind_names[self->kind]);
+}
+
+static PyGetSetDef AerospikePolicy_Type_GetSet[] = {
+	{"kind", (getter) AerospikePolicy_Get_Kind, NULL,
+		"The commands the policy is for: 'read', 'write', 'operate', 'remove', 'apply', 'batch', 'scan' or 'query'.", NULL},
+	{NULL}
+};
+
+static void AerospikePolicy_Type_Dealloc(AerospikePolicy * self)
+{
+	if (self->has_predexp) {
+		as_predexp_list_destroy(&self->predexps);
+	}
+	PyObject_Del(self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+PyTypeObject AerospikePolicy_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.Policy",                 // tp_name
+	sizeof(AerospikePolicy),            // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikePolicy_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	(reprfunc) AerospikePolicy_Repr,    // tp_repr
+	0,                                  // tp_as_number
+	0,                                  // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	0,                                  // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"A policy compiled by client.write_policy() and the other policy methods,\n"
+	"to be passed as the policy argument of the matching commands.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	0,                                  // tp_methods
+	0,                                  // tp_members
+	AerospikePolicy_Type_GetSet,        // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0                                   // tp_new
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikePolicy_Ready()
+{
+	return PyType_Ready(&AerospikePolicy_Type) == 0 ? &AerospikePolicy_Type : NULL;
+}
+
+/*
+ * Convert py_fields with the usual pyobject_to_policy_* function, then keep
+ * the result. The conversion leaves policy_p NULL when there are no fields,
+ * in which case the policy is a copy of the client default. The predexps of
+ * the "predexp" field are kept by the object for as long as the policy.
+ */
+#define POLICY_COMPILE(__member, __defaults, __predexps) { \
+	as_policy_##__member policy;\
+	as_policy_##__member * policy_p = NULL;\
+	if (pyobject_to_policy_##__member(err, py_fields, &policy, &policy_p, &(__defaults), __predexps) != AEROSPIKE_OK) {\
+		break;\
+	}\
+	self->policy.__member = policy_p ? *policy_p : (__defaults);\
+}
+
+AerospikePolicy * AerospikePolicy_New(AerospikeClient * client, as_error * err, as_policy_kind kind, PyObject * py_fields)
+{
+	as_policies * defaults = &client->as->config.policies;
+
+	AerospikePolicy * self = PyObject_New(AerospikePolicy, &AerospikePolicy_Type);
+	if (!self) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the policy");
+		return NULL;
+	}
+	self->kind = kind;
+	self->has_predexp = false;
+	self->records_per_second = 0;
+
+	switch (kind) {
+		case AS_POLICY_KIND_READ:
+			POLICY_COMPILE(read, defaults->read, &self->predexps);
+			self->has_predexp = self->policy.read.base.predexp == &self->predexps;
+			break;
+		case AS_POLICY_KIND_WRITE:
+			POLICY_COMPILE(write, defaults->write, &self->predexps);
+			self->has_predexp = self->policy.write.base.predexp == &self->predexps;
+			break;
+		case AS_POLICY_KIND_OPERATE:
+			POLICY_COMPILE(operate, defaults->operate, &self->predexps);
+			self->has_predexp = self->policy.operate.base.predexp == &self->predexps;
+			break;
+		case AS_POLICY_KIND_REMOVE:
+			POLICY_COMPILE(remove, defaults->remove, &self->predexps);
+			self->has_predexp = self->policy.remove.base.predexp == &self->predexps;
+			break;
+		case AS_POLICY_KIND_APPLY:
+			POLICY_COMPILE(apply, defaults->apply, &self->predexps);
+			self->has_predexp = self->policy.apply.base.predexp == &self->predexps;
+			break;
+		case AS_POLICY_KIND_BATCH:
+			POLICY_COMPILE(batch, defaults->batch, &self->predexps);
+			self->has_predexp = self->policy.batch.base.predexp == &self->predexps;
+			break;
+		case AS_POLICY_KIND_SCAN:
+			POLICY_COMPILE(scan, defaults->scan, &self->predexps);
+			self->has_predexp = self->policy.scan.base.predexp == &self->predexps;
+			break;
+		case AS_POLICY_KIND_QUERY: {
+			// Queries take their predexps from Query.predexp()
+			as_policy_query policy;
+			as_policy_query * policy_p = NULL;
+			if (pyobject_to_policy_query(err, py_fields, &policy, &policy_p, &defaults->query) != AEROSPIKE_OK) {
+				break;
+			}
+			self->policy.query = policy_p ? *policy_p : defaults->query;
+			break;
+		}
+	}
+
+	if (err->code == AEROSPIKE_OK && (kind == AS_POLICY_KIND_SCAN || kind == AS_POLICY_KIND_QUERY)) {
+		pyobject_to_records_per_second(err, py_fields, &self->records_per_second);
+	}
+
+	if (err->code != AEROSPIKE_OK) {
+		Py_DECREF(self);
+		return NULL;
+	}
+	return self;
+}
@@ -43,6 +43,9 @@
 #include "serializer.h"
 #include "exceptions.h"
 #include "cdt_types.h"
+#include "operation.h"
+#include "cdt_context.h"
+#include "hll.h"
 
 #define PY_KEYT_NAMESPACE 0
 #define PY_KEYT_SET 1
@@ -429,6 +432,10 @@ as_status pyobject_to_val(AerospikeClient * self, as_error * err, PyObject * py_
 			}
 		}
 		*val = (as_val *) as_integer_new(l);
+	} else if (AerospikeHyperLogLog_Check(py_obj)) {
+		as_bytes * bytes = as_bytes_new_wrap((uint8_t *) PyBytes_AsString(py_obj), (uint32_t) PyBytes_Size(py_obj), false);
+		as_bytes_set_type(bytes, AS_BYTES_HLL);
+		*val = (as_val *) bytes;
 	} else if (PyUnicode_Check(py_obj)) {
 		PyObject * py_ustr = PyUnicode_AsUTF8String(py_obj);
 		char * str = PyBytes_AsString(py_ustr);
@@ -583,6 +590,9 @@ as_status pyobject_to_record(AerospikeClient * self, as_error * err, PyObject *
 					}
 				}
 				ret_val = as_record_set_int64(rec, name, val);
+			} else if (AerospikeHyperLogLog_Check(value)) {
+				ret_val = as_record_set_raw_typep(rec, name, (uint8_t *) PyBytes_AsString(value),
+						(uint32_t) PyBytes_Size(value), AS_BYTES_HLL, false);
 			} else if (!strcmp(value->ob_type->tp_name, "aerospike.Geospatial")) {
 				PyObject *py_geo_string = PyString_FromString("geo_data");
 				PyObject* py_data = PyObject_GenericGetAttr(value, py_geo_string);
@@ -772,6 +782,10 @@ as_status pyobject_to_astype_write(AerospikeClient * self, as_error * err, PyObj
 	} else if (PyLong_Check(py_value)) {
 		int64_t l = (int64_t) PyLong_AsLongLong(py_value);
 		*val = (as_val *) as_integer_new(l);
+	} else if (AerospikeHyperLogLog_Check(py_value)) {
+		as_bytes * bytes = as_bytes_new_wrap((uint8_t *) PyBytes_AsString(py_value), (uint32_t) PyBytes_Size(py_value), false);
+		as_bytes_set_type(bytes, AS_BYTES_HLL);
+		*val = (as_val *) bytes;
 	} else if (PyUnicode_Check(py_value)) {
 		PyObject * py_ustr = PyUnicode_AsUTF8String(py_value);
 		char * str = PyBytes_AsString(py_ustr);
@@ -1959,96 +1973,117 @@ string_and_pyuni_from_pystring(PyObject* py_string, PyObject** pyuni_r, char** c
 // an as_cdt_ctx object for use with the c-client. the cdt_ctx parameter should be an uninitialized as_cdt_ctx
 // object. This function will initilaise it, and free it IF an error occurs, otherwise, the caller must destroy
 // the as_cdt_ctx when it is done.
-as_status get_cdt_ctx(AerospikeClient* self, as_error* err, as_cdt_ctx* cdt_ctx, 
-    PyObject* op_dict, bool* ctx_in_use, as_static_pool* static_pool, int serializer_type)
+/**
+ * Add the cdt_ctx item_type with value py_value to cdt_ctx.
+ */
+static as_status add_cdt_ctx_item(AerospikeClient* self, as_error* err, as_cdt_ctx* cdt_ctx,
+    uint64_t item_type, PyObject* py_value, as_static_pool* static_pool, int serializer_type)
 {
-    PyObject* py_ctx = PyDict_GetItemString(op_dict, CTX_KEY);
     int int_val = 0;
     as_val* val = NULL;
 
-    if (!py_ctx) {
+    if (requires_int(item_type)) {
+        int_val = PyLong_AsLong(py_value);
+        if (PyErr_Occurred()) {
+            PyErr_Clear();
+            return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
+        }
+        switch(item_type) {
+            case AS_CDT_CTX_LIST_INDEX:
+                as_cdt_ctx_add_list_index(cdt_ctx, int_val);
+                break;
+            case AS_CDT_CTX_LIST_RANK:
+                as_cdt_ctx_add_list_rank(cdt_ctx, int_val);
+                break;
+            case AS_CDT_CTX_MAP_INDEX:
+                as_cdt_ctx_add_map_index(cdt_ctx, int_val);
+                break;
+            case AS_CDT_CTX_MAP_RANK:
+                as_cdt_ctx_add_map_rank(cdt_ctx, int_val);
+                break;
+        }
         return AEROSPIKE_OK;
     }
-    *ctx_in_use = true;
 
-    if (PyList_Check(py_ctx)) {
-        Py_ssize_t py_list_size = PyList_Size(py_ctx);
-        as_cdt_ctx_init(cdt_ctx, (int)py_list_size);
-
-        for (int i = 0; i < py_list_size; i++) {
-            PyObject* py_val = PyList_GetItem(py_ctx, (Py_ssize_t)i);
-
-            PyObject* id_temp = PyObject_GetAttrString(py_val, "id");
-            if (PyErr_Occurred()) {
-				as_cdt_ctx_destroy(cdt_ctx);
-                return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
-            }
-
-            PyObject* value_temp = PyObject_GetAttrString(py_val, "value");
-            if (PyErr_Occurred()) {
-				as_cdt_ctx_destroy(cdt_ctx);
-                return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
-            }
-
-            uint64_t item_type = PyLong_AsUnsignedLong(id_temp);
-            if (PyErr_Occurred()) {
-				as_cdt_ctx_destroy(cdt_ctx);
-                return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
-            }
-
-            // add an as_cdt_ctx with value to cdt_ctx
-            if (requires_int(item_type)) {
-                int_val = PyLong_AsLong(value_temp);
-                if (PyErr_Occurred()) {
-					as_cdt_ctx_destroy(cdt_ctx);
-                    return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
-                }
-                switch(item_type) {
-                    case AS_CDT_CTX_LIST_INDEX:
-                        as_cdt_ctx_add_list_index(cdt_ctx, int_val);
-                        break;
-                    case AS_CDT_CTX_LIST_RANK:
-                        as_cdt_ctx_add_list_rank(cdt_ctx, int_val);
-                        break;
-                    case AS_CDT_CTX_MAP_INDEX:
-                        as_cdt_ctx_add_map_index(cdt_ctx, int_val);
-                        break;
-                    case AS_CDT_CTX_MAP_RANK:
-                        as_cdt_ctx_add_map_rank(cdt_ctx, int_val);
-                        break;
-                    default:
-						as_cdt_ctx_destroy(cdt_ctx);
-                        return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert, unknown ctx operation %s", CTX_KEY);
-                }
-            } else {
-                if (pyobject_to_val(self, err, value_temp, &val, static_pool, serializer_type) != AEROSPIKE_OK) {
-                    return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
-                }
-                switch(item_type) {
-                    case AS_CDT_CTX_LIST_VALUE:
-                        as_cdt_ctx_add_list_value(cdt_ctx, val);
-                        break;
-                    case AS_CDT_CTX_MAP_KEY:
-                        as_cdt_ctx_add_map_key(cdt_ctx, val);
-                        break;
-                    case AS_CDT_CTX_MAP_VALUE:
-                        as_cdt_ctx_add_map_value(cdt_ctx, val);
-                        break;
-                    default:
-						as_cdt_ctx_destroy(cdt_ctx);
-                        return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert, unknown ctx operation %s", CTX_KEY);
-                }
-            }
+    if (item_type != AS_CDT_CTX_LIST_VALUE && item_type != AS_CDT_CTX_MAP_KEY &&
+            item_type != AS_CDT_CTX_MAP_VALUE) {
+        return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert, unknown ctx operation %s", CTX_KEY);
+    }
 
-            Py_DECREF(id_temp);
-            Py_DECREF(value_temp);
-        }
+    if (pyobject_to_val(self, err, py_value, &val, static_pool, serializer_type) != AEROSPIKE_OK) {
+        return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
     }
-    else {
-		as_cdt_ctx_destroy(cdt_ctx);
+    switch(item_type) {
+        case AS_CDT_CTX_LIST_VALUE:
+            as_cdt_ctx_add_list_value(cdt_ctx, val);
+            break;
+        case AS_CDT_CTX_MAP_KEY:
+            as_cdt_ctx_add_map_key(cdt_ctx, val);
+            break;
+        case AS_CDT_CTX_MAP_VALUE:
+            as_cdt_ctx_add_map_value(cdt_ctx, val);
+            break;
+    }
+    return AEROSPIKE_OK;
+}
+
+as_status pyobject_to_cdt_ctx(AerospikeClient* self, as_error* err, PyObject* py_ctx, as_cdt_ctx* cdt_ctx,
+    as_static_pool* static_pool, int serializer_type)
+{
+    if (!PyList_Check(py_ctx)) {
         return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
     }
 
+    Py_ssize_t py_list_size = PyList_Size(py_ctx);
+    as_cdt_ctx_init(cdt_ctx, (int)py_list_size);
+
+    for (Py_ssize_t i = 0; i < py_list_size; i++) {
+        PyObject* py_val = PyList_GetItem(py_ctx, i);
+
+        PyObject* id_temp = PyObject_GetAttrString(py_val, "id");
+        PyObject* value_temp = id_temp ? PyObject_GetAttrString(py_val, "value") : NULL;
+        uint64_t item_type = value_temp ? PyLong_AsUnsignedLong(id_temp) : 0;
+
+        if (PyErr_Occurred()) {
+            PyErr_Clear();
+            as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to convert %s", CTX_KEY);
+        } else {
+            add_cdt_ctx_item(self, err, cdt_ctx, item_type, value_temp, static_pool, serializer_type);
+        }
+
+        Py_XDECREF(id_temp);
+        Py_XDECREF(value_temp);
+
+        if (err->code != AEROSPIKE_OK) {
+            as_cdt_ctx_destroy(cdt_ctx);
+            return err->code;
+        }
+    }
+
+    return AEROSPIKE_OK;
+}
+
+as_status get_cdt_ctx(AerospikeClient* self, as_error* err, as_cdt_ctx* cdt_ctx, 
+    PyObject* op_dict, bool* ctx_in_use, as_static_pool* static_pool, int serializer_type)
+{
+    PyObject* py_ctx = operation_get(op_dict, AS_OP_FIELD_CTX, CTX_KEY);
+
+    if (!py_ctx) {
+        return AEROSPIKE_OK;
+    }
+
+    // A compiled context was converted by client.compile_ctx().
+    if (AerospikeCDTContext_Check(py_ctx)) {
+        AerospikeCDTContext_Copy((AerospikeCDTContext*) py_ctx, cdt_ctx);
+        *ctx_in_use = true;
+        return AEROSPIKE_OK;
+    }
+
+    if (pyobject_to_cdt_ctx(self, err, py_ctx, cdt_ctx, static_pool, serializer_type) != AEROSPIKE_OK) {
+        return err->code;
+    }
+    *ctx_in_use = true;
+
     return AEROSPIKE_OK;
 }
 
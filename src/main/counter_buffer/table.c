@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_key.h>
+
+#include "counter_buffer.h"
+
+// Bins of an entry, most counters have one or two.
+#define COUNTER_BINS_MIN_CAPACITY 2
+
+/*
+ * Everything in this file may run without the GIL, so it must not touch
+ * Python objects.
+ */
+
+static uint32_t digest_hash(const as_key * key)
+{
+	// The digest is a RIPEMD-160 hash, its bytes are uniformly distributed.
+	uint32_t hash;
+	memcpy(&hash, key->digest.value, sizeof(hash));
+	return hash;
+}
+
+static bool key_equals(const as_key * a, const as_key * b)
+{
+	return memcmp(a->digest.value, b->digest.value, AS_DIGEST_VALUE_SIZE) == 0 &&
+		strcmp(a->ns, b->ns) == 0;
+}
+
+static void entry_destroy(as_counter_entry * entry)
+{
+	as_key_destroy(&entry->key);
+	free(entry->bins);
+	free(entry);
+}
+
+bool as_counter_table_init(as_counter_table * table, uint32_t n_buckets)
+{
+	table->buckets = calloc(n_buckets, sizeof(as_counter_entry *));
+	table->n_buckets = table->buckets ? n_buckets : 0;
+	table->n_entries = 0;
+	return table->buckets != NULL;
+}
+
+void as_counter_table_destroy(as_counter_table * table)
+{
+	for (uint32_t i = 0; i < table->n_buckets; i++) {
+		as_counter_entry * entry = table->buckets[i];
+		while (entry) {
+			as_counter_entry * next = entry->next;
+			entry_destroy(entry);
+			entry = next;
+		}
+	}
+	free(table->buckets);
+	table->buckets = NULL;
+	table->n_buckets = 0;
+	table->n_entries = 0;
+}
+
+as_counter_entry * as_counter_table_add(as_counter_table * table, as_key * key, const char * bin, int64_t delta)
+{
+	if (!table->n_buckets) {
+		return NULL;
+	}
+
+	as_counter_entry ** head = &table->buckets[digest_hash(key) % table->n_buckets];
+	as_counter_entry * entry = *head;
+
+	while (entry && !key_equals(&entry->key, key)) {
+		entry = entry->next;
+	}
+
+	bool created = false;
+	if (!entry) {
+		entry = calloc(1, sizeof(as_counter_entry));
+		if (!entry) {
+			return NULL;
+		}
+		as_key_init_digest(&entry->key, key->ns, key->set, key->digest.value);
+		entry->next = *head;
+		*head = entry;
+		table->n_entries++;
+		created = true;
+	}
+
+	for (uint32_t i = 0; i < entry->n_bins; i++) {
+		if (strcmp(entry->bins[i].name, bin) == 0) {
+			// Summed as unsigned, to wrap rather than overflow.
+			entry->bins[i].delta = (int64_t) ((uint64_t) entry->bins[i].delta + (uint64_t) delta);
+			return entry;
+		}
+	}
+
+	if (entry->n_bins == entry->capacity) {
+		uint32_t capacity = entry->capacity ? entry->capacity * 2 : COUNTER_BINS_MIN_CAPACITY;
+		as_counter_bin * bins = realloc(entry->bins, capacity * sizeof(as_counter_bin));
+		if (!bins) {
+			// Don't leave an entry without bins for the flush to write.
+			if (created) {
+				*head = entry->next;
+				table->n_entries--;
+				entry_destroy(entry);
+			}
+			return NULL;
+		}
+		entry->bins = bins;
+		entry->capacity = capacity;
+	}
+
+	as_counter_bin * counter = &entry->bins[entry->n_bins++];
+	strncpy(counter->name, bin, AS_BIN_NAME_MAX_SIZE - 1);
+	counter->name[AS_BIN_NAME_MAX_SIZE - 1] = '\0';
+	counter->delta = delta;
+	return entry;
+}
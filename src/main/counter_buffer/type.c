@@ -0,0 +1,642 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_record.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "counter_buffer.h"
+#include "exceptions.h"
+
+// Buckets of the table, it does not grow.
+#define COUNTER_TABLE_BUCKETS 4096
+
+static void counter_buffer_deadline(struct timespec * ts, uint32_t ms)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	uint64_t ns = (uint64_t) now.tv_usec * 1000 + (uint64_t) ms * 1000000;
+	ts->tv_sec = now.tv_sec + (time_t) (ns / 1000000000);
+	ts->tv_nsec = (long) (ns % 1000000000);
+}
+
+/*
+ * Must be called with the GIL held. Errors of the callback itself are
+ * reported as unraisable, the flush goes on.
+ */
+static void counter_buffer_report(AerospikeCounterBuffer * self, as_error * err, as_counter_entry * entry)
+{
+	as_error conv_err;
+	as_error_init(&conv_err);
+
+	PyObject * py_key = NULL;
+	PyObject * py_bins = PyDict_New();
+	PyObject * py_err = NULL;
+	PyObject * py_exception = NULL;
+
+	key_to_pyobject(&conv_err, &entry->key, &py_key);
+
+	for (uint32_t i = 0; py_bins && i < entry->n_bins; i++) {
+		PyObject * py_delta = PyLong_FromLongLong(entry->bins[i].delta);
+		if (py_delta) {
+			PyDict_SetItemString(py_bins, entry->bins[i].name, py_delta);
+			Py_DECREF(py_delta);
+		}
+	}
+
+	error_to_pyobject(err, &py_err);
+	PyObject * exception_type = raise_exception(err);
+	py_exception = PyObject_CallObject(exception_type, py_err);
+
+	if (py_key && py_bins && py_exception) {
+		PyObject * py_ret = PyObject_CallFunctionObjArgs(self->on_error, py_key, py_bins, py_exception, NULL);
+		if (!py_ret) {
+			PyErr_WriteUnraisable(self->on_error);
+		}
+		Py_XDECREF(py_ret);
+	}
+	PyErr_Clear();
+
+	Py_XDECREF(py_key);
+	Py_XDECREF(py_bins);
+	Py_XDECREF(py_err);
+	Py_XDECREF(py_exception);
+}
+
+typedef struct {
+	as_counter_entry * entry;
+	as_error err;
+} counter_failure;
+
+/*
+ * Write the pending increments, one operate command per key. Must be called
+ * without the GIL, it is taken to report failures.
+ */
+static void counter_buffer_flush(AerospikeCounterBuffer * self)
+{
+	as_counter_table table;
+	counter_failure * failures = NULL;
+	uint32_t n_failures = 0;
+	uint32_t failures_capacity = 0;
+
+	pthread_mutex_lock(&self->flush_lock);
+
+	// Swap the table, so increments are buffered while this one is written.
+	if (!as_counter_table_init(&table, COUNTER_TABLE_BUCKETS)) {
+		pthread_mutex_unlock(&self->flush_lock);
+		return;
+	}
+	pthread_mutex_lock(&self->lock);
+	as_counter_table pending = self->table;
+	self->table = table;
+	pthread_mutex_unlock(&self->lock);
+
+	for (uint32_t i = 0; i < pending.n_buckets; i++) {
+		for (as_counter_entry * entry = pending.buckets[i]; entry; entry = entry->next) {
+			as_error err;
+			as_error_init(&err);
+
+			as_operations ops;
+			as_operations_inita(&ops, entry->n_bins);
+			for (uint32_t j = 0; j < entry->n_bins; j++) {
+				as_operations_add_incr(&ops, entry->bins[j].name, entry->bins[j].delta);
+			}
+
+			as_record * rec = NULL;
+			if (!self->client->as || !self->client->is_conn_16) {
+				as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+			} else {
+				aerospike_key_operate(self->client->as, &err, NULL, &entry->key, &ops, &rec);
+			}
+			if (rec) {
+				as_record_destroy(rec);
+			}
+			as_operations_destroy(&ops);
+			if (entry->pinned) {
+				as_near_cache_unpin(self->client->near_cache, &entry->key);
+			}
+
+			if (err.code != AEROSPIKE_OK && self->on_error) {
+				if (n_failures == failures_capacity) {
+					uint32_t capacity = failures_capacity ? failures_capacity * 2 : 8;
+					counter_failure * list = realloc(failures, capacity * sizeof(counter_failure));
+					if (!list) {
+						continue;
+					}
+					failures = list;
+					failures_capacity = capacity;
+				}
+				failures[n_failures].entry = entry;
+				as_error_init(&failures[n_failures].err);
+				as_error_copy(&failures[n_failures].err, &err);
+				n_failures++;
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&self->flush_lock);
+
+	// Reported without the flush lock, on_error may close the buffer.
+	if (n_failures) {
+		PyGILState_STATE gstate = PyGILState_Ensure();
+		for (uint32_t i = 0; i < n_failures; i++) {
+			counter_buffer_report(self, &failures[i].err, failures[i].entry);
+		}
+		PyGILState_Release(gstate);
+	}
+
+	free(failures);
+	as_counter_table_destroy(&pending);
+}
+
+/*
+ * Flush from the flush thread. on_error may drop the last reference to the
+ * buffer or close it, so one is held while flushing. Returns false if the
+ * buffer was deallocated or closed meanwhile, the thread must then exit
+ * without touching it: once the reference is dropped it may be freed.
+ */
+static bool counter_buffer_flush_held(AerospikeCounterBuffer * self)
+{
+	if (!self->on_error) {
+		counter_buffer_flush(self);
+		return true;
+	}
+
+	// Closing is set under the GIL before a dealloc releases it, so the
+	// buffer is still referenced if it is not closing.
+	PyGILState_STATE gstate = PyGILState_Ensure();
+	pthread_mutex_lock(&self->lock);
+	bool closing = self->closing;
+	pthread_mutex_unlock(&self->lock);
+	if (!closing) {
+		Py_INCREF(self);
+	}
+	PyGILState_Release(gstate);
+
+	if (closing) {
+		// close() writes the pending increments.
+		return true;
+	}
+
+	counter_buffer_flush(self);
+
+	gstate = PyGILState_Ensure();
+	pthread_mutex_lock(&self->lock);
+	closing = self->closing;
+	pthread_mutex_unlock(&self->lock);
+	bool last = Py_REFCNT(self) == 1;
+	Py_DECREF(self);
+	PyGILState_Release(gstate);
+	return !last && !closing;
+}
+
+static void * counter_buffer_run(void * udata)
+{
+	AerospikeCounterBuffer * self = (AerospikeCounterBuffer *) udata;
+
+	pthread_mutex_lock(&self->lock);
+
+	while (!self->closing) {
+		struct timespec deadline;
+		counter_buffer_deadline(&deadline, self->flush_interval_ms);
+
+		while (!self->closing && !self->flush_requested) {
+			int rc = self->flush_interval_ms ?
+					pthread_cond_timedwait(&self->cond, &self->lock, &deadline) :
+					pthread_cond_wait(&self->cond, &self->lock);
+			if (rc != 0) {
+				break;
+			}
+		}
+
+		if (self->closing) {
+			break;
+		}
+
+		self->flush_requested = false;
+		bool pending = self->table.n_entries > 0;
+		pthread_mutex_unlock(&self->lock);
+
+		if (pending && !counter_buffer_flush_held(self)) {
+			return NULL;
+		}
+
+		pthread_mutex_lock(&self->lock);
+	}
+
+	pthread_mutex_unlock(&self->lock);
+	return NULL;
+}
+
+/*
+ * Stop the flush thread and write what is left. Must be called with the GIL.
+ */
+static void counter_buffer_close(AerospikeCounterBuffer * self)
+{
+	pthread_mutex_lock(&self->lock);
+	bool closing = self->closing;
+	self->closing = true;
+	pthread_cond_broadcast(&self->cond);
+	pthread_mutex_unlock(&self->lock);
+
+	if (closing) {
+		return;
+	}
+
+	// The flush thread may wait for the GIL to report failures.
+	Py_BEGIN_ALLOW_THREADS
+	if (self->thread_started) {
+		// Closed by on_error, or deallocated, on the flush thread itself,
+		// which exits once this returns.
+		if (pthread_equal(self->thread, pthread_self())) {
+			pthread_detach(self->thread);
+		} else {
+			pthread_join(self->thread, NULL);
+		}
+		self->thread_started = false;
+	}
+	counter_buffer_flush(self);
+	Py_END_ALLOW_THREADS
+}
+
+/*
+ * Without an interval or a threshold, increments are only written by flush(),
+ * and there is no flush thread.
+ */
+static bool counter_buffer_start(AerospikeCounterBuffer * self, as_error * err)
+{
+	self->fork_generation = as_fork_generation;
+
+	if (!self->flush_interval_ms && !self->max_keys) {
+		return true;
+	}
+	if (pthread_create(&self->thread, NULL, counter_buffer_run, self) != 0) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to start the counter buffer flush thread");
+		return false;
+	}
+	self->thread_started = true;
+	return true;
+}
+
+/*
+ * The flush thread of a buffer created before a fork does not exist in the
+ * child, and may have held the locks. The pending increments are the
+ * parent's to write, so they are dropped here, and the flush thread is
+ * started again if restart is set and the buffer is open. Must be called
+ * with the GIL.
+ */
+static void counter_buffer_after_fork(AerospikeCounterBuffer * self, bool restart)
+{
+	if (self->fork_generation == as_fork_generation) {
+		return;
+	}
+
+	pthread_mutex_init(&self->lock, NULL);
+	pthread_mutex_init(&self->flush_lock, NULL);
+	pthread_cond_init(&self->cond, NULL);
+	self->flush_requested = false;
+	self->thread_started = false;
+
+	// Their pins are forgotten with the parent's, see as_near_cache_after_fork().
+	as_counter_table_destroy(&self->table);
+	if (!as_counter_table_init(&self->table, COUNTER_TABLE_BUCKETS)) {
+		self->closing = true;
+	}
+
+	if (!restart || self->closing) {
+		self->fork_generation = as_fork_generation;
+		return;
+	}
+
+	AerospikeClient_Fork_Ready(self->client);
+	as_error err;
+	as_error_init(&err);
+	if (!counter_buffer_start(self, &err)) {
+		self->closing = true;
+	}
+}
+
+/*
+ * Write the pending increments and close the buffer before the client closes
+ * its cluster.
+ */
+static void counter_buffer_stop(PyObject * py_buffer)
+{
+	AerospikeCounterBuffer * self = (AerospikeCounterBuffer *) py_buffer;
+
+	counter_buffer_after_fork(self, false);
+	counter_buffer_close(self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+PyDoc_STRVAR(increment_doc,
+"increment(key, bin[, offset]) -> None\n\
+\n\
+Add offset, 1 by default, to the pending increment of bin in the record of key. \
+It is written by the next flush.");
+
+PyDoc_STRVAR(flush_doc,
+"flush() -> None\n\
+\n\
+Write the pending increments now, one operate command per key.");
+
+PyDoc_STRVAR(close_doc,
+"close() -> None\n\
+\n\
+Stop the flush thread and write the pending increments. Further increments raise an error.");
+
+static PyObject * AerospikeCounterBuffer_Increment(AerospikeCounterBuffer * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_key = NULL;
+	PyObject * py_bin = NULL;
+	PyObject * py_ustr = NULL;
+	long long offset = 1;
+	char * bin = NULL;
+	as_key key;
+	bool key_initialised = false;
+
+	static char * kwlist[] = {"key", "bin", "offset", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|L:increment", kwlist, &py_key, &py_bin, &offset) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (string_and_pyuni_from_pystring(py_bin, &py_ustr, &bin, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	if (strlen(bin) >= AS_BIN_NAME_MAX_SIZE) {
+		as_error_update(&err, AEROSPIKE_ERR_BIN_NAME, "A bin name should not exceed 14 characters limit");
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_key(&err, py_key, &key) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	key_initialised = true;
+
+	if (!as_key_digest(&key)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Unable to compute the digest of the key");
+		goto CLEANUP;
+	}
+	// The flush thread can not take the GIL, so the cached record is dropped
+	// when buffered, and get() does not cache it again until flushed.
+	as_near_cache_invalidate(self->client->near_cache, &key);
+
+	pthread_mutex_lock(&self->lock);
+	as_counter_entry * entry = NULL;
+	if (self->closing) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "The counter buffer is closed");
+	} else if (!(entry = as_counter_table_add(&self->table, &key, bin, (int64_t) offset))) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for the counter");
+	} else {
+		// Pinned before a flush may take the entry, and unpinned by it.
+		if (!entry->pinned) {
+			as_near_cache_pin(self->client->near_cache, &key);
+			entry->pinned = true;
+		}
+		if (self->max_keys && self->table.n_entries >= self->max_keys && !self->flush_requested) {
+			self->flush_requested = true;
+			pthread_cond_signal(&self->cond);
+		}
+	}
+	pthread_mutex_unlock(&self->lock);
+
+CLEANUP:
+	if (key_initialised) {
+		as_key_destroy(&key);
+	}
+	Py_XDECREF(py_ustr);
+
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeCounterBuffer_Flush(AerospikeCounterBuffer * self)
+{
+	Py_BEGIN_ALLOW_THREADS
+	counter_buffer_flush(self);
+	Py_END_ALLOW_THREADS
+
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeCounterBuffer_Close(AerospikeCounterBuffer * self)
+{
+	counter_buffer_close(self);
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeCounterBuffer_Enter(AerospikeCounterBuffer * self)
+{
+	Py_INCREF(self);
+	return (PyObject *) self;
+}
+
+static PyObject * AerospikeCounterBuffer_Exit(AerospikeCounterBuffer * self, PyObject * args)
+{
+	counter_buffer_close(self);
+	Py_RETURN_FALSE;
+}
+
+static Py_ssize_t AerospikeCounterBuffer_Length(AerospikeCounterBuffer * self)
+{
+	counter_buffer_after_fork(self, true);
+
+	pthread_mutex_lock(&self->lock);
+	Py_ssize_t n_entries = (Py_ssize_t) self->table.n_entries;
+	pthread_mutex_unlock(&self->lock);
+	return n_entries;
+}
+
+static PyMethodDef AerospikeCounterBuffer_Type_Methods[] = {
+
+	{"increment",	(PyCFunction) AerospikeCounterBuffer_Increment,	METH_VARARGS | METH_KEYWORDS,
+				increment_doc},
+
+	{"flush",	(PyCFunction) AerospikeCounterBuffer_Flush,	METH_NOARGS,
+				flush_doc},
+
+	{"close",	(PyCFunction) AerospikeCounterBuffer_Close,	METH_NOARGS,
+				close_doc},
+
+	{"__enter__",	(PyCFunction) AerospikeCounterBuffer_Enter,	METH_NOARGS,
+				NULL},
+
+	{"__exit__",	(PyCFunction) AerospikeCounterBuffer_Exit,	METH_VARARGS,
+				NULL},
+
+	{NULL}
+};
+
+static PySequenceMethods AerospikeCounterBuffer_Type_Sequence = {
+	(lenfunc) AerospikeCounterBuffer_Length,    // sq_length
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static void AerospikeCounterBuffer_Type_Dealloc(AerospikeCounterBuffer * self)
+{
+	AerospikeClient_Unregister_Background(self->client, &self->background);
+	counter_buffer_after_fork(self, false);
+	counter_buffer_close(self);
+
+	as_counter_table_destroy(&self->table);
+	pthread_cond_destroy(&self->cond);
+	pthread_mutex_destroy(&self->lock);
+	pthread_mutex_destroy(&self->flush_lock);
+	Py_CLEAR(self->on_error);
+	Py_CLEAR(self->client);
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+/*
+ * Every method is looked up here, so a buffer created before a fork flushes
+ * again on its first use in the child.
+ */
+static PyObject * AerospikeCounterBuffer_Type_Getattro(AerospikeCounterBuffer * self, PyObject * py_name)
+{
+	counter_buffer_after_fork(self, true);
+	return PyObject_GenericGetAttr((PyObject *) self, py_name);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeCounterBuffer_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.CounterBuffer",          // tp_name
+	sizeof(AerospikeCounterBuffer),     // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikeCounterBuffer_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	0,                                  // tp_repr
+	0,                                  // tp_as_number
+	&AerospikeCounterBuffer_Type_Sequence,
+	                                    // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	(getattrofunc) AerospikeCounterBuffer_Type_Getattro,
+	                                    // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"Increments buffered by client.counter_buffer(), summed per key\n"
+	"and bin, and written as one operate command per key.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	AerospikeCounterBuffer_Type_Methods,
+	                                    // tp_methods
+	0,                                  // tp_members
+	0,                                  // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0,                                  // tp_new
+	0,                                  // tp_free
+	0,                                  // tp_is_gc
+	0                                   // tp_bases
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeCounterBuffer_Ready()
+{
+	return PyType_Ready(&AerospikeCounterBuffer_Type) == 0 ? &AerospikeCounterBuffer_Type : NULL;
+}
+
+AerospikeCounterBuffer * AerospikeCounterBuffer_New(AerospikeClient * client, as_error * err,
+		uint32_t flush_interval_ms, uint32_t max_keys, PyObject * on_error)
+{
+	AerospikeCounterBuffer * self = PyObject_New(AerospikeCounterBuffer, &AerospikeCounterBuffer_Type);
+	if (!self) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the counter buffer");
+		return NULL;
+	}
+
+	Py_INCREF(client);
+	self->client = client;
+	self->on_error = on_error != Py_None ? on_error : NULL;
+	Py_XINCREF(self->on_error);
+	self->flush_interval_ms = flush_interval_ms;
+	self->max_keys = max_keys;
+	self->flush_requested = false;
+	self->closing = false;
+	self->thread_started = false;
+	self->fork_generation = as_fork_generation;
+	self->background.py_obj = NULL;
+	pthread_mutex_init(&self->lock, NULL);
+	pthread_mutex_init(&self->flush_lock, NULL);
+	pthread_cond_init(&self->cond, NULL);
+
+	if (!as_counter_table_init(&self->table, COUNTER_TABLE_BUCKETS)) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the counter buffer");
+		Py_DECREF(self);
+		return NULL;
+	}
+
+	if (AerospikeClient_Register_Background(client, err, &self->background, (PyObject *) self,
+			counter_buffer_stop) != AEROSPIKE_OK || !counter_buffer_start(self, err)) {
+		Py_DECREF(self);
+		return NULL;
+	}
+
+	return self;
+}
@@ -232,6 +232,14 @@ PyObject * AerospikeException_New(void)
 	PyObject_SetAttrString(exceptions_array.ElementExistsError, "code", py_code);
 	Py_DECREF(py_code);
 
+	// FilteredOut , AEROSPIKE_FILTERED_OUT, 27
+	exceptions_array.FilteredOut = PyErr_NewException("exception.FilteredOut", exceptions_array.ServerError, NULL);
+	Py_INCREF(exceptions_array.FilteredOut);
+	PyModule_AddObject(module, "FilteredOut", exceptions_array.FilteredOut);
+	py_code = PyInt_FromLong(AEROSPIKE_FILTERED_OUT);
+	PyObject_SetAttrString(exceptions_array.FilteredOut, "code", py_code);
+	Py_DECREF(py_code);
+
 	// BatchDisabledError , AEROSPIKE_ERR_BATCH_DISABLED, 150
 	exceptions_array.BatchDisabledError = PyErr_NewException("exception.BatchDisabledError", exceptions_array.ServerError, NULL);
 	Py_INCREF(exceptions_array.BatchDisabledError);
@@ -103,6 +103,7 @@ AerospikeGlobalHosts * AerospikeGobalHosts_New(aerospike* as)
 	self->as = as;
 	self->shm_key = as->config.shm_key;
 	self->ref_cnt = 1;
+	self->fork_generation = as_fork_generation;
 	Py_INCREF((PyObject*) self);
 	return self;
 }
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+
+#include "hll.h"
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+PyTypeObject AerospikeHyperLogLog_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.HyperLogLog",            // tp_name
+	0,                                  // tp_basicsize, from bytes
+	0,                                  // tp_itemsize, from bytes
+	0,                                  // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	0,                                  // tp_repr
+	0,                                  // tp_as_number
+	0,                                  // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	0,                                  // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"HyperLogLog(bytes)\n"
+	"\n"
+	"The value of an HLL bin, to be used with the HLL operations.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	0,                                  // tp_methods
+	0,                                  // tp_members
+	0,                                  // tp_getset
+	0,                                  // tp_base, set by AerospikeHyperLogLog_Ready()
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0                                   // tp_new
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeHyperLogLog_Ready()
+{
+	AerospikeHyperLogLog_Type.tp_base = &PyBytes_Type;
+	return PyType_Ready(&AerospikeHyperLogLog_Type) == 0 ? &AerospikeHyperLogLog_Type : NULL;
+}
+
+PyObject * AerospikeHyperLogLog_New(const uint8_t * value, uint32_t size)
+{
+	PyObject * py_bytes = PyBytes_FromStringAndSize((const char *) value, size);
+	if (!py_bytes) {
+		return NULL;
+	}
+
+	PyObject * py_hll = PyObject_CallFunctionObjArgs((PyObject *) &AerospikeHyperLogLog_Type, py_bytes, NULL);
+	Py_DECREF(py_bytes);
+	return py_hll;
+}
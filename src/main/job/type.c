@@ -0,0 +1,911 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/time.h>
+
+#include <aerospike/aerospike_index.h>
+#include <aerospike/aerospike_info.h>
+#include <aerospike/aerospike_job.h>
+#include <aerospike/as_cluster.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_node.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "job.h"
+#include "macros.h"
+
+#define PROGRESS_PCT "progress_pct"
+#define RECORDS_READ "records_read"
+#define STATUS "status"
+
+// Poll intervals, doubled after each poll of a running job
+#define JOB_POLL_INITIAL_MS 100
+#define JOB_POLL_MAX_MS 5000
+
+#define INDEX_LOAD_PCT "load_pct="
+
+/*******************************************************************************
+ * POLLING
+ ******************************************************************************/
+
+typedef struct {
+	aerospike * as;
+	const as_policy_info * policy;
+	as_node * node;
+	const char * request;
+	pthread_t thread;
+	bool started;
+	as_error err;
+	char * response;
+} job_node_request;
+
+static void * job_node_run(void * udata)
+{
+	job_node_request * req = (job_node_request *) udata;
+	aerospike_info_node(req->as, &req->err, req->policy, req->node, req->request, &req->response);
+	return NULL;
+}
+
+/*
+ * Send request to every node at once, each from a thread of its own, so a
+ * poll takes as long as the slowest node rather than all of them in turn.
+ * callback is then called with each node's response or error, in order.
+ * Fails with the error of the first node if no node answered.
+ */
+static as_status job_info_nodes(AerospikeJob * self, as_error * err, const char * request,
+		aerospike_info_foreach_callback callback, void * udata)
+{
+	// The client's cluster, which replaces the task's in a forked child.
+	aerospike * as = self->client->as;
+	if (!as->cluster) {
+		return as_error_update(err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+	}
+
+	as_nodes * nodes = as_nodes_reserve(as->cluster);
+	if (nodes->size == 0) {
+		as_nodes_release(nodes);
+		return as_error_update(err, AEROSPIKE_ERR_CLUSTER, "Cluster is empty");
+	}
+
+	job_node_request * reqs = calloc(nodes->size, sizeof(job_node_request));
+	if (!reqs) {
+		as_nodes_release(nodes);
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the job requests");
+	}
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		job_node_request * req = &reqs[i];
+		req->as = as;
+		req->policy = &self->policy;
+		req->node = nodes->array[i];
+		req->request = request;
+		as_error_init(&req->err);
+		req->started = pthread_create(&req->thread, NULL, job_node_run, req) == 0;
+	}
+
+	uint32_t n_answered = 0;
+
+	for (uint32_t i = 0; i < nodes->size; i++) {
+		job_node_request * req = &reqs[i];
+		if (req->started) {
+			pthread_join(req->thread, NULL);
+		}
+		else {
+			job_node_run(req);
+		}
+
+		if (req->err.code == AEROSPIKE_OK || req->err.code == AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+			n_answered++;
+		}
+		callback(&req->err, req->node, request, req->response, udata);
+		free(req->response);
+	}
+
+	if (!n_answered) {
+		as_error_copy(err, &reqs[0].err);
+	}
+
+	free(reqs);
+	as_nodes_release(nodes);
+	return err->code;
+}
+
+typedef struct {
+	uint32_t min_pct;
+	uint32_t nodes;
+} index_progress;
+
+static bool index_status_node(const as_error * err, const as_node * node,
+		const char * req, char * res, void * udata)
+{
+	index_progress * progress = (index_progress *) udata;
+
+	if (err && err->code != AEROSPIKE_OK) {
+		progress->min_pct = 0;
+		return true;
+	}
+
+	// A node that has not started the build does not report load_pct yet.
+	uint32_t pct = 0;
+	char * found = res ? strstr(res, INDEX_LOAD_PCT) : NULL;
+	if (found) {
+		pct = (uint32_t) atoi(found + strlen(INDEX_LOAD_PCT));
+	}
+	if (pct < progress->min_pct) {
+		progress->min_pct = pct;
+	}
+	progress->nodes++;
+	return true;
+}
+
+/*
+ * Index builds are polled through the sindex info command on every node,
+ * the job is as far along as the slowest node.
+ */
+static as_status index_job_info(AerospikeJob * self, as_error * err, as_job_info * info)
+{
+	char request[256];
+	snprintf(request, sizeof(request), "sindex/%s/%s", self->task.ns, self->task.name);
+
+	index_progress progress = {100, 0};
+	if (job_info_nodes(self, err, request, index_status_node, &progress) != AEROSPIKE_OK) {
+		return err->code;
+	}
+
+	info->progress_pct = progress.nodes ? progress.min_pct : 0;
+	info->records_read = 0;
+	info->status = info->progress_pct == 100 ? AS_JOB_STATUS_COMPLETED : AS_JOB_STATUS_INPROGRESS;
+	return AEROSPIKE_OK;
+}
+
+static const char * job_field(const char * token, const char * name)
+{
+	size_t len = strlen(name);
+	return strncmp(token, name, len) == 0 ? token + len : NULL;
+}
+
+/*
+ * Folds a node's part of a scan or query job in info, as aerospike_job_info()
+ * does: the job runs while a node runs it, is as far along as the slowest
+ * node, and has read the records read by all of them. The fields are named
+ * with dashes by newer servers, with underscores by older ones.
+ */
+static bool job_status_node(const as_error * err, const as_node * node,
+		const char * req, char * res, void * udata)
+{
+	as_job_info * info = (as_job_info *) udata;
+
+	// A node which finished the job long ago, or joined since, does not know it.
+	if (err && err->code == AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+		return true;
+	}
+	if ((err && err->code != AEROSPIKE_OK) || !res) {
+		info->status = AS_JOB_STATUS_INPROGRESS;
+		return true;
+	}
+
+	char * value = strchr(res, '\t');
+	value = value ? value + 1 : res;
+	if (strncmp(value, "ERROR", 5) == 0) {
+		return true;
+	}
+
+	char * save = NULL;
+	for (char * token = strtok_r(value, ":;\n", &save); token; token = strtok_r(NULL, ":;\n", &save)) {
+		const char * field = NULL;
+
+		if ((field = job_field(token, "status=")) || (field = job_field(token, "job_status="))) {
+			if (strncasecmp(field, "done", 4) != 0) {
+				info->status = AS_JOB_STATUS_INPROGRESS;
+			}
+		}
+		else if ((field = job_field(token, "job-progress=")) || (field = job_field(token, "job_progress(%)="))) {
+			uint32_t pct = (uint32_t) atoi(field);
+			if (pct < info->progress_pct) {
+				info->progress_pct = pct;
+			}
+		}
+		else if ((field = job_field(token, "recs-read=")) || (field = job_field(token, "recs_read="))) {
+			info->records_read += (uint64_t) strtoull(field, NULL, 10);
+		}
+	}
+	return true;
+}
+
+static as_status job_poll(AerospikeJob * self, as_error * err, as_job_info * info)
+{
+	if (strcmp(self->module, JOB_MODULE_SINDEX) == 0) {
+		return index_job_info(self, err, info);
+	}
+
+	char request[128];
+	snprintf(request, sizeof(request), "jobs:module=%s;cmd=get-job;trid=%llu", self->module,
+			(unsigned long long) self->job_id);
+
+	// Completed unless a node still runs it.
+	info->status = AS_JOB_STATUS_COMPLETED;
+	info->progress_pct = 100;
+	info->records_read = 0;
+	return job_info_nodes(self, err, request, job_status_node, info);
+}
+
+static void job_deadline(struct timespec * ts, uint32_t ms)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	uint64_t ns = (uint64_t) now.tv_usec * 1000 + (uint64_t) ms * 1000000;
+	ts->tv_sec = now.tv_sec + (time_t) (ns / 1000000000);
+	ts->tv_nsec = (long) (ns % 1000000000);
+}
+
+static PyObject * job_progress_to_pyobject(as_job_info * info)
+{
+	PyObject * py_progress = PyDict_New();
+	if (!py_progress) {
+		return NULL;
+	}
+
+	PyObject * py_longobject = PyLong_FromLong(info->progress_pct);
+	PyDict_SetItemString(py_progress, PROGRESS_PCT, py_longobject);
+	Py_XDECREF(py_longobject);
+	py_longobject = PyLong_FromLong(info->records_read);
+	PyDict_SetItemString(py_progress, RECORDS_READ, py_longobject);
+	Py_XDECREF(py_longobject);
+	py_longobject = PyLong_FromLong(info->status);
+	PyDict_SetItemString(py_progress, STATUS, py_longobject);
+	Py_XDECREF(py_longobject);
+
+	return py_progress;
+}
+
+static PyObject * job_error_to_pyobject(as_error * err)
+{
+	PyObject * py_err = NULL;
+	error_to_pyobject(err, &py_err);
+	PyObject * exception_type = raise_exception(err);
+	PyObject * py_exception = PyObject_CallObject(exception_type, py_err);
+	Py_DECREF(py_err);
+	return py_exception;
+}
+
+/*
+ * Resolves a future on its event loop's thread, scheduled by call_soon_threadsafe.
+ */
+static PyObject * job_resolve_future(PyObject * module, PyObject * args)
+{
+	PyObject * py_future = NULL;
+	PyObject * py_result = NULL;
+	PyObject * py_is_error = NULL;
+
+	if (PyArg_ParseTuple(args, "OOO", &py_future, &py_result, &py_is_error) == false) {
+		return NULL;
+	}
+
+	// The awaiting coroutine may have been cancelled meanwhile.
+	PyObject * py_done = PyObject_CallMethod(py_future, "done", NULL);
+	if (!py_done) {
+		return NULL;
+	}
+	int done = PyObject_IsTrue(py_done);
+	Py_DECREF(py_done);
+
+	if (!done) {
+		PyObject * py_ret = PyObject_CallMethod(py_future,
+				PyObject_IsTrue(py_is_error) ? "set_exception" : "set_result", "O", py_result);
+		if (!py_ret) {
+			return NULL;
+		}
+		Py_DECREF(py_ret);
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef job_resolve_future_def = {
+	"_resolve_job_future", (PyCFunction) job_resolve_future, METH_VARARGS, NULL
+};
+
+static void job_resolve_waiter(PyObject * py_waiter, PyObject * py_result, bool is_error)
+{
+	PyObject * py_loop = PyTuple_GetItem(py_waiter, 0);
+	PyObject * py_future = PyTuple_GetItem(py_waiter, 1);
+
+	PyObject * py_resolve = PyCFunction_New(&job_resolve_future_def, NULL);
+	if (py_resolve) {
+		PyObject * py_ret = PyObject_CallMethod(py_loop, "call_soon_threadsafe", "OOOO",
+				py_resolve, py_future, py_result, is_error ? Py_True : Py_False);
+		Py_XDECREF(py_ret);
+		Py_DECREF(py_resolve);
+	}
+
+	// The loop may be closed already, nothing is waiting on it then.
+	PyErr_Clear();
+}
+
+typedef struct {
+	PyObject * py_waiters;
+	as_error err;
+	as_job_info info;
+} job_waiters;
+
+/*
+ * Takes the waiters out of a done job, to resolve them once the job lock is
+ * released. Must be called with the GIL and the job lock held.
+ */
+static void job_take_waiters(AerospikeJob * self, job_waiters * waiters)
+{
+	waiters->py_waiters = self->py_waiters;
+	self->py_waiters = NULL;
+	as_error_init(&waiters->err);
+	as_error_copy(&waiters->err, &self->err);
+	waiters->info = self->info;
+}
+
+/*
+ * Must be called with the GIL held, and without the job lock, since the
+ * event loops may run Python code. The waiters may hold the last references
+ * to the job.
+ */
+static void job_resolve_waiters(job_waiters * waiters)
+{
+	if (!waiters->py_waiters) {
+		return;
+	}
+
+	bool is_error = waiters->err.code != AEROSPIKE_OK;
+	PyObject * py_result = is_error ?
+			job_error_to_pyobject(&waiters->err) : job_progress_to_pyobject(&waiters->info);
+
+	if (py_result) {
+		for (Py_ssize_t i = 0; i < PyList_Size(waiters->py_waiters); i++) {
+			job_resolve_waiter(PyList_GetItem(waiters->py_waiters, i), py_result, is_error);
+		}
+		Py_DECREF(py_result);
+	}
+	PyErr_Clear();
+	Py_CLEAR(waiters->py_waiters);
+}
+
+static void * job_run(void * udata)
+{
+	AerospikeJob * self = (AerospikeJob *) udata;
+	uint32_t interval_ms = JOB_POLL_INITIAL_MS;
+
+	while (true) {
+		as_error err;
+		as_error_init(&err);
+		as_job_info info;
+		memset(&info, 0, sizeof(as_job_info));
+
+		job_poll(self, &err, &info);
+
+		pthread_mutex_lock(&self->lock);
+		if (err.code != AEROSPIKE_OK) {
+			as_error_copy(&self->err, &err);
+			self->done = true;
+		}
+		else {
+			self->info = info;
+			self->done = info.status == AS_JOB_STATUS_COMPLETED;
+		}
+
+		if (self->done) {
+			pthread_cond_broadcast(&self->cond);
+			pthread_mutex_unlock(&self->lock);
+			break;
+		}
+
+		// Back off, unless the job is dropped meanwhile.
+		struct timespec deadline;
+		job_deadline(&deadline, interval_ms);
+		while (!self->cancelled) {
+			if (pthread_cond_timedwait(&self->cond, &self->lock, &deadline) != 0) {
+				break;
+			}
+		}
+		bool cancelled = self->cancelled;
+		pthread_mutex_unlock(&self->lock);
+
+		if (cancelled) {
+			return NULL;
+		}
+
+		interval_ms = interval_ms * 2 < JOB_POLL_MAX_MS ? interval_ms * 2 : JOB_POLL_MAX_MS;
+	}
+
+	// Wake the coroutines awaiting the job. The job may be freed once they are
+	// resolved, it is not used after.
+	PyGILState_STATE gstate = PyGILState_Ensure();
+	job_waiters waiters;
+	pthread_mutex_lock(&self->lock);
+	job_take_waiters(self, &waiters);
+	pthread_mutex_unlock(&self->lock);
+	job_resolve_waiters(&waiters);
+	PyGILState_Release(gstate);
+
+	return NULL;
+}
+
+static bool job_start(AerospikeJob * self, as_error * err)
+{
+	if (pthread_create(&self->thread, NULL, job_run, self) != 0) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to start the job polling thread");
+		return false;
+	}
+	self->started = true;
+	self->fork_generation = as_fork_generation;
+	return true;
+}
+
+/*
+ * The polling thread of a job created before a fork does not exist in the
+ * child, and may have held the lock. Forget it, and poll from a new thread
+ * if restart is set and the job is not done.
+ */
+static void job_after_fork(AerospikeJob * self, bool restart)
+{
+	if (!self->started || self->fork_generation == as_fork_generation) {
+		return;
+	}
+
+	pthread_mutex_init(&self->lock, NULL);
+	pthread_cond_init(&self->cond, NULL);
+	self->started = false;
+	self->cancelled = false;
+
+	if (restart && !self->done) {
+		AerospikeClient_Fork_Ready(self->client);
+		as_error err;
+		as_error_init(&err);
+		if (!job_start(self, &err)) {
+			as_error_copy(&self->err, &err);
+			self->done = true;
+		}
+	}
+}
+
+/*
+ * Stop polling before the client closes its cluster. A job still running
+ * fails, and the coroutines awaiting it are resumed with the error.
+ */
+static void job_stop(PyObject * py_job)
+{
+	AerospikeJob * self = (AerospikeJob *) py_job;
+
+	job_after_fork(self, false);
+
+	if (self->started) {
+		// The polling thread may wait for the GIL to wake awaiting coroutines.
+		Py_BEGIN_ALLOW_THREADS
+		pthread_mutex_lock(&self->lock);
+		self->cancelled = true;
+		pthread_cond_broadcast(&self->cond);
+		pthread_mutex_unlock(&self->lock);
+		pthread_join(self->thread, NULL);
+		Py_END_ALLOW_THREADS
+		self->started = false;
+	}
+
+	job_waiters waiters;
+	pthread_mutex_lock(&self->lock);
+	if (!self->done) {
+		as_error_update(&self->err, AEROSPIKE_ERR_CLIENT, "The client was closed before the job completed");
+		self->done = true;
+		pthread_cond_broadcast(&self->cond);
+	}
+	job_take_waiters(self, &waiters);
+	pthread_mutex_unlock(&self->lock);
+	job_resolve_waiters(&waiters);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+PyDoc_STRVAR(wait_doc,
+"wait([timeout]) -> bool\n\
+\n\
+Wait for the job to complete, for at most timeout seconds. Returns whether the job completed.");
+
+PyDoc_STRVAR(progress_doc,
+"progress() -> dict\n\
+\n\
+Return the last polled progress of the job, without a round trip to the cluster.");
+
+PyDoc_STRVAR(done_doc,
+"done() -> bool\n\
+\n\
+Return whether the job has completed.");
+
+static bool job_raise_error(AerospikeJob * self)
+{
+	as_error err;
+	as_error_init(&err);
+
+	pthread_mutex_lock(&self->lock);
+	if (self->err.code != AEROSPIKE_OK) {
+		as_error_copy(&err, &self->err);
+	}
+	pthread_mutex_unlock(&self->lock);
+
+	if (err.code == AEROSPIKE_OK) {
+		return false;
+	}
+
+	PyObject * py_err = NULL;
+	error_to_pyobject(&err, &py_err);
+	PyObject *exception_type = raise_exception(&err);
+	PyErr_SetObject(exception_type, py_err);
+	Py_DECREF(py_err);
+	return true;
+}
+
+static PyObject * AerospikeJob_Wait(AerospikeJob * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_timeout = NULL;
+	static char * kwlist[] = {"timeout", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|O:wait", kwlist, &py_timeout) == false) {
+		return NULL;
+	}
+
+	double timeout = -1;
+	if (py_timeout && py_timeout != Py_None) {
+		timeout = PyFloat_AsDouble(py_timeout);
+		if (PyErr_Occurred()) {
+			return NULL;
+		}
+		if (timeout < 0) {
+			timeout = 0;
+		}
+	}
+
+	bool done = false;
+
+	Py_BEGIN_ALLOW_THREADS
+	pthread_mutex_lock(&self->lock);
+	if (timeout < 0) {
+		while (!self->done) {
+			pthread_cond_wait(&self->cond, &self->lock);
+		}
+	}
+	else {
+		struct timespec deadline;
+		job_deadline(&deadline, (uint32_t) (timeout * 1000));
+		while (!self->done) {
+			if (pthread_cond_timedwait(&self->cond, &self->lock, &deadline) != 0) {
+				break;
+			}
+		}
+	}
+	done = self->done;
+	pthread_mutex_unlock(&self->lock);
+	Py_END_ALLOW_THREADS
+
+	if (job_raise_error(self)) {
+		return NULL;
+	}
+
+	return PyBool_FromLong(done);
+}
+
+static PyObject * AerospikeJob_Progress(AerospikeJob * self, PyObject * args)
+{
+	if (job_raise_error(self)) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&self->lock);
+	as_job_info info = self->info;
+	pthread_mutex_unlock(&self->lock);
+
+	return job_progress_to_pyobject(&info);
+}
+
+static PyObject * AerospikeJob_Done(AerospikeJob * self, PyObject * args)
+{
+	pthread_mutex_lock(&self->lock);
+	bool done = self->done;
+	pthread_mutex_unlock(&self->lock);
+
+	return PyBool_FromLong(done);
+}
+
+#if PY_MAJOR_VERSION >= 3
+/*
+ * await job resolves to the final progress, from the polling thread, so no
+ * executor thread is held while waiting. Each waiter holds a reference to the
+ * job, so awaiting a job that is not otherwise referenced keeps it polling.
+ */
+static PyObject * AerospikeJob_Await(AerospikeJob * self)
+{
+	job_after_fork(self, true);
+
+	PyObject * py_asyncio = PyImport_ImportModule("asyncio");
+	if (!py_asyncio) {
+		return NULL;
+	}
+	PyObject * py_loop = PyObject_CallMethod(py_asyncio, "get_event_loop", NULL);
+	Py_DECREF(py_asyncio);
+	if (!py_loop) {
+		return NULL;
+	}
+	PyObject * py_future = PyObject_CallMethod(py_loop, "create_future", NULL);
+	if (!py_future) {
+		Py_DECREF(py_loop);
+		return NULL;
+	}
+
+	PyObject * py_waiter = PyTuple_Pack(3, py_loop, py_future, (PyObject *) self);
+	Py_DECREF(py_loop);
+	if (!py_waiter) {
+		Py_DECREF(py_future);
+		return NULL;
+	}
+
+	job_waiters waiters;
+	waiters.py_waiters = NULL;
+
+	pthread_mutex_lock(&self->lock);
+	if (!self->py_waiters) {
+		self->py_waiters = PyList_New(0);
+	}
+	if (self->py_waiters) {
+		PyList_Append(self->py_waiters, py_waiter);
+	}
+	if (self->done) {
+		job_take_waiters(self, &waiters);
+	}
+	pthread_mutex_unlock(&self->lock);
+	Py_DECREF(py_waiter);
+
+	job_resolve_waiters(&waiters);
+
+	PyObject * py_iter = PyObject_CallMethod(py_future, "__await__", NULL);
+	Py_DECREF(py_future);
+	return py_iter;
+}
+
+static PyAsyncMethods AerospikeJob_Type_Async = {
+	(unaryfunc) AerospikeJob_Await,     // am_await
+	0,                                  // am_aiter
+	0                                   // am_anext
+};
+#endif
+
+static PyObject * AerospikeJob_Repr(AerospikeJob * self)
+{
+	if (strcmp(self->module, JOB_MODULE_SINDEX) == 0) {
+		return PyString_FromFormat("<aerospike.Job sindex %s.%s>", self->task.ns, self->task.name);
+	}
+	return PyString_FromFormat("<aerospike.Job %s %llu>", self->module,
+			(unsigned long long) self->job_id);
+}
+
+static PyObject * AerospikeJob_Get_Job_Id(AerospikeJob * self, void * closure)
+{
+	return PyLong_FromUnsignedLongLong(self->job_id);
+}
+
+static PyObject * AerospikeJob_Get_Module(AerospikeJob * self, void * closure)
+{
+	return PyString_FromString(self->module);
+}
+
+static PyMethodDef AerospikeJob_Type_Methods[] = {
+
+	{"wait",	(PyCFunction) AerospikeJob_Wait,	METH_VARARGS | METH_KEYWORDS,
+				wait_doc},
+
+	{"progress",	(PyCFunction) AerospikeJob_Progress,	METH_NOARGS,
+				progress_doc},
+
+	{"done",	(PyCFunction) AerospikeJob_Done,	METH_NOARGS,
+				done_doc},
+
+	{NULL}
+};
+
+static PyGetSetDef AerospikeJob_Type_GetSet[] = {
+	{"job_id", (getter) AerospikeJob_Get_Job_Id, NULL,
+		"Id of the background scan or query, 0 for an index build.", NULL},
+	{"module", (getter) AerospikeJob_Get_Module, NULL,
+		"aerospike.JOB_SCAN, aerospike.JOB_QUERY or 'sindex'.", NULL},
+	{NULL}
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static void AerospikeJob_Type_Dealloc(AerospikeJob * self)
+{
+	AerospikeClient_Unregister_Background(self->client, &self->background);
+	job_after_fork(self, false);
+
+	if (self->started && pthread_equal(self->thread, pthread_self())) {
+		// Freed by the polling thread resolving the last waiters, it is done.
+		pthread_detach(self->thread);
+	}
+	else if (self->started) {
+		// The polling thread may wait for the GIL to wake awaiting coroutines.
+		Py_BEGIN_ALLOW_THREADS
+		pthread_mutex_lock(&self->lock);
+		self->cancelled = true;
+		pthread_cond_broadcast(&self->cond);
+		pthread_mutex_unlock(&self->lock);
+		pthread_join(self->thread, NULL);
+		Py_END_ALLOW_THREADS
+	}
+
+	pthread_cond_destroy(&self->cond);
+	pthread_mutex_destroy(&self->lock);
+	Py_CLEAR(self->py_waiters);
+	Py_CLEAR(self->client);
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+/*
+ * Every method is looked up here, so a job created before a fork polls again
+ * on its first use in the child.
+ */
+static PyObject * AerospikeJob_Type_Getattro(AerospikeJob * self, PyObject * py_name)
+{
+	job_after_fork(self, true);
+	return PyObject_GenericGetAttr((PyObject *) self, py_name);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeJob_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.Job",                    // tp_name
+	sizeof(AerospikeJob),               // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikeJob_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+#if PY_MAJOR_VERSION >= 3
+	&AerospikeJob_Type_Async,           // tp_as_async
+#else
+	0,                                  // tp_compare
+#endif
+	(reprfunc) AerospikeJob_Repr,       // tp_repr
+	0,                                  // tp_as_number
+	0,                                  // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	(getattrofunc) AerospikeJob_Type_Getattro,
+	                                    // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"A background job on the cluster: a scan or query started with\n"
+	"scan_apply() or execute_background(), or a secondary index build.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	AerospikeJob_Type_Methods,          // tp_methods
+	0,                                  // tp_members
+	AerospikeJob_Type_GetSet,           // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0,                                  // tp_new
+	0,                                  // tp_free
+	0,                                  // tp_is_gc
+	0                                   // tp_bases
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeJob_Ready()
+{
+	return PyType_Ready(&AerospikeJob_Type) == 0 ? &AerospikeJob_Type : NULL;
+}
+
+static AerospikeJob * job_alloc(AerospikeClient * client, const as_policy_info * policy)
+{
+	AerospikeJob * self = PyObject_New(AerospikeJob, &AerospikeJob_Type);
+	if (!self) {
+		return NULL;
+	}
+
+	Py_INCREF(client);
+	self->client = client;
+	self->module[0] = '\0';
+	self->job_id = 0;
+	memset(&self->task, 0, sizeof(as_index_task));
+	self->policy = *policy;
+	self->started = false;
+	self->fork_generation = as_fork_generation;
+	self->done = false;
+	self->cancelled = false;
+	memset(&self->info, 0, sizeof(as_job_info));
+	self->info.status = AS_JOB_STATUS_INPROGRESS;
+	as_error_init(&self->err);
+	self->py_waiters = NULL;
+	self->background.py_obj = NULL;
+	pthread_mutex_init(&self->lock, NULL);
+	pthread_cond_init(&self->cond, NULL);
+	return self;
+}
+
+AerospikeJob * AerospikeJob_New(AerospikeClient * client, as_error * err, const char * module,
+		uint64_t job_id, const as_policy_info * policy)
+{
+	AerospikeJob * self = job_alloc(client, policy);
+	if (!self) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the job");
+		return NULL;
+	}
+
+	strncpy(self->module, module, sizeof(self->module) - 1);
+	self->module[sizeof(self->module) - 1] = '\0';
+	self->job_id = job_id;
+
+	if (AerospikeClient_Register_Background(client, err, &self->background, (PyObject *) self,
+			job_stop) != AEROSPIKE_OK || !job_start(self, err)) {
+		Py_DECREF(self);
+		return NULL;
+	}
+	return self;
+}
+
+AerospikeJob * AerospikeJob_New_Index(AerospikeClient * client, as_error * err, const as_index_task * task,
+		const as_policy_info * policy)
+{
+	AerospikeJob * self = job_alloc(client, policy);
+	if (!self) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the job");
+		return NULL;
+	}
+
+	strcpy(self->module, JOB_MODULE_SINDEX);
+	self->task = *task;
+
+	if (AerospikeClient_Register_Background(client, err, &self->background, (PyObject *) self,
+			job_stop) != AEROSPIKE_OK || !job_start(self, err)) {
+		Py_DECREF(self);
+		return NULL;
+	}
+	return self;
+}
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+
+#include "latency.h"
+
+static const char * latency_command_names[AS_LATENCY_COMMANDS] = {
+	"get", "put", "operate", "batch", "scan", "query", "apply", "info"
+};
+
+static const char * latency_phase_names[AS_LATENCY_PHASES] = {
+	"to_c", "in_c", "to_python"
+};
+
+const char * as_latency_command_name(as_latency_command command)
+{
+	return latency_command_names[command];
+}
+
+as_latency * as_latency_new(void)
+{
+	return calloc(1, sizeof(as_latency));
+}
+
+void as_latency_destroy(as_latency * latency)
+{
+	free(latency);
+}
+
+static void latency_bucket_bounds(uint32_t i, uint64_t * lower, uint64_t * upper)
+{
+	if (i < AS_LATENCY_SUB_BUCKETS) {
+		*lower = i;
+		*upper = i + 1;
+		return;
+	}
+
+	uint32_t shift = i / AS_LATENCY_SUB_BUCKETS - 1;
+	uint64_t sub = AS_LATENCY_SUB_BUCKETS + i % AS_LATENCY_SUB_BUCKETS;
+	*lower = sub << shift;
+	*upper = *lower + ((uint64_t) 1 << shift);
+	// The last bucket ends at the largest value.
+	if (*upper < *lower) {
+		*upper = UINT64_MAX;
+	}
+}
+
+uint64_t as_latency_percentile_ns(const as_latency_histogram * histogram, double percentile)
+{
+	uint64_t rank = (uint64_t) (histogram->count * percentile / 100);
+	uint64_t seen = 0;
+
+	for (uint32_t i = 0; i < AS_LATENCY_BUCKETS; i++) {
+		seen += histogram->buckets[i];
+		if (seen > rank) {
+			uint64_t lower, upper;
+			latency_bucket_bounds(i, &lower, &upper);
+			return upper;
+		}
+	}
+	return histogram->max_ns;
+}
+
+static PyObject * latency_histogram_to_pyobject(as_latency_histogram * histogram)
+{
+	PyObject * py_buckets = PyList_New(0);
+	if (!py_buckets) {
+		return NULL;
+	}
+
+	for (uint32_t i = 0; i < AS_LATENCY_BUCKETS; i++) {
+		if (!histogram->buckets[i]) {
+			continue;
+		}
+
+		uint64_t lower, upper;
+		latency_bucket_bounds(i, &lower, &upper);
+
+		PyObject * py_bucket = Py_BuildValue("(KKK)", (unsigned long long) lower,
+				(unsigned long long) upper, (unsigned long long) histogram->buckets[i]);
+		if (!py_bucket || PyList_Append(py_buckets, py_bucket) < 0) {
+			Py_XDECREF(py_bucket);
+			Py_DECREF(py_buckets);
+			return NULL;
+		}
+		Py_DECREF(py_bucket);
+	}
+
+	return Py_BuildValue("{s:K,s:K,s:K,s:N}",
+			"count", (unsigned long long) histogram->count,
+			"total_ns", (unsigned long long) histogram->total_ns,
+			"max_ns", (unsigned long long) histogram->max_ns,
+			"buckets", py_buckets);
+}
+
+PyObject * as_latency_to_pyobject(as_error * err, as_latency * latency, bool reset)
+{
+	PyObject * py_latency = PyDict_New();
+	if (!py_latency) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the histograms");
+		return NULL;
+	}
+
+	// A client without histograms has none to report.
+	if (!latency) {
+		return py_latency;
+	}
+
+	for (int c = 0; c < AS_LATENCY_COMMANDS; c++) {
+		PyObject * py_command = PyDict_New();
+		if (!py_command || PyDict_SetItemString(py_latency, latency_command_names[c], py_command) < 0) {
+			Py_XDECREF(py_command);
+			goto ERROR;
+		}
+		Py_DECREF(py_command);
+
+		for (int p = 0; p < AS_LATENCY_PHASES; p++) {
+			PyObject * py_histogram = latency_histogram_to_pyobject(&latency->histograms[c][p]);
+			if (!py_histogram || PyDict_SetItemString(py_command, latency_phase_names[p], py_histogram) < 0) {
+				Py_XDECREF(py_histogram);
+				goto ERROR;
+			}
+			Py_DECREF(py_histogram);
+		}
+	}
+
+	// Commands only record with the GIL held, so none is lost between the copy and the reset.
+	if (reset) {
+		memset(latency, 0, sizeof(as_latency));
+	}
+
+	return py_latency;
+
+ERROR:
+	PyErr_Clear();
+	Py_DECREF(py_latency);
+	as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to convert the histograms");
+	return NULL;
+}
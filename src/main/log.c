@@ -15,7 +15,11 @@
  ******************************************************************************/
 
 #include <Python.h>
+#include <pthread.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
 
 #include <aerospike/as_error.h>
 #include <aerospike/as_log.h>
@@ -111,50 +115,270 @@ CLEANUP:
 	return PyLong_FromLong(status);
 }
 
+/*
+ * Log lines are queued in a bounded ring buffer by the C client threads,
+ * without the GIL, and handed to the user callback in batches by a single
+ * drain thread. A line is dropped when the ring is full, rather than
+ * blocking the tend and command threads on the GIL.
+ *
+ * The ring is the bounded multi-producer queue of Dmitry Vyukov: each slot
+ * has a sequence, which tells producers it is free and the consumer it is
+ * written.
+ */
+
+#define LOG_RING_SIZE 1024
+#define LOG_BATCH_SIZE 256
+#define LOG_MESSAGE_SIZE 1024
+// Sleep of the drain thread when the ring is empty
+#define LOG_POLL_INTERVAL_NS 10000000
+
+typedef struct {
+	uint64_t sequence;
+	as_log_level level;
+	// The C client passes literals, so they are not copied.
+	const char * func;
+	const char * file;
+	uint32_t line;
+	char message[LOG_MESSAGE_SIZE];
+} log_slot;
+
+static log_slot log_ring[LOG_RING_SIZE];
+static uint64_t log_enqueue_pos;
+static uint64_t log_dequeue_pos;
+static uint64_t log_dropped;
+static uint64_t log_dropped_reported;
+
+static pthread_t log_thread;
+static bool log_thread_started = false;
+static volatile bool log_stopping = false;
+static uint32_t log_thread_generation;
+static bool log_atexit_registered = false;
+
+static void log_ring_init(void)
+{
+	for (uint64_t i = 0; i < LOG_RING_SIZE; i++) {
+		__atomic_store_n(&log_ring[i].sequence, i, __ATOMIC_RELAXED);
+	}
+	__atomic_store_n(&log_enqueue_pos, 0, __ATOMIC_RELAXED);
+	log_dequeue_pos = 0;
+}
+
+/*
+ * Reserve a slot, NULL if the ring is full.
+ */
+static log_slot * log_ring_reserve(uint64_t * pos_p)
+{
+	uint64_t pos = __atomic_load_n(&log_enqueue_pos, __ATOMIC_RELAXED);
+
+	while (true) {
+		log_slot * slot = &log_ring[pos % LOG_RING_SIZE];
+		uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+		int64_t diff = (int64_t) sequence - (int64_t) pos;
+
+		if (diff == 0) {
+			if (__atomic_compare_exchange_n(&log_enqueue_pos, &pos, pos + 1, true,
+					__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				*pos_p = pos;
+				return slot;
+			}
+			// pos was reloaded by the failed exchange.
+		} else if (diff < 0) {
+			return NULL;
+		} else {
+			pos = __atomic_load_n(&log_enqueue_pos, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+/*
+ * The next written slot, NULL if there is none. Only the drain thread, or
+ * the thread which stopped it, takes slots.
+ */
+static log_slot * log_ring_peek(void)
+{
+	log_slot * slot = &log_ring[log_dequeue_pos % LOG_RING_SIZE];
+	uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+
+	return sequence == log_dequeue_pos + 1 ? slot : NULL;
+}
+
+static void log_ring_release(log_slot * slot)
+{
+	__atomic_store_n(&slot->sequence, log_dequeue_pos + LOG_RING_SIZE, __ATOMIC_RELEASE);
+	log_dequeue_pos++;
+}
+
+static void log_call(PyObject * py_callback, as_log_level level, const char * func,
+		const char * file, uint32_t line, const char * message)
+{
+	PyObject * py_result = PyObject_CallFunction(py_callback, "issIs", (int) level,
+			func, file, line, message);
+
+	if (!py_result) {
+		PyErr_WriteUnraisable(py_callback);
+	}
+	Py_XDECREF(py_result);
+}
+
+/*
+ * Hand up to LOG_BATCH_SIZE lines to the user callback, the GIL must be held.
+ * Returns the number of lines taken.
+ */
+static uint32_t log_drain(void)
+{
+	uint32_t n = 0;
+	// The callback may be replaced while it runs.
+	PyObject * py_callback = user_callback.callback;
+	Py_XINCREF(py_callback);
+
+	uint64_t dropped = __atomic_load_n(&log_dropped, __ATOMIC_RELAXED);
+	if (dropped != log_dropped_reported && py_callback) {
+		char message[64];
+		snprintf(message, sizeof(message), "%llu log lines dropped",
+				(unsigned long long) (dropped - log_dropped_reported));
+		log_call(py_callback, AS_LOG_LEVEL_WARN, "log_drain", __FILE__, __LINE__, message);
+		log_dropped_reported = dropped;
+	}
+
+	log_slot * slot;
+	while (n < LOG_BATCH_SIZE && (slot = log_ring_peek())) {
+		if (py_callback) {
+			log_call(py_callback, slot->level, slot->func, slot->file, slot->line, slot->message);
+		}
+		log_ring_release(slot);
+		n++;
+	}
+
+	Py_XDECREF(py_callback);
+	return n;
+}
+
+static void * log_run(void * udata)
+{
+	while (!log_stopping) {
+		if (!log_ring_peek()) {
+			struct timespec ts = {0, LOG_POLL_INTERVAL_NS};
+			nanosleep(&ts, NULL);
+			continue;
+		}
+
+		PyGILState_STATE gstate = PyGILState_Ensure();
+		log_drain();
+		PyGILState_Release(gstate);
+	}
+
+	return NULL;
+}
+
+static bool log_thread_start(void)
+{
+	log_stopping = false;
+	log_thread_generation = as_fork_generation;
+	log_thread_started = pthread_create(&log_thread, NULL, log_run, NULL) == 0;
+	return log_thread_started;
+}
+
+/*
+ * Stop the drain thread and hand it the remaining lines, the GIL must be held.
+ */
+static void log_thread_stop(void)
+{
+	if (!log_thread_started) {
+		return;
+	}
+
+	log_stopping = true;
+	// The thread of the parent process does not exist in a forked child.
+	if (log_thread_generation == as_fork_generation) {
+		Py_BEGIN_ALLOW_THREADS
+		pthread_join(log_thread, NULL);
+		Py_END_ALLOW_THREADS
+	}
+	log_thread_started = false;
+
+	while (log_drain()) {
+	}
+}
+
+void as_log_after_fork(void)
+{
+	// A line may have been half written by a thread which was not forked.
+	log_ring_init();
+}
+
 static bool log_cb(as_log_level level, const char * func,
 		const char * file, uint32_t line, const char * fmt, ...){
 
-	char msg[1024];
+	// Filter before formatting, the level may have been lowered meanwhile.
+	if (level > g_as_log.level) {
+		return true;
+	}
+
+	// Restarted on the first line of a forked child, once its interpreter runs.
+	if (log_thread_started && log_thread_generation != as_fork_generation) {
+		uint32_t generation = log_thread_generation;
+		if (__atomic_compare_exchange_n(&log_thread_generation, &generation, as_fork_generation,
+				false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+			// On failure, set_log_handler() starts it again.
+			log_stopping = false;
+			log_thread_started = pthread_create(&log_thread, NULL, log_run, NULL) == 0;
+		}
+	}
+
+	uint64_t pos;
+	log_slot * slot = log_ring_reserve(&pos);
+	if (!slot) {
+		__atomic_add_fetch(&log_dropped, 1, __ATOMIC_RELAXED);
+		return true;
+	}
+
 	va_list ap;
 	va_start(ap, fmt);
-	vsnprintf(msg, 1024, fmt, ap);
+	vsnprintf(slot->message, LOG_MESSAGE_SIZE, fmt, ap);
 	va_end(ap);
 
-	// Extract pyhton user callback
-	PyObject *py_callback = user_callback.callback;
-	// User callback's argument list
-	PyObject *py_arglist = NULL;
-
-	// Lock python state
-	PyGILState_STATE gstate;
-	gstate = PyGILState_Ensure();
+	slot->level = level;
+	slot->func = func;
+	slot->file = file;
+	slot->line = line;
+	__atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
 
-	// Create a tuple of argument list
-	py_arglist = PyTuple_New(5);
+	return true;
+}
 
-	// Initialise argument variables
-	PyObject *log_level = PyInt_FromLong((long)level);
-	PyObject *func_name = PyString_FromString(func);
-	PyObject *file_name = PyString_FromString(file);
-	PyObject *line_no   = PyInt_FromLong((long)line);
-	PyObject *message   = PyString_FromString(msg);
+static PyObject * log_atexit(PyObject * self, PyObject * unused)
+{
+	// Threads calling into Python must end before the interpreter does.
+	log_thread_stop();
+	Py_RETURN_NONE;
+}
 
-	// Set argument list
-	PyTuple_SetItem(py_arglist, 0, log_level);
-	PyTuple_SetItem(py_arglist, 1, func_name);
-	PyTuple_SetItem(py_arglist, 2, file_name);
-	PyTuple_SetItem(py_arglist, 3, line_no);
-	PyTuple_SetItem(py_arglist, 4, message);
+static PyMethodDef log_atexit_def = {
+	"_stop_log_handler", (PyCFunction) log_atexit, METH_NOARGS, NULL
+};
 
-	// Invoke user callback, passing in argument's list
-	PyEval_CallObject(py_callback, py_arglist);
+static as_status log_register_atexit(as_error * err)
+{
+	if (log_atexit_registered) {
+		return err->code;
+	}
 
-	Py_DECREF(py_arglist);
+	PyObject * py_atexit = PyImport_ImportModule("atexit");
+	PyObject * py_fn = PyCFunction_New(&log_atexit_def, NULL);
+	PyObject * py_result = py_atexit && py_fn ?
+		PyObject_CallMethod(py_atexit, "register", "O", py_fn) : NULL;
 
-	// Release python state
-	PyGILState_Release(gstate);
+	if (py_result) {
+		log_atexit_registered = true;
+	} else {
+		PyErr_Clear();
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to register the log handler with atexit");
+	}
 
-	return true;
+	Py_XDECREF(py_result);
+	Py_XDECREF(py_fn);
+	Py_XDECREF(py_atexit);
+	return err->code;
 }
 
 PyObject * Aerospike_Set_Log_Handler(PyObject *parent, PyObject *args, PyObject * kwds)
@@ -174,8 +398,22 @@ PyObject * Aerospike_Set_Log_Handler(PyObject *parent, PyObject *args, PyObject
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Log handler must be callable");
 		goto CLEANUP;
 	}
-	// Store user callback
+
+	if (log_register_atexit(&err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (!log_thread_started) {
+		log_ring_init();
+		if (!log_thread_start()) {
+			as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to start the log thread");
+			goto CLEANUP;
+		}
+	}
+
+	// Store user callback, the drain thread reads it with the GIL held
 	Py_INCREF(py_callback);
+	Py_XDECREF(user_callback.callback);
 	user_callback.callback = py_callback;
 
 	// Register callback to C-SDK
@@ -0,0 +1,754 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <alloca.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <aerospike/as_error.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "latency.h"
+#include "multi_client.h"
+
+typedef enum {
+	MULTI_CLIENT_READ,
+	MULTI_CLIENT_WRITE
+} multi_client_kind;
+
+static uint64_t multi_client_now_ms(void)
+{
+	return as_latency_now_ns() / 1000000;
+}
+
+static void multi_client_raise(as_error * err)
+{
+	PyObject * py_err = NULL;
+	error_to_pyobject(err, &py_err);
+	PyObject *exception_type = raise_exception(err);
+	PyErr_SetObject(exception_type, py_err);
+	Py_DECREF(py_err);
+}
+
+/*
+ * The code and in_doubt of an aerospike exception, from the tuple it was
+ * raised with. Returns false for other exceptions.
+ */
+static bool multi_client_error_code(PyObject * py_exc, long * code, bool * in_doubt)
+{
+	bool found = false;
+	PyObject * py_args = py_exc ? PyObject_GetAttrString(py_exc, "args") : NULL;
+
+	if (py_args && PyTuple_Check(py_args) && PyTuple_Size(py_args) >= 5) {
+		PyObject * py_code = PyTuple_GetItem(py_args, 0);
+		if (PyInt_Check(py_code) || PyLong_Check(py_code)) {
+			*code = PyLong_AsLong(py_code);
+			*in_doubt = PyObject_IsTrue(PyTuple_GetItem(py_args, 4)) == 1;
+			found = true;
+		}
+	}
+
+	Py_XDECREF(py_args);
+	PyErr_Clear();
+	return found;
+}
+
+/*
+ * Errors meaning the command was not answered because the cluster, or the
+ * node of the record, can not be reached.
+ */
+static bool multi_client_is_unavailable(long code)
+{
+	switch (code) {
+		case AEROSPIKE_ERR_CLUSTER:
+		case AEROSPIKE_ERR_CONNECTION:
+		case AEROSPIKE_ERR_INVALID_HOST:
+		case AEROSPIKE_ERR_INVALID_NODE:
+		case AEROSPIKE_ERR_NO_MORE_CONNECTIONS:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static void multi_cluster_failed(AerospikeMultiClient * self, as_multi_cluster * cluster)
+{
+	cluster->failures++;
+	cluster->consecutive_failures++;
+
+	if (cluster->consecutive_failures >= self->failure_threshold) {
+		cluster->down_until_ms = multi_client_now_ms() + self->retry_interval_ms;
+	}
+}
+
+static void multi_cluster_answered(as_multi_cluster * cluster)
+{
+	cluster->consecutive_failures = 0;
+	cluster->down_until_ms = 0;
+}
+
+/*
+ * Connect a cluster which could not connect, or was closed, with the
+ * credentials of connect(). A cluster failing to connect is skipped straight
+ * away.
+ */
+static bool multi_cluster_connect(AerospikeMultiClient * self, as_multi_cluster * cluster)
+{
+	PyObject * py_client = PyObject_CallMethod((PyObject *) cluster->client, "connect", "OO",
+			self->py_username, self->py_password);
+
+	if (!py_client) {
+		if (cluster->consecutive_failures < self->failure_threshold) {
+			cluster->consecutive_failures = self->failure_threshold - 1;
+		}
+		return false;
+	}
+
+	Py_DECREF(py_client);
+	return true;
+}
+
+static PyObject * multi_cluster_call(AerospikeMultiClient * self, as_multi_cluster * cluster,
+		const char * name, multi_client_kind kind, PyObject * args, PyObject * kwds)
+{
+	if (kind == MULTI_CLIENT_READ) {
+		cluster->reads++;
+	} else {
+		cluster->writes++;
+	}
+
+	if (!cluster->client->is_conn_16 && !multi_cluster_connect(self, cluster)) {
+		return NULL;
+	}
+
+	// Through the attribute, so the client reconnects after a fork.
+	PyObject * py_method = PyObject_GetAttrString((PyObject *) cluster->client, name);
+	if (!py_method) {
+		return NULL;
+	}
+
+	PyObject * py_result = PyObject_Call(py_method, args, kwds);
+	Py_DECREF(py_method);
+	return py_result;
+}
+
+/*
+ * The clusters to send a command to, in order of preference: the available
+ * ones, or all of them while none is. Writes of AS_MULTI_WRITE_PREFERRED_ONLY
+ * only go to the first cluster.
+ */
+static uint32_t multi_client_order(AerospikeMultiClient * self, multi_client_kind kind, uint32_t * order)
+{
+	if (kind == MULTI_CLIENT_WRITE && self->write_mode == AS_MULTI_WRITE_PREFERRED_ONLY) {
+		order[0] = 0;
+		return 1;
+	}
+
+	uint64_t now_ms = multi_client_now_ms();
+	uint32_t n = 0;
+
+	for (uint32_t i = 0; i < self->n_clusters; i++) {
+		if (self->clusters[i].down_until_ms <= now_ms) {
+			order[n++] = i;
+		}
+	}
+
+	if (!n) {
+		for (uint32_t i = 0; i < self->n_clusters; i++) {
+			order[n++] = i;
+		}
+	}
+	return n;
+}
+
+/*
+ * Send a client method to the clusters. A read, or a write of
+ * AS_MULTI_WRITE_PREFERRED, moves on to the next cluster on the errors it may
+ * fall back on, and raises the error of the first cluster if no cluster
+ * answers. A write of AS_MULTI_WRITE_ALL goes to every cluster, and returns
+ * the result of the first one only if they all succeed, else raises the
+ * error of the first one which failed.
+ */
+static PyObject * multi_client_dispatch(AerospikeMultiClient * self, const char * name,
+		multi_client_kind kind, PyObject * args, PyObject * kwds)
+{
+	if (!self->connected) {
+		as_error err;
+		as_error_init(&err);
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		multi_client_raise(&err);
+		return NULL;
+	}
+
+	bool write_all = kind == MULTI_CLIENT_WRITE && self->write_mode == AS_MULTI_WRITE_ALL;
+	uint32_t * order = (uint32_t *) alloca(sizeof(uint32_t) * self->n_clusters);
+	uint32_t n = multi_client_order(self, kind, order);
+
+	PyObject * py_result = NULL;
+	PyObject * py_type = NULL;          // error of the first cluster which failed
+	PyObject * py_value = NULL;
+	PyObject * py_traceback = NULL;
+
+	for (uint32_t i = 0; i < n; i++) {
+		as_multi_cluster * cluster = &self->clusters[order[i]];
+		PyObject * py_cluster_result = multi_cluster_call(self, cluster, name, kind, args, kwds);
+
+		if (py_cluster_result) {
+			multi_cluster_answered(cluster);
+			if (py_result) {
+				Py_DECREF(py_cluster_result);
+			} else {
+				py_result = py_cluster_result;
+			}
+			if (!write_all) {
+				break;
+			}
+			continue;
+		}
+
+		PyObject * py_err_type = NULL, * py_err_value = NULL, * py_err_traceback = NULL;
+		PyErr_Fetch(&py_err_type, &py_err_value, &py_err_traceback);
+		PyErr_NormalizeException(&py_err_type, &py_err_value, &py_err_traceback);
+
+		long code = AEROSPIKE_OK;
+		bool in_doubt = false;
+		bool is_aerospike_error = multi_client_error_code(py_err_value, &code, &in_doubt);
+		bool unhealthy = is_aerospike_error &&
+				(multi_client_is_unavailable(code) || code == AEROSPIKE_ERR_TIMEOUT);
+
+		if (unhealthy) {
+			multi_cluster_failed(self, cluster);
+		} else if (is_aerospike_error && code > 0) {
+			// Answered by the server
+			multi_cluster_answered(cluster);
+		}
+
+		bool fall_back;
+		if (write_all) {
+			fall_back = true;
+		} else if (kind == MULTI_CLIENT_READ) {
+			fall_back = unhealthy;
+		} else {
+			// A write may only be sent again if it was not sent.
+			fall_back = is_aerospike_error && multi_client_is_unavailable(code) && !in_doubt;
+		}
+
+		if (fall_back && i + 1 < n) {
+			if (!write_all) {
+				cluster->fallbacks++;
+			}
+			if (!py_type) {
+				py_type = py_err_type;
+				py_value = py_err_value;
+				py_traceback = py_err_traceback;
+				continue;
+			}
+			Py_XDECREF(py_err_type);
+			Py_XDECREF(py_err_value);
+			Py_XDECREF(py_err_traceback);
+			continue;
+		}
+
+		// Raise the first error if every cluster failed over, else this one.
+		if (fall_back && py_type) {
+			Py_XDECREF(py_err_type);
+			Py_XDECREF(py_err_value);
+			Py_XDECREF(py_err_traceback);
+		} else {
+			Py_XDECREF(py_type);
+			Py_XDECREF(py_value);
+			Py_XDECREF(py_traceback);
+			py_type = py_err_type;
+			py_value = py_err_value;
+			py_traceback = py_err_traceback;
+		}
+		break;
+	}
+
+	// A write to every cluster fails if any of them failed, the others may
+	// have applied it.
+	if (py_result && !(write_all && py_type)) {
+		Py_XDECREF(py_type);
+		Py_XDECREF(py_value);
+		Py_XDECREF(py_traceback);
+		return py_result;
+	}
+
+	Py_XDECREF(py_result);
+	PyErr_Restore(py_type, py_value, py_traceback);
+	return NULL;
+}
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+PyDoc_STRVAR(connect_doc,
+"connect([username, password]) -> MultiClient\n\
+\n\
+Connect to each cluster. Fails only if no cluster can be connected, the others are connected again later.");
+
+PyDoc_STRVAR(close_doc,
+"close() -> None\n\
+\n\
+Close the connections to each cluster.");
+
+PyDoc_STRVAR(is_connected_doc,
+"is_connected() -> bool\n\
+\n\
+Whether any of the clusters is connected.");
+
+PyDoc_STRVAR(stats_doc,
+"stats() -> {}\n\
+\n\
+Return the health of each cluster, in order of preference, under 'clusters'.");
+
+PyDoc_STRVAR(client_doc,
+"client(index) -> Client\n\
+\n\
+Return the client of the cluster at index, for the commands not sent through the MultiClient.");
+
+static PyObject * AerospikeMultiClient_Connect(AerospikeMultiClient * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_username = Py_None;
+	PyObject * py_password = Py_None;
+
+	static char * kwlist[] = {"username", "password", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|OO:connect", kwlist,
+			&py_username, &py_password) == false) {
+		return NULL;
+	}
+
+	Py_INCREF(py_username);
+	Py_XDECREF(self->py_username);
+	self->py_username = py_username;
+	Py_INCREF(py_password);
+	Py_XDECREF(self->py_password);
+	self->py_password = py_password;
+
+	PyObject * py_type = NULL, * py_value = NULL, * py_traceback = NULL;
+	uint32_t n_connected = 0;
+
+	for (uint32_t i = 0; i < self->n_clusters; i++) {
+		as_multi_cluster * cluster = &self->clusters[i];
+
+		if (cluster->client->is_conn_16 || multi_cluster_connect(self, cluster)) {
+			multi_cluster_answered(cluster);
+			n_connected++;
+			continue;
+		}
+
+		multi_cluster_failed(self, cluster);
+		if (py_type) {
+			PyErr_Clear();
+		} else {
+			PyErr_Fetch(&py_type, &py_value, &py_traceback);
+		}
+	}
+
+	if (!n_connected) {
+		PyErr_Restore(py_type, py_value, py_traceback);
+		return NULL;
+	}
+
+	Py_XDECREF(py_type);
+	Py_XDECREF(py_value);
+	Py_XDECREF(py_traceback);
+
+	self->connected = true;
+	Py_INCREF(self);
+	return (PyObject *) self;
+}
+
+static PyObject * AerospikeMultiClient_Close(AerospikeMultiClient * self)
+{
+	PyObject * py_type = NULL, * py_value = NULL, * py_traceback = NULL;
+
+	for (uint32_t i = 0; i < self->n_clusters; i++) {
+		as_multi_cluster * cluster = &self->clusters[i];
+		if (!cluster->client->is_conn_16) {
+			continue;
+		}
+
+		PyObject * py_result = PyObject_CallMethod((PyObject *) cluster->client, "close", NULL);
+		if (py_result) {
+			Py_DECREF(py_result);
+		} else if (py_type) {
+			PyErr_Clear();
+		} else {
+			PyErr_Fetch(&py_type, &py_value, &py_traceback);
+		}
+	}
+
+	self->connected = false;
+
+	if (py_type) {
+		PyErr_Restore(py_type, py_value, py_traceback);
+		return NULL;
+	}
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeMultiClient_Is_Connected(AerospikeMultiClient * self)
+{
+	if (self->connected) {
+		for (uint32_t i = 0; i < self->n_clusters; i++) {
+			PyObject * py_connected = PyObject_CallMethod((PyObject *) self->clusters[i].client,
+					"is_connected", NULL);
+			if (!py_connected) {
+				return NULL;
+			}
+			if (py_connected == Py_True) {
+				return py_connected;
+			}
+			Py_DECREF(py_connected);
+		}
+	}
+	Py_RETURN_FALSE;
+}
+
+static PyObject * multi_cluster_stats(as_multi_cluster * cluster, uint64_t now_ms)
+{
+	PyObject * py_client_stats = NULL;
+
+	if (cluster->client->is_conn_16) {
+		py_client_stats = PyObject_CallMethod((PyObject *) cluster->client, "stats", NULL);
+		if (!py_client_stats) {
+			return NULL;
+		}
+	} else {
+		Py_INCREF(Py_None);
+		py_client_stats = Py_None;
+	}
+
+	PyObject * py_stats = Py_BuildValue("{s:O,s:O,s:K,s:K,s:K,s:K,s:I,s:N}",
+			"available", cluster->down_until_ms <= now_ms ? Py_True : Py_False,
+			"connected", cluster->client->is_conn_16 ? Py_True : Py_False,
+			"reads", (unsigned long long) cluster->reads,
+			"writes", (unsigned long long) cluster->writes,
+			"failures", (unsigned long long) cluster->failures,
+			"fallbacks", (unsigned long long) cluster->fallbacks,
+			"consecutive_failures", (unsigned int) cluster->consecutive_failures,
+			"stats", py_client_stats);
+	return py_stats;
+}
+
+static PyObject * AerospikeMultiClient_Stats(AerospikeMultiClient * self)
+{
+	uint64_t now_ms = multi_client_now_ms();
+	PyObject * py_clusters = PyList_New(self->n_clusters);
+	if (!py_clusters) {
+		return NULL;
+	}
+
+	for (uint32_t i = 0; i < self->n_clusters; i++) {
+		PyObject * py_cluster = multi_cluster_stats(&self->clusters[i], now_ms);
+		if (!py_cluster) {
+			Py_DECREF(py_clusters);
+			return NULL;
+		}
+		PyList_SET_ITEM(py_clusters, i, py_cluster);
+	}
+
+	return Py_BuildValue("{s:N,s:i}", "clusters", py_clusters, "write_mode", (int) self->write_mode);
+}
+
+static PyObject * AerospikeMultiClient_Client(AerospikeMultiClient * self, PyObject * args, PyObject * kwds)
+{
+	unsigned int index = 0;
+
+	static char * kwlist[] = {"index", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "I:client", kwlist, &index) == false) {
+		return NULL;
+	}
+
+	if (index >= self->n_clusters) {
+		as_error err;
+		as_error_init(&err);
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "index is out of range");
+		multi_client_raise(&err);
+		return NULL;
+	}
+
+	Py_INCREF(self->clusters[index].client);
+	return (PyObject *) self->clusters[index].client;
+}
+
+#define MULTI_CLIENT_COMMAND(__name, __kind) \
+static PyObject * AerospikeMultiClient_Command_##__name(AerospikeMultiClient * self, PyObject * args, PyObject * kwds)\
+{\
+	return multi_client_dispatch(self, #__name, __kind, args, kwds);\
+}
+
+MULTI_CLIENT_COMMAND(get, MULTI_CLIENT_READ)
+MULTI_CLIENT_COMMAND(select, MULTI_CLIENT_READ)
+MULTI_CLIENT_COMMAND(exists, MULTI_CLIENT_READ)
+MULTI_CLIENT_COMMAND(get_many, MULTI_CLIENT_READ)
+MULTI_CLIENT_COMMAND(select_many, MULTI_CLIENT_READ)
+MULTI_CLIENT_COMMAND(exists_many, MULTI_CLIENT_READ)
+
+MULTI_CLIENT_COMMAND(put, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(remove, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(remove_bin, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(increment, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(append, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(prepend, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(touch, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(operate, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(operate_ordered, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(apply, MULTI_CLIENT_WRITE)
+MULTI_CLIENT_COMMAND(update, MULTI_CLIENT_WRITE)
+
+#define MULTI_CLIENT_READ_METHOD(__name) \
+	{#__name, (PyCFunction) AerospikeMultiClient_Command_##__name, METH_VARARGS | METH_KEYWORDS,\
+		"Client." #__name "() on the first available cluster, or the next one if it times out or is unavailable."}
+
+#define MULTI_CLIENT_WRITE_METHOD(__name) \
+	{#__name, (PyCFunction) AerospikeMultiClient_Command_##__name, METH_VARARGS | METH_KEYWORDS,\
+		"Client." #__name "() on the clusters of the write mode."}
+
+static PyMethodDef AerospikeMultiClient_Type_Methods[] = {
+
+	{"connect",	(PyCFunction) AerospikeMultiClient_Connect,	METH_VARARGS | METH_KEYWORDS,
+				connect_doc},
+
+	{"close",	(PyCFunction) AerospikeMultiClient_Close,	METH_NOARGS,
+				close_doc},
+
+	{"is_connected",	(PyCFunction) AerospikeMultiClient_Is_Connected,	METH_NOARGS,
+				is_connected_doc},
+
+	{"stats",	(PyCFunction) AerospikeMultiClient_Stats,	METH_NOARGS,
+				stats_doc},
+
+	{"client",	(PyCFunction) AerospikeMultiClient_Client,	METH_VARARGS | METH_KEYWORDS,
+				client_doc},
+
+	// Reads
+	MULTI_CLIENT_READ_METHOD(get),
+	MULTI_CLIENT_READ_METHOD(select),
+	MULTI_CLIENT_READ_METHOD(exists),
+	MULTI_CLIENT_READ_METHOD(get_many),
+	MULTI_CLIENT_READ_METHOD(select_many),
+	MULTI_CLIENT_READ_METHOD(exists_many),
+
+	// Writes
+	MULTI_CLIENT_WRITE_METHOD(put),
+	MULTI_CLIENT_WRITE_METHOD(remove),
+	MULTI_CLIENT_WRITE_METHOD(remove_bin),
+	MULTI_CLIENT_WRITE_METHOD(increment),
+	MULTI_CLIENT_WRITE_METHOD(append),
+	MULTI_CLIENT_WRITE_METHOD(prepend),
+	MULTI_CLIENT_WRITE_METHOD(touch),
+	MULTI_CLIENT_WRITE_METHOD(operate),
+	MULTI_CLIENT_WRITE_METHOD(operate_ordered),
+	MULTI_CLIENT_WRITE_METHOD(apply),
+	MULTI_CLIENT_WRITE_METHOD(update),
+
+	{NULL}
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static void AerospikeMultiClient_Type_Dealloc(AerospikeMultiClient * self)
+{
+	for (uint32_t i = 0; i < self->n_clusters; i++) {
+		Py_CLEAR(self->clusters[i].client);
+	}
+
+	free(self->clusters);
+	Py_CLEAR(self->py_username);
+	Py_CLEAR(self->py_password);
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeMultiClient_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.MultiClient",            // tp_name
+	sizeof(AerospikeMultiClient),       // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikeMultiClient_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	0,                                  // tp_repr
+	0,                                  // tp_as_number
+	0,                                  // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	0,                                  // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"A client of several clusters, returned by aerospike.multi_client(),\n"
+	"which reads from the first available cluster and writes by its write mode.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	AerospikeMultiClient_Type_Methods,  // tp_methods
+	0,                                  // tp_members
+	0,                                  // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0,                                  // tp_new
+	0,                                  // tp_free
+	0,                                  // tp_is_gc
+	0                                   // tp_bases
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeMultiClient_Ready()
+{
+	return PyType_Ready(&AerospikeMultiClient_Type) == 0 ? &AerospikeMultiClient_Type : NULL;
+}
+
+static bool multi_client_config_uint(as_error * err, PyObject * py_config, const char * name,
+		uint32_t min, uint32_t max, uint32_t * value)
+{
+	PyObject * py_value = PyDict_GetItemString(py_config, name);
+	if (!py_value || py_value == Py_None) {
+		return true;
+	}
+
+	long n = PyInt_Check(py_value) || PyLong_Check(py_value) ? PyLong_AsLong(py_value) : -1;
+	if (PyErr_Occurred()) {
+		PyErr_Clear();
+		n = -1;
+	}
+	if (n < (long) min || n > (long) max) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "%s is invalid", name);
+		return false;
+	}
+
+	*value = (uint32_t) n;
+	return true;
+}
+
+AerospikeMultiClient * AerospikeMultiClient_New(PyObject * parent, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_config = NULL;
+	AerospikeMultiClient * self = NULL;
+
+	static char * kwlist[] = {"config", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O:multi_client", kwlist, &py_config) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (!PyDict_Check(py_config)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "config must be a dict");
+		goto CLEANUP;
+	}
+
+	PyObject * py_clusters = PyDict_GetItemString(py_config, "clusters");
+	if (!py_clusters || !PyList_Check(py_clusters) || !PyList_Size(py_clusters)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "clusters must be a non empty list of client configs");
+		goto CLEANUP;
+	}
+
+	uint32_t write_mode = AS_MULTI_WRITE_PREFERRED;
+	uint32_t failure_threshold = AS_MULTI_CLIENT_DEFAULT_FAILURE_THRESHOLD;
+	uint32_t retry_interval_ms = AS_MULTI_CLIENT_DEFAULT_RETRY_INTERVAL_MS;
+
+	if (!multi_client_config_uint(&err, py_config, "write_mode", AS_MULTI_WRITE_PREFERRED,
+				AS_MULTI_WRITE_ALL, &write_mode) ||
+			!multi_client_config_uint(&err, py_config, "failure_threshold", 1, UINT32_MAX,
+				&failure_threshold) ||
+			!multi_client_config_uint(&err, py_config, "retry_interval", 0, UINT32_MAX,
+				&retry_interval_ms)) {
+		goto CLEANUP;
+	}
+
+	self = PyObject_New(AerospikeMultiClient, &AerospikeMultiClient_Type);
+	if (!self) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the multi-cluster client");
+		goto CLEANUP;
+	}
+
+	Py_ssize_t n_clusters = PyList_Size(py_clusters);
+	self->clusters = calloc((size_t) n_clusters, sizeof(as_multi_cluster));
+	self->n_clusters = 0;
+	self->write_mode = (as_multi_write_mode) write_mode;
+	self->failure_threshold = failure_threshold;
+	self->retry_interval_ms = retry_interval_ms;
+	self->connected = false;
+	self->py_username = NULL;
+	self->py_password = NULL;
+
+	if (!self->clusters) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the multi-cluster client");
+		goto CLEANUP;
+	}
+
+	for (Py_ssize_t i = 0; i < n_clusters; i++) {
+		PyObject * py_client_args = PyTuple_Pack(1, PyList_GetItem(py_clusters, i));
+		if (!py_client_args) {
+			break;
+		}
+
+		// Raises the error of the config
+		AerospikeClient * client = AerospikeClient_New(NULL, py_client_args, NULL);
+		Py_DECREF(py_client_args);
+		if (!client) {
+			break;
+		}
+
+		self->clusters[self->n_clusters++].client = client;
+	}
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		multi_client_raise(&err);
+	}
+
+	if (PyErr_Occurred()) {
+		Py_XDECREF(self);
+		return NULL;
+	}
+
+	return self;
+}
@@ -0,0 +1,227 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include "macros.h"
+#include "operation.h"
+
+#define OPERATION_IMMUTABLE "aerospike.Operation is immutable"
+
+/*******************************************************************************
+ * SLOTS
+ ******************************************************************************/
+
+static void operation_set_field(AerospikeOperation * self, as_operation_field field, PyObject * py_value)
+{
+	PyObject * py_old = self->fields[field];
+	Py_XINCREF(py_value);
+	self->fields[field] = py_value;
+	Py_XDECREF(py_old);
+}
+
+static PyObject * operation_get_item(AerospikeOperation * self, const char * key)
+{
+	return PyDict_GetItemString(self->py_entries, key);
+}
+
+/*
+ * Fill the slots from the entries, once per operation.
+ */
+static void operation_fill(AerospikeOperation * self)
+{
+	PyObject * py_op = operation_get_item(self, "op");
+
+	self->has_op = false;
+	if (py_op && PyInt_Check(py_op)) {
+		long op = PyInt_AsLong(py_op);
+		if (op == -1 && PyErr_Occurred()) {
+			// Left to the dict path, which reports the error.
+			PyErr_Clear();
+		}
+		else {
+			self->op = op;
+			self->has_op = true;
+		}
+	}
+
+	PyObject * py_policy = operation_get_item(self, "list_policy");
+	if (!py_policy) {
+		py_policy = operation_get_item(self, "map_policy");
+	}
+	if (!py_policy) {
+		py_policy = operation_get_item(self, "policy");
+	}
+
+	operation_set_field(self, AS_OP_FIELD_BIN, operation_get_item(self, "bin"));
+	operation_set_field(self, AS_OP_FIELD_VAL, operation_get_item(self, "val"));
+	operation_set_field(self, AS_OP_FIELD_CTX, operation_get_item(self, "ctx"));
+	operation_set_field(self, AS_OP_FIELD_POLICY, py_policy);
+	operation_set_field(self, AS_OP_FIELD_RETURN_TYPE, operation_get_item(self, "return_type"));
+	operation_set_field(self, AS_OP_FIELD_INVERTED, operation_get_item(self, "inverted"));
+}
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+static PyObject * AerospikeOperation_Immutable(PyObject * self, PyObject * args, PyObject * kwds)
+{
+	PyErr_SetString(PyExc_TypeError, OPERATION_IMMUTABLE);
+	return NULL;
+}
+
+static int AerospikeOperation_Ass_Subscript(PyObject * self, PyObject * py_key, PyObject * py_value)
+{
+	PyErr_SetString(PyExc_TypeError, OPERATION_IMMUTABLE);
+	return -1;
+}
+
+static PyObject * AerospikeOperation_Reduce(PyObject * self, PyObject * args)
+{
+	PyObject * py_dict = PyDict_Copy(self);
+	if (!py_dict) {
+		return NULL;
+	}
+	return Py_BuildValue("(O(N))", Py_TYPE(self), py_dict);
+}
+
+static PyMethodDef AerospikeOperation_Type_Methods[] = {
+
+	{"update",	(PyCFunction) AerospikeOperation_Immutable,	METH_VARARGS | METH_KEYWORDS, NULL},
+	{"pop",	(PyCFunction) AerospikeOperation_Immutable,	METH_VARARGS | METH_KEYWORDS, NULL},
+	{"popitem",	(PyCFunction) AerospikeOperation_Immutable,	METH_VARARGS | METH_KEYWORDS, NULL},
+	{"clear",	(PyCFunction) AerospikeOperation_Immutable,	METH_VARARGS | METH_KEYWORDS, NULL},
+	{"setdefault",	(PyCFunction) AerospikeOperation_Immutable,	METH_VARARGS | METH_KEYWORDS, NULL},
+	{"__reduce__",	(PyCFunction) AerospikeOperation_Reduce,	METH_NOARGS, NULL},
+
+	{NULL}
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static int AerospikeOperation_Type_Init(AerospikeOperation * self, PyObject * args, PyObject * kwds)
+{
+	// dict.__init__ would add the arguments to the entries.
+	if (self->py_entries) {
+		PyErr_SetString(PyExc_TypeError, OPERATION_IMMUTABLE);
+		return -1;
+	}
+
+	if (PyDict_Type.tp_init((PyObject *) self, args, kwds) < 0) {
+		return -1;
+	}
+
+	self->py_entries = PyDict_Copy((PyObject *) self);
+	if (!self->py_entries) {
+		return -1;
+	}
+
+	operation_fill(self);
+	return 0;
+}
+
+static void AerospikeOperation_Type_Dealloc(AerospikeOperation * self)
+{
+	for (int i = 0; i < AS_OP_FIELD_COUNT; i++) {
+		Py_CLEAR(self->fields[i]);
+	}
+	Py_CLEAR(self->py_entries);
+	PyDict_Type.tp_dealloc((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyMappingMethods AerospikeOperation_Type_Mapping;
+
+#if PY_VERSION_HEX >= 0x03090000
+static PyNumberMethods AerospikeOperation_Type_Number;
+#endif
+
+PyTypeObject AerospikeOperation_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.Operation",              // tp_name
+	sizeof(AerospikeOperation),         // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikeOperation_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	0,                                  // tp_repr
+	0,                                  // tp_as_number
+	0,                                  // tp_as_sequence
+	&AerospikeOperation_Type_Mapping,   // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	0,                                  // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"An operation for operate() and operate_ordered(), as returned by the\n"
+	"aerospike_helpers.operations functions. An immutable dict.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	AerospikeOperation_Type_Methods,    // tp_methods
+	0,                                  // tp_members
+	0,                                  // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	(initproc) AerospikeOperation_Type_Init,
+	                                    // tp_init
+	0,                                  // tp_alloc
+	0,                                  // tp_new
+	0,                                  // tp_free
+	0,                                  // tp_is_gc
+	0                                   // tp_bases
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeOperation_Ready()
+{
+	// A dict, so the operations stay usable wherever a dict is expected.
+	AerospikeOperation_Type.tp_base = &PyDict_Type;
+
+	AerospikeOperation_Type_Mapping = *PyDict_Type.tp_as_mapping;
+	AerospikeOperation_Type_Mapping.mp_ass_subscript = AerospikeOperation_Ass_Subscript;
+
+#if PY_VERSION_HEX >= 0x03090000
+	// op |= {...} would update in place.
+	AerospikeOperation_Type_Number = *PyDict_Type.tp_as_number;
+	AerospikeOperation_Type_Number.nb_inplace_or = NULL;
+	AerospikeOperation_Type.tp_as_number = &AerospikeOperation_Type_Number;
+#endif
+
+	return PyType_Ready(&AerospikeOperation_Type) == 0 ? &AerospikeOperation_Type : NULL;
+}
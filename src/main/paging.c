@@ -0,0 +1,620 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <aerospike/aerospike_query.h>
+#include <aerospike/aerospike_scan.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_node.h>
+#include <aerospike/as_random.h>
+#include <aerospike/as_val.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "macros.h"
+#include "paging.h"
+
+#define PAGE_CURSOR_CAPSULE "aerospike.page_cursor"
+
+// Two 64 bit random numbers in hex
+#define PAGE_TOKEN_SIZE 33
+
+// A full page not taken for this long is abandoned, and its stream stopped.
+#define PAGE_CURSOR_IDLE_MS 60000
+
+struct as_page_cursor_s {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	pthread_t thread;
+	bool started;
+	uint32_t fork_generation;           // as_fork_generation when the cursor was created
+	bool done;
+	bool cancelled;
+	bool expired;
+
+	// Records in the current page, and slots reserved by callbacks converting a record
+	uint32_t max_records;
+	uint32_t count;
+	uint32_t pending;
+	PyObject * py_records;
+	as_error err;
+
+	AerospikeClient * client;
+	as_throttle * throttle;
+	// Copies of the query or scan, see page_query_copy
+	bool is_query;
+	as_query query;
+	as_policy_query query_policy;
+	as_scan scan;
+	as_policy_scan scan_policy;
+	as_predexp_list predexps;
+	bool has_predexps;
+	PyObject * py_policy;
+	char nodename[AS_NODE_NAME_MAX_SIZE];
+
+	char token[PAGE_TOKEN_SIZE];
+	as_background background;           // the capsule, stopped by client.close()
+};
+
+static void page_cursor_deadline(struct timespec * ts, uint32_t ms)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	uint64_t ns = (uint64_t) now.tv_usec * 1000 + (uint64_t) ms * 1000000;
+	ts->tv_sec = now.tv_sec + (time_t) (ns / 1000000000);
+	ts->tv_nsec = (long) (ns % 1000000000);
+}
+
+/*
+ * The cursor runs on a copy of the query, so the Query may be changed or run
+ * again while it has pages outstanding. The predexps are shared, they can
+ * only be set once and are freed with the Query, after its cursors stop.
+ */
+static bool page_query_copy(as_query * dst, const as_query * src)
+{
+	*dst = *src;
+	dst->_free = false;
+	dst->select.entries = NULL;
+	dst->select.capacity = 0;
+	dst->select.size = 0;
+	dst->where.entries = NULL;
+	dst->where.capacity = 0;
+	dst->where.size = 0;
+	if (dst->apply.arglist) {
+		as_val_reserve(dst->apply.arglist);
+	}
+
+	if (src->select.size) {
+		dst->select.entries = cf_malloc(src->select.size * sizeof(as_bin_name));
+		if (!dst->select.entries) {
+			return false;
+		}
+		memcpy(dst->select.entries, src->select.entries, src->select.size * sizeof(as_bin_name));
+		dst->select.capacity = src->select.size;
+		dst->select.size = src->select.size;
+	}
+
+	if (src->where.size) {
+		dst->where.entries = cf_malloc(src->where.size * sizeof(as_predicate));
+		if (!dst->where.entries) {
+			return false;
+		}
+		dst->where.capacity = src->where.size;
+		for (uint16_t i = 0; i < src->where.size; i++) {
+			as_predicate * p = &dst->where.entries[i];
+			*p = src->where.entries[i];
+			if ((p->dtype == AS_INDEX_STRING || p->dtype == AS_INDEX_GEO2DSPHERE) && p->value.string) {
+				p->value.string = strdup(p->value.string);
+				if (!p->value.string) {
+					return false;
+				}
+			}
+			dst->where.size = i + 1;
+		}
+	}
+	return true;
+}
+
+static void page_query_destroy(as_query * query)
+{
+	for (uint16_t i = 0; i < query->where.size; i++) {
+		as_predicate * p = &query->where.entries[i];
+		if (p->dtype == AS_INDEX_STRING || p->dtype == AS_INDEX_GEO2DSPHERE) {
+			free(p->value.string);
+		}
+	}
+	cf_free(query->where.entries);
+	cf_free(query->select.entries);
+	if (query->apply.arglist) {
+		as_val_destroy(query->apply.arglist);
+	}
+}
+
+static bool page_scan_copy(as_scan * dst, const as_scan * src)
+{
+	*dst = *src;
+	dst->_free = false;
+	dst->select.entries = NULL;
+	dst->select.capacity = 0;
+	dst->select.size = 0;
+	if (dst->apply.arglist) {
+		as_val_reserve(dst->apply.arglist);
+	}
+
+	if (src->select.size) {
+		dst->select.entries = cf_malloc(src->select.size * sizeof(as_bin_name));
+		if (!dst->select.entries) {
+			return false;
+		}
+		memcpy(dst->select.entries, src->select.entries, src->select.size * sizeof(as_bin_name));
+		dst->select.capacity = src->select.size;
+		dst->select.size = src->select.size;
+	}
+	return true;
+}
+
+static void page_scan_destroy(as_scan * scan)
+{
+	cf_free(scan->select.entries);
+	if (scan->apply.arglist) {
+		as_val_destroy(scan->apply.arglist);
+	}
+}
+
+/*
+ * Frees a cursor whose thread is not running. Called with the GIL held.
+ */
+static void page_cursor_free(as_page_cursor * cursor)
+{
+	Py_XDECREF(cursor->py_records);
+	Py_XDECREF(cursor->py_policy);
+	Py_XDECREF(cursor->client);
+	if (cursor->has_predexps) {
+		as_predexp_list_destroy(&cursor->predexps);
+	}
+	if (cursor->is_query) {
+		page_query_destroy(&cursor->query);
+	}
+	else {
+		page_scan_destroy(&cursor->scan);
+	}
+	pthread_cond_destroy(&cursor->cond);
+	pthread_mutex_destroy(&cursor->lock);
+	free(cursor);
+}
+
+static as_page_cursor * page_cursor_new(AerospikeClient * client, as_throttle * throttle)
+{
+	as_page_cursor * cursor = calloc(1, sizeof(as_page_cursor));
+	if (!cursor) {
+		return NULL;
+	}
+
+	pthread_mutex_init(&cursor->lock, NULL);
+	pthread_cond_init(&cursor->cond, NULL);
+	cursor->fork_generation = as_fork_generation;
+	as_error_init(&cursor->err);
+	// The stream outlives the call, keep the client alive with it.
+	Py_INCREF(client);
+	cursor->client = client;
+	cursor->throttle = throttle;
+	cursor->py_records = PyList_New(0);
+	snprintf(cursor->token, PAGE_TOKEN_SIZE, "%016llx%016llx",
+			(unsigned long long) as_random_get_uint64(),
+			(unsigned long long) as_random_get_uint64());
+	return cursor;
+}
+
+as_page_cursor * as_page_cursor_query(AerospikeClient * client, const as_query * query,
+		const as_policy_query * policy, as_throttle * throttle)
+{
+	as_page_cursor * cursor = page_cursor_new(client, throttle);
+	if (cursor) {
+		cursor->is_query = true;
+		if (!page_query_copy(&cursor->query, query)) {
+			page_cursor_free(cursor);
+			return NULL;
+		}
+		cursor->query_policy = policy ? *policy : client->as->config.policies.query;
+	}
+	return cursor;
+}
+
+as_page_cursor * as_page_cursor_scan(AerospikeClient * client, const as_scan * scan,
+		PyObject * py_policy, const as_policy_scan * policy, as_predexp_list * predexps,
+		const char * nodename, as_throttle * throttle)
+{
+	as_page_cursor * cursor = page_cursor_new(client, throttle);
+	if (cursor) {
+		if (!page_scan_copy(&cursor->scan, scan)) {
+			page_cursor_free(cursor);
+			return NULL;
+		}
+		cursor->scan_policy = policy ? *policy : client->as->config.policies.scan;
+		if (policy && policy->base.predexp == predexps) {
+			// The scan outlives the call, it takes over the predexps of the call.
+			cursor->predexps = *predexps;
+			cursor->has_predexps = true;
+			cursor->scan_policy.base.predexp = &cursor->predexps;
+		}
+		// A compiled policy holds its own predexps, keep it alive.
+		Py_XINCREF(py_policy);
+		cursor->py_policy = py_policy;
+		if (nodename) {
+			strncpy(cursor->nodename, nodename, AS_NODE_NAME_MAX_SIZE - 1);
+		}
+	}
+	return cursor;
+}
+
+/*
+ * Called on the C client's threads. Waits for room in the page before
+ * converting the record, so a stalled consumer stalls the query.
+ */
+static bool page_each_result(const as_val * val, void * udata)
+{
+	as_page_cursor * cursor = (as_page_cursor *) udata;
+
+	if (!val) {
+		return false;
+	}
+
+	pthread_mutex_lock(&cursor->lock);
+	struct timespec deadline;
+	page_cursor_deadline(&deadline, PAGE_CURSOR_IDLE_MS);
+	while (!cursor->cancelled && cursor->count + cursor->pending >= cursor->max_records) {
+		if (pthread_cond_timedwait(&cursor->cond, &cursor->lock, &deadline) == ETIMEDOUT &&
+				cursor->count + cursor->pending >= cursor->max_records) {
+			// Nobody took the page, stop the stream and release its connections.
+			cursor->expired = true;
+			cursor->cancelled = true;
+			pthread_cond_broadcast(&cursor->cond);
+		}
+	}
+	if (cursor->cancelled) {
+		pthread_mutex_unlock(&cursor->lock);
+		return false;
+	}
+	cursor->pending++;
+	pthread_mutex_unlock(&cursor->lock);
+
+	as_throttle_acquire(cursor->throttle);
+
+	as_error err;
+	as_error_init(&err);
+	PyObject * py_result = NULL;
+
+	PyGILState_STATE gstate = PyGILState_Ensure();
+
+	val_to_pyobject(cursor->client, &err, val, &py_result);
+
+	// The page is swapped out under the GIL, so append and count together.
+	pthread_mutex_lock(&cursor->lock);
+	cursor->pending--;
+	if (py_result) {
+		PyList_Append(cursor->py_records, py_result);
+		cursor->count++;
+	}
+	if (err.code != AEROSPIKE_OK && cursor->err.code == AEROSPIKE_OK) {
+		as_error_copy(&cursor->err, &err);
+	}
+	pthread_cond_broadcast(&cursor->cond);
+	pthread_mutex_unlock(&cursor->lock);
+
+	Py_XDECREF(py_result);
+	PyGILState_Release(gstate);
+
+	return err.code == AEROSPIKE_OK;
+}
+
+static void * page_cursor_run(void * udata)
+{
+	as_page_cursor * cursor = (as_page_cursor *) udata;
+	aerospike * as = cursor->client->as;
+
+	as_error err;
+	as_error_init(&err);
+
+	if (cursor->is_query) {
+		aerospike_query_foreach(as, &err, &cursor->query_policy, &cursor->query,
+				page_each_result, cursor);
+	}
+	else if (cursor->nodename[0]) {
+		aerospike_scan_node(as, &err, &cursor->scan_policy, &cursor->scan,
+				cursor->nodename, page_each_result, cursor);
+	}
+	else {
+		aerospike_scan_foreach(as, &err, &cursor->scan_policy, &cursor->scan,
+				page_each_result, cursor);
+	}
+
+	pthread_mutex_lock(&cursor->lock);
+	cursor->done = true;
+	if (!cursor->cancelled && err.code != AEROSPIKE_OK && cursor->err.code == AEROSPIKE_OK) {
+		as_error_copy(&cursor->err, &err);
+	}
+	pthread_cond_broadcast(&cursor->cond);
+	pthread_mutex_unlock(&cursor->lock);
+
+	return NULL;
+}
+
+/*
+ * Stop the stream before the client closes its cluster. A page not fully
+ * read fails, rather than ending as if the results were exhausted.
+ */
+static void page_cursor_stop(PyObject * py_capsule)
+{
+	as_page_cursor * cursor = PyCapsule_GetPointer(py_capsule, PAGE_CURSOR_CAPSULE);
+
+	// The thread of a cursor started before a fork does not exist in the child.
+	if (!cursor->started || cursor->fork_generation != as_fork_generation) {
+		return;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	pthread_mutex_lock(&cursor->lock);
+	if (!cursor->done && cursor->err.code == AEROSPIKE_OK) {
+		as_error_update(&cursor->err, AEROSPIKE_ERR_CLIENT, "The client was closed before the results were read");
+	}
+	cursor->cancelled = true;
+	pthread_cond_broadcast(&cursor->cond);
+	pthread_mutex_unlock(&cursor->lock);
+	pthread_join(cursor->thread, NULL);
+	Py_END_ALLOW_THREADS
+
+	cursor->started = false;
+}
+
+/*
+ * Capsule destructor, runs when the cursor leaves the registry. The GIL is
+ * released while the producing thread is stopped, since it may be waiting
+ * for the GIL to convert a record.
+ */
+static void page_cursor_destroy(PyObject * py_capsule)
+{
+	as_page_cursor * cursor = PyCapsule_GetPointer(py_capsule, PAGE_CURSOR_CAPSULE);
+
+	AerospikeClient_Unregister_Background(cursor->client, &cursor->background);
+
+	// The thread of a cursor started before a fork does not exist in the child.
+	if (cursor->started && cursor->fork_generation == as_fork_generation) {
+		Py_BEGIN_ALLOW_THREADS
+		pthread_mutex_lock(&cursor->lock);
+		cursor->cancelled = true;
+		pthread_cond_broadcast(&cursor->cond);
+		pthread_mutex_unlock(&cursor->lock);
+		pthread_join(cursor->thread, NULL);
+		Py_END_ALLOW_THREADS
+	}
+
+	page_cursor_free(cursor);
+}
+
+/*
+ * Whether the cursor was abandoned, or started by the parent of a fork.
+ */
+static bool page_cursor_expired(as_page_cursor * cursor)
+{
+	if (cursor->fork_generation != as_fork_generation) {
+		return true;
+	}
+
+	pthread_mutex_lock(&cursor->lock);
+	bool expired = cursor->expired;
+	pthread_mutex_unlock(&cursor->lock);
+	return expired;
+}
+
+/*
+ * Drops the abandoned cursors, whose streams stopped, so their pages are freed.
+ */
+static void page_cursors_expire(PyObject * py_cursors)
+{
+	PyObject * py_expired = PyList_New(0);
+	PyObject * py_token = NULL;
+	PyObject * py_capsule = NULL;
+	Py_ssize_t pos = 0;
+
+	if (!py_expired) {
+		PyErr_Clear();
+		return;
+	}
+
+	while (PyDict_Next(py_cursors, &pos, &py_token, &py_capsule)) {
+		as_page_cursor * cursor = PyCapsule_GetPointer(py_capsule, PAGE_CURSOR_CAPSULE);
+		if (cursor && page_cursor_expired(cursor)) {
+			PyList_Append(py_expired, py_token);
+		}
+	}
+
+	for (Py_ssize_t i = 0; i < PyList_Size(py_expired); i++) {
+		PyDict_DelItem(py_cursors, PyList_GetItem(py_expired, i));
+	}
+	PyErr_Clear();
+	Py_DECREF(py_expired);
+}
+
+static PyObject * page_cursor_register(as_error * err, PyObject ** py_cursors, as_page_cursor * cursor)
+{
+	PyObject * py_capsule = PyCapsule_New(cursor, PAGE_CURSOR_CAPSULE, page_cursor_destroy);
+	if (!py_capsule) {
+		page_cursor_free(cursor);
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to create the page cursor");
+		return NULL;
+	}
+
+	if (!*py_cursors) {
+		*py_cursors = PyDict_New();
+	}
+	else {
+		page_cursors_expire(*py_cursors);
+	}
+
+	if (!cursor->py_records || !*py_cursors ||
+			PyDict_SetItemString(*py_cursors, cursor->token, py_capsule) != 0) {
+		Py_DECREF(py_capsule);
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to register the page cursor");
+		return NULL;
+	}
+
+	if (AerospikeClient_Register_Background(cursor->client, err, &cursor->background, py_capsule,
+			page_cursor_stop) != AEROSPIKE_OK) {
+		PyDict_DelItemString(*py_cursors, cursor->token);
+		Py_DECREF(py_capsule);
+		return NULL;
+	}
+
+	if (pthread_create(&cursor->thread, NULL, page_cursor_run, cursor) != 0) {
+		PyDict_DelItemString(*py_cursors, cursor->token);
+		Py_DECREF(py_capsule);
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to start the page cursor thread");
+		return NULL;
+	}
+	cursor->started = true;
+
+	return py_capsule;
+}
+
+PyObject * page_cursor_next(as_error * err, PyObject ** py_cursors, PyObject * py_token,
+		uint32_t max_records, as_page_cursor * new_cursor)
+{
+	PyObject * py_capsule = NULL;
+	PyObject * py_page = NULL;
+
+	if (new_cursor) {
+		py_capsule = page_cursor_register(err, py_cursors, new_cursor);
+		if (!py_capsule) {
+			return NULL;
+		}
+	}
+	else {
+		if (!PyString_Check(py_token)) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "token must be a string or None");
+			return NULL;
+		}
+		if (*py_cursors) {
+			py_capsule = PyDict_GetItem(*py_cursors, py_token);
+		}
+		if (!py_capsule) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Unknown or expired page token");
+			return NULL;
+		}
+		// Hold the cursor while waiting, another thread may finish it meanwhile.
+		Py_INCREF(py_capsule);
+	}
+
+	as_page_cursor * cursor = PyCapsule_GetPointer(py_capsule, PAGE_CURSOR_CAPSULE);
+	bool done = false;
+
+	if (!new_cursor && page_cursor_expired(cursor)) {
+		if (PyDict_DelItem(*py_cursors, py_token) != 0) {
+			PyErr_Clear();
+		}
+		Py_DECREF(py_capsule);
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Unknown or expired page token");
+		return NULL;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	pthread_mutex_lock(&cursor->lock);
+	cursor->max_records = max_records;
+	pthread_cond_broadcast(&cursor->cond);
+	while (!cursor->done && cursor->err.code == AEROSPIKE_OK &&
+			cursor->count + cursor->pending < max_records) {
+		pthread_cond_wait(&cursor->cond, &cursor->lock);
+	}
+	pthread_mutex_unlock(&cursor->lock);
+	Py_END_ALLOW_THREADS
+
+	// Wait for in flight records, so the page is full or the stream is drained.
+	Py_BEGIN_ALLOW_THREADS
+	pthread_mutex_lock(&cursor->lock);
+	while (cursor->pending > 0) {
+		pthread_cond_wait(&cursor->cond, &cursor->lock);
+	}
+	pthread_mutex_unlock(&cursor->lock);
+	Py_END_ALLOW_THREADS
+
+	PyObject * py_records = NULL;
+
+	pthread_mutex_lock(&cursor->lock);
+	if (cursor->err.code != AEROSPIKE_OK) {
+		as_error_copy(err, &cursor->err);
+		done = true;
+	}
+	else {
+		// The page may hold more than max_records if an earlier call asked for more.
+		Py_ssize_t size = PyList_Size(cursor->py_records);
+		Py_ssize_t take = size < (Py_ssize_t) max_records ? size : (Py_ssize_t) max_records;
+		py_records = PyList_GetSlice(cursor->py_records, 0, take);
+		if (!py_records || PyList_SetSlice(cursor->py_records, 0, take, NULL) != 0) {
+			PyErr_Clear();
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the page");
+			done = true;
+		}
+		else {
+			cursor->count = (uint32_t) (size - take);
+			done = cursor->done && cursor->count == 0;
+		}
+		pthread_cond_broadcast(&cursor->cond);
+	}
+	pthread_mutex_unlock(&cursor->lock);
+
+	if (err->code == AEROSPIKE_OK && py_records) {
+		if (done) {
+			py_page = Py_BuildValue("(OO)", py_records, Py_None);
+		}
+		else {
+			py_page = Py_BuildValue("(Os)", py_records, cursor->token);
+		}
+	}
+	Py_XDECREF(py_records);
+
+	if (done || err->code != AEROSPIKE_OK) {
+		// Errors end the cursor as well, its stream can not be resumed.
+		if (PyDict_DelItemString(*py_cursors, cursor->token) != 0) {
+			PyErr_Clear();
+		}
+	}
+	Py_DECREF(py_capsule);
+
+	return py_page;
+}
+
+as_status pyobject_to_max_records(as_error * err, PyObject * py_max_records, uint32_t * max_records)
+{
+	if (!PyInt_Check(py_max_records) && !PyLong_Check(py_max_records)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "max_records must be an integer");
+	}
+
+	long value = PyLong_AsLong(py_max_records);
+	if (PyErr_Occurred() || value <= 0 || value > UINT32_MAX) {
+		PyErr_Clear();
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "max_records must be between 1 and %u", UINT32_MAX);
+	}
+
+	*max_records = (uint32_t) value;
+	return AEROSPIKE_OK;
+}
@@ -29,9 +29,14 @@
 
 #include "policy.h"
 #include "macros.h"
+#include "compiled_policy.h"
+#include "predexp.h"
+#include "aggregate.h"
+#include "multi_client.h"
 
 #define MAP_WRITE_FLAGS_KEY "map_write_flags"
 #define BIT_WRITE_FLAGS_KEY "bit_write_flags"
+#define HLL_WRITE_FLAGS_KEY "hll_write_flags"
 
 #define POLICY_INIT(__policy) \
 	as_error_reset(err);\
@@ -43,6 +48,34 @@ if (!PyDict_Check(py_policy)) {\
 }\
 __policy##_init(policy);\
 
+/* A compiled policy of the same kind is used as it is, by pointer */
+#define POLICY_USE_COMPILED(__kind, __member) \
+if (py_policy && AerospikePolicy_Check(py_policy)) {\
+	as_error_reset(err);\
+	if (((AerospikePolicy *) py_policy)->kind != __kind) {\
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "policy must be a dict or a %s policy", #__member);\
+	}\
+	*policy_p = &((AerospikePolicy *) py_policy)->policy.__member;\
+	return err->code;\
+}
+
+/*
+ * Set last, so the predexps are only created if the whole policy converts.
+ * predexp_list is NULL for the commands which do not filter records.
+ */
+#define POLICY_SET_PREDEXP() { \
+	PyObject * py_predexp = PyDict_GetItemString(py_policy, "predexp");\
+	if (py_predexp && py_predexp != Py_None) {\
+		if (!predexp_list) {\
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "predexp is not supported by this method");\
+		}\
+		if (pyobject_to_predexp_list(err, py_predexp, predexp_list) != AEROSPIKE_OK) {\
+			return err->code;\
+		}\
+		policy->base.predexp = predexp_list;\
+	}\
+}
+
 #define POLICY_UPDATE() \
 	*policy_p = policy;
 
@@ -315,6 +348,38 @@ AerospikeConstants aerospike_constants[] = {
 	{ OP_BIT_LSCAN, "OP_BIT_LSCAN"},
 	{ OP_BIT_RSCAN, "OP_BIT_RSCAN"},
 
+	/* HyperLogLog constants: 3.10.0 */
+	{ AS_HLL_WRITE_DEFAULT, "HLL_WRITE_DEFAULT"},
+	{ AS_HLL_WRITE_CREATE_ONLY, "HLL_WRITE_CREATE_ONLY"},
+	{ AS_HLL_WRITE_UPDATE_ONLY, "HLL_WRITE_UPDATE_ONLY"},
+	{ AS_HLL_WRITE_NO_FAIL, "HLL_WRITE_NO_FAIL"},
+	{ AS_HLL_WRITE_ALLOW_FOLD, "HLL_WRITE_ALLOW_FOLD"},
+
+	/* HYPERLOGLOG OPS: 3.10.0 */
+	{ OP_HLL_INIT, "OP_HLL_INIT"},
+	{ OP_HLL_ADD, "OP_HLL_ADD"},
+	{ OP_HLL_GET_COUNT, "OP_HLL_GET_COUNT"},
+	{ OP_HLL_GET_UNION, "OP_HLL_GET_UNION"},
+	{ OP_HLL_GET_UNION_COUNT, "OP_HLL_GET_UNION_COUNT"},
+	{ OP_HLL_GET_INTERSECT_COUNT, "OP_HLL_GET_INTERSECT_COUNT"},
+	{ OP_HLL_GET_SIMILARITY, "OP_HLL_GET_SIMILARITY"},
+	{ OP_HLL_DESCRIBE, "OP_HLL_DESCRIBE"},
+	{ OP_HLL_FOLD, "OP_HLL_FOLD"},
+	{ OP_HLL_REFRESH_COUNT, "OP_HLL_REFRESH_COUNT"},
+	{ OP_HLL_SET_UNION, "OP_HLL_SET_UNION"},
+
+	/* Native aggregation constants: 3.10.0 */
+	{ AGGREGATE_COUNT, "AGGREGATE_COUNT"},
+	{ AGGREGATE_SUM, "AGGREGATE_SUM"},
+	{ AGGREGATE_MIN, "AGGREGATE_MIN"},
+	{ AGGREGATE_MAX, "AGGREGATE_MAX"},
+	{ AGGREGATE_HISTOGRAM, "AGGREGATE_HISTOGRAM"},
+
+	/* Multi-cluster write modes: 3.10.0 */
+	{ AS_MULTI_WRITE_PREFERRED, "MULTI_WRITE_PREFERRED"},
+	{ AS_MULTI_WRITE_PREFERRED_ONLY, "MULTI_WRITE_PREFERRED_ONLY"},
+	{ AS_MULTI_WRITE_ALL, "MULTI_WRITE_ALL"},
+
 	/* Nested CDT constants: 3.9.0 */
 	{ AS_CDT_CTX_LIST_INDEX, "CDT_CTX_LIST_INDEX"},
 	{ AS_CDT_CTX_LIST_RANK, "CDT_CTX_LIST_RANK"},
@@ -494,8 +559,12 @@ as_status pyobject_to_policy_admin(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_apply(as_error * err, PyObject * py_policy,
 		as_policy_apply * policy,
 		as_policy_apply ** policy_p,
-		as_policy_apply * config_apply_policy)
+		as_policy_apply * config_apply_policy,
+		as_predexp_list * predexp_list)
 {
+	// Use a compiled policy as it is
+	POLICY_USE_COMPILED(AS_POLICY_KIND_APPLY, apply);
+
 	// Initialize Policy
 	POLICY_INIT(as_policy_apply);
 	
@@ -516,6 +585,8 @@ as_status pyobject_to_policy_apply(as_error * err, PyObject * py_policy,
 	POLICY_SET_FIELD(commit_level, as_policy_commit_level);
 	POLICY_SET_FIELD(durable_delete, bool);
 
+	POLICY_SET_PREDEXP();
+
 	// Update the policy
 	POLICY_UPDATE();
 
@@ -561,6 +632,9 @@ as_status pyobject_to_policy_query(as_error * err, PyObject * py_policy,
 		as_policy_query ** policy_p,
 		as_policy_query * config_query_policy)
 {
+	// Use a compiled policy as it is
+	POLICY_USE_COMPILED(AS_POLICY_KIND_QUERY, query);
+
 	// Initialize Policy
 	POLICY_INIT(as_policy_query);
 
@@ -592,8 +666,12 @@ as_status pyobject_to_policy_query(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_read(as_error * err, PyObject * py_policy,
 		as_policy_read * policy,
 		as_policy_read ** policy_p,
-		as_policy_read * config_read_policy)
+		as_policy_read * config_read_policy,
+		as_predexp_list * predexp_list)
 {
+	// Use a compiled policy as it is
+	POLICY_USE_COMPILED(AS_POLICY_KIND_READ, read);
+
 	// Initialize Policy
 	POLICY_INIT(as_policy_read);
 	
@@ -616,6 +694,8 @@ as_status pyobject_to_policy_read(as_error * err, PyObject * py_policy,
 	POLICY_SET_FIELD(read_mode_ap, as_policy_read_mode_ap);
 	POLICY_SET_FIELD(read_mode_sc, as_policy_read_mode_sc);
 
+	POLICY_SET_PREDEXP();
+
 	// Update the policy
 	POLICY_UPDATE();
 
@@ -631,8 +711,12 @@ as_status pyobject_to_policy_read(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_remove(as_error * err, PyObject * py_policy,
 		as_policy_remove * policy,
 		as_policy_remove ** policy_p,
-		as_policy_remove * config_remove_policy)
+		as_policy_remove * config_remove_policy,
+		as_predexp_list * predexp_list)
 {
+	// Use a compiled policy as it is
+	POLICY_USE_COMPILED(AS_POLICY_KIND_REMOVE, remove);
+
 	// Initialize Policy
 	POLICY_INIT(as_policy_remove);
 	
@@ -655,6 +739,8 @@ as_status pyobject_to_policy_remove(as_error * err, PyObject * py_policy,
 	POLICY_SET_FIELD(replica, as_policy_replica);
 	POLICY_SET_FIELD(durable_delete, bool);
 
+	POLICY_SET_PREDEXP();
+
 	// Update the policy
 	POLICY_UPDATE();
 
@@ -670,8 +756,12 @@ as_status pyobject_to_policy_remove(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_scan(as_error * err, PyObject * py_policy,
 		as_policy_scan * policy,
 		as_policy_scan ** policy_p,
-		as_policy_scan * config_scan_policy)
+		as_policy_scan * config_scan_policy,
+		as_predexp_list * predexp_list)
 {
+	// Use a compiled policy as it is
+	POLICY_USE_COMPILED(AS_POLICY_KIND_SCAN, scan);
+
 	// Initialize Policy
 	POLICY_INIT(as_policy_scan);
 
@@ -690,6 +780,8 @@ as_status pyobject_to_policy_scan(as_error * err, PyObject * py_policy,
 	POLICY_SET_FIELD(fail_on_cluster_change, bool);
 	POLICY_SET_FIELD(durable_delete, bool);
 
+	POLICY_SET_PREDEXP();
+
 	// Update the policy
 	POLICY_UPDATE();
 
@@ -705,8 +797,12 @@ as_status pyobject_to_policy_scan(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_write(as_error * err, PyObject * py_policy,
 		as_policy_write * policy,
 		as_policy_write ** policy_p,
-		as_policy_write * config_write_policy)
+		as_policy_write * config_write_policy,
+		as_predexp_list * predexp_list)
 {
+	// Use a compiled policy as it is
+	POLICY_USE_COMPILED(AS_POLICY_KIND_WRITE, write);
+
 	// Initialize Policy
 	POLICY_INIT(as_policy_write);
 
@@ -730,6 +826,8 @@ as_status pyobject_to_policy_write(as_error * err, PyObject * py_policy,
 	POLICY_SET_FIELD(replica, as_policy_replica);
 	POLICY_SET_FIELD(compression_threshold, uint32_t);
 
+	POLICY_SET_PREDEXP();
+
 	// Update the policy
 	POLICY_UPDATE();
 
@@ -745,8 +843,12 @@ as_status pyobject_to_policy_write(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_operate(as_error * err, PyObject * py_policy,
 		as_policy_operate * policy,
 		as_policy_operate ** policy_p,
-		as_policy_operate * config_operate_policy)
+		as_policy_operate * config_operate_policy,
+		as_predexp_list * predexp_list)
 {
+	// Use a compiled policy as it is
+	POLICY_USE_COMPILED(AS_POLICY_KIND_OPERATE, operate);
+
 	// Initialize Policy
 	POLICY_INIT(as_policy_operate);
 	
@@ -773,6 +875,8 @@ as_status pyobject_to_policy_operate(as_error * err, PyObject * py_policy,
 	POLICY_SET_FIELD(read_mode_ap, as_policy_read_mode_ap);
 	POLICY_SET_FIELD(read_mode_sc, as_policy_read_mode_sc);
 
+	POLICY_SET_PREDEXP();
+
 	// Update the policy
 	POLICY_UPDATE();
 
@@ -788,8 +892,12 @@ as_status pyobject_to_policy_operate(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_batch(as_error * err, PyObject * py_policy,
 		as_policy_batch * policy,
 		as_policy_batch ** policy_p,
-		as_policy_batch * config_batch_policy)
+		as_policy_batch * config_batch_policy,
+		as_predexp_list * predexp_list)
 {
+	// Use a compiled policy as it is
+	POLICY_USE_COMPILED(AS_POLICY_KIND_BATCH, batch);
+
 	// Initialize Policy
 	POLICY_INIT(as_policy_batch);
 
@@ -814,6 +922,8 @@ as_status pyobject_to_policy_batch(as_error * err, PyObject * py_policy,
 	POLICY_SET_FIELD(read_mode_ap, as_policy_read_mode_ap);
 	POLICY_SET_FIELD(read_mode_sc, as_policy_read_mode_sc);
 
+	POLICY_SET_PREDEXP();
+
 	// Update the policy
 	POLICY_UPDATE();
 
@@ -838,6 +948,27 @@ pyobject_to_bit_policy(as_error* err, PyObject* py_policy, as_bit_policy* policy
     
     return err->code;
 }
+as_status
+pyobject_to_hll_policy(as_error* err, PyObject* py_policy, as_hll_policy* policy) {
+    as_hll_policy_init(policy);
+    POLICY_INIT(as_hll_policy);
+
+    PyObject* py_hll_flags = PyDict_GetItemString(py_policy, HLL_WRITE_FLAGS_KEY);
+    if (py_hll_flags) {
+        if (PyInt_Check(py_hll_flags)) {
+            as_hll_write_flags hll_write_flags = (as_hll_write_flags)PyInt_AsLong(py_hll_flags);
+            as_hll_policy_set_write_flags(policy, hll_write_flags);
+        } else {
+            return as_error_update(err, AEROSPIKE_ERR_PARAM, "hll_write_flags must be an integer");
+        }
+    } else if (PyErr_Occurred()) {
+        /* Fetching a map key failed internally for some reason, raise an error and exit.*/
+        PyErr_Clear();
+        return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to get hll_write_flags");
+    }
+
+    return err->code;
+}
 as_status pyobject_to_map_policy(as_error * err, PyObject * py_policy,
 		as_map_policy * policy)
 {
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_query.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_query.h>
+
+#include "aggregate.h"
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "policy.h"
+#include "query.h"
+
+typedef struct {
+	as_aggregates * aggregates;
+	as_error error;
+	as_throttle * throttle;
+} LocalData;
+
+static bool each_result(const as_val * val, void * udata)
+{
+	if (!val) {
+		return false;
+	}
+
+	LocalData * data = (LocalData *) udata;
+
+	// Records are read at the rate of results() and foreach().
+	as_throttle_acquire(data->throttle);
+
+	// Reduced without the GIL, stop the query on the first error.
+	if (as_val_type(val) != AS_REC) {
+		as_error_update(&data->error, AEROSPIKE_ERR_CLIENT,
+				"aggregate() requires record results, not stream UDF results");
+		return false;
+	}
+	return as_aggregates_add_record(data->aggregates, &data->error, as_record_fromval(val)) == AEROSPIKE_OK;
+}
+
+PyObject * AerospikeQuery_Aggregate(AerospikeQuery * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_aggregates = NULL;
+	PyObject * py_policy = NULL;
+	PyObject * py_options = NULL;
+	PyObject * py_result = NULL;
+
+	as_policy_query query_policy;
+	as_policy_query * query_policy_p = NULL;
+	as_aggregates aggregates;
+	bool aggregates_initialised = false;
+
+	LocalData data;
+	data.aggregates = &aggregates;
+	data.throttle = &self->throttle;
+	as_error_init(&data.error);
+	static char * kwlist[] = {"aggregates", "policy", "options", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O|OO:aggregate", kwlist, &py_aggregates, &py_policy, &py_options) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (!self || !self->client->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->client->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	// Convert python policy object to as_policy_query
+	pyobject_to_policy_query(&err, py_policy, &query_policy, &query_policy_p,
+			&self->client->as->config.policies.query);
+	if (err.code != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_throttle(&err, py_policy, &self->throttle) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (set_query_options(&err, py_options, &self->query) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_aggregates(&err, py_aggregates, &aggregates) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	aggregates_initialised = true;
+
+	Py_BEGIN_ALLOW_THREADS
+
+	aerospike_query_foreach(self->client->as, &err, query_policy_p, &self->query, each_result, &data);
+
+	Py_END_ALLOW_THREADS
+
+	if (data.error.code != AEROSPIKE_OK) {
+		as_error_copy(&err, &data.error);
+	}
+
+	if (err.code == AEROSPIKE_OK) {
+		as_aggregates_to_pyobject(&err, &aggregates, &py_result);
+	}
+
+CLEANUP:
+	if (aggregates_initialised) {
+		as_aggregates_destroy(&aggregates);
+	}
+
+	if (err.code != AEROSPIKE_OK) {
+		Py_XDECREF(py_result);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return py_result;
+}
@@ -57,7 +57,7 @@ PyObject * AerospikeQuery_ExecuteBackground(AerospikeQuery * self, PyObject * ar
 	}
 
     if (pyobject_to_policy_write(&err, py_policy, &write_policy, &write_policy_p,
-        &self->client->as->config.policies.write) != AEROSPIKE_OK) {
+        &self->client->as->config.policies.write, NULL) != AEROSPIKE_OK) {
             goto CLEANUP;
         }
 
@@ -34,6 +34,7 @@ typedef struct {
 	as_error error;
 	PyObject * callback;
 	AerospikeClient * client;
+	as_throttle * throttle;
 } LocalData;
 
 
@@ -48,6 +49,9 @@ static bool each_result(const as_val * val, void * udata)
 	// Extract callback user-data
 	LocalData * data = (LocalData *) udata;
 	as_error * err = &data->error;
+
+	// Wait for the record rate limit before taking the GIL
+	as_throttle_acquire(data->throttle);
 	PyObject * py_callback = data->callback;
 
 	// Python Function Arguments and Result Value
@@ -124,15 +128,20 @@ PyObject * AerospikeQuery_Foreach(AerospikeQuery * self, PyObject * args, PyObje
 	LocalData data;
 	data.callback = py_callback;
 	data.client = self->client;
+	data.throttle = &self->throttle;
 	as_error_init(&data.error);
 
 	// Aerospike Client Arguments
 	as_error err;
 	as_policy_query query_policy;
 	as_policy_query * query_policy_p = NULL;
+	as_latency_timer timer;
+	as_trace_span span;
 
 	// Initialize error
 	as_error_init(&err);
+	as_trace_begin(&span, AS_LATENCY_QUERY);
+	as_trace_namespace(&span, self->query.ns, self->query.set);
 
 	if (!self || !self->client->as) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
@@ -144,6 +153,8 @@ PyObject * AerospikeQuery_Foreach(AerospikeQuery * self, PyObject * args, PyObje
 		goto CLEANUP;
 	}
 
+	as_latency_timer_start(&timer, self->client->latency, AS_LATENCY_QUERY);
+
 	// Convert python policy object to as_policy_exists
 	pyobject_to_policy_query(&err, py_policy, &query_policy, &query_policy_p,
 			&self->client->as->config.policies.query);
@@ -151,10 +162,17 @@ PyObject * AerospikeQuery_Foreach(AerospikeQuery * self, PyObject * args, PyObje
 		goto CLEANUP;
 	}
 
+	if (pyobject_to_throttle(&err, py_policy, &self->throttle) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
 	if (set_query_options(&err, py_options, &self->query) != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
+	// The records are handed to the callback as they arrive, so in_c includes it.
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
+
 	// We are spawning multiple threads
 	PyThreadState * _save = PyEval_SaveThread();
 
@@ -163,12 +181,14 @@ PyObject * AerospikeQuery_Foreach(AerospikeQuery * self, PyObject * args, PyObje
 
 	// We are done using multiple threads
 	PyEval_RestoreThread(_save);
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 	if (data.error.code != AEROSPIKE_OK) {
 		as_error_update(&data.error, data.error.code, NULL);
 		goto CLEANUP;
 	}
 
 CLEANUP:
+	as_trace_end(&span, err.code != AEROSPIKE_OK ? &err : &data.error);
 	if (self->query.apply.arglist) {
 		as_arraylist_destroy( (as_arraylist *) self->query.apply.arglist );
 	}
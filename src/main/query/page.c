@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_query.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "paging.h"
+#include "policy.h"
+#include "query.h"
+
+PyObject * AerospikeQuery_Page(AerospikeQuery * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_max_records = NULL;
+	PyObject * py_token = NULL;
+	PyObject * py_policy = NULL;
+	PyObject * py_options = NULL;
+	PyObject * py_page = NULL;
+
+	as_policy_query query_policy;
+	as_policy_query * query_policy_p = NULL;
+	as_page_cursor * cursor = NULL;
+	uint32_t max_records = 0;
+
+	static char * kwlist[] = {"max_records", "token", "policy", "options", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O|OOO:page", kwlist,
+			&py_max_records, &py_token, &py_policy, &py_options) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (!self || !self->client->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->client->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_max_records(&err, py_max_records, &max_records) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	// The policy and options apply to the first page, later pages resume its stream.
+	if (!py_token || py_token == Py_None) {
+		py_token = Py_None;
+
+		pyobject_to_policy_query(&err, py_policy, &query_policy, &query_policy_p,
+				&self->client->as->config.policies.query);
+		if (err.code != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+
+		if (pyobject_to_throttle(&err, py_policy, &self->throttle) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+
+		if (set_query_options(&err, py_options, &self->query) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+
+		cursor = as_page_cursor_query(self->client, &self->query, query_policy_p, &self->throttle);
+		if (!cursor) {
+			as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the page cursor");
+			goto CLEANUP;
+		}
+	}
+
+	py_page = page_cursor_next(&err, &self->py_cursors, py_token, max_records, cursor);
+
+CLEANUP:
+
+	if (err.code != AEROSPIKE_OK) {
+		Py_XDECREF(py_page);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return py_page;
+}
@@ -8,6 +8,7 @@
 
 #include "client.h"
 #include "query.h"
+#include "predexp.h"
 #include "conversions.h"
 #include "exceptions.h"
 
@@ -61,53 +62,53 @@ typedef as_predexp_base* (no_arg_predexp_constructor) (void);
 
 /* Predexp constructor function which takes a single char* argument */
 as_status
-add_single_string_arg_predicate(as_query* query, PyObject* predicate, as_error* err,
+add_single_string_arg_predicate(as_predexp_list* predexps, PyObject* predicate, as_error* err,
 		single_string_predexp_constructor* constructor, const char* predicate_name);
 
 /* Predexp constructor function which takes a single char* argument */
 as_status
-add_no_arg_predicate(as_query* query, PyObject* predicate, as_error* err,
+add_no_arg_predicate(as_predexp_list* predexps, PyObject* predicate, as_error* err,
 		no_arg_predexp_constructor* no_arg_constructor, const char* predicate_name);
 
 /* Dispatch to another function based on what kind of predicate we have */
-as_status add_predexp(as_query* query, PyObject* predicate, as_error* err);
+as_status add_predexp(as_predexp_list* predexps, PyObject* predicate, as_error* err);
 
 /* Functions for converting a Python tuple into a predexp, and adding it to the query */
-as_status add_and(as_query* query, PyObject* predicate, as_error* err);
-as_status add_or(as_query* query, PyObject* predicate, as_error* err);
-as_status add_not(as_query* query, PyObject* predicate, as_error* err);
-as_status add_integer_val(as_query* query, PyObject* predicate, as_error* err);
-as_status add_string_val(as_query* query, PyObject* predicate, as_error* err);
-as_status add_geojson_val(as_query* query, PyObject* predicate, as_error* err);
-as_status add_int_bin(as_query* query, PyObject* predicate, as_error* err);
-as_status add_string_bin(as_query* query, PyObject* predicate, as_error* err);
-as_status add_geo_bin(as_query* query, PyObject* predicate, as_error* err);
-as_status add_list_bin(as_query* query, PyObject* predicate, as_error* err);
-as_status add_map_bin(as_query* query, PyObject* predicate, as_error* err);
-as_status add_integer_var(as_query* query, PyObject* predicate, as_error* err);
-as_status add_string_var(as_query* query, PyObject* predicate, as_error* err);
-as_status add_geojson_var(as_query* query, PyObject* predicate, as_error* err);
-as_status add_rec_device_size(as_query* query, PyObject* predicate, as_error* err);
-as_status add_rec_last_update(as_query* query, PyObject* predicate, as_error* err);
-as_status add_rec_void_time(as_query* query, PyObject* predicate, as_error* err);
-as_status add_rec_digest_modulo(as_query* query, PyObject* predicate, as_error* err);
-as_status add_integer_equal(as_query* query, PyObject* predicate, as_error* err);
-as_status add_integer_unequal(as_query* query, PyObject* predicate, as_error* err);
-as_status add_integer_greater(as_query* query, PyObject* predicate, as_error* err);
-as_status add_integer_greatereq(as_query* query, PyObject* predicate, as_error* err);
-as_status add_integer_less(as_query* query, PyObject* predicate, as_error* err);
-as_status add_integer_lesseq(as_query* query, PyObject* predicate, as_error* err);
-as_status add_string_equal(as_query* query, PyObject* predicate, as_error* err);
-as_status add_string_unequal(as_query* query, PyObject* predicate, as_error* err);
-as_status add_string_regex(as_query* query, PyObject* predicate, as_error* err);
-as_status add_geojson_within(as_query* query, PyObject* predicate, as_error* err);
-as_status add_geojson_contains(as_query* query, PyObject* predicate, as_error* err);
-as_status add_list_iterate_or(as_query* query, PyObject* predicate, as_error* err);
-as_status add_list_iterate_and(as_query* query, PyObject* predicate, as_error* err);
-as_status add_mapkey_iterate_or(as_query* query, PyObject* predicate, as_error* err);
-as_status add_mapkey_iterate_and(as_query* query, PyObject* predicate, as_error* err);
-as_status add_mapval_iterate_or(as_query* query, PyObject* predicate, as_error* err);
-as_status add_mapval_iterate_and(as_query* query, PyObject* predicate, as_error* err);
+as_status add_and(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_or(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_not(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_integer_val(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_string_val(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_geojson_val(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_int_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_string_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_geo_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_list_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_map_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_integer_var(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_string_var(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_geojson_var(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_rec_device_size(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_rec_last_update(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_rec_void_time(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_rec_digest_modulo(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_integer_equal(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_integer_unequal(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_integer_greater(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_integer_greatereq(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_integer_less(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_integer_lesseq(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_string_equal(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_string_unequal(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_string_regex(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_geojson_within(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_geojson_contains(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_list_iterate_or(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_list_iterate_and(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_mapkey_iterate_or(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_mapkey_iterate_and(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_mapval_iterate_or(as_predexp_list* predexps, PyObject* predicate, as_error* err);
+as_status add_mapval_iterate_and(as_predexp_list* predexps, PyObject* predicate, as_error* err);
 
 /* MACROS For simple tuple return functions */
 #define OneArgPredExpBuilderFunc(_name, _pyfunc_name, _predexp_code) static PyObject * AerospikePredExp_ ## _name(PyObject * self, PyObject * param) \
@@ -123,65 +124,66 @@ as_status add_mapval_iterate_and(as_query* query, PyObject* predicate, as_error*
 #define OneArgPredExpFunctionEntry(_name, _pyfunc_name, _doc_var) {#_pyfunc_name, (PyCFunction) AerospikePredExp_ ## _name, METH_O, _doc_var}
 #define NoArgPredExpFunctionEntry(_name, _pyfunc_name, _doc_var) {#_pyfunc_name, (PyCFunction) AerospikePredExp_ ## _name, METH_NOARGS, _doc_var}
 
-AerospikeQuery * AerospikeQuery_Predexp(AerospikeQuery * self, PyObject * args) {
-	PyObject* predicates_list = NULL;
-
-	as_error err;
-	as_error_init(&err);
+/**
+ * Convert a list of predexp tuples into predexps, in order.
+ * On success predexps is initialized and owned by the caller, on error it
+ * is left destroyed.
+ */
+as_status pyobject_to_predexp_list(as_error* err, PyObject* py_predicates, as_predexp_list* predexps) {
 	Py_ssize_t predicate_count = 0;
-	uint16_t predicates_stored = 0;
-	bool predicates_initialized = false;
-
-	if (PyArg_ParseTuple(args, "O", &predicates_list) == false) {
-		return NULL;
-	}
 
-	if (!PyList_Check(predicates_list)) {
-		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Predicates must be a list");
-		goto CLEANUP;
+	if (!PyList_Check(py_predicates)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Predicates must be a list");
 	}
 
-	predicate_count = PyList_Size(predicates_list);
+	predicate_count = PyList_Size(py_predicates);
 
 	if (predicate_count == 0) {
-		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Predicates list must not be empty");
-		goto CLEANUP;
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Predicates list must not be empty");
 	}
 
-	as_query_predexp_init(&self->query, predicate_count);
+	if (predicate_count > UINT16_MAX) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Predicates list is too long");
+	}
 
-	PyObject* predicateTuple = NULL;
+	as_predexp_list_init(predexps, (uint32_t) predicate_count);
 
 	for (Py_ssize_t i = 0; i < predicate_count; i++) {
-		predicateTuple = PyList_GetItem(predicates_list, i);
-		if (add_predexp(&self->query, predicateTuple, &err) != AEROSPIKE_OK) {
-			goto CLEANUP;
+		if (add_predexp(predexps, PyList_GetItem(py_predicates, i), err) != AEROSPIKE_OK) {
+			as_predexp_list_destroy(predexps);
+			return err->code;
 		}
-		predicates_stored += 1;
 	}
 
-CLEANUP:
+	return err->code;
+}
 
-	if (err.code != AEROSPIKE_OK) {
+AerospikeQuery * AerospikeQuery_Predexp(AerospikeQuery * self, PyObject * args) {
+	PyObject* predicates_list = NULL;
+	as_predexp_list predexps;
 
-		if (predicates_initialized) {
+	as_error err;
+	as_error_init(&err);
 
-			for (uint16_t ndx = 0; ndx < self->query.predexp.size; ++ndx) {
-				as_predexp_base * bp = self->query.predexp.entries[ndx];
-				if (!bp) {
-					break;
-				}
-				if (bp->dtor_fn) {
-					(*bp->dtor_fn)(bp);
-				}
-			}
+	if (PyArg_ParseTuple(args, "O", &predicates_list) == false) {
+		return NULL;
+	}
 
-			if ( self->query.predexp.entries && self->query.predexp._free) {
-				cf_free(self->query.predexp.entries);
-			}
-			self->query.predexp.entries = NULL;
-		}
+	if (pyobject_to_predexp_list(&err, predicates_list, &predexps) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	// The query takes ownership of the predexps, only the list is freed.
+	as_query_predexp_init(&self->query, (uint16_t) predexps.size);
+	for (uint32_t i = 0; i < predexps.size; i++) {
+		as_query_predexp_add(&self->query, predexps.entries[i]);
+	}
+	predexps.size = 0;
+	as_predexp_list_destroy(&predexps);
+
+CLEANUP:
 
+	if (err.code != AEROSPIKE_OK) {
 		PyObject * py_err = NULL;
 		error_to_pyobject(&err, &py_err);
 		PyObject *exception_type = raise_exception(&err);
@@ -192,9 +194,6 @@ CLEANUP:
 
 	Py_INCREF(self);
 	return self;
-
-
-//ERROR
 }
 
 
@@ -205,7 +204,7 @@ CLEANUP:
  *
  */
 
-as_status add_predexp(as_query* query, PyObject* predicate, as_error* err) {
+as_status add_predexp(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
 	long predicate_type = -1;
 
 	if (!predicate || !PyTuple_Check(predicate) || PyTuple_Size(predicate) < 1) {
@@ -222,177 +221,177 @@ as_status add_predexp(as_query* query, PyObject* predicate, as_error* err) {
 	switch (predicate_type) {
 
 		case AS_PREDEXP_AND: {
-			add_and(query, predicate, err);
+			add_and(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_OR: {
-			add_or(query, predicate, err);
+			add_or(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_NOT: {
-			add_not(query, predicate, err);
+			add_not(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_VALUE: {
-			add_integer_val(query, predicate, err);
+			add_integer_val(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_STRING_VALUE: {
-			add_string_val(query, predicate, err);
+			add_string_val(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_GEOJSON_VALUE: {
-			add_geojson_val(query, predicate, err);
+			add_geojson_val(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_BIN: {
-			add_int_bin(query, predicate, err);
+			add_int_bin(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_STRING_BIN: {
-			add_string_bin(query, predicate, err);
+			add_string_bin(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_GEOJSON_BIN: {
-			add_geo_bin(query, predicate, err);
+			add_geo_bin(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_LIST_BIN: {
-			add_list_bin(query, predicate, err);
+			add_list_bin(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_MAP_BIN: {
-			add_map_bin(query, predicate, err);
+			add_map_bin(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_VAR: {
-			add_integer_var(query, predicate, err);
+			add_integer_var(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_STRING_VAR: {
-			add_string_var(query, predicate, err);
+			add_string_var(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_GEOJSON_VAR: {
-			add_geojson_var(query, predicate, err);
+			add_geojson_var(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_REC_DEVICE_SIZE: {
-			add_rec_device_size(query, predicate, err);
+			add_rec_device_size(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_REC_LAST_UPDATE: {
-			add_rec_last_update(query, predicate, err);
+			add_rec_last_update(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_REC_VOID_TIME: {
-			add_rec_void_time(query, predicate, err);
+			add_rec_void_time(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_REC_DIGEST_MODULO: {
-			add_rec_digest_modulo(query, predicate, err);
+			add_rec_digest_modulo(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_EQUAL: {
-			add_integer_equal(query, predicate, err);
+			add_integer_equal(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_UNEQUAL: {
-			add_integer_unequal(query, predicate, err);
+			add_integer_unequal(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_GREATER: {
-			add_integer_greater(query, predicate, err);
+			add_integer_greater(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_GREATEREQ: {
-			add_integer_greatereq(query, predicate, err);
+			add_integer_greatereq(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_LESS: {
-			add_integer_less(query, predicate, err);
+			add_integer_less(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_INTEGER_LESSEQ: {
-			add_integer_lesseq(query, predicate, err);
+			add_integer_lesseq(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_STRING_EQUAL: {
-			add_string_equal(query, predicate, err);
+			add_string_equal(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_STRING_UNEQUAL: {
-			add_string_unequal(query, predicate, err);
+			add_string_unequal(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_STRING_REGEX: {
-			add_string_regex(query, predicate, err);
+			add_string_regex(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_GEOJSON_WITHIN: {
-			add_geojson_within(query, predicate, err);
+			add_geojson_within(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_GEOJSON_CONTAINS: {
-			add_geojson_contains(query, predicate, err);
+			add_geojson_contains(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_LIST_ITERATE_OR: {
-			add_list_iterate_or(query, predicate, err);
+			add_list_iterate_or(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_MAPKEY_ITERATE_OR: {
-			add_mapkey_iterate_or(query, predicate, err);
+			add_mapkey_iterate_or(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_MAPVAL_ITERATE_OR: {
-			add_mapval_iterate_or(query, predicate, err);
+			add_mapval_iterate_or(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_LIST_ITERATE_AND: {
-			add_list_iterate_and(query, predicate, err);
+			add_list_iterate_and(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_MAPKEY_ITERATE_AND: {
-			add_mapkey_iterate_and(query, predicate, err);
+			add_mapkey_iterate_and(predexps, predicate, err);
 			break;
 		}
 
 		case AS_PREDEXP_MAPVAL_ITERATE_AND: {
-			add_mapval_iterate_and(query, predicate, err);
+			add_mapval_iterate_and(predexps, predicate, err);
 			break;
 		}
 
@@ -403,11 +402,11 @@ as_status add_predexp(as_query* query, PyObject* predicate, as_error* err) {
 }
 
 /*
- * as_query_predexp_add(as_query* query, as_predexp_base * predexp)
+ * as_predexp_list_add(as_predexp_list* predexps, as_predexp_base * predexp)
  *
  */
 
-as_status add_and(as_query* query, PyObject* predicate, as_error* err) {
+as_status add_and(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
 	if (PyTuple_Size(predicate) != 2) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid and predicate");
 	}
@@ -423,13 +422,13 @@ as_status add_and(as_query* query, PyObject* predicate, as_error* err) {
 			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid number of items for predexp_and");
 		 }
 	}
-	if (!as_query_predexp_add(query, as_predexp_and(nitems))) {
+	if (!as_predexp_list_add(predexps, as_predexp_and(nitems))) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add and predicate");
 	}
 	return err->code;
 }
 
-as_status add_or(as_query* query, PyObject* predicate, as_error* err){
+as_status add_or(as_predexp_list* predexps, PyObject* predicate, as_error* err){
 	if (PyTuple_Size(predicate) != 2) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid or predicate");
 	}
@@ -446,17 +445,17 @@ as_status add_or(as_query* query, PyObject* predicate, as_error* err){
 			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid number of items for predexp_or");
 		 }
 	}
-	if (!as_query_predexp_add(query, as_predexp_or(nitems))) {
+	if (!as_predexp_list_add(predexps, as_predexp_or(nitems))) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add or predicate");
 	}
 	return err->code;
 }
 
-as_status add_not(as_query* query, PyObject* predicate, as_error* err){
-	return add_no_arg_predicate(query, predicate, err, as_predexp_not, "not");
+as_status add_not(as_predexp_list* predexps, PyObject* predicate, as_error* err){
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_not, "not");
 }
 
-as_status add_integer_val(as_query* query, PyObject* predicate, as_error* err){
+as_status add_integer_val(as_predexp_list* predexps, PyObject* predicate, as_error* err){
 	if (PyTuple_Size(predicate) != 2) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid integer val predicate");
 	}
@@ -469,66 +468,66 @@ as_status add_integer_val(as_query* query, PyObject* predicate, as_error* err){
 		PyErr_Clear();
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add integer_val predicate, due to integer conversion failure");
 	}
-	if (!as_query_predexp_add(query, as_predexp_integer_value(int_val))) {
+	if (!as_predexp_list_add(predexps, as_predexp_integer_value(int_val))) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add interger_val");
 	}
 	return err->code;
 }
 
-as_status add_string_val(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_string_value, "string value");
+as_status add_string_val(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_string_value, "string value");
 }
 
-as_status add_geojson_val(as_query* query, PyObject* predicate, as_error* err){
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_geojson_value, "geojson value");
+as_status add_geojson_val(as_predexp_list* predexps, PyObject* predicate, as_error* err){
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_geojson_value, "geojson value");
 }
 
-as_status add_int_bin(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_integer_bin, "integer bin");
+as_status add_int_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_integer_bin, "integer bin");
 }
 
-as_status add_string_bin(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_string_bin, "string bin");
+as_status add_string_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_string_bin, "string bin");
 }
 
-as_status add_geo_bin(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_geojson_bin, "geojson bin");
+as_status add_geo_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_geojson_bin, "geojson bin");
 }
 
-as_status add_list_bin(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_list_bin, "list bin");
+as_status add_list_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_list_bin, "list bin");
 }
 
-as_status add_map_bin(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_map_bin, "map bin");
+as_status add_map_bin(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_map_bin, "map bin");
 
 }
 
-as_status add_integer_var(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_integer_var, "integer var");
+as_status add_integer_var(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_integer_var, "integer var");
 }
 
-as_status add_string_var(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_string_var, "string var");
+as_status add_string_var(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_string_var, "string var");
 }
 
-as_status add_geojson_var(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_geojson_var, "geojson var");
+as_status add_geojson_var(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_geojson_var, "geojson var");
 }
 
-as_status add_rec_device_size(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_rec_device_size, "rec device size");
+as_status add_rec_device_size(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_rec_device_size, "rec device size");
 }
 
-as_status add_rec_last_update(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_rec_last_update, "rec last update");
+as_status add_rec_last_update(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_rec_last_update, "rec last update");
 }
 
-as_status add_rec_void_time(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_rec_void_time, "rec void time");
+as_status add_rec_void_time(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_rec_void_time, "rec void time");
 }
 
-as_status add_rec_digest_modulo(as_query* query, PyObject* predicate, as_error* err) {
+as_status add_rec_digest_modulo(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
 	if (PyTuple_Size(predicate) != 2) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid digest modulo predicate");
 	}
@@ -541,46 +540,46 @@ as_status add_rec_digest_modulo(as_query* query, PyObject* predicate, as_error*
 		PyErr_Clear();
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add rec_digest_modulo predicate, due to integer conversion failure");
 	}
-	if (!as_query_predexp_add(query, as_predexp_rec_digest_modulo(int_val))) {
+	if (!as_predexp_list_add(predexps, as_predexp_rec_digest_modulo(int_val))) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add digest modulo predicate");
 	}
 	return err->code;
 }
 
-as_status add_integer_equal(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_integer_equal, "integer equal");
+as_status add_integer_equal(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_integer_equal, "integer equal");
 }
 
-as_status add_integer_unequal(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_integer_unequal, "integer unequal");
+as_status add_integer_unequal(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_integer_unequal, "integer unequal");
 }
 
-as_status add_integer_greater(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_integer_greater, "integer greater");
+as_status add_integer_greater(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_integer_greater, "integer greater");
 }
 
-as_status add_integer_greatereq(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_integer_greatereq, "integer greatereq");
+as_status add_integer_greatereq(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_integer_greatereq, "integer greatereq");
 }
 
-as_status add_integer_less(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_integer_less, "integer less");
+as_status add_integer_less(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_integer_less, "integer less");
 }
 
-as_status add_integer_lesseq(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_integer_lesseq, "integer lesseq");
+as_status add_integer_lesseq(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_integer_lesseq, "integer lesseq");
 }
 
-as_status add_string_equal(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_string_equal, "string equal");
+as_status add_string_equal(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_string_equal, "string equal");
 }
 
-as_status add_string_unequal(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_string_unequal, "string unequal");
+as_status add_string_unequal(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_string_unequal, "string unequal");
 
 }
 
-as_status add_string_regex(as_query* query, PyObject* predicate, as_error* err) {
+as_status add_string_regex(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
 	if (PyTuple_Size(predicate) != 2) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid string regex predicate");
 	}
@@ -596,47 +595,47 @@ as_status add_string_regex(as_query* query, PyObject* predicate, as_error* err)
 			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid flags for string_regex.");
 		}
 	}
-	if (!as_query_predexp_add(query, as_predexp_string_regex(flags))) {
+	if (!as_predexp_list_add(predexps, as_predexp_string_regex(flags))) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add string regex predicate");
 	}
 	return err->code;
 }
 
-as_status add_geojson_within(as_query* query, PyObject* predicate, as_error* err){
-	return add_no_arg_predicate(query, predicate, err, as_predexp_geojson_within, "geojson within");
+as_status add_geojson_within(as_predexp_list* predexps, PyObject* predicate, as_error* err){
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_geojson_within, "geojson within");
 }
 
-as_status add_geojson_contains(as_query* query, PyObject* predicate, as_error* err) {
-	return add_no_arg_predicate(query, predicate, err, as_predexp_geojson_contains, "geojson contains");
+as_status add_geojson_contains(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_no_arg_predicate(predexps, predicate, err, as_predexp_geojson_contains, "geojson contains");
 }
 
-as_status add_list_iterate_or(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_list_iterate_or, "list_iterate_or");
+as_status add_list_iterate_or(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_list_iterate_or, "list_iterate_or");
 }
 
-as_status add_list_iterate_and(as_query* query, PyObject* predicate, as_error* err) {
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_list_iterate_and, "list_iterate_and");
+as_status add_list_iterate_and(as_predexp_list* predexps, PyObject* predicate, as_error* err) {
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_list_iterate_and, "list_iterate_and");
 }
 
-as_status add_mapkey_iterate_or(as_query* query, PyObject* predicate, as_error* err){
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_mapkey_iterate_or, "mapkey_iterate_or");
+as_status add_mapkey_iterate_or(as_predexp_list* predexps, PyObject* predicate, as_error* err){
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_mapkey_iterate_or, "mapkey_iterate_or");
 
 }
 
-as_status add_mapkey_iterate_and(as_query* query, PyObject* predicate, as_error* err){
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_mapkey_iterate_and, "mapkey_iterate_and");
+as_status add_mapkey_iterate_and(as_predexp_list* predexps, PyObject* predicate, as_error* err){
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_mapkey_iterate_and, "mapkey_iterate_and");
 }
 
-as_status add_mapval_iterate_or(as_query* query, PyObject* predicate, as_error* err){
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_mapval_iterate_or, "mapval_iterate_or");
+as_status add_mapval_iterate_or(as_predexp_list* predexps, PyObject* predicate, as_error* err){
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_mapval_iterate_or, "mapval_iterate_or");
 }
 
-as_status add_mapval_iterate_and(as_query* query, PyObject* predicate, as_error* err){
-	return add_single_string_arg_predicate(query, predicate, err, as_predexp_mapval_iterate_and, "mapval_iterate_and");
+as_status add_mapval_iterate_and(as_predexp_list* predexps, PyObject* predicate, as_error* err){
+	return add_single_string_arg_predicate(predexps, predicate, err, as_predexp_mapval_iterate_and, "mapval_iterate_and");
 }
 
 as_status
-add_single_string_arg_predicate(as_query* query, PyObject* predicate, as_error* err,
+add_single_string_arg_predicate(as_predexp_list* predexps, PyObject* predicate, as_error* err,
 		single_string_predexp_constructor* constructor, const char* predicate_name) {
 	char* c_var_name = NULL;
 	PyObject* py_uni = NULL;
@@ -656,7 +655,7 @@ add_single_string_arg_predicate(as_query* query, PyObject* predicate, as_error*
 		return err->code;
 	}
 
-	if (!as_query_predexp_add(query, constructor(c_var_name))) {
+	if (!as_predexp_list_add(predexps, constructor(c_var_name))) {
 		as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add %s predicate", predicate_name);
 	}
 
@@ -665,13 +664,13 @@ add_single_string_arg_predicate(as_query* query, PyObject* predicate, as_error*
 }
 
 as_status
-add_no_arg_predicate(as_query* query, PyObject* predicate, as_error* err,
+add_no_arg_predicate(as_predexp_list* predexps, PyObject* predicate, as_error* err,
 		no_arg_predexp_constructor* no_arg_constructor, const char* predicate_name) {
 
 	if (PyTuple_Size(predicate) != 1) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid %s predicate", predicate_name);
 	}
-	if (!as_query_predexp_add(query, no_arg_constructor())) {
+	if (!as_predexp_list_add(predexps, no_arg_constructor())) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to add %s predicate", predicate_name);
 	}
 	return err->code;
@@ -24,6 +24,7 @@
 #include <aerospike/as_arraylist.h>
 
 #include "client.h"
+#include "columnar.h"
 #include "conversions.h"
 #include "exceptions.h"
 #include "query.h"
@@ -35,6 +36,9 @@
 typedef struct {
 	PyObject * py_results;
 	AerospikeClient * client;
+	AerospikeColumnar * columnar;
+	as_throttle * throttle;
+	as_error error;
 } LocalData;
 
 static bool each_result(const as_val * val, void * udata)
@@ -48,6 +52,20 @@ static bool each_result(const as_val * val, void * udata)
 	py_results = data->py_results;
 	PyObject * py_result = NULL;
 
+	// Wait for the record rate limit before taking the GIL
+	as_throttle_acquire(data->throttle);
+
+	if (data->columnar) {
+		// Columns are built without the GIL, stop the query on the first error.
+		if (as_val_type(val) != AS_REC) {
+			as_error_update(&data->error, AEROSPIKE_ERR_CLIENT,
+					"The columnar format requires record results, not aggregation results");
+			return false;
+		}
+		return as_columns_append_record(&data->columnar->columns, &data->error,
+				as_record_fromval(val)) == AEROSPIKE_OK;
+	}
+
 	as_error err;
 
 	PyGILState_STATE gstate;
@@ -70,13 +88,18 @@ PyObject * AerospikeQuery_Results(AerospikeQuery * self, PyObject * args, PyObje
 	PyObject * py_policy = NULL;
 	PyObject * py_results = NULL;
 	PyObject* py_options = NULL;
+	PyObject * py_format = NULL;
+	bool columnar = false;
 
-	static char * kwlist[] = {"policy", "options", NULL};
+	static char * kwlist[] = {"policy", "options", "format", NULL};
 
 	LocalData data;
 	data.client = self->client;
+	data.columnar = NULL;
+	data.throttle = &self->throttle;
+	as_error_init(&data.error);
 
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "|OO:results", kwlist, &py_policy, &py_options) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|OOO:results", kwlist, &py_policy, &py_options, &py_format) == false) {
 		return NULL;
 	}
 
@@ -85,6 +108,11 @@ PyObject * AerospikeQuery_Results(AerospikeQuery * self, PyObject * args, PyObje
 
 	as_policy_query query_policy;
 	as_policy_query * query_policy_p = NULL;
+	as_latency_timer timer;
+	as_trace_span span;
+
+	as_trace_begin(&span, AS_LATENCY_QUERY);
+	as_trace_namespace(&span, self->query.ns, self->query.set);
 
 	if (!self || !self->client->as) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
@@ -96,6 +124,8 @@ PyObject * AerospikeQuery_Results(AerospikeQuery * self, PyObject * args, PyObje
 		goto CLEANUP;
 	}
 
+	as_latency_timer_start(&timer, self->client->latency, AS_LATENCY_QUERY);
+
 	// Convert python policy object to as_policy_query
 	pyobject_to_policy_query(&err, py_policy, &query_policy, &query_policy_p,
 			&self->client->as->config.policies.query);
@@ -103,20 +133,45 @@ PyObject * AerospikeQuery_Results(AerospikeQuery * self, PyObject * args, PyObje
 		goto CLEANUP;
 	}
 
+	if (pyobject_to_throttle(&err, py_policy, &self->throttle) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
 	if (set_query_options(&err, py_options,  &self->query) != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
-	py_results = PyList_New(0);
+	if (pyobject_to_result_format(&err, py_format, &columnar) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (columnar) {
+		data.columnar = AerospikeColumnar_New();
+		py_results = (PyObject *) data.columnar;
+	} else {
+		py_results = PyList_New(0);
+	}
+	if (!py_results) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate results");
+		goto CLEANUP;
+	}
 	data.py_results = py_results;
 
+	// The records are converted as they arrive, so in_c includes it.
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	PyThreadState * _save = PyEval_SaveThread();
 
 	aerospike_query_foreach(self->client->as, &err, query_policy_p, &self->query, each_result, &data);
 
 	PyEval_RestoreThread(_save);
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
+
+	if (data.error.code != AEROSPIKE_OK) {
+		as_error_copy(&err, &data.error);
+	}
 
 CLEANUP:/*??trace()*/
+	as_trace_end(&span, &err);
 	if (err.code != AEROSPIKE_OK) {
 		Py_XDECREF(py_results);
 		PyObject * py_err = NULL;
@@ -45,9 +45,22 @@ PyDoc_STRVAR(foreach_doc,
 Invoke the callback function for each of the records streaming back from the query.");
 
 PyDoc_STRVAR(results_doc,
-"results([policy]) -> list of (key, meta, bins)\n\
+"results([policy[, options[, format]]]) -> list of (key, meta, bins)\n\
 \n\
-Buffer the records resulting from the query, and return them as a list of records.");
+Buffer the records resulting from the query, and return them as a list of records. \
+With format='columnar' the records are returned as a ColumnarResult.");
+
+PyDoc_STRVAR(set_records_per_second_doc,
+"set_records_per_second(rate)\n\
+\n\
+Limit the rate records of the query are handed to the application, across all nodes. \
+0 removes the limit. May be called while the query is running.");
+
+PyDoc_STRVAR(page_doc,
+"page(max_records[, token[, policy[, options]]]) -> (list of (key, meta, bins), token)\n\
+\n\
+Return at most max_records results of the query, and a token to pass to the next call \
+to resume the same stream. The token is None once the query is exhausted.");
 
 PyDoc_STRVAR(select_doc,
 "select(bin1[, bin2[, bin3..]])\n\
@@ -71,6 +84,18 @@ PyDoc_STRVAR(execute_background_doc,
 \n\
 Buffer the records resulting from the query, and return them as a list of records.");
 
+PyDoc_STRVAR(aggregate_doc,
+"aggregate(aggregates[, policy[, options]]) -> dict\n\
+\n\
+Reduce the records resulting from the query to the aggregates, a dict of name to an aggregate built by \
+aerospike_helpers.aggregates. Records are reduced on the client's query threads without creating Python objects. \
+Returns a dict of name to reduced value.");
+
+static PyObject * AerospikeQuery_Set_Records_Per_Second(AerospikeQuery * self, PyObject * args, PyObject * kwds)
+{
+	return throttle_set_records_per_second(&self->throttle, args, kwds);
+}
+
 /*******************************************************************************
  * PYTHON TYPE METHODS
  ******************************************************************************/
@@ -86,6 +111,15 @@ static PyMethodDef AerospikeQuery_Type_Methods[] = {
 	{"results",	(PyCFunction) AerospikeQuery_Results,	METH_VARARGS | METH_KEYWORDS,
 				results_doc},
 
+	{"page",	(PyCFunction) AerospikeQuery_Page,	METH_VARARGS | METH_KEYWORDS,
+				page_doc},
+
+	{"aggregate",	(PyCFunction) AerospikeQuery_Aggregate,	METH_VARARGS | METH_KEYWORDS,
+				aggregate_doc},
+
+	{"set_records_per_second",	(PyCFunction) AerospikeQuery_Set_Records_Per_Second,	METH_VARARGS | METH_KEYWORDS,
+				set_records_per_second_doc},
+
 	{"select",	(PyCFunction) AerospikeQuery_Select,	METH_VARARGS | METH_KEYWORDS,
 				select_doc},
 
@@ -112,6 +146,7 @@ static PyObject * AerospikeQuery_Type_New(PyTypeObject * type, PyObject * args,
 
     if (self) {
         self->client = NULL;
+        as_throttle_init(&self->throttle);
     }
 
 	return (PyObject *) self;
@@ -179,6 +214,10 @@ CLEANUP:
 static void AerospikeQuery_Type_Dealloc(AerospikeQuery * self)
 {
 	int i;
+
+	// Stops the threads of any unfinished page cursors, which use the throttle.
+	Py_CLEAR(self->py_cursors);
+
 	for (i=0; i < self->u_objs.size; i++) {
 		Py_XDECREF(self->u_objs.ob[i]);
 	}
@@ -193,10 +232,23 @@ static void AerospikeQuery_Type_Dealloc(AerospikeQuery * self)
 	}
 
 	as_query_destroy(&self->query);
+	as_throttle_destroy(&self->throttle);
     Py_CLEAR(self->client);
 	Py_TYPE(self)->tp_free((PyObject *) self);
 }
 
+/*
+ * Every method is looked up here, so the client of a query created before a
+ * fork is reconnected on its first use in the child.
+ */
+static PyObject * AerospikeQuery_Type_Getattro(AerospikeQuery * self, PyObject * py_name)
+{
+	if (self->client) {
+		AerospikeClient_Fork_Ready(self->client);
+	}
+	return PyObject_GenericGetAttr((PyObject *) self, py_name);
+}
+
 /*******************************************************************************
  * PYTHON TYPE DESCRIPTOR
  ******************************************************************************/
@@ -218,7 +270,8 @@ static PyTypeObject AerospikeQuery_Type = {
 	0,                                  // tp_hash
 	0,                                  // tp_call
 	0,                                  // tp_str
-	0,                                  // tp_getattro
+	(getattrofunc) AerospikeQuery_Type_Getattro,
+	                                    // tp_getattro
 	0,                                  // tp_setattro
 	0,                                  // tp_as_buffer
 	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_scan.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_scan.h>
+
+#include "aggregate.h"
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "policy.h"
+#include "predexp.h"
+#include "scan.h"
+
+typedef struct {
+	as_aggregates * aggregates;
+	as_error error;
+	as_throttle * throttle;
+} LocalData;
+
+static bool each_result(const as_val * val, void * udata)
+{
+	if (!val) {
+		return false;
+	}
+
+	LocalData * data = (LocalData *) udata;
+
+	// Records are read at the rate of results() and foreach().
+	as_throttle_acquire(data->throttle);
+
+	// Reduced without the GIL, stop the scan on the first error.
+	return as_aggregates_add_record(data->aggregates, &data->error, as_record_fromval(val)) == AEROSPIKE_OK;
+}
+
+PyObject * AerospikeScan_Aggregate(AerospikeScan * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_aggregates = NULL;
+	PyObject * py_policy = NULL;
+	PyObject * py_nodename = NULL;
+	PyObject * py_ustr = NULL;
+	PyObject * py_result = NULL;
+
+	as_policy_scan scan_policy;
+	as_policy_scan * scan_policy_p = NULL;
+	as_predexp_list predexp_list;
+	as_aggregates aggregates;
+	bool aggregates_initialised = false;
+
+	char * nodename = NULL;
+	LocalData data;
+	data.aggregates = &aggregates;
+	data.throttle = &self->throttle;
+	as_error_init(&data.error);
+	static char * kwlist[] = {"aggregates", "policy", "nodename", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O|OO:aggregate", kwlist, &py_aggregates, &py_policy, &py_nodename) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (!self || !self->client->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+	if (!self->client->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	// Convert python policy object to as_policy_scan
+	pyobject_to_policy_scan(&err, py_policy, &scan_policy, &scan_policy_p,
+			&self->client->as->config.policies.scan, &predexp_list);
+	if (err.code != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_throttle(&err, py_policy, &self->throttle) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (py_nodename) {
+		if (PyString_Check(py_nodename)) {
+			nodename = PyString_AsString(py_nodename);
+		} else if (PyUnicode_Check(py_nodename)) {
+			py_ustr = PyUnicode_AsUTF8String(py_nodename);
+			if (!py_ustr) {
+				as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid unicode nodename");
+				goto CLEANUP;
+			}
+			nodename = PyBytes_AsString(py_ustr);
+		} else {
+			as_error_update(&err, AEROSPIKE_ERR_PARAM, "nodename must be a string");
+			goto CLEANUP;
+		}
+	}
+
+	if (pyobject_to_aggregates(&err, py_aggregates, &aggregates) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	aggregates_initialised = true;
+
+	Py_BEGIN_ALLOW_THREADS
+
+	if (nodename) {
+		aerospike_scan_node(self->client->as, &err, scan_policy_p, &self->scan, nodename, each_result, &data);
+	} else {
+		aerospike_scan_foreach(self->client->as, &err, scan_policy_p, &self->scan, each_result, &data);
+	}
+
+	Py_END_ALLOW_THREADS
+
+	if (data.error.code != AEROSPIKE_OK) {
+		as_error_copy(&err, &data.error);
+	}
+
+	if (err.code == AEROSPIKE_OK) {
+		as_aggregates_to_pyobject(&err, &aggregates, &py_result);
+	}
+
+CLEANUP:
+	PREDEXP_LIST_DESTROY(scan_policy_p, &predexp_list);
+
+	if (aggregates_initialised) {
+		as_aggregates_destroy(&aggregates);
+	}
+
+	Py_XDECREF(py_ustr);
+
+	if (err.code != AEROSPIKE_OK) {
+		Py_XDECREF(py_result);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return py_result;
+}
@@ -0,0 +1,627 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/aerospike_scan.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_scan.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_record_iterator.h>
+#include <aerospike/as_geojson.h>
+#include <aerospike/as_pair.h>
+
+#include "client.h"
+#include "columnar.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "policy.h"
+#include "predexp.h"
+#include "scan.h"
+
+#define EXPORT_FORMAT_NDJSON "ndjson"
+#define EXPORT_FORMAT_ARROW_IPC "arrow_ipc"
+
+// Size of the stdio buffer used for the export file.
+#define EXPORT_FILE_BUFFER_SIZE (1024 * 1024)
+
+// Records per Arrow record batch.
+#define EXPORT_ARROW_BATCH_ROWS 65536
+
+// Initial capacity of the per record line buffer.
+#define EXPORT_LINE_INIT_SIZE 1024
+
+/*
+ * Growable byte buffer used to format a single record.
+ * Records are formatted on the C client's scan threads without the GIL,
+ * so nothing in here may touch Python objects.
+ */
+typedef struct {
+	char * data;
+	size_t len;
+	size_t capacity;
+	bool on_heap;
+	bool failed;
+} export_buffer;
+
+typedef struct {
+	as_error error;
+	FILE * file;
+	pthread_mutex_t lock;
+	uint64_t written;
+	as_throttle * throttle;
+	// Batch being built and the stream it is written to, for arrow_ipc
+	as_columns columns;
+	as_ipc_writer ipc;
+} ExportData;
+
+static void buffer_reserve(export_buffer * buf, size_t extra)
+{
+	if (buf->failed || buf->len + extra <= buf->capacity) {
+		return;
+	}
+
+	size_t capacity = buf->capacity ? buf->capacity : EXPORT_LINE_INIT_SIZE;
+	while (capacity < buf->len + extra) {
+		capacity *= 2;
+	}
+
+	char * data = NULL;
+	if (buf->on_heap) {
+		data = realloc(buf->data, capacity);
+	}
+	else {
+		// The initial buffer lives on the caller's stack, move it to the heap.
+		data = malloc(capacity);
+		if (data && buf->len) {
+			memcpy(data, buf->data, buf->len);
+		}
+	}
+	if (!data) {
+		buf->failed = true;
+		return;
+	}
+	buf->data = data;
+	buf->on_heap = true;
+	buf->capacity = capacity;
+}
+
+static void buffer_append(export_buffer * buf, const char * str, size_t len)
+{
+	buffer_reserve(buf, len);
+	if (buf->failed) {
+		return;
+	}
+	memcpy(buf->data + buf->len, str, len);
+	buf->len += len;
+}
+
+static void buffer_append_str(export_buffer * buf, const char * str)
+{
+	buffer_append(buf, str, strlen(str));
+}
+
+static void buffer_append_char(export_buffer * buf, char c)
+{
+	buffer_append(buf, &c, 1);
+}
+
+static void buffer_append_json_string(export_buffer * buf, const char * str, size_t len)
+{
+	static const char hex[] = "0123456789abcdef";
+
+	buffer_append_char(buf, '"');
+	for (size_t i = 0; i < len; i++) {
+		unsigned char c = (unsigned char) str[i];
+		switch (c) {
+			case '"':
+				buffer_append(buf, "\\\"", 2);
+				break;
+			case '\\':
+				buffer_append(buf, "\\\\", 2);
+				break;
+			case '\n':
+				buffer_append(buf, "\\n", 2);
+				break;
+			case '\r':
+				buffer_append(buf, "\\r", 2);
+				break;
+			case '\t':
+				buffer_append(buf, "\\t", 2);
+				break;
+			default:
+				if (c < 0x20) {
+					char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+					buffer_append(buf, escaped, sizeof(escaped));
+				}
+				else {
+					buffer_append_char(buf, (char) c);
+				}
+		}
+	}
+	buffer_append_char(buf, '"');
+}
+
+static void buffer_append_hex(export_buffer * buf, const uint8_t * bytes, uint32_t size)
+{
+	static const char hex[] = "0123456789abcdef";
+
+	buffer_reserve(buf, (size_t) size * 2 + 2);
+	buffer_append_char(buf, '"');
+	for (uint32_t i = 0; i < size; i++) {
+		char pair[2] = {hex[bytes[i] >> 4], hex[bytes[i] & 0xf]};
+		buffer_append(buf, pair, 2);
+	}
+	buffer_append_char(buf, '"');
+}
+
+static void val_to_json(export_buffer * buf, const as_val * val);
+
+typedef struct {
+	export_buffer * buf;
+	bool first;
+} json_iter_data;
+
+static bool list_item_to_json(as_val * val, void * udata)
+{
+	json_iter_data * data = (json_iter_data *) udata;
+	if (!data->first) {
+		buffer_append_char(data->buf, ',');
+	}
+	data->first = false;
+	val_to_json(data->buf, val);
+	return !data->buf->failed;
+}
+
+static bool map_entry_to_json(const as_val * key, const as_val * val, void * udata)
+{
+	json_iter_data * data = (json_iter_data *) udata;
+	if (!data->first) {
+		buffer_append_char(data->buf, ',');
+	}
+	data->first = false;
+
+	// JSON object keys must be strings, so non-string map keys are stringified.
+	if (as_val_type(key) == AS_STRING) {
+		as_string * str = as_string_fromval(key);
+		buffer_append_json_string(data->buf, as_string_get(str), as_string_len(str));
+	}
+	else {
+		export_buffer key_buf = {NULL, 0, 0, true, false};
+		val_to_json(&key_buf, key);
+		if (key_buf.failed) {
+			data->buf->failed = true;
+		}
+		else {
+			buffer_append_json_string(data->buf, key_buf.data, key_buf.len);
+		}
+		free(key_buf.data);
+	}
+	buffer_append_char(data->buf, ':');
+	val_to_json(data->buf, val);
+	return !data->buf->failed;
+}
+
+static void val_to_json(export_buffer * buf, const as_val * val)
+{
+	char num[32];
+
+	if (!val) {
+		buffer_append_str(buf, "null");
+		return;
+	}
+
+	switch (as_val_type(val)) {
+		case AS_BOOLEAN:
+			buffer_append_str(buf, as_boolean_get(as_boolean_fromval(val)) ? "true" : "false");
+			break;
+		case AS_INTEGER:
+			snprintf(num, sizeof(num), "%" PRId64, as_integer_get(as_integer_fromval(val)));
+			buffer_append_str(buf, num);
+			break;
+		case AS_DOUBLE: {
+			double d = as_double_get(as_double_fromval(val));
+			if (isfinite(d)) {
+				snprintf(num, sizeof(num), "%.17g", d);
+				buffer_append_str(buf, num);
+			}
+			else {
+				buffer_append_str(buf, "null");
+			}
+			break;
+		}
+		case AS_STRING: {
+			as_string * str = as_string_fromval(val);
+			buffer_append_json_string(buf, as_string_get(str), as_string_len(str));
+			break;
+		}
+		case AS_GEOJSON: {
+			// GeoJSON is already a JSON document, embed it as is.
+			char * geo = as_geojson_get(as_geojson_fromval(val));
+			buffer_append_str(buf, geo ? geo : "null");
+			break;
+		}
+		case AS_BYTES: {
+			as_bytes * bytes = as_bytes_fromval(val);
+			buffer_append_hex(buf, as_bytes_get(bytes), as_bytes_size(bytes));
+			break;
+		}
+		case AS_LIST: {
+			json_iter_data data = {buf, true};
+			buffer_append_char(buf, '[');
+			as_list_foreach(as_list_fromval((as_val *) val), list_item_to_json, &data);
+			buffer_append_char(buf, ']');
+			break;
+		}
+		case AS_MAP: {
+			json_iter_data data = {buf, true};
+			buffer_append_char(buf, '{');
+			as_map_foreach(as_map_fromval(val), map_entry_to_json, &data);
+			buffer_append_char(buf, '}');
+			break;
+		}
+		case AS_PAIR: {
+			as_pair * pair = as_pair_fromval(val);
+			buffer_append_char(buf, '[');
+			val_to_json(buf, as_pair_1(pair));
+			buffer_append_char(buf, ',');
+			val_to_json(buf, as_pair_2(pair));
+			buffer_append_char(buf, ']');
+			break;
+		}
+		default:
+			buffer_append_str(buf, "null");
+			break;
+	}
+}
+
+/**
+ * Format a record as a single NDJSON line:
+ *
+ *     {"key": ..., "digest": "..", "gen": n, "ttl": n, "bins": {...}}\n
+ */
+static void record_to_json(export_buffer * buf, const as_record * rec)
+{
+	char num[32];
+
+	buffer_append_str(buf, "{\"key\":");
+	val_to_json(buf, (as_val *) rec->key.valuep);
+
+	buffer_append_str(buf, ",\"digest\":");
+	if (rec->key.digest.init) {
+		buffer_append_hex(buf, rec->key.digest.value, AS_DIGEST_VALUE_SIZE);
+	}
+	else {
+		buffer_append_str(buf, "null");
+	}
+
+	snprintf(num, sizeof(num), ",\"gen\":%u,\"ttl\":%u", rec->gen, rec->ttl);
+	buffer_append_str(buf, num);
+
+	buffer_append_str(buf, ",\"bins\":{");
+
+	as_record_iterator it;
+	as_record_iterator_init(&it, rec);
+	bool first = true;
+	while (as_record_iterator_has_next(&it)) {
+		as_bin * bin = as_record_iterator_next(&it);
+		if (!first) {
+			buffer_append_char(buf, ',');
+		}
+		first = false;
+		buffer_append_json_string(buf, as_bin_get_name(bin), strlen(as_bin_get_name(bin)));
+		buffer_append_char(buf, ':');
+		val_to_json(buf, (as_val *) as_bin_get_value(bin));
+	}
+	as_record_iterator_destroy(&it);
+
+	buffer_append_str(buf, "}}\n");
+}
+
+static bool each_result(const as_val * val, void * udata)
+{
+	if (!val) {
+		return false;
+	}
+
+	ExportData * data = (ExportData *) udata;
+	as_record * rec = as_record_fromval(val);
+	if (!rec) {
+		return true;
+	}
+
+	as_throttle_acquire(data->throttle);
+
+	char stack_data[EXPORT_LINE_INIT_SIZE];
+	export_buffer buf = {stack_data, 0, sizeof(stack_data), false, false};
+
+	// Format outside of the lock, only the write itself is serialized.
+	record_to_json(&buf, rec);
+
+	bool rval = true;
+	pthread_mutex_lock(&data->lock);
+	if (data->error.code != AEROSPIKE_OK) {
+		rval = false;
+	}
+	else if (buf.failed) {
+		as_error_update(&data->error, AEROSPIKE_ERR_CLIENT, "Unable to allocate memory for export record");
+		rval = false;
+	}
+	else if (fwrite(buf.data, 1, buf.len, data->file) != buf.len) {
+		as_error_update(&data->error, AEROSPIKE_ERR_CLIENT, "Unable to write to export file");
+		rval = false;
+	}
+	else {
+		data->written++;
+	}
+	pthread_mutex_unlock(&data->lock);
+
+	if (buf.on_heap) {
+		free(buf.data);
+	}
+
+	return rval;
+}
+
+/*
+ * Append the record to the current batch, and write the batch once it is full.
+ * Batches are written under the lock, they keep the order of the records.
+ */
+static bool each_arrow_result(const as_val * val, void * udata)
+{
+	if (!val) {
+		return false;
+	}
+
+	ExportData * data = (ExportData *) udata;
+	as_record * rec = as_record_fromval(val);
+	if (!rec) {
+		return true;
+	}
+
+	as_throttle_acquire(data->throttle);
+
+	bool rval = true;
+	pthread_mutex_lock(&data->lock);
+	if (data->error.code != AEROSPIKE_OK) {
+		rval = false;
+	}
+	else if (as_columns_append_record(&data->columns, &data->error, rec) != AEROSPIKE_OK) {
+		rval = false;
+	}
+	else {
+		data->written++;
+		if (data->columns.n_rows == EXPORT_ARROW_BATCH_ROWS &&
+				as_ipc_write_batch(&data->ipc, &data->error, &data->columns) != AEROSPIKE_OK) {
+			rval = false;
+		}
+	}
+	pthread_mutex_unlock(&data->lock);
+
+	return rval;
+}
+
+/*
+ * Select bins in scan, a copy of the Scan's as_scan, without changing the
+ * bins of its select(). The entries are owned by the copy.
+ */
+static as_status set_export_bins(as_error * err, as_scan * scan, PyObject * py_bins)
+{
+	if (!py_bins || py_bins == Py_None) {
+		return AEROSPIKE_OK;
+	}
+
+	if (!PyList_Check(py_bins)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "bins must be a list");
+	}
+
+	int nbins = (int) PyList_Size(py_bins);
+	scan->select.entries = NULL;
+	scan->select.capacity = 0;
+	scan->select.size = 0;
+	scan->select._free = false;
+	as_scan_select_init(scan, nbins);
+
+	for (int i = 0; i < nbins; i++) {
+		PyObject * py_bin = PyList_GetItem(py_bins, i);
+		PyObject * py_ustr = NULL;
+		char * bin = NULL;
+
+		if (string_and_pyuni_from_pystring(py_bin, &py_ustr, &bin, err) != AEROSPIKE_OK) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Bin name should be of type string");
+		}
+		as_scan_select(scan, bin);
+		Py_XDECREF(py_ustr);
+	}
+
+	return AEROSPIKE_OK;
+}
+
+/**
+ *******************************************************************************************************
+ * Execute the scan and write every record to a file, without creating Python objects
+ * for the records. Records are formatted on the C client's scan threads with the GIL released.
+ *
+ *		scan.export(path[, format[, bins[, policy[, options[, nodename]]]]])
+ *
+ * Returns the number of records written.
+ *******************************************************************************************************
+ */
+PyObject * AerospikeScan_Export(AerospikeScan * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_format = NULL;
+	PyObject * py_bins = NULL;
+	PyObject * py_policy = NULL;
+	PyObject * py_options = NULL;
+	PyObject * py_nodename = NULL;
+	PyObject * py_ustr = NULL;
+
+	char * path = NULL;
+	char * format = EXPORT_FORMAT_NDJSON;
+	char * nodename = NULL;
+	char * file_buffer = NULL;
+	bool arrow = false;
+	aerospike_scan_foreach_callback callback = each_result;
+
+	as_policy_scan scan_policy;
+	as_policy_scan * scan_policy_p = NULL;
+	as_predexp_list predexp_list;
+	as_scan scan;
+	bool scan_copied = false;
+
+	ExportData data;
+	data.file = NULL;
+	data.written = 0;
+	data.throttle = &self->throttle;
+	as_error_init(&data.error);
+	pthread_mutex_init(&data.lock, NULL);
+	as_columns_init(&data.columns);
+	as_ipc_writer_init(&data.ipc, NULL);
+
+	static char * kwlist[] = {"path", "format", "bins", "policy", "options", "nodename", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "s|OOOOO:export", kwlist, &path, &py_format,
+				&py_bins, &py_policy, &py_options, &py_nodename) == false) {
+		pthread_mutex_destroy(&data.lock);
+		as_columns_destroy(&data.columns);
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (!self || !self->client->as) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
+		goto CLEANUP;
+	}
+
+	if (!self->client->is_conn_16) {
+		as_error_update(&err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		goto CLEANUP;
+	}
+
+	if (py_format && py_format != Py_None) {
+		if (!PyString_Check(py_format)) {
+			as_error_update(&err, AEROSPIKE_ERR_PARAM, "format must be a string");
+			goto CLEANUP;
+		}
+		format = PyString_AsString(py_format);
+	}
+
+	if (strcmp(format, EXPORT_FORMAT_ARROW_IPC) == 0) {
+		arrow = true;
+		callback = each_arrow_result;
+	}
+	else if (strcmp(format, EXPORT_FORMAT_NDJSON) != 0) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid export format %s", format);
+		goto CLEANUP;
+	}
+
+	pyobject_to_policy_scan(&err, py_policy, &scan_policy, &scan_policy_p,
+			&self->client->as->config.policies.scan, &predexp_list);
+	if (err.code != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_throttle(&err, py_policy, &self->throttle) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (py_options && PyDict_Check(py_options)) {
+		set_scan_options(&err, &self->scan, py_options);
+		if (err.code != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	scan = self->scan;
+	scan_copied = true;
+	if (set_export_bins(&err, &scan, py_bins) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (py_nodename) {
+		if (string_and_pyuni_from_pystring(py_nodename, &py_ustr, &nodename, &err) != AEROSPIKE_OK) {
+			as_error_update(&err, AEROSPIKE_ERR_PARAM, "nodename must be a string");
+			goto CLEANUP;
+		}
+	}
+
+	data.file = fopen(path, arrow ? "wb" : "w");
+	if (!data.file) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to open export file %s", path);
+		goto CLEANUP;
+	}
+
+	file_buffer = malloc(EXPORT_FILE_BUFFER_SIZE);
+	if (file_buffer) {
+		setvbuf(data.file, file_buffer, _IOFBF, EXPORT_FILE_BUFFER_SIZE);
+	}
+	data.ipc.file = data.file;
+
+	Py_BEGIN_ALLOW_THREADS
+	if (nodename) {
+		aerospike_scan_node(self->client->as, &err, scan_policy_p, &scan, nodename, callback, &data);
+	} else {
+		aerospike_scan_foreach(self->client->as, &err, scan_policy_p, &scan, callback, &data);
+	}
+
+	if (arrow && err.code == AEROSPIKE_OK && data.error.code == AEROSPIKE_OK) {
+		as_ipc_write_end(&data.ipc, &data.error, &data.columns);
+	}
+	Py_END_ALLOW_THREADS
+
+	if (err.code == AEROSPIKE_OK && data.error.code != AEROSPIKE_OK) {
+		as_error_copy(&err, &data.error);
+	}
+
+CLEANUP:
+	PREDEXP_LIST_DESTROY(scan_policy_p, &predexp_list);
+
+	if (scan_copied && scan.select.entries != self->scan.select.entries) {
+		cf_free(scan.select.entries);
+	}
+
+	Py_XDECREF(py_ustr);
+
+	if (data.file) {
+		if (fclose(data.file) != 0 && err.code == AEROSPIKE_OK) {
+			as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to write to export file");
+		}
+	}
+	free(file_buffer);
+	pthread_mutex_destroy(&data.lock);
+	as_columns_destroy(&data.columns);
+	as_ipc_writer_destroy(&data.ipc);
+
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return PyLong_FromUnsignedLongLong(data.written);
+}
@@ -26,12 +26,14 @@
 #include "exceptions.h"
 #include "scan.h"
 #include "policy.h"
+#include "predexp.h"
 
 // Struct for Python User-Data for the Callback
 typedef struct {
 	as_error error;
 	PyObject * callback;
 	AerospikeClient * client;
+	as_throttle * throttle;
 } LocalData;
 
 
@@ -46,6 +48,9 @@ static bool each_result(const as_val * val, void * udata)
 	// Extract callback user-data
 	LocalData * data = (LocalData *) udata;
 	as_error * err = &data->error;
+
+	// Wait for the record rate limit before taking the GIL
+	as_throttle_acquire(data->throttle);
 	PyObject * py_callback = data->callback;
 
 	// Python Function Arguments and Result Value
@@ -114,6 +119,9 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 
 	as_policy_scan scan_policy;
 	as_policy_scan * scan_policy_p = NULL;
+	as_predexp_list predexp_list;
+	as_latency_timer timer;
+	as_trace_span span;
 
 	// Python Function Keyword Arguments
 	static char * kwlist[] = {"callback", "policy", "options", "nodename", NULL};
@@ -127,6 +135,7 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 	LocalData data;
 	data.callback = py_callback;
 	data.client = self->client;
+	data.throttle = &self->throttle;
 	as_error_init(&data.error);
 
 	// Aerospike Client Arguments
@@ -134,6 +143,8 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 
 	// Initialize error
 	as_error_init(&err);
+	as_trace_begin(&span, AS_LATENCY_SCAN);
+	as_trace_namespace(&span, self->scan.ns, self->scan.set);
 
 	if (!self || !self->client->as) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
@@ -145,12 +156,18 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 		goto CLEANUP;
 	}
 
+	as_latency_timer_start(&timer, self->client->latency, AS_LATENCY_SCAN);
+
 	// Convert python policy object to as_policy_exists
 	pyobject_to_policy_scan(&err, py_policy, &scan_policy, &scan_policy_p,
-			&self->client->as->config.policies.scan);
+			&self->client->as->config.policies.scan, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
+
+	if (pyobject_to_throttle(&err, py_policy, &self->throttle) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
 	if (py_options && PyDict_Check(py_options)) {
 		set_scan_options(&err, &self->scan, py_options);
 		if (err.code != AEROSPIKE_OK) {
@@ -175,6 +192,9 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 		}
 	}
 
+	// The records are handed to the callback as they arrive, so in_c includes it.
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
+
 	// We are spawning multiple threads
 	Py_BEGIN_ALLOW_THREADS
 	// Invoke operation
@@ -185,6 +205,7 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 	}
 	// We are done using multiple threads
 	Py_END_ALLOW_THREADS
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 
 	if (data.error.code != AEROSPIKE_OK) {
 		as_error_update(&data.error, data.error.code, NULL);
@@ -192,6 +213,9 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 	}
 
 CLEANUP:
+	as_trace_end(&span, err.code != AEROSPIKE_OK ? &err : &data.error);
+	PREDEXP_LIST_DESTROY(scan_policy_p, &predexp_list);
+
 
 	Py_XDECREF(py_ustr);
 
@@ -23,9 +23,11 @@
 #include <aerospike/as_scan.h>
 
 #include "client.h"
+#include "columnar.h"
 #include "conversions.h"
 #include "exceptions.h"
 #include "policy.h"
+#include "predexp.h"
 #include "scan.h"
 
 #undef TRACE
@@ -34,6 +36,9 @@
 typedef struct {
 	PyObject * py_results;
 	AerospikeClient * client;
+	AerospikeColumnar * columnar;
+	as_throttle * throttle;
+	as_error error;
 } LocalData;
 
 static bool each_result(const as_val * val, void * udata)
@@ -47,6 +52,15 @@ static bool each_result(const as_val * val, void * udata)
 	py_results = data->py_results;
 	PyObject * py_result = NULL;
 
+	// Wait for the record rate limit before taking the GIL
+	as_throttle_acquire(data->throttle);
+
+	if (data->columnar) {
+		// Columns are built without the GIL, stop the scan on the first error.
+		return as_columns_append_record(&data->columnar->columns, &data->error,
+				as_record_fromval(val)) == AEROSPIKE_OK;
+	}
+
 	as_error err;
 
 	PyGILState_STATE gstate;
@@ -69,22 +83,32 @@ PyObject * AerospikeScan_Results(AerospikeScan * self, PyObject * args, PyObject
 	PyObject * py_policy = NULL;
 	PyObject * py_results = NULL;
 	PyObject * py_nodename = NULL;
+	PyObject * py_format = NULL;
 	PyObject* py_ustr = NULL;
+	bool columnar = false;
 
 	as_policy_scan scan_policy;
 	as_policy_scan * scan_policy_p = NULL;
+	as_predexp_list predexp_list;
+	as_latency_timer timer;
+	as_trace_span span;
 
 	char* nodename = NULL;
 	LocalData data;
 	data.client = self->client;
-	static char * kwlist[] = {"policy", "nodename", NULL};
+	data.columnar = NULL;
+	data.throttle = &self->throttle;
+	as_error_init(&data.error);
+	static char * kwlist[] = {"policy", "nodename", "format", NULL};
 
-	if (PyArg_ParseTupleAndKeywords(args, kwds, "|OO:results", kwlist, &py_policy, &py_nodename) == false) {
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "|OOO:results", kwlist, &py_policy, &py_nodename, &py_format) == false) {
 		return NULL;
 	}
 
 	as_error err;
 	as_error_init(&err);
+	as_trace_begin(&span, AS_LATENCY_SCAN);
+	as_trace_namespace(&span, self->scan.ns, self->scan.set);
 
 	if (!self || !self->client->as) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid aerospike object");
@@ -95,14 +119,20 @@ PyObject * AerospikeScan_Results(AerospikeScan * self, PyObject * args, PyObject
 		goto CLEANUP;
 	}
 
+	as_latency_timer_start(&timer, self->client->latency, AS_LATENCY_SCAN);
+
 	// Convert python policy object to as_policy_scan
 	pyobject_to_policy_scan(&err, py_policy, &scan_policy, &scan_policy_p,
-			&self->client->as->config.policies.scan);
+			&self->client->as->config.policies.scan, &predexp_list);
 	if (err.code != AEROSPIKE_OK) {
 		as_error_update(&err, err.code, NULL);
 		goto CLEANUP;
 	}
 
+	if (pyobject_to_throttle(&err, py_policy, &self->throttle) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
 	/*
 	 * If the user specified a nodename, validate and convert it to a char*
 	 */
@@ -124,9 +154,24 @@ PyObject * AerospikeScan_Results(AerospikeScan * self, PyObject * args, PyObject
 		}
 	}
 
-	py_results = PyList_New(0);
+	if (pyobject_to_result_format(&err, py_format, &columnar) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (columnar) {
+		data.columnar = AerospikeColumnar_New();
+		py_results = (PyObject *) data.columnar;
+	} else {
+		py_results = PyList_New(0);
+	}
+	if (!py_results) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate results");
+		goto CLEANUP;
+	}
 	data.py_results = py_results;
 
+	// The records are converted as they arrive, so in_c includes it.
+	as_latency_timer_mark(&timer, AS_LATENCY_TO_C);
 	Py_BEGIN_ALLOW_THREADS
 
 	if (nodename) {
@@ -137,9 +182,16 @@ PyObject * AerospikeScan_Results(AerospikeScan * self, PyObject * args, PyObject
 
 
 	Py_END_ALLOW_THREADS
+	as_latency_timer_mark(&timer, AS_LATENCY_IN_C);
 
+	if (data.error.code != AEROSPIKE_OK) {
+		as_error_copy(&err, &data.error);
+	}
 
 CLEANUP:
+	as_trace_end(&span, &err);
+	PREDEXP_LIST_DESTROY(scan_policy_p, &predexp_list);
+
 
 	Py_XDECREF(py_ustr);
 
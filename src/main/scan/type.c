@@ -47,11 +47,43 @@ Set a filter on the record bins resulting from results() or foreach(). \
 If a selected bin does not exist in a record it will not appear in the bins portion of that record tuple.");
 
 PyDoc_STRVAR(results_doc,
-"results([policy [, nodename]) -> list of (key, meta, bins)\n\
+"results([policy [, nodename[, format]]) -> list of (key, meta, bins)\n\
 \n\
 Buffer the records resulting from the scan, and return them as a list of records.If provided \
-nodename should be the Node ID of a node to limit the scan to.");
+nodename should be the Node ID of a node to limit the scan to. \
+With format='columnar' the records are returned as a ColumnarResult.");
+
+PyDoc_STRVAR(set_records_per_second_doc,
+"set_records_per_second(rate)\n\
+\n\
+Limit the rate records of the scan are handed to the application, across all nodes. \
+0 removes the limit. May be called while the scan is running.");
+
+PyDoc_STRVAR(page_doc,
+"page(max_records[, token[, policy[, nodename]]]) -> (list of (key, meta, bins), token)\n\
+\n\
+Return at most max_records records of the scan, and a token to pass to the next call \
+to resume the same stream. The token is None once the scan is exhausted.");
+
+PyDoc_STRVAR(export_doc,
+"export(path[, format[, bins[, policy[, options[, nodename]]]]]) -> int\n\
+\n\
+Write the records resulting from the scan to the file at path, one JSON document per line. \
+Records are converted on the client's scan threads without creating Python objects. \
+Returns the number of records written.");
+
+
+PyDoc_STRVAR(aggregate_doc,
+"aggregate(aggregates[, policy[, nodename]]) -> dict\n\
+\n\
+Reduce the records resulting from the scan to the aggregates, a dict of name to an aggregate built by \
+aerospike_helpers.aggregates. Records are reduced on the client's scan threads without creating Python objects. \
+Returns a dict of name to reduced value.");
 
+static PyObject * AerospikeScan_Set_Records_Per_Second(AerospikeScan * self, PyObject * args, PyObject * kwds)
+{
+	return throttle_set_records_per_second(&self->throttle, args, kwds);
+}
 
 /*******************************************************************************
  * PYTHON TYPE METHODS
@@ -67,6 +99,18 @@ static PyMethodDef AerospikeScan_Type_Methods[] = {
 
 	{"results",	(PyCFunction) AerospikeScan_Results,	METH_VARARGS | METH_KEYWORDS,
 				results_doc},
+
+	{"page",	(PyCFunction) AerospikeScan_Page,	METH_VARARGS | METH_KEYWORDS,
+				page_doc},
+
+	{"set_records_per_second",	(PyCFunction) AerospikeScan_Set_Records_Per_Second,	METH_VARARGS | METH_KEYWORDS,
+				set_records_per_second_doc},
+
+	{"export",	(PyCFunction) AerospikeScan_Export,	METH_VARARGS | METH_KEYWORDS,
+				export_doc},
+
+	{"aggregate",	(PyCFunction) AerospikeScan_Aggregate,	METH_VARARGS | METH_KEYWORDS,
+				aggregate_doc},
 	{NULL}
 };
 
@@ -82,6 +126,7 @@ static PyObject * AerospikeScan_Type_New(PyTypeObject * type, PyObject * args, P
 
     if (self) {
         self->client = NULL;
+        as_throttle_init(&self->throttle);
     }
 
     return (PyObject *) self;
@@ -130,11 +175,26 @@ static int AerospikeScan_Type_Init(AerospikeScan * self, PyObject * args, PyObje
 
 static void AerospikeScan_Type_Dealloc(PyObject * self)
 {
+	// Stops the threads of any unfinished page cursors, which use the throttle.
+	Py_CLEAR(((AerospikeScan *)self)->py_cursors);
 	as_scan_destroy(&((AerospikeScan *)self)->scan);
+	as_throttle_destroy(&((AerospikeScan *)self)->throttle);
     Py_CLEAR(((AerospikeScan *)self)->client);
 	Py_TYPE(self)->tp_free((PyObject *) self);
 }
 
+/*
+ * Every method is looked up here, so the client of a scan created before a
+ * fork is reconnected on its first use in the child.
+ */
+static PyObject * AerospikeScan_Type_Getattro(AerospikeScan * self, PyObject * py_name)
+{
+	if (self->client) {
+		AerospikeClient_Fork_Ready(self->client);
+	}
+	return PyObject_GenericGetAttr((PyObject *) self, py_name);
+}
+
 /*******************************************************************************
  * PYTHON TYPE DESCRIPTOR
  ******************************************************************************/
@@ -157,7 +217,8 @@ static PyTypeObject AerospikeScan_Type = {
 	0,                                  // tp_hash
 	0,                                  // tp_call
 	0,                                  // tp_str
-	0,                                  // tp_getattro
+	(getattrofunc) AerospikeScan_Type_Getattro,
+	                                    // tp_getattro
 	0,                                  // tp_setattro
 	0,                                  // tp_as_buffer
 	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
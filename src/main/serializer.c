@@ -24,6 +24,7 @@
 #include "client.h"
 #include "conversions.h"
 #include "exceptions.h"
+#include "hll.h"
 #include "policy.h"
 #include "serializer.h"
 
@@ -542,6 +543,15 @@ extern as_status deserialize_based_on_as_bytes_type(AerospikeClient * self,
 								*retval = Py_None;
 							}
 							break;
+		case AS_BYTES_HLL:  {
+								PyObject* py_val = AerospikeHyperLogLog_New(as_bytes_get(bytes), as_bytes_size(bytes));
+								if (!py_val) {
+									as_error_update(error_p, AEROSPIKE_ERR_CLIENT, "Unable to deserialize bytes");
+									goto CLEANUP;
+								}
+								*retval = py_val;
+							}
+							break;
 		default:			{
 								// First try to return a raw byte array, if that fails raise an error
 								uint32_t bval_size = as_bytes_size(bytes);
@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <aerospike/as_error.h>
+
+#include "compiled_policy.h"
+#include "exceptions.h"
+#include "macros.h"
+#include "throttle.h"
+
+// Longest single sleep, so a raised rate takes effect promptly
+#define THROTTLE_MAX_SLEEP_US 50000
+
+static uint64_t throttle_now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+}
+
+// Allow bursts of a tenth of a second, so records flow smoothly rather than once a second.
+static double throttle_capacity(uint32_t rate)
+{
+	return rate >= 10 ? rate / 10.0 : 1.0;
+}
+
+void as_throttle_init(as_throttle * throttle)
+{
+	pthread_mutex_init(&throttle->lock, NULL);
+	throttle->rate = 0;
+	throttle->tokens = 0;
+	throttle->last_ns = 0;
+}
+
+void as_throttle_destroy(as_throttle * throttle)
+{
+	pthread_mutex_destroy(&throttle->lock);
+}
+
+void as_throttle_set_rate(as_throttle * throttle, uint32_t rate)
+{
+	pthread_mutex_lock(&throttle->lock);
+	if (throttle->rate == 0) {
+		// Start with a single token rather than a full burst.
+		throttle->tokens = 1.0;
+		throttle->last_ns = throttle_now_ns();
+	}
+	throttle->rate = rate;
+	if (rate && throttle->tokens > throttle_capacity(rate)) {
+		throttle->tokens = throttle_capacity(rate);
+	}
+	pthread_mutex_unlock(&throttle->lock);
+}
+
+void as_throttle_acquire(as_throttle * throttle)
+{
+	while (true) {
+		pthread_mutex_lock(&throttle->lock);
+
+		uint32_t rate = throttle->rate;
+		if (rate == 0) {
+			pthread_mutex_unlock(&throttle->lock);
+			return;
+		}
+
+		uint64_t now = throttle_now_ns();
+		throttle->tokens += (double) (now - throttle->last_ns) * rate / 1e9;
+		throttle->last_ns = now;
+		if (throttle->tokens > throttle_capacity(rate)) {
+			throttle->tokens = throttle_capacity(rate);
+		}
+
+		if (throttle->tokens >= 1.0) {
+			throttle->tokens -= 1.0;
+			pthread_mutex_unlock(&throttle->lock);
+			return;
+		}
+
+		uint64_t wait_us = (uint64_t) ((1.0 - throttle->tokens) * 1e6 / rate) + 1;
+		pthread_mutex_unlock(&throttle->lock);
+
+		usleep(wait_us < THROTTLE_MAX_SLEEP_US ? (useconds_t) wait_us : THROTTLE_MAX_SLEEP_US);
+	}
+}
+
+static as_status pyobject_to_rate(as_error * err, PyObject * py_rate, uint32_t * rate)
+{
+	if (!PyInt_Check(py_rate) && !PyLong_Check(py_rate)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "%s must be an integer", THROTTLE_POLICY_KEY);
+	}
+
+	long value = PyLong_AsLong(py_rate);
+	if (PyErr_Occurred() || value < 0 || value > UINT32_MAX) {
+		PyErr_Clear();
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "%s must be between 0 and %u",
+				THROTTLE_POLICY_KEY, UINT32_MAX);
+	}
+
+	*rate = (uint32_t) value;
+	return AEROSPIKE_OK;
+}
+
+as_status pyobject_to_records_per_second(as_error * err, PyObject * py_policy, uint32_t * rate)
+{
+	*rate = 0;
+	if (!py_policy || !PyDict_Check(py_policy)) {
+		return AEROSPIKE_OK;
+	}
+
+	PyObject * py_rate = PyDict_GetItemString(py_policy, THROTTLE_POLICY_KEY);
+	if (!py_rate) {
+		return AEROSPIKE_OK;
+	}
+	return pyobject_to_rate(err, py_rate, rate);
+}
+
+as_status pyobject_to_throttle(as_error * err, PyObject * py_policy, as_throttle * throttle)
+{
+	uint32_t rate = 0;
+
+	if (py_policy && AerospikePolicy_Check(py_policy)) {
+		rate = ((AerospikePolicy *) py_policy)->records_per_second;
+	}
+	else if (pyobject_to_records_per_second(err, py_policy, &rate) != AEROSPIKE_OK) {
+		return err->code;
+	}
+
+	// Set on every call, so a limit does not carry over to a later call without one.
+	as_throttle_set_rate(throttle, rate);
+	return AEROSPIKE_OK;
+}
+
+PyObject * throttle_set_records_per_second(as_throttle * throttle, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_rate = NULL;
+	uint32_t rate = 0;
+
+	static char * kwlist[] = {"rate", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O:set_records_per_second", kwlist,
+			&py_rate) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	if (pyobject_to_rate(&err, py_rate, &rate) != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	as_throttle_set_rate(throttle, rate);
+	Py_RETURN_NONE;
+}
@@ -0,0 +1,433 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_msgpack.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_val.h>
+
+#include "conversions.h"
+#include "exceptions.h"
+#include "macros.h"
+#include "trace.h"
+#include "types.h"
+
+#define TRACE_DEFAULT_BATCH_SIZE 100
+#define TRACE_DEFAULT_FLUSH_INTERVAL_MS 1000
+#define TRACE_DEFAULT_MAX_QUEUED 10000
+
+struct as_tracer_s {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	pthread_t thread;
+	bool stopping;
+	uint32_t fork_generation;           // as_fork_generation when the thread was started
+	PyObject * exporter;
+	uint32_t batch_size;
+	uint32_t flush_interval_ms;
+	uint32_t max_queued;
+	// Appended to by the commands and swapped by the thread, with the GIL held
+	as_trace_span * spans;
+	as_trace_span * spare;
+	uint32_t n_spans;
+};
+
+as_tracer * as_trace_tracer = NULL;
+
+static bool trace_atexit_registered = false;
+
+static void trace_deadline(struct timespec * ts, uint32_t ms)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	uint64_t ns = (uint64_t) now.tv_usec * 1000 + (uint64_t) ms * 1000000;
+	ts->tv_sec = now.tv_sec + (time_t) (ns / 1000000000);
+	ts->tv_nsec = (long) (ns % 1000000000);
+}
+
+static uint64_t trace_val_size(as_val * val)
+{
+	switch (as_val_type(val)) {
+		case AS_INTEGER:
+		case AS_DOUBLE:
+			return 8;
+		case AS_STRING:
+			return as_string_len((as_string *) val);
+		case AS_GEOJSON:
+			return as_geojson_len((as_geojson *) val);
+		case AS_BYTES:
+			return as_bytes_size((as_bytes *) val);
+		case AS_LIST:
+		case AS_MAP: {
+			as_serializer ser;
+			as_msgpack_init(&ser);
+			uint32_t size = as_serializer_serialize_getsize(&ser, val);
+			as_serializer_destroy(&ser);
+			return size;
+		}
+		default:
+			return 0;
+	}
+}
+
+uint64_t as_trace_record_size(const as_record * rec)
+{
+	uint64_t size = 0;
+
+	for (uint16_t i = 0; i < rec->bins.size; i++) {
+		as_val * val = (as_val *) rec->bins.entries[i].valuep;
+		if (val) {
+			size += trace_val_size(val);
+		}
+	}
+	return size;
+}
+
+void as_trace_start(as_trace_span * span, as_latency_command command)
+{
+	struct timespec ts;
+
+	memset(span, 0, sizeof(as_trace_span));
+	span->active = true;
+	span->command = command;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	span->start_ns = (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+	span->start_mono_ns = as_latency_now_ns();
+}
+
+static PyObject * trace_span_to_pyobject(as_trace_span * span)
+{
+	const char * command = as_latency_command_name(span->command);
+
+	return Py_BuildValue("{s:s,s:K,s:K,s:i,s:{s:s,s:s,s:s,s:s,s:I,s:K}}",
+			"name", command,
+			"start_time", (unsigned long long) span->start_ns,
+			"end_time", (unsigned long long) (span->start_ns + span->duration_ns),
+			"status_code", (int) span->status,
+			"attributes",
+				"db.system", "aerospike",
+				"db.operation", command,
+				"db.name", span->ns,
+				"db.aerospike.set", span->set,
+				"db.aerospike.records", (unsigned int) span->records,
+				"db.aerospike.payload_bytes", (unsigned long long) span->payload_bytes);
+}
+
+/*
+ * Hand the buffered spans to the exporter, the GIL must be held.
+ */
+static void tracer_export(as_tracer * tracer)
+{
+	as_trace_span * spans = tracer->spans;
+	uint32_t n_spans = tracer->n_spans;
+
+	if (!n_spans) {
+		return;
+	}
+
+	// The commands append to the other buffer meanwhile.
+	tracer->spans = tracer->spare;
+	tracer->spare = spans;
+	tracer->n_spans = 0;
+
+	PyObject * py_spans = PyList_New(n_spans);
+	for (uint32_t i = 0; py_spans && i < n_spans; i++) {
+		PyObject * py_span = trace_span_to_pyobject(&spans[i]);
+		if (!py_span) {
+			Py_CLEAR(py_spans);
+			break;
+		}
+		PyList_SET_ITEM(py_spans, i, py_span);
+	}
+
+	PyObject * py_result = py_spans ?
+		PyObject_CallFunctionObjArgs(tracer->exporter, py_spans, NULL) : NULL;
+
+	if (!py_result) {
+		PyErr_WriteUnraisable(tracer->exporter);
+	}
+
+	Py_XDECREF(py_result);
+	Py_XDECREF(py_spans);
+}
+
+static void * tracer_run(void * udata)
+{
+	as_tracer * tracer = (as_tracer *) udata;
+	bool stopping = false;
+
+	while (!stopping) {
+		pthread_mutex_lock(&tracer->lock);
+		if (!tracer->stopping) {
+			// Woken early when a batch is full.
+			struct timespec deadline;
+			trace_deadline(&deadline, tracer->flush_interval_ms);
+			pthread_cond_timedwait(&tracer->cond, &tracer->lock, &deadline);
+		}
+		stopping = tracer->stopping;
+		pthread_mutex_unlock(&tracer->lock);
+
+		// An unlocked peek, a span appended meanwhile waits for the next round.
+		if (tracer->n_spans || stopping) {
+			PyGILState_STATE gstate = PyGILState_Ensure();
+			tracer_export(tracer);
+			PyGILState_Release(gstate);
+		}
+	}
+
+	return NULL;
+}
+
+static as_tracer * tracer_new(void)
+{
+	as_tracer * tracer = calloc(1, sizeof(as_tracer));
+	if (tracer) {
+		pthread_mutex_init(&tracer->lock, NULL);
+		pthread_cond_init(&tracer->cond, NULL);
+		tracer->fork_generation = as_fork_generation;
+	}
+	return tracer;
+}
+
+static bool tracer_start_thread(as_tracer * tracer)
+{
+	// In a forked child, the lock may have been held by the thread of the parent.
+	if (tracer->fork_generation != as_fork_generation) {
+		pthread_mutex_init(&tracer->lock, NULL);
+		pthread_cond_init(&tracer->cond, NULL);
+	}
+
+	tracer->stopping = false;
+	if (pthread_create(&tracer->thread, NULL, tracer_run, tracer) != 0) {
+		return false;
+	}
+	tracer->fork_generation = as_fork_generation;
+	return true;
+}
+
+static void tracer_destroy(as_tracer * tracer)
+{
+	pthread_cond_destroy(&tracer->cond);
+	pthread_mutex_destroy(&tracer->lock);
+	Py_XDECREF(tracer->exporter);
+	free(tracer->spans);
+	free(tracer->spare);
+	free(tracer);
+}
+
+/*
+ * Export the remaining spans and free the tracer, the GIL must be held.
+ */
+static void tracer_stop(as_tracer * tracer)
+{
+	// The thread of the parent process does not exist in a forked child.
+	if (tracer->fork_generation == as_fork_generation) {
+		pthread_mutex_lock(&tracer->lock);
+		tracer->stopping = true;
+		pthread_cond_signal(&tracer->cond);
+		pthread_mutex_unlock(&tracer->lock);
+
+		Py_BEGIN_ALLOW_THREADS
+		pthread_join(tracer->thread, NULL);
+		Py_END_ALLOW_THREADS
+	}
+
+	tracer_export(tracer);
+	tracer_destroy(tracer);
+}
+
+void as_trace_finish(as_trace_span * span, as_status status)
+{
+	as_tracer * tracer = as_trace_tracer;
+
+	// The hook was removed while the command ran.
+	if (!tracer) {
+		return;
+	}
+
+	if (tracer->fork_generation != as_fork_generation && !tracer_start_thread(tracer)) {
+		return;
+	}
+
+	// Spans are dropped while the exporter is behind.
+	if (tracer->n_spans >= tracer->max_queued) {
+		return;
+	}
+
+	span->status = status;
+	span->duration_ns = as_latency_now_ns() - span->start_mono_ns;
+	tracer->spans[tracer->n_spans++] = *span;
+
+	if (tracer->n_spans % tracer->batch_size == 0) {
+		pthread_cond_signal(&tracer->cond);
+	}
+}
+
+static PyObject * trace_atexit(PyObject * self, PyObject * unused)
+{
+	as_tracer * tracer = as_trace_tracer;
+
+	// Threads calling into Python must end before the interpreter does.
+	if (tracer) {
+		as_trace_tracer = NULL;
+		tracer_stop(tracer);
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef trace_atexit_def = {
+	"_unset_trace_hook", (PyCFunction) trace_atexit, METH_NOARGS, NULL
+};
+
+static as_status trace_register_atexit(as_error * err)
+{
+	if (trace_atexit_registered) {
+		return err->code;
+	}
+
+	PyObject * py_atexit = PyImport_ImportModule("atexit");
+	PyObject * py_fn = PyCFunction_New(&trace_atexit_def, NULL);
+	PyObject * py_result = py_atexit && py_fn ?
+		PyObject_CallMethod(py_atexit, "register", "O", py_fn) : NULL;
+
+	if (py_result) {
+		trace_atexit_registered = true;
+	} else {
+		PyErr_Clear();
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to register the trace hook with atexit");
+	}
+
+	Py_XDECREF(py_result);
+	Py_XDECREF(py_fn);
+	Py_XDECREF(py_atexit);
+	return err->code;
+}
+
+static as_status trace_get_limit(as_error * err, PyObject * py_value, const char * name, uint32_t * value)
+{
+	if (!py_value) {
+		return err->code;
+	}
+
+	if (!PyInt_Check(py_value) && !PyLong_Check(py_value)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "%s must be an integer", name);
+	}
+
+	long limit = PyInt_AsLong(py_value);
+	if (limit < 1 || limit > UINT32_MAX) {
+		PyErr_Clear();
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "%s must be positive", name);
+	}
+
+	*value = (uint32_t) limit;
+	return err->code;
+}
+
+PyObject * Aerospike_Set_Trace_Hook(PyObject * parent, PyObject * args, PyObject * kwds)
+{
+	as_error err;
+	as_error_init(&err);
+
+	PyObject * py_exporter = NULL;
+	PyObject * py_batch_size = NULL;
+	PyObject * py_flush_interval = NULL;
+	PyObject * py_max_queued = NULL;
+	uint32_t batch_size = TRACE_DEFAULT_BATCH_SIZE;
+	uint32_t flush_interval_ms = TRACE_DEFAULT_FLUSH_INTERVAL_MS;
+	uint32_t max_queued = TRACE_DEFAULT_MAX_QUEUED;
+	as_tracer * tracer = NULL;
+
+	static char * kwlist[] = {"exporter", "batch_size", "flush_interval_ms", "max_queued", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "O|OOO:set_trace_hook", kwlist,
+			&py_exporter, &py_batch_size, &py_flush_interval, &py_max_queued) == false) {
+		return NULL;
+	}
+
+	if (py_exporter != Py_None && !PyCallable_Check(py_exporter)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Trace exporter must be callable or None");
+		goto CLEANUP;
+	}
+
+	if (trace_get_limit(&err, py_batch_size, "batch_size", &batch_size) != AEROSPIKE_OK ||
+			trace_get_limit(&err, py_flush_interval, "flush_interval_ms", &flush_interval_ms) != AEROSPIKE_OK ||
+			trace_get_limit(&err, py_max_queued, "max_queued", &max_queued) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	// The spans of the previous hook go to its exporter.
+	if (as_trace_tracer) {
+		as_tracer * previous = as_trace_tracer;
+		as_trace_tracer = NULL;
+		tracer_stop(previous);
+	}
+
+	if (py_exporter == Py_None) {
+		goto CLEANUP;
+	}
+
+	if (trace_register_atexit(&err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	tracer = tracer_new();
+	if (!tracer || !(tracer->spans = malloc(max_queued * sizeof(as_trace_span))) ||
+			!(tracer->spare = malloc(max_queued * sizeof(as_trace_span)))) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the span buffers");
+		goto CLEANUP;
+	}
+
+	Py_INCREF(py_exporter);
+	tracer->exporter = py_exporter;
+	tracer->batch_size = batch_size;
+	tracer->flush_interval_ms = flush_interval_ms;
+	tracer->max_queued = max_queued;
+
+	if (!tracer_start_thread(tracer)) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to start the trace exporter thread");
+		goto CLEANUP;
+	}
+
+	as_trace_tracer = tracer;
+	tracer = NULL;
+
+CLEANUP:
+	if (tracer) {
+		tracer_destroy(tracer);
+	}
+
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	return PyLong_FromLong(0);
+}
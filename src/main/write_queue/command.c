@@ -0,0 +1,442 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_boolean.h>
+#include <aerospike/as_buffer.h>
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_double.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_geojson.h>
+#include <aerospike/as_integer.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_msgpack.h>
+#include <aerospike/as_nil.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_record_iterator.h>
+#include <aerospike/as_serializer.h>
+#include <aerospike/as_string.h>
+#include <aerospike/as_vector.h>
+
+#include "client.h"
+#include "compiled_ops.h"
+#include "conversions.h"
+#include "policy.h"
+#include "predexp.h"
+#include "write_queue.h"
+
+/*
+ * Values converted from Python reference the Python objects and the static
+ * pool of the call, so they are copied into values owning their memory.
+ */
+static as_val * copy_val(const as_val * val)
+{
+	switch (as_val_type(val)) {
+		case AS_NIL:
+			return (as_val *) &as_nil;
+		case AS_BOOLEAN:
+			return (as_val *) as_boolean_new(as_boolean_get((as_boolean *) val));
+		case AS_INTEGER:
+			return (as_val *) as_integer_new(as_integer_get((as_integer *) val));
+		case AS_DOUBLE:
+			return (as_val *) as_double_new(as_double_get((as_double *) val));
+		case AS_STRING: {
+			char * str = strdup(as_string_get((as_string *) val));
+			return str ? (as_val *) as_string_new(str, true) : NULL;
+		}
+		case AS_GEOJSON: {
+			char * str = strdup(as_geojson_get((as_geojson *) val));
+			return str ? (as_val *) as_geojson_new(str, true) : NULL;
+		}
+		case AS_BYTES: {
+			as_bytes * bytes = (as_bytes *) val;
+			uint32_t size = as_bytes_size(bytes);
+			uint8_t * value = malloc(size ? size : 1);
+			if (!value) {
+				return NULL;
+			}
+			memcpy(value, as_bytes_get(bytes), size);
+			as_bytes * copy = as_bytes_new_wrap(value, size, true);
+			as_bytes_set_type(copy, as_bytes_get_type(bytes));
+			return (as_val *) copy;
+		}
+		default: {
+			// Lists and maps round trip through msgpack, which keeps the map order.
+			as_serializer ser;
+			as_buffer buffer;
+			as_val * copy = NULL;
+
+			as_msgpack_init(&ser);
+			as_buffer_init(&buffer);
+			if (as_serializer_serialize(&ser, (as_val *) val, &buffer) == 0) {
+				as_serializer_deserialize(&ser, &buffer, &copy);
+			}
+			as_buffer_destroy(&buffer);
+			as_serializer_destroy(&ser);
+			return copy;
+		}
+	}
+}
+
+/*
+ * The digest of key must be computed. copy is initialized even on error.
+ */
+static as_status copy_key(as_error * err, as_key * key, as_key * copy)
+{
+	if (!key->valuep) {
+		as_key_init_digest(copy, key->ns, key->set, key->digest.value);
+		return AEROSPIKE_OK;
+	}
+
+	as_val * value = copy_val((as_val *) key->valuep);
+	if (!value) {
+		as_key_init_digest(copy, key->ns, key->set, key->digest.value);
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to copy the key");
+	}
+
+	as_key_init_value(copy, key->ns, key->set, (as_key_value *) value);
+	copy->digest = key->digest;
+	return AEROSPIKE_OK;
+}
+
+static as_status copy_record(as_error * err, as_record * rec, as_record * copy)
+{
+	copy->ttl = rec->ttl;
+	copy->gen = rec->gen;
+
+	as_record_iterator it;
+	as_record_iterator_init(&it, rec);
+
+	while (as_record_iterator_has_next(&it)) {
+		as_bin * bin = as_record_iterator_next(&it);
+		as_val * value = copy_val((as_val *) as_bin_get_value(bin));
+		if (!value) {
+			as_record_iterator_destroy(&it);
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to copy bin %s", as_bin_get_name(bin));
+		}
+		if (!as_record_set(copy, as_bin_get_name(bin), (as_bin_value *) value)) {
+			as_val_destroy(value);
+			as_record_iterator_destroy(&it);
+			return as_error_update(err, AEROSPIKE_ERR_BIN_NAME, "Unable to set bin %s", as_bin_get_name(bin));
+		}
+	}
+
+	as_record_iterator_destroy(&it);
+	return AEROSPIKE_OK;
+}
+
+static as_status copy_operations(as_error * err, as_operations * ops, as_operations * copy)
+{
+	copy->ttl = ops->ttl;
+	copy->gen = ops->gen;
+
+	for (uint16_t i = 0; i < ops->binops.size; i++) {
+		as_binop * binop = &ops->binops.entries[i];
+		as_val * value = NULL;
+
+		if (binop->bin.valuep) {
+			value = copy_val((as_val *) binop->bin.valuep);
+			if (!value) {
+				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to copy the operation on bin %s",
+						binop->bin.name);
+			}
+		}
+
+		as_binop * binop_copy = &copy->binops.entries[copy->binops.size++];
+		binop_copy->op = binop->op;
+		as_bin_init(&binop_copy->bin, binop->bin.name, (as_bin_value *) value);
+	}
+
+	return AEROSPIKE_OK;
+}
+
+/*
+ * The resolved policy is copied into the command. A policy dict's predexps
+ * are already in cmd->predexp_list, a compiled policy's are kept alive by a
+ * reference to it.
+ */
+#define COMMAND_SET_POLICY(__kind, __policy_p, __py_policy) \
+	do {\
+		if (__policy_p) {\
+			if (__policy_p != &cmd->__kind##_policy) {\
+				cmd->__kind##_policy = *__policy_p;\
+			}\
+			cmd->__kind##_policy_p = &cmd->__kind##_policy;\
+			if (cmd->__kind##_policy.base.predexp && cmd->__kind##_policy.base.predexp != &cmd->predexp_list) {\
+				Py_INCREF(__py_policy);\
+				cmd->py_policy = __py_policy;\
+			}\
+		}\
+	} while (0)
+
+static as_write_command * command_new(as_error * err, as_write_command_type type)
+{
+	as_write_command * cmd = calloc(1, sizeof(as_write_command));
+	if (!cmd) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the write command");
+		return NULL;
+	}
+	cmd->type = type;
+	as_error_init(&cmd->err);
+	return cmd;
+}
+
+/*
+ * Free a command whose key and values are not initialized yet.
+ */
+static void command_discard(as_write_command * cmd)
+{
+	if (cmd->type == AS_WRITE_COMMAND_PUT) {
+		PREDEXP_LIST_DESTROY(cmd->write_policy_p, &cmd->predexp_list);
+	}
+	else {
+		PREDEXP_LIST_DESTROY(cmd->operate_policy_p, &cmd->predexp_list);
+	}
+	Py_XDECREF(cmd->py_policy);
+	free(cmd);
+}
+
+/*
+ * The sender threads can not take the GIL, so the cached record of the key
+ * is dropped when queued, and get() does not cache it again until sent.
+ */
+static void command_pin(AerospikeClient * client, as_write_command * cmd)
+{
+	as_near_cache_invalidate(client->near_cache, &cmd->key);
+	as_near_cache_pin(client->near_cache, &cmd->key);
+	cmd->near_cache = client->near_cache;
+}
+
+static void command_unpin(as_write_command * cmd)
+{
+	if (cmd->near_cache) {
+		as_near_cache_unpin(cmd->near_cache, &cmd->key);
+		cmd->near_cache = NULL;
+	}
+}
+
+as_status as_write_command_put(AerospikeClient * client, as_error * err, PyObject * py_key,
+		PyObject * py_bins, PyObject * py_meta, PyObject * py_policy, as_write_command ** cmd_p)
+{
+	as_policy_write * write_policy_p = NULL;
+	as_key key;
+	as_record rec;
+	bool key_initialised = false;
+	bool cmd_initialised = false;
+
+	as_record_init(&rec, 0);
+
+	as_static_pool static_pool;
+	memset(&static_pool, 0, sizeof(static_pool));
+
+	as_write_command * cmd = command_new(err, AS_WRITE_COMMAND_PUT);
+	if (!cmd) {
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_key(err, py_key, &key) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	key_initialised = true;
+
+	client->is_client_put_serializer = false;
+	if (pyobject_to_record(client, err, py_bins, py_meta, &rec, SERIALIZER_PYTHON, &static_pool) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_policy_write(err, py_policy, &cmd->write_policy, &write_policy_p,
+			&client->as->config.policies.write, &cmd->predexp_list) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	COMMAND_SET_POLICY(write, write_policy_p, py_policy);
+
+	if (!as_key_digest(&key)) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Unable to compute the digest of the key");
+		goto CLEANUP;
+	}
+	as_record_init(&cmd->rec, rec.bins.size);
+	cmd_initialised = true;
+	if (copy_key(err, &key, &cmd->key) == AEROSPIKE_OK) {
+		copy_record(err, &rec, &cmd->rec);
+	}
+	command_pin(client, cmd);
+
+CLEANUP:
+	POOL_DESTROY(&static_pool);
+
+	if (key_initialised) {
+		as_key_destroy(&key);
+	}
+	as_record_destroy(&rec);
+
+	if (err->code != AEROSPIKE_OK && cmd) {
+		if (cmd_initialised) {
+			as_write_command_destroy(cmd);
+		}
+		else {
+			command_discard(cmd);
+		}
+		cmd = NULL;
+	}
+
+	*cmd_p = cmd;
+	return err->code;
+}
+
+as_status as_write_command_operate(AerospikeClient * client, as_error * err, PyObject * py_key,
+		PyObject * py_list, PyObject * py_meta, PyObject * py_policy, as_write_command ** cmd_p)
+{
+	as_policy_operate * operate_policy_p = NULL;
+	as_key key;
+	as_operations ops;
+	bool key_initialised = false;
+	bool cmd_initialised = false;
+	long operation;
+	long return_type = -1;
+
+	as_vector * unicodeStrVector = as_vector_create(sizeof(char *), 128);
+
+	AerospikeCompiledOps * compiled = AerospikeCompiledOps_Check(py_list) ? (AerospikeCompiledOps *) py_list : NULL;
+	Py_ssize_t size = compiled ? compiled->size : (PyList_Check(py_list) ? PyList_Size(py_list) : 0);
+	as_operations_inita(&ops, size);
+
+	as_static_pool static_pool;
+	memset(&static_pool, 0, sizeof(static_pool));
+
+	as_write_command * cmd = command_new(err, AS_WRITE_COMMAND_OPERATE);
+	if (!cmd) {
+		goto CLEANUP;
+	}
+
+	if (!compiled && !PyList_Check(py_list)) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Operations should be of type list");
+		goto CLEANUP;
+	}
+
+	if (pyobject_to_key(err, py_key, &key) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	key_initialised = true;
+
+	if (py_meta && check_for_meta(py_meta, &ops, err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (compiled) {
+		if (compiled_ops_fill(client, err, compiled, NULL, unicodeStrVector, &static_pool, &ops) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	for (Py_ssize_t i = 0; !compiled && i < size; i++) {
+		PyObject * py_val = PyList_GetItem(py_list, i);
+
+		if (!PyDict_Check(py_val)) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation should be of type dict");
+			goto CLEANUP;
+		}
+		if (add_op(client, err, py_val, unicodeStrVector, &static_pool, &ops, &operation, &return_type) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	if (pyobject_to_policy_operate(err, py_policy, &cmd->operate_policy, &operate_policy_p,
+			&client->as->config.policies.operate, &cmd->predexp_list) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	COMMAND_SET_POLICY(operate, operate_policy_p, py_policy);
+
+	if (!as_key_digest(&key)) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Unable to compute the digest of the key");
+		goto CLEANUP;
+	}
+	as_operations_init(&cmd->ops, ops.binops.size);
+	cmd_initialised = true;
+	if (copy_key(err, &key, &cmd->key) == AEROSPIKE_OK) {
+		copy_operations(err, &ops, &cmd->ops);
+	}
+	command_pin(client, cmd);
+
+CLEANUP:
+	for (uint32_t i = 0; i < unicodeStrVector->size; i++) {
+		free(as_vector_get_ptr(unicodeStrVector, i));
+	}
+	as_vector_destroy(unicodeStrVector);
+
+	// The compiled operations are owned by the compiled object.
+	if (compiled) {
+		compiled_ops_release(compiled, &ops);
+	}
+	as_operations_destroy(&ops);
+	POOL_DESTROY(&static_pool);
+
+	if (key_initialised) {
+		as_key_destroy(&key);
+	}
+
+	if (err->code != AEROSPIKE_OK && cmd) {
+		if (cmd_initialised) {
+			as_write_command_destroy(cmd);
+		}
+		else {
+			command_discard(cmd);
+		}
+		cmd = NULL;
+	}
+
+	*cmd_p = cmd;
+	return err->code;
+}
+
+void as_write_command_execute(aerospike * as, as_write_command * cmd)
+{
+	as_error_reset(&cmd->err);
+
+	if (cmd->type == AS_WRITE_COMMAND_PUT) {
+		aerospike_key_put(as, &cmd->err, cmd->write_policy_p, &cmd->key, &cmd->rec);
+	}
+	else {
+		as_record * rec = NULL;
+		aerospike_key_operate(as, &cmd->err, cmd->operate_policy_p, &cmd->key, &cmd->ops, &rec);
+		if (rec) {
+			as_record_destroy(rec);
+		}
+	}
+	command_unpin(cmd);
+}
+
+void as_write_command_destroy(as_write_command * cmd)
+{
+	if (cmd->type == AS_WRITE_COMMAND_PUT) {
+		PREDEXP_LIST_DESTROY(cmd->write_policy_p, &cmd->predexp_list);
+		as_record_destroy(&cmd->rec);
+	}
+	else {
+		PREDEXP_LIST_DESTROY(cmd->operate_policy_p, &cmd->predexp_list);
+		as_operations_destroy(&cmd->ops);
+	}
+	command_unpin(cmd);
+	as_key_destroy(&cmd->key);
+	Py_XDECREF(cmd->py_policy);
+	free(cmd);
+}
@@ -0,0 +1,644 @@
+/*******************************************************************************
+ * Copyright 2013-2020 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <aerospike/as_error.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "exceptions.h"
+#include "write_queue.h"
+
+/*
+ * Sender thread. Takes the commands in order, and once closing, still sends
+ * the ones queued before it stops.
+ */
+static void * write_queue_run(void * udata)
+{
+	AerospikeWriteQueue * self = (AerospikeWriteQueue *) udata;
+
+	pthread_mutex_lock(&self->lock);
+
+	while (true) {
+		while (!self->head && !self->closing) {
+			pthread_cond_wait(&self->cond, &self->lock);
+		}
+
+		as_write_command * cmd = self->head;
+		if (!cmd) {
+			break;
+		}
+
+		self->head = cmd->next;
+		if (!self->head) {
+			self->tail = NULL;
+		}
+		cmd->next = NULL;
+		self->n_waiting--;
+		self->n_inflight++;
+		pthread_mutex_unlock(&self->lock);
+
+		if (!self->client->as || !self->client->is_conn_16) {
+			as_error_update(&cmd->err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");
+		}
+		else {
+			as_write_command_execute(self->client->as, cmd);
+		}
+
+		bool failed = cmd->err.code != AEROSPIKE_OK;
+		bool keep = (failed && self->on_error) || cmd->py_policy;
+		if (!keep) {
+			as_write_command_destroy(cmd);
+		}
+
+		pthread_mutex_lock(&self->lock);
+		self->n_inflight--;
+		if (failed) {
+			self->failed++;
+		}
+		else {
+			self->sent++;
+		}
+		if (keep) {
+			cmd->next = self->done;
+			self->done = cmd;
+		}
+		pthread_cond_broadcast(&self->done_cond);
+	}
+
+	pthread_mutex_unlock(&self->lock);
+	return NULL;
+}
+
+/*
+ * Must be called with the GIL held. Errors of the callback itself are
+ * reported as unraisable.
+ */
+static void write_queue_report(AerospikeWriteQueue * self, as_write_command * cmd)
+{
+	as_error conv_err;
+	as_error_init(&conv_err);
+
+	PyObject * py_key = NULL;
+	PyObject * py_err = NULL;
+	PyObject * py_exception = NULL;
+
+	key_to_pyobject(&conv_err, &cmd->key, &py_key);
+
+	error_to_pyobject(&cmd->err, &py_err);
+	PyObject * exception_type = raise_exception(&cmd->err);
+	py_exception = PyObject_CallObject(exception_type, py_err);
+
+	if (py_key && py_exception) {
+		PyObject * py_ret = PyObject_CallFunctionObjArgs(self->on_error, py_key, py_exception, NULL);
+		if (!py_ret) {
+			PyErr_WriteUnraisable(self->on_error);
+		}
+		Py_XDECREF(py_ret);
+	}
+	PyErr_Clear();
+
+	Py_XDECREF(py_key);
+	Py_XDECREF(py_err);
+	Py_XDECREF(py_exception);
+}
+
+/*
+ * Report the failed commands, oldest first, and destroy the completed ones
+ * which need the GIL. Must be called with the GIL held.
+ */
+static void write_queue_reap(AerospikeWriteQueue * self)
+{
+	pthread_mutex_lock(&self->lock);
+	as_write_command * done = self->done;
+	self->done = NULL;
+	pthread_mutex_unlock(&self->lock);
+
+	// The list is newest first.
+	as_write_command * ordered = NULL;
+	while (done) {
+		as_write_command * next = done->next;
+		done->next = ordered;
+		ordered = done;
+		done = next;
+	}
+
+	while (ordered) {
+		as_write_command * next = ordered->next;
+		if (ordered->err.code != AEROSPIKE_OK && self->on_error) {
+			write_queue_report(self, ordered);
+		}
+		as_write_command_destroy(ordered);
+		ordered = next;
+	}
+}
+
+/*
+ * Wait for the queued commands to complete. Must be called without the GIL.
+ */
+static void write_queue_wait(AerospikeWriteQueue * self)
+{
+	pthread_mutex_lock(&self->lock);
+	while (self->n_waiting || self->n_inflight) {
+		pthread_cond_wait(&self->done_cond, &self->lock);
+	}
+	pthread_mutex_unlock(&self->lock);
+}
+
+/*
+ * Send the queued commands and stop the sender threads. Must be called with
+ * the GIL.
+ */
+static void write_queue_close(AerospikeWriteQueue * self)
+{
+	pthread_mutex_lock(&self->lock);
+	bool closing = self->closing;
+	self->closing = true;
+	pthread_cond_broadcast(&self->cond);
+	pthread_mutex_unlock(&self->lock);
+
+	if (!closing) {
+		Py_BEGIN_ALLOW_THREADS
+		for (uint32_t i = 0; i < self->n_threads; i++) {
+			pthread_join(self->threads[i], NULL);
+		}
+		self->n_threads = 0;
+		Py_END_ALLOW_THREADS
+	}
+
+	write_queue_reap(self);
+}
+
+/*
+ * Queue a converted command, waiting for room if max_queued commands are
+ * waiting already. Must be called with the GIL, which is released to wait.
+ */
+static as_status write_queue_push(AerospikeWriteQueue * self, as_error * err, as_write_command * cmd)
+{
+	pthread_mutex_lock(&self->lock);
+
+	if (self->max_queued && self->n_waiting >= self->max_queued && !self->closing) {
+		pthread_mutex_unlock(&self->lock);
+		Py_BEGIN_ALLOW_THREADS
+		pthread_mutex_lock(&self->lock);
+		while (self->n_waiting >= self->max_queued && !self->closing) {
+			pthread_cond_wait(&self->done_cond, &self->lock);
+		}
+		pthread_mutex_unlock(&self->lock);
+		Py_END_ALLOW_THREADS
+		pthread_mutex_lock(&self->lock);
+	}
+
+	if (self->closing) {
+		pthread_mutex_unlock(&self->lock);
+		as_write_command_destroy(cmd);
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "The write queue is closed");
+	}
+
+	if (self->tail) {
+		self->tail->next = cmd;
+	}
+	else {
+		self->head = cmd;
+	}
+	self->tail = cmd;
+	self->n_waiting++;
+	self->queued++;
+	pthread_cond_signal(&self->cond);
+	pthread_mutex_unlock(&self->lock);
+
+	return AEROSPIKE_OK;
+}
+
+/*
+ * Start the sender threads missing up to max_inflight. On failure, the queue
+ * is closed and the threads started are stopped. Must be called with the GIL.
+ */
+static bool write_queue_start(AerospikeWriteQueue * self, as_error * err)
+{
+	self->fork_generation = as_fork_generation;
+
+	for (uint32_t i = self->n_threads; i < self->max_inflight; i++) {
+		if (pthread_create(&self->threads[i], NULL, write_queue_run, self) != 0) {
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to start the write queue sender threads");
+			write_queue_close(self);
+			return false;
+		}
+		self->n_threads++;
+	}
+	return true;
+}
+
+/*
+ * The sender threads of a queue created before a fork do not exist in the
+ * child, and may have held the lock. The pending commands are the parent's
+ * to send and report, so they are dropped here, and the sender threads are
+ * started again if restart is set and the queue is open. Must be called with
+ * the GIL.
+ */
+static void write_queue_after_fork(AerospikeWriteQueue * self, bool restart)
+{
+	if (self->fork_generation == as_fork_generation) {
+		return;
+	}
+
+	pthread_mutex_init(&self->lock, NULL);
+	pthread_cond_init(&self->cond, NULL);
+	pthread_cond_init(&self->done_cond, NULL);
+	self->n_threads = 0;
+	self->n_waiting = 0;
+	self->n_inflight = 0;
+
+	as_write_command * lists[] = {self->head, self->done};
+	self->head = NULL;
+	self->tail = NULL;
+	self->done = NULL;
+	for (uint32_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+		while (lists[i]) {
+			as_write_command * next = lists[i]->next;
+			// Its pin is forgotten with the parent's, see as_near_cache_after_fork().
+			lists[i]->near_cache = NULL;
+			as_write_command_destroy(lists[i]);
+			lists[i] = next;
+		}
+	}
+
+	if (!restart || self->closing) {
+		self->fork_generation = as_fork_generation;
+		return;
+	}
+
+	AerospikeClient_Fork_Ready(self->client);
+	as_error err;
+	as_error_init(&err);
+	write_queue_start(self, &err);
+}
+
+/*
+ * Send the queued commands and close the queue before the client closes its
+ * cluster.
+ */
+static void write_queue_stop(PyObject * py_queue)
+{
+	AerospikeWriteQueue * self = (AerospikeWriteQueue *) py_queue;
+
+	write_queue_after_fork(self, false);
+	write_queue_close(self);
+}
+
+#define WRITE_QUEUE_CHECK_OPEN(__err) \
+	if (self->closing) {\
+		as_error_update(__err, AEROSPIKE_ERR_CLIENT, "The write queue is closed");\
+		goto CLEANUP;\
+	}\
+	if (!self->client->as || !self->client->is_conn_16) {\
+		as_error_update(__err, AEROSPIKE_ERR_CLUSTER, "No connection to aerospike cluster");\
+		goto CLEANUP;\
+	}
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+PyDoc_STRVAR(put_doc,
+"put(key, bins[, meta[, policy]]) -> None\n\
+\n\
+Queue a write of bins to the record of key. It is converted now and sent by a sender thread.");
+
+PyDoc_STRVAR(operate_doc,
+"operate(key, list[, meta[, policy]]) -> None\n\
+\n\
+Queue the operations of list, or compiled operations, on the record of key. Their results are discarded.");
+
+PyDoc_STRVAR(flush_doc,
+"flush() -> None\n\
+\n\
+Wait until the queued writes are sent, and report the failures to on_error.");
+
+PyDoc_STRVAR(close_doc,
+"close() -> None\n\
+\n\
+Send the queued writes and stop the sender threads. Further writes raise an error.");
+
+static PyObject * AerospikeWriteQueue_Put(AerospikeWriteQueue * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_key = NULL;
+	PyObject * py_bins = NULL;
+	PyObject * py_meta = NULL;
+	PyObject * py_policy = NULL;
+	as_write_command * cmd = NULL;
+
+	static char * kwlist[] = {"key", "bins", "meta", "policy", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO:put", kwlist,
+			&py_key, &py_bins, &py_meta, &py_policy) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	write_queue_reap(self);
+	WRITE_QUEUE_CHECK_OPEN(&err);
+
+	if (as_write_command_put(self->client, &err, py_key, py_bins, py_meta, py_policy, &cmd) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	write_queue_push(self, &err, cmd);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeWriteQueue_Operate(AerospikeWriteQueue * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_key = NULL;
+	PyObject * py_list = NULL;
+	PyObject * py_meta = NULL;
+	PyObject * py_policy = NULL;
+	as_write_command * cmd = NULL;
+
+	static char * kwlist[] = {"key", "list", "meta", "policy", NULL};
+
+	if (PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO:operate", kwlist,
+			&py_key, &py_list, &py_meta, &py_policy) == false) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	write_queue_reap(self);
+	WRITE_QUEUE_CHECK_OPEN(&err);
+
+	if (as_write_command_operate(self->client, &err, py_key, py_list, py_meta, py_policy, &cmd) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	write_queue_push(self, &err, cmd);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyObject *exception_type = raise_exception(&err);
+		PyErr_SetObject(exception_type, py_err);
+		Py_DECREF(py_err);
+		return NULL;
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeWriteQueue_Flush(AerospikeWriteQueue * self)
+{
+	Py_BEGIN_ALLOW_THREADS
+	write_queue_wait(self);
+	Py_END_ALLOW_THREADS
+
+	write_queue_reap(self);
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeWriteQueue_Close(AerospikeWriteQueue * self)
+{
+	write_queue_close(self);
+	Py_RETURN_NONE;
+}
+
+static PyObject * AerospikeWriteQueue_Enter(AerospikeWriteQueue * self)
+{
+	Py_INCREF(self);
+	return (PyObject *) self;
+}
+
+static PyObject * AerospikeWriteQueue_Exit(AerospikeWriteQueue * self, PyObject * args)
+{
+	write_queue_close(self);
+	Py_RETURN_FALSE;
+}
+
+static Py_ssize_t AerospikeWriteQueue_Length(AerospikeWriteQueue * self)
+{
+	write_queue_after_fork(self, true);
+
+	pthread_mutex_lock(&self->lock);
+	Py_ssize_t n_pending = (Py_ssize_t) (self->n_waiting + self->n_inflight);
+	pthread_mutex_unlock(&self->lock);
+	return n_pending;
+}
+
+#define WRITE_QUEUE_COUNTER_GETTER(__counter) \
+static PyObject * AerospikeWriteQueue_Get_##__counter(AerospikeWriteQueue * self, void * closure)\
+{\
+	pthread_mutex_lock(&self->lock);\
+	uint64_t count = self->__counter;\
+	pthread_mutex_unlock(&self->lock);\
+	return PyLong_FromUnsignedLongLong(count);\
+}
+
+WRITE_QUEUE_COUNTER_GETTER(queued)
+WRITE_QUEUE_COUNTER_GETTER(sent)
+WRITE_QUEUE_COUNTER_GETTER(failed)
+
+static PyMethodDef AerospikeWriteQueue_Type_Methods[] = {
+
+	{"put",	(PyCFunction) AerospikeWriteQueue_Put,	METH_VARARGS | METH_KEYWORDS,
+				put_doc},
+
+	{"operate",	(PyCFunction) AerospikeWriteQueue_Operate,	METH_VARARGS | METH_KEYWORDS,
+				operate_doc},
+
+	{"flush",	(PyCFunction) AerospikeWriteQueue_Flush,	METH_NOARGS,
+				flush_doc},
+
+	{"close",	(PyCFunction) AerospikeWriteQueue_Close,	METH_NOARGS,
+				close_doc},
+
+	{"__enter__",	(PyCFunction) AerospikeWriteQueue_Enter,	METH_NOARGS,
+				NULL},
+
+	{"__exit__",	(PyCFunction) AerospikeWriteQueue_Exit,	METH_VARARGS,
+				NULL},
+
+	{NULL}
+};
+
+static PyGetSetDef AerospikeWriteQueue_Type_GetSet[] = {
+	{"queued", (getter) AerospikeWriteQueue_Get_queued, NULL,
+		"Number of writes accepted by the queue.", NULL},
+	{"sent", (getter) AerospikeWriteQueue_Get_sent, NULL,
+		"Number of writes which succeeded.", NULL},
+	{"failed", (getter) AerospikeWriteQueue_Get_failed, NULL,
+		"Number of writes which failed.", NULL},
+	{NULL}
+};
+
+static PySequenceMethods AerospikeWriteQueue_Type_Sequence = {
+	(lenfunc) AerospikeWriteQueue_Length,       // sq_length
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static void AerospikeWriteQueue_Type_Dealloc(AerospikeWriteQueue * self)
+{
+	AerospikeClient_Unregister_Background(self->client, &self->background);
+	write_queue_after_fork(self, false);
+	write_queue_close(self);
+
+	free(self->threads);
+	pthread_cond_destroy(&self->cond);
+	pthread_cond_destroy(&self->done_cond);
+	pthread_mutex_destroy(&self->lock);
+	Py_CLEAR(self->on_error);
+	Py_CLEAR(self->client);
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+/*
+ * Every method is looked up here, so a queue created before a fork sends
+ * again on its first use in the child.
+ */
+static PyObject * AerospikeWriteQueue_Type_Getattro(AerospikeWriteQueue * self, PyObject * py_name)
+{
+	write_queue_after_fork(self, true);
+	return PyObject_GenericGetAttr((PyObject *) self, py_name);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeWriteQueue_Type = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"aerospike.WriteQueue",             // tp_name
+	sizeof(AerospikeWriteQueue),        // tp_basicsize
+	0,                                  // tp_itemsize
+	(destructor) AerospikeWriteQueue_Type_Dealloc,
+	                                    // tp_dealloc
+	0,                                  // tp_print
+	0,                                  // tp_getattr
+	0,                                  // tp_setattr
+	0,                                  // tp_compare
+	0,                                  // tp_repr
+	0,                                  // tp_as_number
+	&AerospikeWriteQueue_Type_Sequence,
+	                                    // tp_as_sequence
+	0,                                  // tp_as_mapping
+	0,                                  // tp_hash
+	0,                                  // tp_call
+	0,                                  // tp_str
+	(getattrofunc) AerospikeWriteQueue_Type_Getattro,
+	                                    // tp_getattro
+	0,                                  // tp_setattro
+	0,                                  // tp_as_buffer
+	Py_TPFLAGS_DEFAULT,                 // tp_flags
+	"Writes queued by client.write_queue(), converted on the caller\n"
+	"thread and sent by background threads without waiting for them.\n",
+	                                    // tp_doc
+	0,                                  // tp_traverse
+	0,                                  // tp_clear
+	0,                                  // tp_richcompare
+	0,                                  // tp_weaklistoffset
+	0,                                  // tp_iter
+	0,                                  // tp_iternext
+	AerospikeWriteQueue_Type_Methods,   // tp_methods
+	0,                                  // tp_members
+	AerospikeWriteQueue_Type_GetSet,    // tp_getset
+	0,                                  // tp_base
+	0,                                  // tp_dict
+	0,                                  // tp_descr_get
+	0,                                  // tp_descr_set
+	0,                                  // tp_dictoffset
+	0,                                  // tp_init
+	0,                                  // tp_alloc
+	0,                                  // tp_new
+	0,                                  // tp_free
+	0,                                  // tp_is_gc
+	0                                   // tp_bases
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeWriteQueue_Ready()
+{
+	return PyType_Ready(&AerospikeWriteQueue_Type) == 0 ? &AerospikeWriteQueue_Type : NULL;
+}
+
+AerospikeWriteQueue * AerospikeWriteQueue_New(AerospikeClient * client, as_error * err,
+		uint32_t max_inflight, uint32_t max_queued, PyObject * on_error)
+{
+	AerospikeWriteQueue * self = PyObject_New(AerospikeWriteQueue, &AerospikeWriteQueue_Type);
+	if (!self) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the write queue");
+		return NULL;
+	}
+
+	Py_INCREF(client);
+	self->client = client;
+	self->on_error = on_error != Py_None ? on_error : NULL;
+	Py_XINCREF(self->on_error);
+	self->max_inflight = max_inflight;
+	self->max_queued = max_queued;
+	self->head = NULL;
+	self->tail = NULL;
+	self->done = NULL;
+	self->n_waiting = 0;
+	self->n_inflight = 0;
+	self->closing = false;
+	self->queued = 0;
+	self->sent = 0;
+	self->failed = 0;
+	self->n_threads = 0;
+	self->fork_generation = as_fork_generation;
+	self->background.py_obj = NULL;
+	pthread_mutex_init(&self->lock, NULL);
+	pthread_cond_init(&self->cond, NULL);
+	pthread_cond_init(&self->done_cond, NULL);
+
+	// One sender thread per command in flight.
+	self->threads = calloc(max_inflight, sizeof(pthread_t));
+	if (!self->threads) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the write queue");
+		Py_DECREF(self);
+		return NULL;
+	}
+
+	if (AerospikeClient_Register_Background(client, err, &self->background, (PyObject *) self,
+			write_queue_stop) != AEROSPIKE_OK || !write_queue_start(self, err)) {
+		Py_DECREF(self);
+		return NULL;
+	}
+
+	return self;
+}
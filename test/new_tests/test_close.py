@@ -66,3 +66,42 @@ class TestClose():
         # This second call should not raise any errors
         self.client.close()
         assert self.client.is_connected() is False
+
+    def test_close_sends_write_queue(self):
+        keys = [('test', 'demo', 'close_queued%d' % i) for i in range(20)]
+        client = TestBaseClass.get_new_connection()
+        writes = client.write_queue(max_inflight=2)
+        for i, key in enumerate(keys):
+            writes.put(key, {'i': i})
+
+        client.close()
+
+        assert len(writes) == 0
+        assert writes.sent == len(keys)
+        with pytest.raises(e.ClientError):
+            writes.put(keys[0], {'i': 0})
+
+        client = TestBaseClass.get_new_connection()
+        for i, key in enumerate(keys):
+            _, _, bins = client.get(key)
+            assert bins == {'i': i}
+            client.remove(key)
+        client.close()
+
+    def test_close_flushes_counter_buffer(self):
+        key = ('test', 'demo', 'close_counter')
+        client = TestBaseClass.get_new_connection()
+        counters = client.counter_buffer(flush_interval_ms=60000)
+        counters.increment(key, 'hits', 3)
+
+        client.close()
+
+        assert len(counters) == 0
+        with pytest.raises(e.ClientError):
+            counters.increment(key, 'hits')
+
+        client = TestBaseClass.get_new_connection()
+        _, _, bins = client.get(key)
+        assert bins == {'hits': 3}
+        client.remove(key)
+        client.close()
@@ -0,0 +1,117 @@
+# -*- coding: utf-8 -*-
+
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestColumnarResults(TestBaseClass):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.test_ns = 'test'
+        self.test_set = 'columnar'
+        self.record_count = 10
+        self.keys = [('test', 'columnar', i) for i in range(self.record_count)]
+
+        for i, key in enumerate(self.keys):
+            rec = {
+                'name': 'name%s' % (str(i)),
+                'age': i,
+                'score': i / 2.0,
+                'tags': ['a', 'b'],
+                'blob': bytearray(b'\x00\x01')
+            }
+            # Every other record is missing the optional bin
+            if i % 2 == 0:
+                rec['optional'] = i
+            as_connection.put(key, rec)
+
+        def teardown():
+            for key in self.keys:
+                as_connection.remove(key)
+            try:
+                as_connection.remove(('test', 'columnar', 'map'))
+            except e.RecordNotFound:
+                pass
+
+        request.addfinalizer(teardown)
+
+    def test_get_many_columnar(self):
+        missing = ('test', 'columnar', 'missing')
+        result = self.as_connection.get_many(self.keys + [missing], format='columnar')
+
+        assert isinstance(result, aerospike.ColumnarResult)
+        assert result.num_rows == self.record_count + 1
+        assert len(result) == self.record_count + 1
+        assert set(result.column_names) == set(
+            ['name', 'age', 'score', 'tags', 'blob', 'optional'])
+
+    def test_get_many_columnar_to_pyarrow(self):
+        pyarrow = pytest.importorskip("pyarrow")
+        missing = ('test', 'columnar', 'missing')
+        batch = self.as_connection.get_many(self.keys + [missing], format='columnar').to_pyarrow()
+
+        assert batch.num_rows == self.record_count + 1
+        assert batch.column('age').to_pylist() == list(range(self.record_count)) + [None]
+        assert batch.column('name').to_pylist()[3] == 'name3'
+        assert batch.column('score').to_pylist()[3] == 1.5
+        assert batch.column('tags').to_pylist()[3] == ['a', 'b']
+        assert batch.column('blob').to_pylist()[3] == b'\x00\x01'
+        assert batch.column('optional').to_pylist()[:4] == [0, None, 2, None]
+        assert batch.schema.field('age').type == pyarrow.int64()
+
+    def test_get_many_columnar_capsule_interface(self):
+        pyarrow = pytest.importorskip("pyarrow")
+        if not hasattr(pyarrow.RecordBatch, '_import_from_c_capsule'):
+            pytest.skip("pyarrow does not support the Arrow PyCapsule interface")
+
+        result = self.as_connection.get_many(self.keys, format='columnar')
+        batch = pyarrow.record_batch(result)
+
+        assert batch.num_rows == self.record_count
+
+    def test_scan_results_columnar(self):
+        pytest.importorskip("pyarrow")
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        result = scan_obj.results(format='columnar')
+
+        assert result.num_rows == self.record_count
+        ages = result.to_pyarrow().column('age').to_pylist()
+        assert sorted(ages) == list(range(self.record_count))
+
+    def test_query_results_columnar(self):
+        query = self.as_connection.query(self.test_ns, self.test_set)
+
+        result = query.results(format='columnar')
+
+        assert result.num_rows == self.record_count
+
+    def test_columnar_with_map_bin(self):
+        self.as_connection.put(('test', 'columnar', 'map'), {'age': {'a': 1}})
+
+        with pytest.raises(e.ClientError):
+            self.as_connection.get_many([('test', 'columnar', 'map')], format='columnar')
+
+    def test_columnar_with_mixed_types(self):
+        self.as_connection.put(('test', 'columnar', 'map'), {'age': 'ten'})
+
+        with pytest.raises(e.ClientError):
+            self.as_connection.get_many(
+                self.keys + [('test', 'columnar', 'map')], format='columnar')
+
+    def test_columnar_with_invalid_format(self):
+        with pytest.raises(e.ParamError):
+            self.as_connection.get_many(self.keys, format='rows')
+
+        with pytest.raises(e.ParamError):
+            self.as_connection.scan(self.test_ns, self.test_set).results(format=1)
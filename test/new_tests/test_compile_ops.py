@@ -0,0 +1,157 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+import threading
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike_helpers.operations import operations
+from aerospike_helpers.operations import list_operations
+from aerospike_helpers.operations import map_operations
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestCompileOps(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.keys = [('test', 'demo', 'compile_ops_%d' % i) for i in range(5)]
+        for i, key in enumerate(self.keys):
+            as_connection.put(key, {'name': 'name%d' % i, 'age': i,
+                                    'list': [1, 2, 3], 'map': {'a': 1}})
+
+        def teardown():
+            for key in self.keys:
+                as_connection.remove(key)
+
+        request.addfinalizer(teardown)
+
+    def test_compiled_ops_match_dict_ops(self):
+        ops = [
+            operations.increment('age', 10),
+            operations.append('name', '_x'),
+            list_operations.list_append('list', 4),
+            map_operations.map_put('map', 'b', 2),
+            operations.read('age'),
+            operations.read('name')
+        ]
+        compiled = self.as_connection.compile_ops(ops)
+
+        assert len(compiled) == 6
+        assert compiled.num_params == 0
+
+        _, _, compiled_bins = self.as_connection.operate(self.keys[0], compiled)
+        _, _, dict_bins = self.as_connection.operate(self.keys[1], ops)
+
+        assert compiled_bins['age'] == 10
+        assert compiled_bins['name'] == 'name0_x'
+        assert dict_bins['age'] == 11
+        _, _, bins = self.as_connection.get(self.keys[0])
+        assert bins['list'] == [1, 2, 3, 4]
+        assert bins['map'] == {'a': 1, 'b': 2}
+
+    def test_compiled_ops_reused_across_keys(self):
+        compiled = self.as_connection.compile_ops([
+            operations.increment('age', 1),
+            operations.read('age')
+        ])
+
+        for i, key in enumerate(self.keys):
+            _, _, bins = self.as_connection.operate(key, compiled)
+            assert bins['age'] == i + 1
+
+    def test_compiled_ops_with_placeholders(self):
+        compiled = self.as_connection.compile_ops([
+            operations.increment('age', aerospike.Placeholder(0)),
+            operations.write('name', aerospike.Placeholder(1)),
+            operations.read('age'),
+            operations.read('name')
+        ])
+
+        assert compiled.num_params == 2
+
+        for i, key in enumerate(self.keys):
+            _, _, bins = self.as_connection.operate(key, compiled, values=[100, 'user%d' % i])
+            assert bins == {'age': i + 100, 'name': 'user%d' % i}
+
+    def test_operate_ordered_with_compiled_ops(self):
+        compiled = self.as_connection.compile_ops([
+            operations.read('name'),
+            operations.write('age', aerospike.Placeholder(0)),
+            operations.read('age')
+        ])
+
+        _, _, bins = self.as_connection.operate_ordered(self.keys[2], compiled, values=(42,))
+
+        assert bins == [('name', 'name2'), ('age', 42)]
+
+    def test_compiled_ops_with_meta(self):
+        compiled = self.as_connection.compile_ops([operations.increment('age', 1)])
+
+        self.as_connection.operate(self.keys[0], compiled, {'ttl': 1000})
+
+        _, meta = self.as_connection.exists(self.keys[0])
+        assert 0 < meta['ttl'] <= 1000
+
+    def test_compiled_ops_keep_their_bytes(self):
+        value = bytearray(b'abc')
+        compiled = self.as_connection.compile_ops([
+            operations.write('blob', value),
+            operations.write('bytes', b'xyz' * 10)
+        ])
+        value[0:3] = b'zzz'
+        del value
+
+        self.as_connection.operate(self.keys[0], compiled)
+
+        _, _, bins = self.as_connection.get(self.keys[0])
+        assert bins['blob'] == bytearray(b'abc')
+        assert bins['bytes'] == b'xyz' * 10
+
+    def test_compiled_ops_from_threads(self):
+        compiled = self.as_connection.compile_ops([
+            operations.increment('age', aerospike.Placeholder(0)),
+        ])
+
+        def work():
+            for _ in range(20):
+                self.as_connection.operate(self.keys[3], compiled, values=[1])
+
+        threads = [threading.Thread(target=work) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        _, _, bins = self.as_connection.get(self.keys[3])
+        assert bins['age'] == 3 + 80
+
+    def test_compiled_ops_missing_values(self):
+        compiled = self.as_connection.compile_ops([
+            operations.write('age', aerospike.Placeholder(1))
+        ])
+
+        with pytest.raises(e.ParamError):
+            self.as_connection.operate(self.keys[0], compiled)
+
+        with pytest.raises(e.ParamError):
+            self.as_connection.operate(self.keys[0], compiled, values=[1])
+
+    @pytest.mark.parametrize("ops", [
+        None,
+        [],
+        ['not an operation'],
+        [{'op': aerospike.OPERATOR_READ}],
+    ])
+    def test_compile_ops_with_invalid_ops(self, ops):
+        with pytest.raises(e.ParamError):
+            self.as_connection.compile_ops(ops)
+
+    def test_placeholder_with_negative_index(self):
+        with pytest.raises(e.ParamError):
+            aerospike.Placeholder(-1)
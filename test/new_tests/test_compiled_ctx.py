@@ -0,0 +1,107 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike_helpers import cdt_ctx
+from aerospike_helpers.operations import list_operations
+from aerospike_helpers.operations import map_operations
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestCompiledCtx(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.key = ('test', 'demo', 'compiled_ctx')
+        as_connection.put(self.key, {
+            'doc': {'profile': {'address': {'city': 'Paris', 'zip': '75001'}}},
+            'nested': [[1, 2, 3], [4, 5, 6]]
+        })
+
+        def teardown():
+            try:
+                as_connection.remove(self.key)
+            except e.RecordNotFound:
+                pass
+
+        request.addfinalizer(teardown)
+
+    def test_compile_ctx(self):
+        ctx = self.as_connection.compile_ctx([cdt_ctx.cdt_ctx_map_key('profile'),
+                                              cdt_ctx.cdt_ctx_map_key('address')])
+
+        assert isinstance(ctx, aerospike.CDTContext)
+        assert len(ctx) == 2
+
+    def test_compiled_ctx_matches_list(self):
+        ctx_list = [cdt_ctx.cdt_ctx_map_key('profile'), cdt_ctx.cdt_ctx_map_key('address')]
+        ctx = self.as_connection.compile_ctx(ctx_list)
+
+        _, _, expected = self.as_connection.operate(self.key, [
+            map_operations.map_get_by_key('doc', 'city', aerospike.MAP_RETURN_VALUE, ctx=ctx_list)
+        ])
+        _, _, bins = self.as_connection.operate(self.key, [
+            map_operations.map_get_by_key('doc', 'city', aerospike.MAP_RETURN_VALUE, ctx=ctx)
+        ])
+
+        assert bins == expected == {'doc': 'Paris'}
+
+    def test_compiled_ctx_reused(self):
+        ctx = self.as_connection.compile_ctx([cdt_ctx.cdt_ctx_list_index(1)])
+
+        for i in range(3):
+            self.as_connection.operate(self.key, [
+                list_operations.list_append('nested', 7 + i, ctx=ctx)
+            ])
+        _, _, bins = self.as_connection.operate(self.key, [
+            list_operations.list_get_by_index('nested', -1, aerospike.LIST_RETURN_VALUE, ctx=ctx),
+            list_operations.list_size('nested', ctx=ctx)
+        ])
+
+        assert bins == {'nested': 6}
+        _, _, bins = self.as_connection.get(self.key)
+        assert bins['nested'] == [[1, 2, 3], [4, 5, 6, 7, 8, 9]]
+
+    def test_compiled_ctx_in_compiled_ops(self):
+        ctx = self.as_connection.compile_ctx([cdt_ctx.cdt_ctx_map_key('profile'),
+                                              cdt_ctx.cdt_ctx_map_key('address')])
+        program = self.as_connection.compile_ops([
+            map_operations.map_put('doc', 'city', 'Lyon', ctx=ctx)
+        ])
+        del ctx
+
+        self.as_connection.operate(self.key, program)
+
+        _, _, bins = self.as_connection.get(self.key)
+        assert bins['doc']['profile']['address']['city'] == 'Lyon'
+
+    def test_compiled_ctx_keeps_its_bytes(self):
+        self.as_connection.put(self.key, {'blobs': {b'key': {'a': 1}}})
+        map_key = bytearray(b'key')
+        ctx = self.as_connection.compile_ctx([cdt_ctx.cdt_ctx_map_key(map_key)])
+        map_key[0:3] = b'xyz'
+        del map_key
+
+        _, _, bins = self.as_connection.operate(self.key, [
+            map_operations.map_get_by_key('blobs', 'a', aerospike.MAP_RETURN_VALUE, ctx=ctx)
+        ])
+
+        assert bins == {'blobs': 1}
+
+    @pytest.mark.parametrize("ctx", [
+        [],
+        cdt_ctx.cdt_ctx_list_index(1),
+        [cdt_ctx.cdt_ctx_list_index('1')],
+        [cdt_ctx._cdt_ctx(1234, 1)],
+        [1],
+    ])
+    def test_invalid_ctx(self, ctx):
+        with pytest.raises(e.ParamError):
+            self.as_connection.compile_ctx(ctx)
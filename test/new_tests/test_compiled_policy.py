@@ -0,0 +1,106 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike_helpers.operations import operations
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestCompiledPolicy(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.keys = [('test', 'demo', 'compiled_policy_%d' % i) for i in range(3)]
+        for i, key in enumerate(self.keys):
+            as_connection.put(key, {'i': i})
+
+        def teardown():
+            for key in self.keys:
+                try:
+                    as_connection.remove(key)
+                except e.RecordNotFound:
+                    pass
+
+        request.addfinalizer(teardown)
+
+    @pytest.mark.parametrize("method, kind", [
+        ('read_policy', 'read'),
+        ('write_policy', 'write'),
+        ('operate_policy', 'operate'),
+        ('remove_policy', 'remove'),
+        ('apply_policy', 'apply'),
+        ('batch_policy', 'batch'),
+        ('scan_policy', 'scan'),
+        ('query_policy', 'query'),
+    ])
+    def test_policy_kinds(self, method, kind):
+        policy = getattr(self.as_connection, method)()
+
+        assert isinstance(policy, aerospike.Policy)
+        assert policy.kind == kind
+
+    def test_put_with_compiled_policy(self):
+        policy = self.as_connection.write_policy(key=aerospike.POLICY_KEY_SEND,
+                                                 total_timeout=1000)
+        key = ('test', 'demo', 'compiled_policy_0')
+
+        self.as_connection.put(key, {'i': 10}, policy=policy)
+
+        (key, _, bins) = self.as_connection.get(key)
+        assert bins == {'i': 10}
+        assert key[2] == 'compiled_policy_0'
+
+    def test_exists_policy_is_enforced(self):
+        policy = self.as_connection.write_policy(exists=aerospike.POLICY_EXISTS_CREATE)
+
+        with pytest.raises(e.RecordExistsError):
+            self.as_connection.put(self.keys[0], {'i': 1}, policy=policy)
+
+    def test_compiled_policy_reused(self):
+        read_policy = self.as_connection.read_policy(total_timeout=1000)
+        operate_policy = self.as_connection.operate_policy(total_timeout=1000)
+
+        for i, key in enumerate(self.keys):
+            _, _, bins = self.as_connection.get(key, policy=read_policy)
+            assert bins == {'i': i}
+            _, _, bins = self.as_connection.operate(key, [operations.increment('i', 1),
+                                                         operations.read('i')],
+                                                    policy=operate_policy)
+            assert bins == {'i': i + 1}
+
+    def test_batch_policy(self):
+        policy = self.as_connection.batch_policy(total_timeout=1000)
+
+        records = self.as_connection.get_many(self.keys, policy)
+
+        assert [bins['i'] for _, _, bins in records] == [0, 1, 2]
+
+    def test_remove_with_compiled_policy_and_gen(self):
+        policy = self.as_connection.remove_policy(gen=aerospike.POLICY_GEN_EQ)
+        _, meta = self.as_connection.exists(self.keys[1])
+
+        with pytest.raises(e.RecordGenerationError):
+            self.as_connection.remove(self.keys[1], {'gen': meta['gen'] + 1}, policy)
+
+        self.as_connection.remove(self.keys[1], {'gen': meta['gen']}, policy)
+
+    def test_policy_of_another_kind(self):
+        policy = self.as_connection.read_policy()
+
+        with pytest.raises(e.ParamError):
+            self.as_connection.put(self.keys[0], {'i': 1}, policy=policy)
+
+    def test_invalid_field(self):
+        with pytest.raises(e.ParamError):
+            self.as_connection.write_policy(total_timeout='1000')
+
+    def test_positional_fields(self):
+        with pytest.raises(e.ParamError):
+            self.as_connection.write_policy({'total_timeout': 1000})
@@ -0,0 +1,153 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+import threading
+import time
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestCounterBuffer(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.keys = [('test', 'demo', 'counter%d' % i) for i in range(3)]
+        for key in self.keys:
+            as_connection.put(key, {'hits': 0, 'name': 'counter'})
+
+        def teardown():
+            for key in self.keys:
+                try:
+                    as_connection.remove(key)
+                except e.RecordNotFound:
+                    pass
+
+        request.addfinalizer(teardown)
+
+    def bins(self, key):
+        _, _, bins = self.as_connection.get(key)
+        return bins
+
+    def test_increments_coalesced_on_flush(self):
+        counters = self.as_connection.counter_buffer(flush_interval_ms=0, max_keys=0)
+
+        for i in range(100):
+            counters.increment(self.keys[i % 2], 'hits')
+        counters.increment(self.keys[0], 'misses', 5)
+
+        assert len(counters) == 2
+        assert self.bins(self.keys[0])['hits'] == 0
+
+        counters.flush()
+
+        assert len(counters) == 0
+        assert self.bins(self.keys[0]) == {'hits': 50, 'misses': 5, 'name': 'counter'}
+        assert self.bins(self.keys[1])['hits'] == 50
+        counters.close()
+
+    def test_flush_interval(self):
+        counters = self.as_connection.counter_buffer(flush_interval_ms=20)
+        counters.increment(self.keys[2], 'hits', 3)
+
+        deadline = time.time() + 5
+        while self.bins(self.keys[2])['hits'] != 3 and time.time() < deadline:
+            time.sleep(0.02)
+
+        assert self.bins(self.keys[2])['hits'] == 3
+        counters.close()
+
+    def test_max_keys(self):
+        counters = self.as_connection.counter_buffer(flush_interval_ms=0, max_keys=2)
+        counters.increment(self.keys[0], 'hits')
+        counters.increment(self.keys[1], 'hits')
+
+        deadline = time.time() + 5
+        while self.bins(self.keys[1])['hits'] != 1 and time.time() < deadline:
+            time.sleep(0.02)
+
+        assert self.bins(self.keys[0])['hits'] == 1
+        assert self.bins(self.keys[1])['hits'] == 1
+        counters.close()
+
+    def test_context_manager_closes(self):
+        with self.as_connection.counter_buffer(flush_interval_ms=0, max_keys=0) as counters:
+            counters.increment(self.keys[0], 'hits', -4)
+
+        assert self.bins(self.keys[0])['hits'] == -4
+        with pytest.raises(e.ClientError):
+            counters.increment(self.keys[0], 'hits')
+
+    def test_on_error(self):
+        failures = []
+        counters = self.as_connection.counter_buffer(
+            flush_interval_ms=0, max_keys=0,
+            on_error=lambda key, bins, exception: failures.append((key, bins, exception)))
+
+        # Incrementing a string bin fails on the server.
+        counters.increment(self.keys[0], 'name', 2)
+        counters.increment(self.keys[1], 'hits', 2)
+        counters.close()
+
+        assert len(failures) == 1
+        key, bins, exception = failures[0]
+        assert key[:2] == ('test', 'demo')
+        assert bins == {'name': 2}
+        assert isinstance(exception, e.AerospikeError)
+        assert self.bins(self.keys[1])['hits'] == 2
+
+    def test_on_error_closes_from_flush_thread(self):
+        reported = threading.Event()
+        buffers = []
+
+        def on_error(key, bins, exception):
+            buffers[0].close()
+            reported.set()
+
+        buffers.append(self.as_connection.counter_buffer(
+            flush_interval_ms=0, max_keys=1, on_error=on_error))
+        buffers[0].increment(self.keys[0], 'name', 2)
+
+        assert reported.wait(5)
+        with pytest.raises(e.ClientError):
+            buffers[0].increment(self.keys[0], 'hits')
+
+    def test_on_error_drops_last_reference(self):
+        reported = threading.Event()
+        buffers = []
+
+        def on_error(key, bins, exception):
+            del buffers[:]
+            reported.set()
+
+        buffers.append(self.as_connection.counter_buffer(
+            flush_interval_ms=0, max_keys=1, on_error=on_error))
+        buffers[0].increment(self.keys[0], 'name', 2)
+
+        assert reported.wait(5)
+        counters = self.as_connection.counter_buffer(flush_interval_ms=0, max_keys=0)
+        counters.increment(self.keys[1], 'hits')
+        counters.close()
+        assert self.bins(self.keys[1])['hits'] == 1
+
+    @pytest.mark.parametrize("key, bin", [
+        (None, 'hits'),
+        (('test', 'demo', 'counter0'), 1),
+        (('test', 'demo', 'counter0'), 'a_bin_name_too_long'),
+    ])
+    def test_invalid_increment(self, key, bin):
+        counters = self.as_connection.counter_buffer()
+
+        with pytest.raises((e.ParamError, e.BinNameError)):
+            counters.increment(key, bin)
+        counters.close()
+
+    def test_invalid_on_error(self):
+        with pytest.raises(e.ParamError):
+            self.as_connection.counter_buffer(on_error=1)
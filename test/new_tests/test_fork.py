@@ -0,0 +1,101 @@
+# -*- coding: utf-8 -*-
+import os
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+@pytest.mark.skipif(not hasattr(os, 'fork'), reason="os.fork is not available")
+class TestFork(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.key = ('test', 'demo', 'fork')
+        as_connection.put(self.key, {'parent': 1})
+
+        def teardown():
+            try:
+                as_connection.remove(self.key)
+            except e.RecordNotFound:
+                pass
+
+        request.addfinalizer(teardown)
+
+    def run_in_child(self, fn):
+        pid = os.fork()
+        if pid == 0:
+            status = 1
+            try:
+                fn()
+                status = 0
+            finally:
+                os._exit(status)
+
+        _, status = os.waitpid(pid, 0)
+        return os.WEXITSTATUS(status)
+
+    def test_client_usable_in_child(self):
+        def child():
+            _, _, bins = self.as_connection.get(self.key)
+            assert bins == {'parent': 1}
+            self.as_connection.put(self.key, {'child': 1})
+
+        assert self.run_in_child(child) == 0
+
+        _, _, bins = self.as_connection.get(self.key)
+        assert bins == {'parent': 1, 'child': 1}
+
+    def test_client_closed_in_child(self):
+        def child():
+            self.as_connection.get(self.key)
+            self.as_connection.close()
+
+        assert self.run_in_child(child) == 0
+        assert self.as_connection.is_connected()
+        self.as_connection.get(self.key)
+
+    def test_query_usable_in_child(self):
+        query = self.as_connection.query('test', 'demo')
+
+        def child():
+            keys = [record[0][2] for record in query.results()]
+            assert keys is not None
+
+        assert self.run_in_child(child) == 0
+
+    def test_write_queue_usable_in_child(self):
+        queue = self.as_connection.write_queue()
+
+        def child():
+            queue.put(self.key, {'queued': 1})
+            queue.flush()
+            assert queue.sent == 1
+            queue.close()
+
+        assert self.run_in_child(child) == 0
+        assert queue.sent == 0
+
+        _, _, bins = self.as_connection.get(self.key)
+        assert bins['queued'] == 1
+        queue.close()
+
+    def test_counter_buffer_usable_in_child(self):
+        counters = self.as_connection.counter_buffer(flush_interval_ms=10)
+
+        def child():
+            counters.increment(self.key, 'count', 2)
+            counters.close()
+
+        assert self.run_in_child(child) == 0
+
+        _, _, bins = self.as_connection.get(self.key)
+        assert bins['count'] == 2
+        counters.close()
@@ -0,0 +1,86 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from aerospike import exception as e
+from aerospike import predexp
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+@pytest.mark.usefixtures("as_connection")
+class TestHedgedReads(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.key = ('test', 'demo', 'hedged_reads')
+        as_connection.put(self.key, {'a': 1, 'b': 2})
+
+        def teardown():
+            try:
+                as_connection.remove(self.key)
+            except e.RecordNotFound:
+                pass
+
+        request.addfinalizer(teardown)
+
+    def hedged(self):
+        return self.as_connection.stats()['hedged_reads']
+
+    def test_get(self):
+        before = self.hedged()
+        key, meta, bins = self.as_connection.get(self.key, {'hedge_delay': 1})
+
+        assert bins == {'a': 1, 'b': 2}
+        assert meta['gen'] >= 1
+        assert key[2] is None
+        assert self.hedged()['reads'] == before['reads'] + 1
+
+    def test_select(self):
+        _, _, bins = self.as_connection.select(self.key, ['a'], {'hedge_delay': 1})
+        assert bins == {'a': 1}
+
+    def test_hedge_race(self):
+        # With a 1ms delay, most reads are hedged and both reads race.
+        before = self.hedged()
+        for _ in range(20):
+            policy = {'hedge_delay': 1, 'total_timeout': 1000}
+            assert self.as_connection.get(self.key, policy)[2] == {'a': 1, 'b': 2}
+        after = self.hedged()
+        assert after['reads'] == before['reads'] + 20
+        assert after['won'] - before['won'] <= after['issued'] - before['issued']
+
+    def test_not_found(self):
+        with pytest.raises(e.RecordNotFound):
+            self.as_connection.get(('test', 'demo', 'hedged_reads_missing'), {'hedge_delay': 1})
+
+    def test_percentile(self):
+        before = self.hedged()
+        for _ in range(10):
+            assert self.as_connection.get(self.key, {'hedge_percentile': 99})[2] == {'a': 1, 'b': 2}
+        # Recorded, but not hedged before enough reads.
+        assert self.hedged()['reads'] == before['reads'] + 10
+
+    def test_not_hedged(self):
+        before = self.hedged()
+        self.as_connection.get(self.key)
+        self.as_connection.get(self.key, {'hedge_delay': None})
+        preds = [predexp.integer_bin('a'), predexp.integer_value(1), predexp.integer_equal()]
+        self.as_connection.get(self.key, {'hedge_delay': 1, 'predexp': preds})
+        assert self.hedged() == before
+
+    @pytest.mark.parametrize("policy", [
+        {'hedge_delay': 0},
+        {'hedge_delay': -1},
+        {'hedge_delay': '5'},
+        {'hedge_percentile': 0},
+        {'hedge_percentile': 100},
+        {'hedge_percentile': 'p99'},
+    ])
+    def test_invalid_policy(self, policy):
+        with pytest.raises(e.ParamError):
+            self.as_connection.get(self.key, policy)
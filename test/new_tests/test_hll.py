@@ -0,0 +1,141 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike_helpers.operations import hll_operations
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestHLL(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        if self.server_version < [4, 9]:
+            pytest.skip("HyperLogLog requires server 4.9")
+
+        self.keys = [('test', 'demo', 'hll%d' % i) for i in range(3)]
+        values = [
+            ['a', 'b', 'c', 'd'],
+            ['c', 'd', 'e', 'f'],
+            ['x', 'y'],
+        ]
+        for key, value in zip(self.keys, values):
+            as_connection.operate(key, [
+                hll_operations.hll_add('hll', value, index_bit_count=10, mh_bit_count=20)
+            ])
+
+        def teardown():
+            for key in self.keys:
+                try:
+                    as_connection.remove(key)
+                except e.RecordNotFound:
+                    pass
+
+        request.addfinalizer(teardown)
+
+    def hll(self, key):
+        _, _, bins = self.as_connection.get(key)
+        return bins['hll']
+
+    def test_hll_get_count(self):
+        _, _, bins = self.as_connection.operate(self.keys[0], [hll_operations.hll_get_count('hll')])
+
+        assert bins['hll'] == 4
+
+    def test_hll_read_as_hyperloglog(self):
+        value = self.hll(self.keys[0])
+
+        assert isinstance(value, aerospike.HyperLogLog)
+        assert isinstance(value, bytes)
+
+    def test_hll_init_resets_bin(self):
+        self.as_connection.operate(self.keys[0], [hll_operations.hll_init('hll', 12)])
+        _, _, bins = self.as_connection.operate(self.keys[0], [
+            hll_operations.hll_get_count('hll'),
+        ])
+
+        assert bins['hll'] == 0
+
+    def test_hll_describe(self):
+        _, _, bins = self.as_connection.operate(self.keys[0], [hll_operations.hll_describe('hll')])
+
+        assert bins['hll'] == [10, 20]
+
+    def test_hll_get_union(self):
+        others = [self.hll(self.keys[1])]
+        _, _, bins = self.as_connection.operate(self.keys[0], [
+            hll_operations.hll_get_union('hll', others)
+        ])
+
+        assert isinstance(bins['hll'], aerospike.HyperLogLog)
+
+    def test_hll_counts(self):
+        others = [self.hll(self.keys[1])]
+
+        _, _, union = self.as_connection.operate(self.keys[0], [
+            hll_operations.hll_get_union_count('hll', others)
+        ])
+        _, _, intersect = self.as_connection.operate(self.keys[0], [
+            hll_operations.hll_get_intersect_count('hll', others)
+        ])
+        _, _, similarity = self.as_connection.operate(self.keys[0], [
+            hll_operations.hll_get_similarity('hll', others)
+        ])
+
+        assert union['hll'] == 6
+        assert intersect['hll'] == 2
+        assert similarity['hll'] == pytest.approx(2 / 6.0, abs=0.05)
+
+    def test_hll_set_union(self):
+        others = [self.hll(self.keys[1]), self.hll(self.keys[2])]
+        _, _, bins = self.as_connection.operate(self.keys[0], [
+            hll_operations.hll_set_union('hll', others),
+            hll_operations.hll_refresh_count('hll')
+        ])
+
+        assert bins['hll'] == 8
+
+    def test_hll_fold(self):
+        self.as_connection.operate(self.keys[0], [hll_operations.hll_init('hll', 12)])
+        _, _, bins = self.as_connection.operate(self.keys[0], [
+            hll_operations.hll_add('hll', ['a', 'b']),
+            hll_operations.hll_fold('hll', 6),
+            hll_operations.hll_describe('hll')
+        ])
+
+        assert bins['hll'] == [6, 0]
+
+    def test_hll_write_flags(self):
+        policy = {'hll_write_flags': aerospike.HLL_WRITE_CREATE_ONLY}
+
+        with pytest.raises(e.BinExistsError):
+            self.as_connection.operate(self.keys[0], [hll_operations.hll_init('hll', 10, policy=policy)])
+
+        policy['hll_write_flags'] |= aerospike.HLL_WRITE_NO_FAIL
+        self.as_connection.operate(self.keys[0], [hll_operations.hll_init('hll', 10, policy=policy)])
+
+    def test_hll_put_round_trip(self):
+        value = self.hll(self.keys[0])
+        self.as_connection.put(self.keys[2], {'copy': value})
+
+        _, _, bins = self.as_connection.operate(self.keys[2], [hll_operations.hll_get_count('copy')])
+
+        assert bins['copy'] == 4
+
+    @pytest.mark.parametrize("op", [
+        hll_operations.hll_init('hll', 65),
+        hll_operations.hll_init('hll', 10, -2),
+        hll_operations.hll_add('hll', 'abc', index_bit_count=10),
+        hll_operations.hll_get_union('hll', None),
+        hll_operations.hll_init('hll', 10, policy={'hll_write_flags': 'create'}),
+    ])
+    def test_invalid_hll_op(self, op):
+        with pytest.raises(e.ParamError):
+            self.as_connection.operate(self.keys[0], [op])
@@ -0,0 +1,108 @@
+# -*- coding: utf-8 -*-
+import asyncio
+import pytest
+import sys
+from .index_helpers import ensure_dropped_index
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestJob(object):
+
+    udf_to_load = "bin_lua.lua"
+
+    # connection_with_udf will remove the udf at the end of the tests
+    @pytest.fixture(autouse=True)
+    def setup(self, request, connection_with_udf):
+        for i in range(15):
+            key = ('test', 'demo', i)
+            rec = {'age': i}
+            connection_with_udf.put(key, rec)
+        self.job_id = connection_with_udf.scan_apply(
+            "test", "demo", "bin_lua", "mytransform", ['age', 2])
+
+        def teardown():
+            for i in range(15):
+                key = ('test', 'demo', i)
+                connection_with_udf.remove(key)
+            ensure_dropped_index(connection_with_udf, 'test', 'job_age_index')
+
+        request.addfinalizer(teardown)
+
+    def test_job_wait(self):
+        job = self.as_connection.job(self.job_id, aerospike.JOB_SCAN)
+
+        assert job.job_id == self.job_id
+        assert job.module == aerospike.JOB_SCAN
+        assert job.wait(timeout=30) is True
+        assert job.done() is True
+        assert job.progress()['status'] == aerospike.JOB_STATUS_COMPLETED
+
+    def test_job_progress_without_waiting(self):
+        job = self.as_connection.job(self.job_id, aerospike.JOB_SCAN)
+
+        progress = job.progress()
+
+        assert set(progress.keys()) == {'progress_pct', 'records_read', 'status'}
+        assert progress['status'] in (aerospike.JOB_STATUS_COMPLETED,
+                                      aerospike.JOB_STATUS_INPROGRESS)
+
+    def test_job_await(self):
+        job = self.as_connection.job(self.job_id, aerospike.JOB_SCAN)
+
+        async def wait_job():
+            return await job
+
+        loop = asyncio.new_event_loop()
+        asyncio.set_event_loop(loop)
+        try:
+            status = loop.run_until_complete(asyncio.wait_for(wait_job(), 30))
+        finally:
+            loop.close()
+
+        assert status['status'] == aerospike.JOB_STATUS_COMPLETED
+
+    def test_job_await_temporary(self):
+        # Nothing but the coroutine references the job.
+        async def wait_job():
+            return await self.as_connection.job(self.job_id, aerospike.JOB_SCAN)
+
+        loop = asyncio.new_event_loop()
+        asyncio.set_event_loop(loop)
+        try:
+            status = loop.run_until_complete(asyncio.wait_for(wait_job(), 30))
+        finally:
+            loop.close()
+
+        assert status['status'] == aerospike.JOB_STATUS_COMPLETED
+
+    def test_index_create_without_blocking(self):
+        job = self.as_connection.index_integer_create(
+            'test', 'demo', 'age', 'job_age_index', block=False)
+
+        assert isinstance(job, aerospike.Job)
+        assert job.module == 'sindex'
+        assert job.wait(timeout=30) is True
+        assert job.progress()['progress_pct'] == 100
+
+    def test_index_create_blocking_returns_zero(self):
+        retobj = self.as_connection.index_integer_create(
+            'test', 'demo', 'age', 'job_age_index', block=True)
+
+        assert retobj == 0
+
+    def test_job_with_invalid_module(self):
+        with pytest.raises(e.ParamError):
+            self.as_connection.job(self.job_id, 'aggregate')
+
+    def test_index_create_with_invalid_block(self):
+        with pytest.raises(e.ParamError):
+            self.as_connection.index_integer_create(
+                'test', 'demo', 'age', 'job_age_index', block='no')
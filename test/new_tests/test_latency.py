@@ -0,0 +1,93 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+@pytest.mark.usefixtures("connection_config")
+class TestLatencyHistograms(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request):
+        config = dict(self.connection_config, latency_histograms=True)
+        self.client = aerospike.client(config)
+        _, user, password = TestBaseClass.get_hosts()
+        if user and password:
+            self.client.connect(user, password)
+        else:
+            self.client.connect()
+        self.key = ('test', 'demo', 'latency')
+
+        def teardown():
+            try:
+                self.client.remove(self.key)
+            except e.RecordNotFound:
+                pass
+            self.client.close()
+
+        request.addfinalizer(teardown)
+
+    def test_commands_and_phases(self):
+        histograms = self.client.latency_histograms()
+
+        assert sorted(histograms) == sorted(['get', 'put', 'operate', 'batch', 'scan',
+                                             'query', 'apply', 'info'])
+        for phases in histograms.values():
+            assert sorted(phases) == ['in_c', 'to_c', 'to_python']
+
+    def test_get_and_put_recorded(self):
+        self.client.latency_histograms(reset=True)
+        self.client.put(self.key, {'a': 1})
+        self.client.get(self.key)
+        self.client.get(self.key)
+
+        histograms = self.client.latency_histograms()
+        assert histograms['put']['to_c']['count'] == 1
+        assert histograms['put']['in_c']['count'] == 1
+        assert histograms['put']['to_python']['count'] == 0
+        for phase in ('to_c', 'in_c', 'to_python'):
+            assert histograms['get'][phase]['count'] == 2
+
+        in_c = histograms['get']['in_c']
+        assert sum(count for _, _, count in in_c['buckets']) == 2
+        assert in_c['max_ns'] <= in_c['total_ns']
+        for lower, upper, _ in in_c['buckets']:
+            assert lower < upper
+        assert in_c['buckets'][-1][0] <= in_c['max_ns'] < in_c['buckets'][-1][1]
+
+    def test_batch_and_operate_recorded(self):
+        self.client.latency_histograms(reset=True)
+        self.client.put(self.key, {'a': 1})
+        self.client.get_many([self.key])
+        self.client.increment(self.key, 'a', 1)
+
+        histograms = self.client.latency_histograms()
+        assert histograms['batch']['in_c']['count'] == 1
+        assert histograms['operate']['in_c']['count'] == 1
+
+    def test_reset(self):
+        self.client.put(self.key, {'a': 1})
+
+        assert self.client.latency_histograms(reset=True)['put']['in_c']['count'] >= 1
+        histogram = self.client.latency_histograms()['put']['in_c']
+        assert histogram == {'count': 0, 'total_ns': 0, 'max_ns': 0, 'buckets': []}
+
+    def test_failed_conversion_not_recorded(self):
+        self.client.latency_histograms(reset=True)
+
+        with pytest.raises(e.ParamError):
+            self.client.get(('test', 'demo'))
+        assert self.client.latency_histograms()['get']['in_c']['count'] == 0
+
+    def test_disabled_by_default(self, as_connection):
+        as_connection.put(self.key, {'a': 1})
+
+        assert as_connection.latency_histograms() == {}
@@ -1,6 +1,8 @@
 # -*- coding: utf-8 -*-
 import pytest
 import sys
+import threading
+import time
 
 from .test_base_class import TestBaseClass
 from aerospike import exception as e
@@ -64,6 +66,49 @@ class TestLog(object):
         assert response == 0
         client.close()
 
+    def test_log_lines_delivered_by_drain_thread(self):
+        '''
+        Test that log lines reach the handler from the drain thread,
+        rather than the C client threads which logged them
+        '''
+        threads = set()
+        received = threading.Event()
+
+        def collecting_handler(level, func, path, line, msg):
+            assert isinstance(msg, str)
+            threads.add(threading.current_thread().ident)
+            received.set()
+
+        aerospike.set_log_level(aerospike.LOG_LEVEL_DEBUG)
+        aerospike.set_log_handler(collecting_handler)
+
+        client = TestBaseClass.get_new_connection()
+        client.close()
+
+        assert received.wait(5)
+        assert threading.current_thread().ident not in threads
+        assert len(threads) == 1
+
+    def test_log_handler_replaced(self):
+        '''
+        Test that lines logged after a handler is replaced reach the new one
+        '''
+        first = []
+        second = []
+
+        aerospike.set_log_level(aerospike.LOG_LEVEL_DEBUG)
+        aerospike.set_log_handler(lambda *args: first.append(args))
+        aerospike.set_log_handler(lambda *args: second.append(args))
+
+        client = TestBaseClass.get_new_connection()
+        client.close()
+
+        deadline = time.time() + 5
+        while not second and time.time() < deadline:
+            time.sleep(0.01)
+        assert second
+        assert all(len(args) == 5 for args in second)
+
     @pytest.mark.skip()
     def test_incorrect_prototype_callback(self):
         """
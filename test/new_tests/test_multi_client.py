@@ -0,0 +1,145 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+UNREACHABLE = {'hosts': [('127.0.0.1', 1)]}
+
+
+@pytest.mark.usefixtures("connection_config")
+class TestMultiClient(object):
+
+    def connect(self, client):
+        _, user, password = TestBaseClass.get_hosts()
+        if user and password:
+            return client.connect(user, password)
+        return client.connect()
+
+    def new_client(self, clusters, **config):
+        config['clusters'] = clusters
+        return self.connect(aerospike.multi_client(config))
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.key = ('test', 'demo', 'multi_client')
+        as_connection.put(self.key, {'a': 1})
+
+        def teardown():
+            try:
+                as_connection.remove(self.key)
+            except e.RecordNotFound:
+                pass
+
+        request.addfinalizer(teardown)
+
+    def test_reads_and_writes(self):
+        client = self.new_client([self.connection_config, self.connection_config])
+
+        client.put(self.key, {'a': 2})
+        assert client.get(self.key)[2] == {'a': 2}
+        assert client.select(self.key, ['a'])[2] == {'a': 2}
+        assert client.exists(self.key)[1] is not None
+        client.increment(self.key, 'a', 1)
+        assert client.get_many([self.key])[0][2] == {'a': 3}
+
+        clusters = client.stats()['clusters']
+        assert clusters[0]['reads'] == 4
+        assert clusters[0]['writes'] == 2
+        assert clusters[1]['reads'] == 0
+        assert clusters[0]['available'] and clusters[0]['connected']
+        assert 'nodes' in clusters[0]['stats']
+        client.close()
+
+    def test_fallback_to_next_cluster(self):
+        client = self.new_client([UNREACHABLE, self.connection_config])
+
+        assert client.get(self.key)[2] == {'a': 1}
+        client.put(self.key, {'a': 2})
+        assert client.get(self.key)[2] == {'a': 2}
+
+        clusters = client.stats()['clusters']
+        assert not clusters[0]['connected']
+        assert not clusters[0]['available']
+        assert clusters[0]['stats'] is None
+        assert clusters[1]['reads'] == 2
+        assert client.is_connected()
+        client.close()
+
+    def test_not_found_is_raised(self):
+        client = self.new_client([self.connection_config, self.connection_config])
+
+        with pytest.raises(e.RecordNotFound):
+            client.get(('test', 'demo', 'multi_client_missing'))
+        assert client.stats()['clusters'][0]['fallbacks'] == 0
+        client.close()
+
+    def test_write_all(self):
+        client = self.new_client([self.connection_config, self.connection_config],
+                                 write_mode=aerospike.MULTI_WRITE_ALL)
+
+        client.put(self.key, {'a': 2})
+        clusters = client.stats()['clusters']
+        assert clusters[0]['writes'] == 1
+        assert clusters[1]['writes'] == 1
+        client.close()
+
+    def test_write_all_raises_if_any_fails(self):
+        client = self.new_client([self.connection_config, UNREACHABLE],
+                                 write_mode=aerospike.MULTI_WRITE_ALL, retry_interval=0)
+
+        with pytest.raises(e.AerospikeError):
+            client.put(self.key, {'a': 2})
+        # Sent to the first cluster all the same.
+        assert client.get(self.key)[2] == {'a': 2}
+
+        clusters = client.stats()['clusters']
+        assert clusters[0]['writes'] == 1
+        assert clusters[0]['failures'] == 0
+        assert clusters[1]['writes'] == 1
+        client.close()
+
+    def test_write_preferred_only(self):
+        client = self.new_client([UNREACHABLE, self.connection_config],
+                                 write_mode=aerospike.MULTI_WRITE_PREFERRED_ONLY)
+
+        with pytest.raises(e.AerospikeError):
+            client.put(self.key, {'a': 2})
+        assert client.get(self.key)[2] == {'a': 1}
+        client.close()
+
+    def test_no_cluster_connects(self):
+        with pytest.raises(e.AerospikeError):
+            self.new_client([UNREACHABLE])
+
+    def test_not_connected(self):
+        client = aerospike.multi_client({'clusters': [self.connection_config]})
+        with pytest.raises(e.ClusterError):
+            client.get(self.key)
+
+    def test_client(self):
+        client = self.new_client([self.connection_config, self.connection_config])
+
+        assert client.client(1).get(self.key)[2] == {'a': 1}
+        with pytest.raises(e.ParamError):
+            client.client(2)
+        client.close()
+
+    @pytest.mark.parametrize("config", [
+        {},
+        {'clusters': []},
+        {'clusters': UNREACHABLE},
+        {'clusters': [UNREACHABLE], 'write_mode': 3},
+        {'clusters': [UNREACHABLE], 'failure_threshold': 0},
+        {'clusters': [UNREACHABLE], 'retry_interval': 'soon'},
+    ])
+    def test_invalid_config(self, config):
+        with pytest.raises(e.ParamError):
+            aerospike.multi_client(config)
@@ -0,0 +1,113 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike import predicates as p
+from aerospike_helpers import aggregates
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestNativeAggregate(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.keys = [('test', 'native_aggregate', i) for i in range(10)]
+        for i, key in enumerate(self.keys):
+            bins = {'age': i * 5, 'views': i, 'name': 'name%d' % i}
+            if i == 9:
+                bins['views'] = 'not a number'
+            as_connection.put(key, bins)
+        as_connection.put(('test', 'native_aggregate', 'score'), {'score': 1.5})
+        try:
+            as_connection.index_integer_create('test', 'native_aggregate', 'age', 'native_aggregate_age')
+        except e.IndexFoundError:
+            pass
+
+        def teardown():
+            for key in self.keys + [('test', 'native_aggregate', 'score')]:
+                try:
+                    as_connection.remove(key)
+                except e.RecordNotFound:
+                    pass
+            as_connection.index_remove('test', 'native_aggregate_age')
+
+        request.addfinalizer(teardown)
+
+    def test_scan_aggregate(self):
+        scan = self.as_connection.scan('test', 'native_aggregate')
+
+        result = scan.aggregate({
+            'records': aggregates.count(),
+            'named': aggregates.count('name'),
+            'views': aggregates.sum('views'),
+            'youngest': aggregates.min('age'),
+            'oldest': aggregates.max('age'),
+            'ages': aggregates.histogram('age', 10),
+        })
+
+        assert result == {
+            'records': 11,
+            'named': 10,
+            'views': sum(range(9)),
+            'youngest': 0,
+            'oldest': 45,
+            'ages': {0: 2, 10: 2, 20: 2, 30: 2, 40: 2},
+        }
+
+    def test_scan_aggregate_floats(self):
+        scan = self.as_connection.scan('test', 'native_aggregate')
+
+        result = scan.aggregate({
+            'total': aggregates.sum('score'),
+            'top': aggregates.max('score'),
+            'missing': aggregates.min('no_such_bin'),
+            'none': aggregates.sum('no_such_bin'),
+        })
+
+        assert result == {'total': 1.5, 'top': 1.5, 'missing': None, 'none': 0}
+
+    def test_query_aggregate(self):
+        query = self.as_connection.query('test', 'native_aggregate')
+        query.select('age', 'views')
+        query.where(p.between('age', 10, 30))
+
+        result = query.aggregate({'views': aggregates.sum('views'), 'records': aggregates.count()})
+
+        assert result == {'views': 2 + 3 + 4 + 5 + 6, 'records': 5}
+
+    def test_aggregate_many(self):
+        keys = self.keys[:4] + [('test', 'native_aggregate', 'missing')]
+
+        result = self.as_connection.aggregate_many(keys, {
+            'records': aggregates.count(),
+            'views': aggregates.sum('views'),
+            'oldest': aggregates.max('age'),
+        })
+
+        assert result == {'records': 4, 'views': 6, 'oldest': 15}
+
+    def test_aggregate_many_count_only(self):
+        result = self.as_connection.aggregate_many(tuple(self.keys), {'records': aggregates.count()})
+
+        assert result == {'records': 10}
+
+    @pytest.mark.parametrize("aggs", [
+        {},
+        [aggregates.count()],
+        {'views': 'sum'},
+        {'views': {'aggregate': 99, 'bin': 'views'}},
+        {'views': {'aggregate': aerospike.AGGREGATE_SUM}},
+        {'ages': aggregates.histogram('age', 0)},
+        {'ages': aggregates.histogram('age', '10')},
+        {'views': aggregates.sum('a_bin_name_too_long')},
+    ])
+    def test_invalid_aggregates(self, aggs):
+        with pytest.raises((e.ParamError, e.BinNameError)):
+            self.as_connection.aggregate_many(self.keys, aggs)
@@ -0,0 +1,164 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+@pytest.mark.usefixtures("connection_config")
+class TestNearCache(object):
+
+    def new_client(self, **config):
+        config.update(self.connection_config)
+        client = aerospike.client(config)
+        _, user, password = TestBaseClass.get_hosts()
+        if user and password:
+            return client.connect(user, password)
+        return client.connect()
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.keys = [('test', 'demo', 'near_cache_%d' % i) for i in range(3)]
+        for key in self.keys:
+            as_connection.put(key, {'a': 1})
+
+        def teardown():
+            for key in self.keys:
+                try:
+                    as_connection.remove(key)
+                except e.RecordNotFound:
+                    pass
+
+        request.addfinalizer(teardown)
+
+    def test_get_hit(self):
+        client = self.new_client(near_cache={'max_entries': 10})
+
+        first = client.get(self.keys[0])
+        second = client.get(self.keys[0])
+
+        assert second[1]['gen'] == first[1]['gen']
+        assert second[2] == {'a': 1}
+        stats = client.stats()['near_cache']
+        assert stats['misses'] == 1
+        assert stats['hits'] == 1
+        assert stats['entries'] == 1
+        client.close()
+
+    def test_returned_bins_are_copies(self):
+        client = self.new_client(near_cache={})
+
+        client.get(self.keys[0])[2]['a'] = 2
+        assert client.get(self.keys[0])[2] == {'a': 1}
+        client.close()
+
+    def test_returned_containers_are_copies(self):
+        client = self.new_client(near_cache={})
+        client.put(self.keys[0], {'l': [1, [2]], 'm': {'k': [3]}})
+
+        bins = client.get(self.keys[0])[2]
+        bins['l'][1].append(4)
+        bins['m']['k'].append(5)
+        assert client.get(self.keys[0])[2] == {'a': 1, 'l': [1, [2]], 'm': {'k': [3]}}
+
+        client.get(self.keys[0])[2]['l'].append(6)
+        assert client.get(self.keys[0])[2]['l'] == [1, [2]]
+        client.close()
+
+    def test_queued_write_not_cached_until_sent(self):
+        client = self.new_client(near_cache={})
+        queue = client.write_queue(max_inflight=1)
+
+        client.get(self.keys[0])
+        queue.put(self.keys[0], {'a': 2})
+        client.get(self.keys[0])
+        queue.flush()
+        assert client.get(self.keys[0])[2] == {'a': 2}
+
+        queue.close()
+        client.close()
+
+    def test_buffered_increment_not_cached_until_flushed(self):
+        client = self.new_client(near_cache={})
+        counters = client.counter_buffer(flush_interval_ms=0)
+
+        counters.increment(self.keys[0], 'a', 1)
+        assert client.get(self.keys[0])[2] == {'a': 1}
+        counters.flush()
+        assert client.get(self.keys[0])[2] == {'a': 2}
+
+        counters.close()
+        client.close()
+
+    def test_write_invalidates(self):
+        client = self.new_client(near_cache={})
+
+        client.get(self.keys[0])
+        client.put(self.keys[0], {'a': 2})
+        assert client.get(self.keys[0])[2] == {'a': 2}
+
+        client.increment(self.keys[0], 'a', 1)
+        assert client.get(self.keys[0])[2] == {'a': 3}
+
+        client.remove(self.keys[0])
+        with pytest.raises(e.RecordNotFound):
+            client.get(self.keys[0])
+        assert client.stats()['near_cache']['invalidations'] == 3
+        client.close()
+
+    def test_eviction(self):
+        client = self.new_client(near_cache={'max_entries': 2})
+
+        for key in self.keys:
+            client.get(key)
+
+        stats = client.stats()['near_cache']
+        assert stats['entries'] == 2
+        assert stats['evictions'] == 1
+        client.close()
+
+    def test_validate_mode_sees_other_writes(self):
+        client = self.new_client(near_cache={'mode': 'validate'})
+
+        client.get(self.keys[0])
+        assert client.get(self.keys[0])[2] == {'a': 1}
+        self.as_connection.put(self.keys[0], {'a': 2})
+        assert client.get(self.keys[0])[2] == {'a': 2}
+
+        stats = client.stats()['near_cache']
+        assert stats['hits'] == 1
+        assert stats['stale'] == 1
+        client.close()
+
+    def test_validate_mode_removed_record(self):
+        client = self.new_client(near_cache={'mode': 'validate'})
+
+        client.get(self.keys[0])
+        self.as_connection.remove(self.keys[0])
+        with pytest.raises(e.RecordNotFound):
+            client.get(self.keys[0])
+        assert client.stats()['near_cache']['entries'] == 0
+        client.close()
+
+    def test_no_near_cache_stats(self):
+        assert 'near_cache' not in self.as_connection.stats()
+
+    @pytest.mark.parametrize("near_cache", [
+        {'max_entries': 0},
+        {'max_entries': 'ten'},
+        {'ttl': -1},
+        {'mode': 'write-through'},
+        [],
+    ])
+    def test_invalid_config(self, near_cache):
+        config = {'near_cache': near_cache}
+        config.update(self.connection_config)
+        with pytest.raises(e.ParamError):
+            aerospike.client(config)
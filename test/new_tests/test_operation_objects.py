@@ -0,0 +1,133 @@
+# -*- coding: utf-8 -*-
+import pickle
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike_helpers.operations import operations
+from aerospike_helpers.operations import list_operations
+from aerospike_helpers.operations import map_operations
+from aerospike_helpers.operations import bitwise_operations
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestOperationObjects(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.key = ('test', 'demo', 'operation_objects')
+        as_connection.put(self.key, {'name': 'name', 'age': 1,
+                                     'list': [1, 2, 3], 'map': {'a': 1, 'b': 2},
+                                     'bytes': bytearray([0] * 4)})
+
+        def teardown():
+            as_connection.remove(self.key)
+
+        request.addfinalizer(teardown)
+
+    @pytest.mark.parametrize("op", [
+        operations.read('name'),
+        operations.increment('age', 1),
+        operations.touch(),
+        list_operations.list_append('list', 4),
+        map_operations.map_get_by_key('map', 'a', aerospike.MAP_RETURN_VALUE),
+        bitwise_operations.bit_count('bytes', 0, 8),
+    ])
+    def test_helpers_return_operations(self, op):
+        assert isinstance(op, aerospike.Operation)
+        assert isinstance(op, dict)
+
+    def test_operation_equals_dict(self):
+        op = operations.write('name', 'value')
+
+        assert op == {'op': aerospike.OPERATOR_WRITE, 'bin': 'name', 'val': 'value'}
+        assert dict(op) == op
+        assert op['bin'] == 'name'
+
+    def test_operation_is_immutable(self):
+        op = operations.write('name', 'value')
+
+        with pytest.raises(TypeError):
+            op['val'] = 'other'
+        with pytest.raises(TypeError):
+            del op['val']
+        with pytest.raises(TypeError):
+            op.update({'val': 'other'})
+        with pytest.raises(TypeError):
+            op.pop('val')
+        with pytest.raises(TypeError):
+            op.clear()
+
+        assert op['val'] == 'value'
+
+    def test_operation_reinit_is_rejected(self):
+        op = operations.write('name', 'value')
+
+        with pytest.raises(TypeError):
+            op.__init__({'val': 'other'})
+
+        assert op['val'] == 'value'
+
+    def test_operation_runs_as_created(self):
+        op = list_operations.list_get_by_index_range('list', 0, aerospike.LIST_RETURN_VALUE, 1)
+
+        # The methods of dict itself bypass the operation's own.
+        dict.__setitem__(op, 'index', 2)
+        dict.update(op, {'bin': 'map'})
+        _, _, bins = self.as_connection.operate(self.key, [op])
+
+        assert bins == {'list': [1]}
+
+    def test_operation_pickle(self):
+        op = list_operations.list_get_by_index_range('list', 0, aerospike.LIST_RETURN_VALUE, 2, True)
+
+        loaded = pickle.loads(pickle.dumps(op))
+
+        assert isinstance(loaded, aerospike.Operation)
+        assert loaded == op
+
+    def test_operate_with_operations_and_dicts(self):
+        ops = [
+            operations.increment('age', 1),
+            {'op': aerospike.OPERATOR_APPEND, 'bin': 'name', 'val': '_x'},
+            list_operations.list_get_by_index_range('list', 1, aerospike.LIST_RETURN_VALUE, 2),
+            map_operations.map_get_by_key('map', 'a', aerospike.MAP_RETURN_VALUE),
+            operations.read('age'),
+            operations.read('name')
+        ]
+
+        _, _, bins = self.as_connection.operate(self.key, ops)
+
+        assert bins['age'] == 2
+        assert bins['name'] == 'name_x'
+        assert bins['list'] == [2, 3]
+        assert bins['map'] == 1
+
+    def test_operate_ordered_with_operations(self):
+        ops = [
+            operations.read('name'),
+            list_operations.list_get_by_index_range('list', 0, aerospike.LIST_RETURN_VALUE, 1, inverted=True),
+        ]
+
+        _, _, bins = self.as_connection.operate_ordered(self.key, ops)
+
+        assert bins == [('name', 'name'), ('list', [2, 3])]
+
+    def test_operation_created_from_dict(self):
+        op = aerospike.Operation({'op': aerospike.OPERATOR_READ, 'bin': 'age'})
+
+        _, _, bins = self.as_connection.operate(self.key, [op])
+
+        assert bins == {'age': 1}
+
+    def test_operation_missing_bin(self):
+        op = aerospike.Operation({'op': aerospike.OPERATOR_INCR, 'val': 1})
+
+        with pytest.raises(e.ParamError):
+            self.as_connection.operate(self.key, [op])
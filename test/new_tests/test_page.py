@@ -0,0 +1,133 @@
+# -*- coding: utf-8 -*-
+
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestPage(TestBaseClass):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.test_ns = 'test'
+        self.test_set = 'page'
+        self.record_count = 25
+
+        for i in range(self.record_count):
+            as_connection.put(('test', 'page', i), {'id': i})
+
+        def teardown():
+            for i in range(self.record_count):
+                as_connection.remove(('test', 'page', i))
+
+        request.addfinalizer(teardown)
+
+    def read_all_pages(self, obj, max_records):
+        pages = []
+        records, token = obj.page(max_records)
+        pages.append(records)
+        while token:
+            records, token = obj.page(max_records, token)
+            pages.append(records)
+        return pages
+
+    def test_scan_page(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        pages = self.read_all_pages(scan_obj, 10)
+
+        for records in pages:
+            assert len(records) <= 10
+        ids = sorted(bins['id'] for records in pages for _, _, bins in records)
+        assert ids == list(range(self.record_count))
+
+    def test_query_page(self):
+        query = self.as_connection.query(self.test_ns, self.test_set)
+
+        pages = self.read_all_pages(query, 7)
+
+        for records in pages:
+            assert len(records) <= 7
+        ids = sorted(bins['id'] for records in pages for _, _, bins in records)
+        assert ids == list(range(self.record_count))
+
+    def test_scan_page_keeps_scan(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        records, token = scan_obj.page(5)
+        scan_obj.select('missing')
+        while token:
+            records, token = scan_obj.page(5, token)
+            for _, _, bins in records:
+                assert 'id' in bins
+
+    def test_query_page_keeps_query(self):
+        query = self.as_connection.query(self.test_ns, self.test_set)
+
+        records, token = query.page(5)
+        query.select('missing')
+        while token:
+            records, token = query.page(5, token)
+            for _, _, bins in records:
+                assert 'id' in bins
+
+    def test_scan_page_larger_than_set(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        records, token = scan_obj.page(self.record_count + 100)
+
+        assert len(records) == self.record_count
+        assert token is None
+
+    def test_scan_page_with_policy(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        records, token = scan_obj.page(5, None, {'total_timeout': 10000})
+
+        assert len(records) == 5
+        assert token is not None
+
+    def test_scan_page_changing_page_size(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        records, token = scan_obj.page(10)
+        assert len(records) == 10
+        records, token = scan_obj.page(3, token)
+        assert len(records) == 3
+
+    def test_scan_page_token_expires(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        pages = self.read_all_pages(scan_obj, 100)
+        assert len(pages) == 1
+
+        with pytest.raises(e.ParamError):
+            scan_obj.page(100, 'not a token')
+
+    def test_page_token_is_per_object(self):
+        _, token = self.as_connection.scan(self.test_ns, self.test_set).page(5)
+        other = self.as_connection.scan(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ParamError):
+            other.page(5, token)
+
+    @pytest.mark.parametrize("max_records", [0, -1, 'ten', None])
+    def test_page_with_invalid_max_records(self, max_records):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ParamError):
+            scan_obj.page(max_records)
+
+    def test_page_with_invalid_token_type(self):
+        query = self.as_connection.query(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ParamError):
+            query.page(5, 1)
@@ -0,0 +1,102 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike import predexp as as_predexp
+from aerospike_helpers.operations import operations
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+def age_at_least(age):
+    return [
+        as_predexp.integer_bin('age'),
+        as_predexp.integer_value(age),
+        as_predexp.integer_greatereq()
+    ]
+
+
+class TestPredexpPolicies(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.keys = [('test', 'predexp_policies', i) for i in range(5)]
+        for i, key in enumerate(self.keys):
+            as_connection.put(key, {'age': i * 10, 'name': 'name%d' % i})
+
+        def teardown():
+            for key in self.keys:
+                try:
+                    as_connection.remove(key)
+                except e.RecordNotFound:
+                    pass
+
+        request.addfinalizer(teardown)
+
+    def test_get_with_predexp(self):
+        policy = {'predexp': age_at_least(20)}
+
+        _, _, bins = self.as_connection.get(self.keys[3], policy=policy)
+        assert bins['age'] == 30
+
+        with pytest.raises(e.FilteredOut):
+            self.as_connection.get(self.keys[1], policy=policy)
+
+    def test_put_with_predexp(self):
+        policy = {'predexp': age_at_least(20)}
+
+        with pytest.raises(e.FilteredOut):
+            self.as_connection.put(self.keys[0], {'name': 'changed'}, policy=policy)
+        self.as_connection.put(self.keys[4], {'name': 'changed'}, policy=policy)
+
+        _, _, bins = self.as_connection.get(self.keys[0])
+        assert bins['name'] == 'name0'
+        _, _, bins = self.as_connection.get(self.keys[4])
+        assert bins['name'] == 'changed'
+
+    def test_operate_with_predexp(self):
+        policy = {'predexp': age_at_least(40)}
+        ops = [operations.increment('age', 1), operations.read('age')]
+
+        with pytest.raises(e.FilteredOut):
+            self.as_connection.operate(self.keys[2], ops, policy=policy)
+        _, _, bins = self.as_connection.operate(self.keys[4], ops, policy=policy)
+        assert bins['age'] == 41
+
+    def test_get_many_with_predexp(self):
+        records = self.as_connection.get_many(self.keys, {'predexp': age_at_least(30)})
+
+        assert [bins['age'] if bins else None for _, _, bins in records] == [None, None, None, 30, 40]
+
+    def test_scan_with_predexp(self):
+        scan = self.as_connection.scan('test', 'predexp_policies')
+
+        records = scan.results({'predexp': age_at_least(20)})
+
+        assert sorted(bins['age'] for _, _, bins in records) == [20, 30, 40]
+
+    def test_compiled_policy_with_predexp(self):
+        policy = self.as_connection.read_policy(predexp=age_at_least(20))
+
+        for i, key in enumerate(self.keys):
+            if i < 2:
+                with pytest.raises(e.FilteredOut):
+                    self.as_connection.get(key, policy=policy)
+            else:
+                _, _, bins = self.as_connection.get(key, policy=policy)
+                assert bins['age'] == i * 10
+
+    @pytest.mark.parametrize("predexp", [
+        [],
+        'age',
+        [('not', 'a predexp')],
+    ])
+    def test_invalid_predexp(self, predexp):
+        with pytest.raises(e.ParamError):
+            self.as_connection.get(self.keys[0], policy={'predexp': predexp})
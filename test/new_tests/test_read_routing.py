@@ -0,0 +1,97 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+import time
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+@pytest.mark.usefixtures("connection_config")
+class TestReadRouting(object):
+
+    def connect(self, client):
+        _, user, password = TestBaseClass.get_hosts()
+        if user and password:
+            return client.connect(user, password)
+        return client.connect()
+
+    def new_client(self, **config):
+        config.update(self.connection_config)
+        return self.connect(aerospike.client(config))
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.key = ('test', 'demo', 'read_routing')
+        as_connection.put(self.key, {'a': 1})
+
+        def teardown():
+            try:
+                as_connection.remove(self.key)
+            except e.RecordNotFound:
+                pass
+
+        request.addfinalizer(teardown)
+
+    def test_reads_with_routing(self):
+        client = self.new_client(latency_aware_reads=True, tend_interval=100)
+
+        for _ in range(10):
+            assert client.get(self.key)[2] == {'a': 1}
+            assert client.select(self.key, ['a'])[2] == {'a': 1}
+            assert client.exists(self.key)[1] is not None
+        client.close()
+
+    def test_stats_have_node_ewma(self):
+        client = self.new_client(latency_aware_reads={'percentile': 99, 'min_delay': 5},
+                                 tend_interval=100)
+        time.sleep(0.5)
+
+        stats = client.stats()
+        routing = stats['read_routing']
+        assert routing['delay_ms'] >= 5
+        assert routing['rerouted'] >= 0
+        for node in stats['nodes'].values():
+            assert node['latency_ewma_us'] > 0
+            assert node['degraded'] in (True, False)
+        client.close()
+
+    def test_unbounded_reads_not_rerouted(self):
+        client = self.new_client(latency_aware_reads=True, tend_interval=100)
+        time.sleep(0.5)
+
+        before = client.stats()['read_routing']['rerouted']
+        for _ in range(10):
+            assert client.get(self.key, {'total_timeout': 0})[2] == {'a': 1}
+        assert client.stats()['read_routing']['rerouted'] == before
+        client.close()
+
+    def test_no_routing_stats(self):
+        assert 'read_routing' not in self.as_connection.stats()
+
+    def test_reconnect(self):
+        client = self.new_client(latency_aware_reads=True)
+        client.close()
+        self.connect(client)
+        assert client.get(self.key)[2] == {'a': 1}
+        client.close()
+
+    @pytest.mark.parametrize("config", [
+        {'percentile': 0},
+        {'percentile': 100},
+        {'percentile': 'p95'},
+        {'min_delay': 0},
+        {'degraded_factor': 1},
+        'yes',
+    ])
+    def test_invalid_config(self, config):
+        client_config = {'latency_aware_reads': config}
+        client_config.update(self.connection_config)
+        with pytest.raises(e.ParamError):
+            aerospike.client(client_config)
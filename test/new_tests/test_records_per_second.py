@@ -0,0 +1,126 @@
+# -*- coding: utf-8 -*-
+
+import pytest
+import sys
+import threading
+import time
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike_helpers import aggregates
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestRecordsPerSecond(TestBaseClass):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.test_ns = 'test'
+        self.test_set = 'throttle'
+        self.record_count = 20
+
+        for i in range(self.record_count):
+            as_connection.put(('test', 'throttle', i), {'id': i})
+
+        def teardown():
+            for i in range(self.record_count):
+                as_connection.remove(('test', 'throttle', i))
+
+        request.addfinalizer(teardown)
+
+    def test_scan_results_with_records_per_second(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        start = time.time()
+        records = scan_obj.results({'records_per_second': 50})
+        elapsed = time.time() - start
+
+        assert len(records) == self.record_count
+        # 20 records at 50 per second, less the initial burst
+        assert elapsed >= 0.25
+
+    def test_query_foreach_with_records_per_second(self):
+        query = self.as_connection.query(self.test_ns, self.test_set)
+        records = []
+
+        start = time.time()
+        query.foreach(records.append, {'records_per_second': 50})
+        elapsed = time.time() - start
+
+        assert len(records) == self.record_count
+        assert elapsed >= 0.25
+
+    def test_scan_set_records_per_second_while_running(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+        records = []
+
+        worker = threading.Thread(target=scan_obj.foreach, args=(records.append,),
+                                  kwargs={'policy': {'records_per_second': 1}})
+        start = time.time()
+        worker.start()
+        time.sleep(0.2)
+        scan_obj.set_records_per_second(0)
+        worker.join()
+        elapsed = time.time() - start
+
+        assert len(records) == self.record_count
+        # At 1 record per second the scan would take 20 seconds
+        assert elapsed < 10
+
+    def test_records_per_second_is_per_call(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+        scan_obj.results({'records_per_second': 1})
+
+        start = time.time()
+        records = scan_obj.results()
+        elapsed = time.time() - start
+
+        assert len(records) == self.record_count
+        # Still at 1 record per second the scan would take 20 seconds
+        assert elapsed < 10
+
+    def test_scan_results_with_compiled_policy(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+        policy = self.as_connection.scan_policy(records_per_second=50)
+
+        start = time.time()
+        records = scan_obj.results(policy)
+        elapsed = time.time() - start
+
+        assert len(records) == self.record_count
+        assert elapsed >= 0.25
+
+    def test_scan_aggregate_with_records_per_second(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        start = time.time()
+        scan_obj.aggregate({'records': aggregates.count()}, {'records_per_second': 50})
+        elapsed = time.time() - start
+
+        assert elapsed >= 0.25
+
+    def test_records_per_second_zero_is_unlimited(self):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        records = scan_obj.results({'records_per_second': 0})
+
+        assert len(records) == self.record_count
+
+    @pytest.mark.parametrize("rate", [-1, 'fast', 1.5])
+    def test_records_per_second_with_invalid_policy(self, rate):
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ParamError):
+            scan_obj.results({'records_per_second': rate})
+
+    @pytest.mark.parametrize("rate", [-1, 'fast', None])
+    def test_set_records_per_second_with_invalid_rate(self, rate):
+        query = self.as_connection.query(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ParamError):
+            query.set_records_per_second(rate)
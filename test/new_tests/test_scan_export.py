@@ -0,0 +1,143 @@
+# -*- coding: utf-8 -*-
+
+import json
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestScanExport(TestBaseClass):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.test_ns = 'test'
+        self.test_set = 'export'
+        self.record_count = 20
+
+        for i in range(self.record_count):
+            key = ('test', 'export', i)
+            rec = {
+                'name': 'name%s' % (str(i)),
+                'age': i,
+                'score': i / 2.0,
+                'tags': ['a', i],
+                'attrs': {'k': i, 1: 'one'},
+                'blob': bytearray(b'\x00\x01'),
+                'quote': 'say "hi"\n'
+            }
+            as_connection.put(key, rec, policy={'key': aerospike.POLICY_KEY_SEND})
+
+        def teardown():
+            for i in range(self.record_count):
+                key = ('test', 'export', i)
+                as_connection.remove(key)
+
+        request.addfinalizer(teardown)
+
+    def read_lines(self, path):
+        with open(str(path)) as export_file:
+            return [json.loads(line) for line in export_file]
+
+    def test_scan_export_ndjson(self, tmpdir):
+        path = tmpdir.join('export.ndjson')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        count = scan_obj.export(str(path))
+
+        records = self.read_lines(path)
+        assert count == self.record_count
+        assert len(records) == self.record_count
+
+        records.sort(key=lambda rec: rec['key'])
+        record = records[3]
+        assert record['key'] == 3
+        assert len(record['digest']) == 40
+        assert record['gen'] >= 1
+        assert record['bins']['name'] == 'name3'
+        assert record['bins']['age'] == 3
+        assert record['bins']['score'] == 1.5
+        assert record['bins']['tags'] == ['a', 3]
+        assert record['bins']['attrs'] == {'k': 3, '1': 'one'}
+        assert record['bins']['blob'] == '0001'
+        assert record['bins']['quote'] == 'say "hi"\n'
+
+    def test_scan_export_with_bins(self, tmpdir):
+        path = tmpdir.join('export.ndjson')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        scan_obj.export(str(path), bins=['name', 'age'])
+
+        for record in self.read_lines(path):
+            assert set(record['bins'].keys()) == set(['name', 'age'])
+
+    def test_scan_export_bins_keep_select(self, tmpdir):
+        path = tmpdir.join('export.ndjson')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+        scan_obj.select('score')
+
+        scan_obj.export(str(path), bins=['name', 'age'])
+
+        for _, _, bins in scan_obj.results():
+            assert list(bins.keys()) == ['score']
+        for record in self.read_lines(path):
+            assert set(record['bins'].keys()) == set(['name', 'age'])
+
+    def test_scan_export_with_policy_and_options(self, tmpdir):
+        path = tmpdir.join('export.ndjson')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        count = scan_obj.export(str(path), 'ndjson', None, {'total_timeout': 10000},
+                                {'concurrent': True})
+
+        assert count == self.record_count
+
+    def test_scan_export_arrow_ipc(self, tmpdir):
+        pyarrow_ipc = pytest.importorskip("pyarrow.ipc")
+        path = tmpdir.join('export.arrows')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        count = scan_obj.export(str(path), format='arrow_ipc',
+                                bins=['name', 'age', 'score', 'blob'])
+
+        table = pyarrow_ipc.open_stream(str(path)).read_all()
+        assert count == self.record_count
+        assert table.num_rows == self.record_count
+        assert sorted(table.column_names) == ['age', 'blob', 'name', 'score']
+        rows = sorted(table.to_pylist(), key=lambda row: row['age'])
+        assert rows[3] == {'name': 'name3', 'age': 3, 'score': 1.5, 'blob': b'\x00\x01'}
+
+    def test_scan_export_arrow_ipc_with_map_bin(self, tmpdir):
+        path = tmpdir.join('export.arrows')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ClientError):
+            scan_obj.export(str(path), format='arrow_ipc', bins=['attrs'])
+
+    def test_scan_export_with_invalid_format(self, tmpdir):
+        path = tmpdir.join('export.ndjson')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ParamError):
+            scan_obj.export(str(path), format='csv')
+
+    def test_scan_export_with_invalid_bins(self, tmpdir):
+        path = tmpdir.join('export.ndjson')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ParamError):
+            scan_obj.export(str(path), bins='name')
+
+    def test_scan_export_with_unwritable_path(self, tmpdir):
+        path = tmpdir.join('missing', 'export.ndjson')
+        scan_obj = self.as_connection.scan(self.test_ns, self.test_set)
+
+        with pytest.raises(e.ClientError):
+            scan_obj.export(str(path))
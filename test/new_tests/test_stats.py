@@ -0,0 +1,94 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+import threading
+import time
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+@pytest.mark.usefixtures("connection_config")
+class TestStats(object):
+
+    def new_client(self, **config):
+        config.update(self.connection_config)
+        client = aerospike.client(config)
+        _, user, password = TestBaseClass.get_hosts()
+        if user and password:
+            return client.connect(user, password)
+        return client.connect()
+
+    def test_stats_of_each_node(self):
+        client = self.new_client()
+        key = ('test', 'demo', 'stats')
+        client.put(key, {'a': 1})
+
+        stats = client.stats()
+        assert len(stats['nodes']) == len(client.get_nodes())
+        assert stats['thread_pool_queued_tasks'] >= 0
+        for node in stats['nodes'].values():
+            assert node['open'] == node['in_use'] + node['idle']
+            assert node['connects'] >= node['closes']
+        assert sum(node['connects'] for node in stats['nodes'].values()) >= 1
+
+        client.remove(key)
+        client.close()
+
+    def test_stats_with_warmup(self):
+        client = self.new_client(min_conns_per_node=3)
+
+        for node in client.stats()['nodes'].values():
+            assert node['idle'] >= 3
+        client.close()
+
+    def test_idle_connections_trimmed(self):
+        client = self.new_client(max_idle_conns_per_node=1, tend_interval=100)
+        key = ('test', 'demo', 'stats')
+        client.put(key, {'a': 1})
+
+        def read():
+            for _ in range(50):
+                client.get(key)
+
+        threads = [threading.Thread(target=read) for _ in range(16)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        # Each tend interval halves the idle connections above the floor.
+        time.sleep(1)
+        for node in client.stats()['nodes'].values():
+            assert node['idle'] <= 1
+
+        client.remove(key)
+        client.close()
+
+    def test_trim_floor_raised_to_min_conns(self):
+        client = self.new_client(min_conns_per_node=4, max_idle_conns_per_node=1,
+                                 tend_interval=100)
+
+        time.sleep(0.5)
+        for node in client.stats()['nodes'].values():
+            assert node['idle'] >= 4
+        client.close()
+
+    def test_stats_without_connection(self):
+        client = aerospike.client(self.connection_config)
+
+        with pytest.raises(e.ClusterError):
+            client.stats()
+
+    def test_stats_with_args(self):
+        client = self.new_client()
+
+        with pytest.raises(TypeError):
+            client.stats(1)
+        client.close()
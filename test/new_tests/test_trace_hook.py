@@ -0,0 +1,111 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+import threading
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestTraceHook(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.key = ('test', 'demo', 'trace')
+        self.spans = []
+        self.exported = threading.Event()
+
+        def teardown():
+            aerospike.set_trace_hook(None)
+            try:
+                as_connection.remove(self.key)
+            except e.RecordNotFound:
+                pass
+
+        request.addfinalizer(teardown)
+
+    def export(self, spans):
+        self.spans.extend(spans)
+        self.exported.set()
+
+    def test_spans_exported_on_unset(self):
+        aerospike.set_trace_hook(self.export)
+        self.as_connection.put(self.key, {'a': 1, 'b': 'xyz'})
+        self.as_connection.get(self.key)
+        aerospike.set_trace_hook(None)
+
+        put, get = self.spans[-2:]
+        assert put['name'] == 'put'
+        assert get['name'] == 'get'
+        assert put['attributes']['db.system'] == 'aerospike'
+        assert put['attributes']['db.name'] == 'test'
+        assert put['attributes']['db.aerospike.set'] == 'demo'
+        assert put['attributes']['db.aerospike.records'] == 1
+        assert put['attributes']['db.aerospike.payload_bytes'] == 8 + 3
+        assert get['attributes']['db.aerospike.payload_bytes'] == 8 + 3
+        assert put['status_code'] == 0
+        assert put['start_time'] <= put['end_time'] <= get['start_time']
+
+    def test_spans_exported_in_batches(self):
+        aerospike.set_trace_hook(self.export, batch_size=2, flush_interval_ms=60000)
+        self.as_connection.put(self.key, {'a': 1})
+        self.as_connection.get(self.key)
+
+        assert self.exported.wait(5)
+        assert [span['name'] for span in self.spans] == ['put', 'get']
+
+    def test_spans_exported_on_interval(self):
+        aerospike.set_trace_hook(self.export, flush_interval_ms=50)
+        self.as_connection.put(self.key, {'a': 1})
+
+        assert self.exported.wait(5)
+        assert self.spans[0]['name'] == 'put'
+
+    def test_failed_command_status(self):
+        aerospike.set_trace_hook(self.export)
+        with pytest.raises(e.RecordNotFound):
+            self.as_connection.get(('test', 'demo', 'trace-missing'))
+        aerospike.set_trace_hook(None)
+
+        assert self.spans[-1]['status_code'] == 2
+
+    def test_exporter_exception_ignored(self):
+        def export(spans):
+            raise ValueError('exporter failed')
+
+        aerospike.set_trace_hook(export)
+        self.as_connection.put(self.key, {'a': 1})
+        aerospike.set_trace_hook(None)
+
+        assert self.as_connection.get(self.key)[2] == {'a': 1}
+
+    def test_spans_dropped_above_max_queued(self):
+        aerospike.set_trace_hook(self.export, max_queued=2, flush_interval_ms=60000,
+                                 batch_size=1000)
+        for _ in range(5):
+            self.as_connection.put(self.key, {'a': 1})
+        aerospike.set_trace_hook(None)
+
+        assert len(self.spans) == 2
+
+    def test_not_traced_when_off(self):
+        aerospike.set_trace_hook(self.export)
+        aerospike.set_trace_hook(None)
+        self.as_connection.put(self.key, {'a': 1})
+
+        assert self.spans == []
+
+    @pytest.mark.parametrize("kwargs", [
+        {'exporter': 1},
+        {'exporter': print, 'batch_size': 0},
+        {'exporter': print, 'max_queued': 'many'},
+    ])
+    def test_invalid_args(self, kwargs):
+        with pytest.raises(e.ParamError):
+            aerospike.set_trace_hook(**kwargs)
@@ -0,0 +1,102 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestUpdate(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.key = ('test', 'demo', 'update')
+        self.new_key = ('test', 'demo', 'update_new')
+        as_connection.put(self.key, {'count': 1, 'tags': ['a'], 'name': 'update'})
+
+        def teardown():
+            for key in (self.key, self.new_key):
+                try:
+                    as_connection.remove(key)
+                except e.RecordNotFound:
+                    pass
+
+        request.addfinalizer(teardown)
+
+    def test_update_in_place(self):
+        def fn(bins):
+            bins['count'] += 1
+            bins['tags'].append('b')
+
+        bins = self.as_connection.update(self.key, fn)
+
+        assert bins == {'count': 2, 'tags': ['a', 'b'], 'name': 'update'}
+        _, meta, record = self.as_connection.get(self.key)
+        assert record == bins
+        assert meta['gen'] == 2
+
+    def test_update_returned_bins(self):
+        bins = self.as_connection.update(self.key, lambda bins: {'count': 5})
+
+        assert bins == {'count': 5}
+        _, _, record = self.as_connection.get(self.key)
+        assert record == {'count': 5}
+
+    def test_update_unchanged_not_written(self):
+        self.as_connection.update(self.key, lambda bins: None)
+
+        _, meta, _ = self.as_connection.get(self.key)
+        assert meta['gen'] == 1
+
+    def test_update_creates_record(self):
+        bins = self.as_connection.update(self.new_key, lambda bins: {'count': bins.get('count', 0) + 1})
+
+        assert bins == {'count': 1}
+        _, _, record = self.as_connection.get(self.new_key)
+        assert record == {'count': 1}
+
+    def test_update_retries_on_concurrent_change(self):
+        calls = []
+
+        def fn(bins):
+            calls.append(bins['count'])
+            if len(calls) == 1:
+                # Another writer changes the record after it was read.
+                self.as_connection.put(self.key, {'count': 10})
+            bins['count'] += 1
+
+        bins = self.as_connection.update(self.key, fn)
+
+        assert calls == [1, 10]
+        assert bins['count'] == 11
+        _, _, record = self.as_connection.get(self.key)
+        assert record['count'] == 11
+
+    def test_update_retries_exhausted(self):
+        def fn(bins):
+            self.as_connection.increment(self.key, 'count', 1)
+            bins['count'] = 0
+
+        with pytest.raises(e.RecordGenerationError):
+            self.as_connection.update(self.key, fn, max_retries=2, backoff_ms=0)
+
+        _, _, record = self.as_connection.get(self.key)
+        assert record['count'] == 4
+
+    def test_update_fn_exception(self):
+        def fn(bins):
+            raise ValueError("no update")
+
+        with pytest.raises(ValueError):
+            self.as_connection.update(self.key, fn)
+
+    @pytest.mark.parametrize("fn", [1, lambda bins: 1])
+    def test_update_invalid_fn(self, fn):
+        with pytest.raises(e.ParamError):
+            self.as_connection.update(self.key, fn)
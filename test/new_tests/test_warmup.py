@@ -0,0 +1,60 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+@pytest.mark.usefixtures("connection_config")
+class TestWarmup(object):
+
+    def new_client(self, **config):
+        config.update(self.connection_config)
+        return aerospike.client(config)
+
+    def connect(self, client, **kwargs):
+        _, user, password = TestBaseClass.get_hosts()
+        if user and password:
+            return client.connect(user, password, **kwargs)
+        return client.connect(**kwargs)
+
+    def test_connect_with_warmup(self):
+        client = self.new_client(min_conns_per_node=4, tend_interval=100)
+        self.connect(client)
+
+        assert client.is_connected()
+        key = ('test', 'demo', 'warmup')
+        client.put(key, {'a': 1})
+        assert client.get(key)[2] == {'a': 1}
+        client.remove(key)
+        client.close()
+
+    def test_connect_without_warmup(self):
+        client = self.new_client(min_conns_per_node=2)
+        self.connect(client, warmup=False)
+
+        assert client.is_connected()
+        client.close()
+
+    def test_min_conns_above_max(self):
+        client = self.new_client(min_conns_per_node=50, max_conns_per_node=5)
+        self.connect(client)
+
+        assert client.is_connected()
+        client.close()
+
+    def test_reconnect_after_close(self):
+        client = self.new_client(min_conns_per_node=2)
+        self.connect(client)
+        client.close()
+        self.connect(client)
+
+        assert client.is_connected()
+        client.close()
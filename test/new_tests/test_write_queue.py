@@ -0,0 +1,102 @@
+# -*- coding: utf-8 -*-
+import pytest
+import sys
+from .test_base_class import TestBaseClass
+from aerospike import exception as e
+from aerospike_helpers.operations import operations
+
+aerospike = pytest.importorskip("aerospike")
+try:
+    import aerospike
+except:
+    print("Please install aerospike python client.")
+    sys.exit(1)
+
+
+class TestWriteQueue(object):
+
+    @pytest.fixture(autouse=True)
+    def setup(self, request, as_connection):
+        self.keys = [('test', 'demo', 'queued%d' % i) for i in range(50)]
+        as_connection.put(self.keys[0], {'name': 'queued'})
+
+        def teardown():
+            for key in self.keys:
+                try:
+                    as_connection.remove(key)
+                except e.RecordNotFound:
+                    pass
+
+        request.addfinalizer(teardown)
+
+    def test_puts_sent_on_flush(self):
+        writes = self.as_connection.write_queue(max_inflight=4)
+        keys = self.keys[1:]
+
+        for i, key in enumerate(keys):
+            writes.put(key, {'i': i, 'tags': ['a', {'b': bytearray(b'c')}]})
+        writes.flush()
+
+        assert len(writes) == 0
+        assert writes.queued == len(keys)
+        assert writes.sent == len(keys)
+        assert writes.failed == 0
+        for i, key in enumerate(keys):
+            _, _, bins = self.as_connection.get(key)
+            assert bins == {'i': i, 'tags': ['a', {'b': bytearray(b'c')}]}
+        writes.close()
+
+    def test_operate(self):
+        with self.as_connection.write_queue(max_inflight=1) as writes:
+            writes.operate(self.keys[0], [
+                operations.write('count', 1),
+                operations.increment('count', 2),
+                operations.read('count'),
+            ], {'ttl': 1000})
+
+        _, _, bins = self.as_connection.get(self.keys[0])
+        assert bins == {'name': 'queued', 'count': 3}
+        assert writes.sent == 1
+
+    def test_on_error(self):
+        failures = []
+        writes = self.as_connection.write_queue(
+            on_error=lambda key, exception: failures.append((key, exception)))
+
+        writes.put(self.keys[0], {'other': 1}, policy={'exists': aerospike.POLICY_EXISTS_CREATE})
+        writes.put(self.keys[1], {'other': 1}, policy={'exists': aerospike.POLICY_EXISTS_CREATE})
+        writes.flush()
+
+        assert len(failures) == 1
+        key, exception = failures[0]
+        assert key[:2] == ('test', 'demo')
+        assert isinstance(exception, e.RecordExistsError)
+        assert writes.failed == 1
+        assert writes.sent == 1
+        writes.close()
+
+    def test_closed(self):
+        writes = self.as_connection.write_queue()
+        writes.close()
+
+        with pytest.raises(e.ClientError):
+            writes.put(self.keys[0], {'i': 1})
+
+    def test_invalid_put_raised_on_caller(self):
+        writes = self.as_connection.write_queue()
+
+        with pytest.raises(e.ParamError):
+            writes.put(None, {'i': 1})
+        with pytest.raises(e.ParamError):
+            writes.operate(self.keys[0], 'not a list')
+        assert writes.queued == 0
+        writes.close()
+
+    @pytest.mark.parametrize("kwargs", [
+        {'max_inflight': 0},
+        {'max_inflight': 2000},
+        {'on_error': 1},
+    ])
+    def test_invalid_write_queue(self, kwargs):
+        with pytest.raises(e.ParamError):
+            self.as_connection.write_queue(**kwargs)